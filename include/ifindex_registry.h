@@ -0,0 +1,63 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup ops-intfd
+ *
+ * @file
+ * Header for the ifIndex registry of the IF-MIB and IP-MIB plugins.
+ *
+ * The registry gives every interface or port name an ifIndex once and
+ * keeps it: the names are mapped in both directions with hash tables, and
+ * ifindex_registry_flush() saves the map to IFINDEX_REGISTRY_FILE in
+ * ovs_dbdir() when names were added, so the indexes survive restarts of
+ * snmpd.
+ *
+ * A name of digits only, like the ports "1" to "54", keeps its number as
+ * its ifIndex, which is what it was before the registry.  Every other
+ * name, like "49-1", "1.10", "vlan10" or "loopback0", gets the next free
+ * index from IFINDEX_REGISTRY_DYNAMIC_MIN up.
+ *
+ * Each plugin builds ifindex_registry.c in, like mib_refresh.c, so each
+ * has its own copy of the map.  The file is what keeps them consistent:
+ * before adding a name a copy reads what the other one saved since, and
+ * snmpd runs both plugins from one thread.  So each plugin flushes the
+ * names it added before it returns to snmpd: at the end of ops_snmp_run()
+ * and of a container_load() that built a snapshot.
+ *
+ ***************************************************************************/
+
+#ifndef __IFINDEX_REGISTRY_H__
+#define __IFINDEX_REGISTRY_H__
+
+#define IFINDEX_REGISTRY_FILE           "snmp_ifindex.map"
+
+/* Names of digits only below this keep their number as their ifIndex. */
+#define IFINDEX_REGISTRY_DYNAMIC_MIN    1000
+#define IFINDEX_REGISTRY_MAX            2147483647
+
+/* Returns the ifIndex of 'name', giving it one if it has none yet, or 0
+ * if there is no free index left. */
+long ifindex_registry_get(const char *name);
+
+/* Returns the name with 'ifindex', or NULL if there is none. */
+const char *ifindex_registry_name(long ifindex);
+
+/* Saves the map if names were added since the last save. */
+void ifindex_registry_flush(void);
+
+void ifindex_registry_destroy(void);
+
+#endif /* __IFINDEX_REGISTRY_H__ */
@@ -0,0 +1,64 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/****************************************************************************
+ * @ingroup cli
+ *
+ * @file intf_json.h
+ * Streaming JSON encoder for the "json" modifier of the show commands.
+ *
+ * Values are appended to a struct ds as they are produced, so no document
+ * tree is built and the caller may write out and clear the buffer between
+ * any two values.  The elements of the outermost array or object are put
+ * on lines of their own so that a pager shows one interface per line.
+ *
+ ***************************************************************************/
+
+#ifndef _INTF_JSON_H
+#define _INTF_JSON_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+struct ds;
+
+#define INTF_JSON_MAX_DEPTH     8
+
+struct intf_json {
+    struct ds *out;
+    int depth;                              /* Open arrays and objects. */
+    bool has_values[INTF_JSON_MAX_DEPTH];   /* Per depth: needs a comma. */
+};
+
+void intf_json_init(struct intf_json *json, struct ds *out);
+
+/* 'name' is the member name inside an object and NULL elsewhere. */
+void intf_json_object_start(struct intf_json *json, const char *name);
+void intf_json_object_end(struct intf_json *json);
+void intf_json_array_start(struct intf_json *json, const char *name);
+void intf_json_array_end(struct intf_json *json);
+
+/* A NULL 'value' is written as null. */
+void intf_json_string(struct intf_json *json, const char *name,
+                      const char *value);
+void intf_json_int(struct intf_json *json, const char *name, int64_t value);
+void intf_json_bool(struct intf_json *json, const char *name, bool value);
+
+/* Writes 'value' as a number if it is one, such as the DOM readings kept
+ * as strings in the IDL, and as a string otherwise. */
+void intf_json_reading(struct intf_json *json, const char *name,
+                       const char *value);
+
+#endif /* _INTF_JSON_H */
@@ -0,0 +1,51 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/****************************************************************************
+ * @ingroup cli
+ *
+ * @file intf_out.h
+ * Output builder for the long show commands.
+ *
+ * Between intf_out_begin() and intf_out_end(), intf_out() formats into a
+ * reusable buffer that is written to the vty once it holds about a screen
+ * of text, at interface block boundaries, so a pager keeps receiving
+ * whole blocks as they are built.  Outside of begin/end, intf_out() writes
+ * straight through.  Callers must intf_out_flush() before any helper that
+ * still writes with vty_out().
+ *
+ ***************************************************************************/
+
+#ifndef _INTF_OUT_H
+#define _INTF_OUT_H
+
+struct ds;
+struct vty;
+
+/* Buffered bytes after which intf_out_block_end() writes them out. */
+#define INTF_OUT_CHUNK  4096
+
+void intf_out(struct vty *vty, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+void intf_out_flush(struct vty *vty);
+void intf_out_begin(void);
+void intf_out_block_end(struct vty *vty);
+void intf_out_end(struct vty *vty);
+
+/* The buffer intf_out() formats into, for encoders such as intf_json that
+ * append to a struct ds themselves. */
+struct ds *intf_out_buffer(void);
+
+#endif /* _INTF_OUT_H */
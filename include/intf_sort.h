@@ -0,0 +1,68 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/****************************************************************************
+ * @ingroup cli
+ *
+ * @file intf_sort.h
+ * Precomputed sort keys for displaying interfaces in name order.
+ *
+ * The display order is:
+ *
+ *      1. "bridge_normal".
+ *      2. Names starting with a digit, by port, split lane and
+ *         subinterface tag, e.g. 1, 1.10, 2, 49-1, 49-1.5, 49-2.
+ *      3. All other names, by the type prefix before the first digit
+ *         (strcmp order), then by the value of all their digits, e.g.
+ *         lag2, lo1, vlan3, vlan20.
+ *
+ * The key of each name is parsed once, so sorting N names takes N
+ * parses and O(N log N) integer comparisons.
+ *
+ ***************************************************************************/
+
+#ifndef _INTF_SORT_H
+#define _INTF_SORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+enum intf_sort_class {
+    INTF_SORT_CLASS_BRIDGE_NORMAL,
+    INTF_SORT_CLASS_NUMBERED,
+    INTF_SORT_CLASS_NAMED
+};
+
+/* Number of type prefix bytes packed into 'major' of a named interface.
+ * Longer prefixes fall back to a byte comparison on ties. */
+#define INTF_SORT_PACKED_PREFIX_LEN     8
+
+struct intf_sort_key {
+    uint64_t    major;          /* Numbered: port << 32 | split lane.
+                                 * Named: packed type prefix. */
+    uint64_t    minor;          /* Numbered: subinterface tag.
+                                 * Named: value of the name's digits. */
+    uint32_t    cls;            /* enum intf_sort_class. */
+    uint32_t    prefix_len;     /* Named: length of the type prefix. */
+    const char  *name;
+    const void  *data;          /* Caller's row or node. */
+};
+
+void intf_sort_key_init(struct intf_sort_key *key, const char *name,
+                        const void *data);
+int intf_sort_key_compare(const void *a_, const void *b_);
+void intf_sort_keys(struct intf_sort_key *keys, size_t n);
+
+#endif /* _INTF_SORT_H */
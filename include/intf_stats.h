@@ -0,0 +1,84 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup ops-intfd
+ *
+ * @file
+ * Header for the Interface "statistics" column decoder.
+ *
+ * The statistics column is a string to integer map kept sorted by key.
+ * intf_stats_decode() walks it once, merging it against a sorted table of
+ * the keys below, instead of looking every counter up on its own.  The CLI
+ * and the IF-MIB and IP-MIB plugins read their counters from the decoded
+ * struct.  intf_stats.c only depends on the IDL, so each of these shared
+ * libraries builds it in.
+ *
+ ***************************************************************************/
+
+#ifndef __INTF_STATS_H__
+#define __INTF_STATS_H__
+
+#include <stdint.h>
+
+struct ovsdb_datum;
+struct ovsrec_interface;
+
+/* Per address family counters: "ipv4_<name>" and "ipv6_<name>". */
+struct intf_ip_stats {
+    uint64_t uc_rx_packets;
+    uint64_t uc_rx_bytes;
+    uint64_t mc_rx_packets;
+    uint64_t mc_rx_bytes;
+    uint64_t uc_tx_packets;
+    uint64_t uc_tx_bytes;
+    uint64_t mc_tx_packets;
+    uint64_t mc_tx_bytes;
+};
+
+/* Counters of one Interface row.  Keys missing from the column read 0. */
+struct intf_stats {
+    /* L2, named after their keys. */
+    uint64_t rx_packets;
+    uint64_t rx_bytes;
+    uint64_t tx_packets;
+    uint64_t tx_bytes;
+    uint64_t rx_dropped;
+    uint64_t rx_frame_err;
+    uint64_t rx_over_err;
+    uint64_t rx_crc_err;
+    uint64_t rx_errors;
+    uint64_t tx_dropped;
+    uint64_t collisions;
+    uint64_t tx_errors;
+
+    struct intf_ip_stats ipv4;
+    struct intf_ip_stats ipv6;
+};
+
+/* Fills 'stats' from a statistics datum, which may be NULL. */
+void intf_stats_decode(const struct ovsdb_datum *datum,
+                       struct intf_stats *stats);
+
+/* Fills 'stats' from the statistics column of 'ifrow'. */
+void intf_stats_from_interface(const struct ovsrec_interface *ifrow,
+                               struct intf_stats *stats);
+
+/* Adds every counter of 'stats' to 'sum', as for the members of a LAG.
+ * 'sum' and 'stats' must not overlap. */
+void intf_stats_add(struct intf_stats *restrict sum,
+                    const struct intf_stats *restrict stats);
+
+#endif /* __INTF_STATS_H__ */
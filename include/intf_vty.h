@@ -41,5 +41,14 @@ void dyncb_helpstr_mtu(struct cmd_token *token, struct vty *vty, \
 const struct shash_node **sort_interface(const struct shash *sh);
 void show_sflow_config (const char *name, const char *align, bool show_cmd);
 const struct shash_node **sort_interface(const struct shash *sh);
+const struct shash_node **get_sorted_interfaces(struct ovsdb_idl *idl,
+                                                int *count);
+const struct ovsrec_interface *intf_index_find(struct ovsdb_idl *idl,
+                                              const char *name);
+const struct ovsrec_port *port_index_find(struct ovsdb_idl *idl,
+                                          const char *name);
+void lag_member_map_build(struct ovsdb_idl *idl);
+void lag_member_map_destroy(void);
+bool lag_member_map_lookup(const char *name, const struct ovsrec_port **lag);
 
 #endif /* _INFT_VTY_H */
@@ -56,6 +56,9 @@
  *        --syslog-target=HOST:PORT  also send syslog msgs to HOST:PORT via UDP
  *
  *      Other options:
+ *        --record=FILE           record the OVSDB update stream to FILE
+ *        --standby               keep state current while another instance
+ *                                holds the ops_intfd lock (hot standby)
  *        --unixctl=SOCKET        override default control socket name
  *        -h, --help              display this help message
  *
@@ -67,6 +70,8 @@
  *      list-commands
  *      version
  *      ops-intfd/dump              dumps daemons internal data for debugging.
+ *      ops-intfd/record FILE|stop  starts/stops recording the OVSDB updates
+ *                                  processed by the daemon (see ops-intfd-replay).
  *      vlog/disable-rate-limit [module]...
  *      vlog/enable-rate-limit  [module]...
  *      vlog/list
@@ -103,6 +108,10 @@
 #include <openvswitch/vlog.h>
 #include <openvswitch/compiler.h>
 
+struct ds;
+struct smap;
+struct ovsrec_interface;
+
 /* Currently only QSFP+ and QSFP28 interfaces can be split
  * up into subintfs, and it's always groups of 4. */
 #define MAX_SPLIT_COUNT                4
@@ -268,6 +277,7 @@ struct intfd_arbiter_class {
 };
 
 extern void intfd_ovsdb_init(const char *db_path);
+extern void intfd_ovsdb_set_standby(bool enable);
 extern void intfd_ovsdb_exit(void);
 extern void intfd_run(void);
 extern void intfd_wait(void);
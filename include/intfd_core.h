@@ -0,0 +1,171 @@
+/*
+ * (c) Copyright 2015 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup ops-intfd
+ *
+ * @file
+ * Header for the ops-intfd interface decision logic.
+ *
+ * These functions derive an interface's operational state and hardware
+ * configuration from its parsed user configuration, hardware description
+ * and pluggable module information.  They work on plain structs only:
+ * raw column values come in as borrowed strings, results go out as enums,
+ * numbers and static strings, and nothing is allocated.  The library
+ * (libintfd_core) is linked by the daemon, the offline replay tool and the
+ * intfd_core_bench micro-benchmark.  The smap based wrappers used with IDL
+ * rows live in intfd_utils.c.
+ *
+ ***************************************************************************/
+
+#ifndef __INTFD_CORE_H__
+#define __INTFD_CORE_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "intfd.h"
+
+/** @ingroup ops-intfd
+ * @{ */
+
+/* How intfd treats an interface, derived from the Interface "type". */
+enum intfd_type_class {
+    INTFD_TYPE_CLASS_SYSTEM,        /* Physical ("" or "system") */
+    INTFD_TYPE_CLASS_INTERNAL,
+    INTFD_TYPE_CLASS_VLANSUBINT,
+    INTFD_TYPE_CLASS_LOOPBACK
+};
+
+/* Raw column values the core parses.  Each member is the value of the
+ * matching map key, or NULL if the key is absent. */
+struct intf_hw_info_raw {
+    const char *pluggable;
+    const char *connector;
+    const char *speeds;
+    const char *max_speed;
+};
+
+struct intf_user_cfg_raw {
+    const char *admin;
+    const char *autoneg;
+    const char *pause;
+    const char *duplex;
+    const char *speeds;
+    const char *mtu;
+    const char *lane_split;
+};
+
+struct intf_pm_info_raw {
+    const char *connector_status;
+    const char *connector;
+    const char *supported_speeds;
+};
+
+struct intf_hw_info {
+    bool is_pluggable;
+    enum ovsrec_interface_hw_intf_connector_e      connector;
+    uint32_t    speeds[INTFD_MAX_SPEEDS_ALLOWED];
+    int32_t     n_speeds;
+    uint32_t    max_speed;
+};
+
+struct intf_user_cfg {
+    enum ovsrec_interface_user_config_admin_e      admin_state;
+    enum ovsrec_interface_user_config_autoneg_e    autoneg;
+    enum ovsrec_interface_user_config_pause_e      pause;
+    enum ovsrec_interface_user_config_duplex_e     duplex;
+    enum ovsrec_interface_user_config_lane_split_e lane_split;
+
+    uint32_t   speeds[INTFD_MAX_SPEEDS_ALLOWED];
+    int32_t    n_speeds;
+    int32_t    mtu;
+};
+
+struct intf_oper_state {
+    bool        enabled;
+    enum ovsrec_interface_error_e reason;
+    enum ovsrec_interface_error_e autoneg_reason;
+
+    enum ovsrec_interface_hw_intf_config_duplex_e   duplex;
+    enum ovsrec_interface_hw_intf_config_pause_e    pause;
+    int32_t     autoneg_capability;
+    int32_t     autoneg_state;
+    int32_t     mtu;
+    uint32_t    speeds[INTFD_MAX_SPEEDS_ALLOWED];
+    int32_t     n_speeds;
+};
+
+struct intf_pm_info {
+    uint64_t    op_connector_flags;
+    enum ovsrec_interface_pm_info_connector_e           connector;
+    enum ovsrec_interface_pm_info_connector_status_e    connector_status;
+
+    enum ovsrec_interface_hw_intf_config_interface_type_e   intf_type;
+};
+
+struct iface {
+    char                        *name;
+    struct intf_hw_info         hw_info;
+    enum ovsrec_port_config_admin_e  port_admin;
+    enum intfd_type_class       type_class;
+    struct intf_user_cfg        user_cfg;
+    struct intf_oper_state      op_state;
+    struct intf_pm_info         pm_info;
+    struct iface                *split_parent;
+    struct iface                **split_children;
+    int                         n_split_children;
+};
+
+/* The values of the hw_intf_config column.  Only 'enable' is meaningful
+ * unless 'link_config' is set; 'mtu' and 'n_speeds' are 0 when the key
+ * is not to be written.  Strings are static. */
+struct intf_hw_config {
+    bool        enable;
+    bool        link_config;
+    const char  *autoneg;
+    const char  *duplex;
+    const char  *pause;
+    int32_t     mtu;
+    uint32_t    speeds[INTFD_MAX_SPEEDS_ALLOWED];
+    int32_t     n_speeds;
+    const char  *interface_type;
+};
+
+extern enum intfd_type_class intfd_core_type_class(const char *type);
+
+extern void intfd_core_parse_hw_info(struct intf_hw_info *hw_info,
+                                     const struct intf_hw_info_raw *raw);
+extern void intfd_core_parse_user_cfg(struct intf_user_cfg *user_config,
+                                      const struct intf_user_cfg_raw *raw,
+                                      const char *hw_info_speeds,
+                                      int32_t max_mtu);
+extern void intfd_core_parse_pm_info(const struct intf_hw_info *hw_info,
+                                     struct intf_pm_info *pm_info,
+                                     const struct intf_pm_info_raw *raw);
+extern void intfd_core_parse_split_pm_info(struct intf_pm_info *pm_info,
+                                           const struct intf_pm_info_raw *parent_raw);
+
+extern void intfd_core_calc_op_state(struct iface *intf);
+extern const char *intfd_core_get_hw_config(const struct iface *intf,
+                                            struct intf_hw_config *hw_config);
+
+extern const char* intfd_get_error_str(enum ovsrec_interface_error_e reason);
+extern const char* intfd_get_intf_type_str(enum ovsrec_interface_hw_intf_config_interface_type_e intf_type);
+extern const char* intfd_get_lane_split_str(enum ovsrec_interface_user_config_lane_split_e ls);
+
+/** @} end of group ops-intfd */
+
+#endif /* __INTFD_CORE_H__ */
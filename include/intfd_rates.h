@@ -0,0 +1,65 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup ops-intfd
+ *
+ * @file
+ * Header for the interface rate engine of ops-intfd.
+ *
+ * Every load interval the engine samples the rx/tx byte and packet counters
+ * of each Interface row's statistics column, as of the last time they
+ * changed.  It keeps the differences between consecutive samples in a small
+ * ring per interface (intfd_rates_ring.h) and folds each one into
+ * exponentially weighted bit and packet rates.  The rates are read
+ * with "ovs-appctl -t ops-intfd ops-intfd/rates [IFNAME]", which is what
+ * "show interface [IFNAME] rates" does, so no client has to fetch and diff
+ * the raw counters itself.
+ *
+ * The load interval of an interface is the "load_interval" key of its
+ * user_config column, in seconds, set with the "load-interval" command.
+ *
+ ***************************************************************************/
+
+#ifndef __INTFD_RATES_H__
+#define __INTFD_RATES_H__
+
+#include <stdbool.h>
+
+#include <dynamic-string.h>
+
+/** @ingroup ops-intfd
+ * @{ */
+
+#define INTFD_USER_CONFIG_MAP_LOAD_INTERVAL     "load_interval"
+
+/* Load interval bounds, in seconds. */
+#define INTFD_LOAD_INTERVAL_MIN                 5
+#define INTFD_LOAD_INTERVAL_MAX                 300
+#define INTFD_LOAD_INTERVAL_DEFAULT             30
+
+struct ovsdb_idl;
+
+extern void intfd_rates_run(const struct ovsdb_idl *idl);
+extern void intfd_rates_wait(void);
+extern void intfd_rates_exit(void);
+
+/* Appends the rates of interface 'name', or of every interface if 'name'
+ * is NULL, to 'ds'.  Returns false if there is no interface 'name'. */
+extern bool intfd_rates_dump(struct ds *ds, const char *name);
+
+/** @} end of group ops-intfd */
+
+#endif /* __INTFD_RATES_H__ */
@@ -0,0 +1,87 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup ops-intfd
+ *
+ * @file
+ * Header for the sample ring and weighted rates of the interface rate
+ * engine.
+ *
+ * The ring works on plain counter arrays and millisecond timestamps.  It
+ * has no IDL, smap or logging dependency, so the same source is built into
+ * ops-intfd and into the intfd_rates_test unit test.
+ *
+ ***************************************************************************/
+
+#ifndef __INTFD_RATES_RING_H__
+#define __INTFD_RATES_RING_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @ingroup ops-intfd
+ * @{ */
+
+/* Samples kept per interface.  The rates are weighted with
+ * INTFD_RATES_ALPHA, so they mostly reflect the traffic of the samples the
+ * ring holds. */
+#define INTFD_RATES_RING_SIZE   8
+
+/* Weight of the newest sample in the rates. */
+#define INTFD_RATES_ALPHA       (2.0 / (INTFD_RATES_RING_SIZE + 1))
+
+enum intfd_rate_counter {
+    INTFD_RATE_RX_BYTES,
+    INTFD_RATE_RX_PACKETS,
+    INTFD_RATE_TX_BYTES,
+    INTFD_RATE_TX_PACKETS,
+    INTFD_RATE_N_COUNTERS
+};
+
+/* The difference between two consecutive samples of the counters. */
+struct intfd_rate_sample {
+    unsigned int msec;                      /* Since the previous sample. */
+    uint64_t delta[INTFD_RATE_N_COUNTERS];
+};
+
+struct intfd_rate_ring {
+    long long int last_time;                /* Time of the last sample, in
+                                             * msec, 0 before the first. */
+    uint64_t last[INTFD_RATE_N_COUNTERS];   /* Counters at 'last_time'. */
+
+    /* The last 'n_samples' samples end before ring['head']. */
+    struct intfd_rate_sample ring[INTFD_RATES_RING_SIZE];
+    unsigned int head;
+    unsigned int n_samples;
+
+    double rate[INTFD_RATE_N_COUNTERS];     /* Per second, weighted. */
+};
+
+/* Adds the sample 'counters', taken at 'time' msec, to 'ring' and folds it
+ * into the rates.  The first sample, and the first after the counters went
+ * backwards, only sets the base of the next one.  Returns false if the
+ * counters went backwards. */
+bool intfd_rate_ring_add(struct intfd_rate_ring *ring,
+                         const uint64_t counters[INTFD_RATE_N_COUNTERS],
+                         long long int time);
+
+/* Returns the i'th sample of 'ring', oldest first, for i < n_samples. */
+const struct intfd_rate_sample *
+intfd_rate_ring_sample(const struct intfd_rate_ring *ring, unsigned int i);
+
+/** @} end of group ops-intfd */
+
+#endif /* __INTFD_RATES_RING_H__ */
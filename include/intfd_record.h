@@ -0,0 +1,83 @@
+/*
+ * (c) Copyright 2015 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup ops-intfd
+ *
+ * @file
+ * Header for recording the OVSDB update stream consumed by ops-intfd.
+ *
+ * A record file is line oriented.  Each IDL change processed by
+ * intfd_reconfigure() becomes one batch:
+ *
+ *     B <seqno> <usec since recording started>
+ *     I <name> <type> <split_parent> <split_children> <user_config>
+ *       <hw_intf_info> <pm_info>               Interface inserted/modified
+ *     i <name>                                 Interface deleted
+ *     P <name> <admin> <interfaces>            Port inserted/modified
+ *     p <name>                                 Port deleted
+ *     S <name> <max_transmission_unit> <interfaces>
+ *                                              Subsystem inserted/modified
+ *     s <name>                                 Subsystem deleted
+ *     Y <cur_cfg>                              System modified
+ *     O <name> <error> <hw_intf_config>        Columns written by intfd
+ *     E                                        End of batch
+ *
+ * Fields never contain blanks.  "-" is an absent value, "~" an empty
+ * string, lists are comma separated and maps are comma separated
+ * key=value pairs.  Any other character that would be ambiguous is
+ * escaped as %XX.  The first batch after recording starts contains every
+ * row, so a file can be replayed on its own.
+ *
+ ***************************************************************************/
+
+#ifndef __INTFD_RECORD_H__
+#define __INTFD_RECORD_H__
+
+#include <stdbool.h>
+
+#include <dynamic-string.h>
+#include <smap.h>
+#include <svec.h>
+
+/** @ingroup ops-intfd
+ * @{ */
+
+#define INTFD_RECORD_VERSION            2
+
+/* Passed to intfd_record_output() when the "error" column is not written. */
+#define INTFD_RECORD_ERROR_UNCHANGED    "*"
+
+struct ovsdb_idl;
+
+/* Daemon side. */
+extern bool intfd_record_start(const char *path);
+extern void intfd_record_stop(void);
+extern bool intfd_record_is_active(void);
+extern void intfd_record_updates(struct ovsdb_idl *idl, unsigned int idl_seqno);
+extern void intfd_record_output(const char *name, const char *error,
+                                const struct smap *hw_intf_config);
+extern void intfd_record_commit(void);
+
+/* Encoding helpers, shared with the replay tool. */
+extern void intfd_record_put_str(struct ds *ds, const char *str);
+extern void intfd_record_put_smap(struct ds *ds, const struct smap *smap);
+extern char *intfd_record_get_str(const char *field);
+extern void intfd_record_get_smap(const char *field, struct smap *smap);
+extern void intfd_record_get_list(const char *field, struct svec *svec);
+
+/** @} end of group ops-intfd */
+
+#endif /* __INTFD_RECORD_H__ */
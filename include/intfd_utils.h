@@ -29,9 +29,21 @@
 
 extern void intfd_print_smap(const char *name, const struct smap *map);
 
-extern const char* intfd_get_error_str(enum ovsrec_interface_error_e reason);
-extern const char* intfd_get_intf_type_str(enum ovsrec_interface_hw_intf_config_interface_type_e intf_type);
-extern const char* intfd_get_lane_split_str(enum ovsrec_interface_user_config_lane_split_e ls);
+/* smap front ends for the intfd_core.h parsers and hw_intf_config
+ * builder, for use with IDL rows. */
+extern void intfd_parse_hw_info(struct intf_hw_info *hw_info,
+                                const struct smap *ifrow_hw_info);
+extern void intfd_parse_user_cfg(struct intf_user_cfg *user_config,
+                                 const struct smap *ifrow_config,
+                                 const struct smap *ifrow_hw_intf_info,
+                                 int32_t max_mtu);
+extern void intfd_parse_pm_info(struct intf_hw_info *hw_info,
+                                struct intf_pm_info *pm_info,
+                                const struct smap *ifrow_pm_info);
+extern void intfd_parse_split_pm_info(struct intf_pm_info *pm_info,
+                                      const struct smap *ifrow_pm_info);
+extern const char *intfd_build_hw_intf_config(const struct iface *intf,
+                                              struct smap *hw_intf_config);
 
 /** @} end of group ops-intfd */
 
@@ -0,0 +1,85 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup ops-intfd
+ *
+ * @file
+ * Header for the columnar counter snapshots of the IF-MIB tables.
+ *
+ * A GETBULK walk reads a table a column at a time: every ifHCInOctets,
+ * then every ifHCOutOctets, and so on.  In the rows of the container each
+ * counter sits next to the strings and the other columns of its row, so
+ * such a walk touches a new cache line for every varbind.  A mib_columns
+ * keeps the counters instead as one dense array of uint64_t per column,
+ * indexed by the ordinal of the row in the snapshot, and the walk reads
+ * them in order.
+ *
+ * A table keeps two of them: the counters refresh fills the back one a
+ * slice at a time and its publish() swaps the two, so the requests never
+ * see a half-built snapshot.  The generation of a snapshot tells a row
+ * whether the ordinal it was given belongs to the one being served.
+ *
+ ***************************************************************************/
+
+#ifndef __MIB_COLUMNS_H__
+#define __MIB_COLUMNS_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct mib_columns {
+    uint64_t *values;           /* 'n_columns' arrays of 'allocated' rows. */
+    size_t n_columns;
+    size_t n_rows;
+    size_t allocated;
+    unsigned int generation;    /* 0 until the first swap. */
+};
+
+#define MIB_COLUMNS_INITIALIZER(N_COLUMNS) { .n_columns = N_COLUMNS }
+
+/* Makes room for 'n_rows' rows in 'cols', whose values are then undefined.
+ * Returns false if out of memory. */
+bool mib_columns_reset(struct mib_columns *cols, size_t n_rows);
+
+/* Publishes 'back' as the snapshot to serve, with a new generation, and
+ * hands the previous one back for the next refresh. */
+void mib_columns_swap(struct mib_columns *front, struct mib_columns *back);
+
+void mib_columns_destroy(struct mib_columns *cols);
+
+static inline void
+mib_columns_set(struct mib_columns *cols, size_t column, size_t row,
+                uint64_t value)
+{
+    cols->values[column * cols->allocated + row] = value;
+}
+
+/* Returns true and the value of 'column' in 'row' if 'generation' and 'row'
+ * are those of a row of the snapshot in 'cols'. */
+static inline bool
+mib_columns_get(const struct mib_columns *cols, unsigned int generation,
+                size_t row, size_t column, uint64_t *value)
+{
+    if (!cols->generation || generation != cols->generation
+        || row >= cols->n_rows) {
+        return false;
+    }
+    *value = cols->values[column * cols->allocated + row];
+    return true;
+}
+
+#endif /* __MIB_COLUMNS_H__ */
@@ -0,0 +1,109 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup ops-intfd
+ *
+ * @file
+ * Header for the background refresh of the IF-MIB and IP-MIB tables.
+ *
+ * Without it the container of a table is only reloaded when a request finds
+ * its cache expired, and that request pays for walking the whole database.
+ * Instead, the ops_snmp_run() hook of each plugin builds the next snapshot
+ * of its tables a bounded slice at a time: begin() lists the rows to visit,
+ * step() fills the back buffer for one of them and publish() copies the
+ * back buffer into the container the requests are served from, all within
+ * one run of the loop.  The container_load() callback of the table then
+ * finds a ready snapshot and returns at once; it only builds one
+ * synchronously before the first snapshot, or when the loop fell so far
+ * behind that the snapshot is more than two intervals old.
+ *
+ * mib_refresh.c only depends on the OVS library, so each plugin builds it
+ * in, like intf_stats.c.
+ *
+ ***************************************************************************/
+
+#ifndef __MIB_REFRESH_H__
+#define __MIB_REFRESH_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <dynamic-string.h>
+
+/* Bounds of one slice of a refresh. */
+#define MIB_REFRESH_SLICE_ROWS  64
+#define MIB_REFRESH_SLICE_MSEC  5
+
+/* Bounds of the configurable intervals, in seconds. */
+#define MIB_REFRESH_INTERVAL_MIN        1
+#define MIB_REFRESH_INTERVAL_MAX        3600
+
+/* What publish() does with a row of the back buffer. */
+enum mib_refresh_row_state {
+    MIB_REFRESH_ROW_GONE,       /* Its database row was deleted. */
+    MIB_REFRESH_ROW_KEEP,       /* Nothing changed. */
+    MIB_REFRESH_ROW_UPDATE,     /* Copy the columns step() read. */
+    MIB_REFRESH_ROW_NEW,        /* Insert it with every column. */
+};
+
+struct mib_refresh {
+    const char *name;
+    long long int interval;             /* Between snapshots, in msec. */
+
+    size_t (*begin)(void);              /* Returns the number of items. */
+    void (*step)(size_t item);
+    void (*publish)(void);
+
+    /* The snapshot being built. */
+    bool building;
+    size_t n_items;
+    size_t next_item;
+    long long int started;              /* time_msec() of begin(). */
+    long long int busy;                 /* Time spent in step(), in msec. */
+    unsigned int n_slices;
+
+    /* Statistics of the published snapshots. */
+    long long int published;            /* time_msec(), 0 before the first. */
+    long long int last_duration;        /* From begin() to publish(). */
+    long long int last_busy;
+    unsigned int last_slices;
+    size_t last_items;
+    unsigned long long int n_snapshots;
+    unsigned long long int n_sync;      /* Built by a request. */
+};
+
+#define MIB_REFRESH_INITIALIZER(NAME, SECONDS, BEGIN, STEP, PUBLISH)    \
+    { .name = NAME, .interval = (SECONDS) * 1000LL,                     \
+      .begin = BEGIN, .step = STEP, .publish = PUBLISH }
+
+void mib_refresh_run(struct mib_refresh *);
+void mib_refresh_wait(const struct mib_refresh *);
+
+/* Sets the interval between the snapshots of 'r'.  Returns false if
+ * 'seconds' is out of bounds. */
+bool mib_refresh_set_interval(struct mib_refresh *, long int seconds);
+
+/* Returns true if 'r' has a snapshot recent enough to serve requests. */
+bool mib_refresh_ready(const struct mib_refresh *);
+
+/* Completes the snapshot being built, or builds one, at once. */
+void mib_refresh_sync(struct mib_refresh *);
+
+/* Appends a line of statistics about 'r' to 'ds'. */
+void mib_refresh_format(const struct mib_refresh *, struct ds *);
+void mib_refresh_format_header(struct ds *);
+
+#endif /* __MIB_REFRESH_H__ */
@@ -0,0 +1,166 @@
+# Copyright (C) 2016 Hewlett Packard Enterprise Development LP
+# All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may
+# not use this file except in compliance with the License. You may obtain
+# a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations
+# under the License.
+
+TOPOLOGY = """
+#
+# +-------+
+# |  sw1  |
+# +-------+
+#
+
+# Nodes
+[type=openswitch name="Switch 1"] sw1
+"""
+
+
+def count_lines(out, text):
+    return len([line for line in out.split("\n") if text in line])
+
+
+def test_interface_range(topology, step):
+    sw1 = topology.get('sw1')
+
+    assert sw1 is not None
+
+    step('\n########## Test attribute commands on an interface range '
+         '##########\n')
+    sw1('configure terminal')
+    sw1('interface range 1-4,6')
+    sw1('no shutdown')
+    sw1('mtu 1600')
+    sw1('end')
+
+    out = sw1('show running-config interface')
+    assert count_lines(out, 'mtu 1600') == 5, \
+        "Failed test, mtu not set on all interfaces of the range!"
+
+    out = sw1('show running-config interface 5')
+    assert 'mtu 1600' not in out, \
+        "Failed test, mtu set on an interface outside the range!"
+
+    sw1('configure terminal')
+    sw1('interface range 1-4,6')
+    sw1('no mtu')
+    sw1('shutdown')
+    sw1('end')
+
+    out = sw1('show running-config interface')
+    assert count_lines(out, 'mtu 1600') == 0, \
+        "Failed test, mtu not removed from all interfaces of the range!"
+
+    step('\n########## Test invalid interface ranges ##########\n')
+    sw1('configure terminal')
+    out = sw1('interface range 4-1')
+    assert 'Invalid interface range' in out, \
+        "Failed test, reversed range accepted!"
+
+    out = sw1('interface range 1-1-2-4')
+    assert 'Invalid interface range' in out, \
+        "Failed test, split range across parents accepted!"
+    sw1('end')
+
+    step('\n########## Test commands without range support ##########\n')
+    sw1('configure terminal')
+    sw1('interface range 1-2')
+    out = sw1('ip address 10.0.0.1/24')
+    assert 'Unknown command' in out, \
+        "Failed test, L3 command accepted in the range context!"
+
+    out = sw1('split')
+    assert 'Unknown command' in out, \
+        "Failed test, split accepted in the range context!"
+    sw1('exit')
+
+    sw1('interface 3')
+    sw1('mtu 1700')
+    sw1('end')
+
+    out = sw1('show running-config')
+    assert 'interface 1-2' not in out, \
+        "Failed test, range name used as an interface name!"
+    assert count_lines(out, 'mtu 1700') == 1, \
+        "Failed test, interface context broken after leaving a range!"
+
+    sw1('configure terminal')
+    sw1('interface 3')
+    sw1('no mtu')
+    sw1('end')
+
+    step('\n########## Test split children in an interface range '
+         '##########\n')
+    split_interface(sw1, '50', 'split')
+
+    sw1('configure terminal')
+    out = sw1('interface range 50-1')
+    assert 'Invalid interface range' not in out, \
+        "Failed test, split child 50-1 parsed as the range 50 to 1!"
+    sw1('mtu 1800')
+    sw1('end')
+
+    out = sw1('show running-config interface')
+    assert count_lines(out, 'mtu 1800') == 1, \
+        "Failed test, mtu not set on split child 50-1 only!"
+    out = sw1('show running-config interface 50-1')
+    assert 'mtu 1800' in out, \
+        "Failed test, mtu not set on split child 50-1!"
+
+    sw1('configure terminal')
+    sw1('interface range 50-2,50-3-50-4')
+    sw1('mtu 1800')
+    sw1('end')
+
+    out = sw1('show running-config interface')
+    assert count_lines(out, 'mtu 1800') == 4, \
+        "Failed test, mtu not set on all split children of the range!"
+
+    sw1('configure terminal')
+    sw1('interface range 50-1-50-4')
+    sw1('no mtu')
+    sw1('end')
+
+    out = sw1('show running-config interface')
+    assert count_lines(out, 'mtu 1800') == 0, \
+        "Failed test, mtu not removed from the split children!"
+
+    split_interface(sw1, '50', 'no split')
+
+    step('\n########## Test leaving a range through another context '
+         '##########\n')
+    sw1('configure terminal')
+    sw1('interface range 1-2')
+    sw1('interface 3')
+    sw1('mtu 1700')
+    sw1('end')
+
+    out = sw1('show running-config interface')
+    assert count_lines(out, 'mtu 1700') == 1, \
+        "Failed test, range still applied after entering another context!"
+
+    sw1('configure terminal')
+    sw1('interface 3')
+    sw1('no mtu')
+    sw1('end')
+
+
+def split_interface(sw1, name, command):
+    # The split commands ask for a confirmation, see
+    # test_intfd_ct_interface_split_with_lag.py.
+    sw1('configure terminal')
+    sw1('interface ' + name)
+    sw1._shells['vtysh']._prompt = ('.*Do you want to continue [y/n]?')
+    sw1(command)
+    sw1._shells['vtysh']._prompt = ('(^|\n)switch(\\([\\-a-zA-Z0-9]*\\))?#')
+    sw1('y')
+    sw1('end')
@@ -0,0 +1,171 @@
+# Copyright (C) 2016 Hewlett Packard Enterprise Development LP
+# All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may
+# not use this file except in compliance with the License. You may obtain
+# a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations
+# under the License.
+
+import json
+from time import sleep
+
+TOPOLOGY = """
+#
+# +-------+
+# |  sw1  |
+# +-------+
+#
+
+# Nodes
+[type=openswitch name="Switch 1"] sw1
+"""
+
+
+def set_link_speed(sw1, name, speed):
+    """
+    Writes link_speed, which the sim switchd also writes on link changes,
+    until it reads back the same value a second later.  Interfaces 3 and 4
+    stay admin down, so the switchd has no reason to write it.
+    """
+    for _ in range(10):
+        sw1('ovs-vsctl set interface %s link_speed=%d' % (name, speed),
+            shell='bash')
+        sleep(1)
+        out = sw1('ovs-vsctl get interface %s link_speed' % name,
+                  shell='bash')
+        if out.strip() == str(speed):
+            return
+    assert False, "Failed test, link_speed of %s does not settle!" % name
+
+
+def split_interface(sw1, name, command):
+    # The split commands ask for a confirmation, see
+    # test_intfd_ct_interface_split_with_lag.py.
+    sw1('configure terminal')
+    sw1('interface ' + name)
+    sw1._shells['vtysh']._prompt = ('.*Do you want to continue [y/n]?')
+    sw1(command)
+    sw1._shells['vtysh']._prompt = ('(^|\n)switch(\\([\\-a-zA-Z0-9]*\\))?#')
+    sw1('y')
+    sw1('end')
+
+
+def test_show_interface_filter(topology, step):
+    sw1 = topology.get('sw1')
+
+    assert sw1 is not None
+
+    sw1('configure terminal')
+    sw1('interface lag 1')
+    sw1('exit')
+    sw1('interface 1')
+    sw1('lag 1')
+    sw1('exit')
+    sw1('interface 2')
+    sw1('no shutdown')
+    sw1('end')
+
+    step('\n########## Test show interface error ##########\n')
+    rows = json.loads(sw1('show interface error admin_down json'))
+    names = [r['name'] for r in rows]
+    assert '3' in names, "Failed test, admin down interface missing!"
+    assert '2' not in names, "Failed test, enabled interface listed!"
+    assert all(r['reason'] == 'admin_down' for r in rows), \
+        "Failed test, interface with another reason listed!"
+
+    step('\n########## Test show interface status ##########\n')
+    out = sw1('show interface status up brief')
+    assert 'lag1' not in out, "Failed test, LAG listed by a predicate!"
+    rows = json.loads(sw1('show interface status down json'))
+    assert all(r['link_state'] != 'up' for r in rows), \
+        "Failed test, link up interface listed!"
+
+    step('\n########## Test show interface lag ##########\n')
+    rows = json.loads(sw1('show interface lag 1 json'))
+    assert [r['name'] for r in rows] == ['1'], \
+        "Failed test, expected only the member of lag1!"
+
+    step('\n########## Test show interface speed ##########\n')
+    out = sw1('show interface speed fast')
+    assert 'Invalid speed fast.' in out
+
+    set_link_speed(sw1, '3', 10000000000)
+    set_link_speed(sw1, '4', 1000000000)
+    rows = json.loads(sw1('show interface speed 10000 json'))
+    names = [r['name'] for r in rows]
+    assert '3' in names, "Failed test, 10 Gb/s interface missing!"
+    assert '4' not in names, "Failed test, 1 Gb/s interface listed!"
+    assert all(r['speed_mbps'] == 10000 for r in rows), \
+        "Failed test, interface with another speed listed!"
+    rows = json.loads(sw1('show interface speed 10G json'))
+    assert [r['name'] for r in rows] == names, \
+        "Failed test, 10G and 10000 list different interfaces!"
+    rows = json.loads(sw1('show interface speed 1G json'))
+    names = [r['name'] for r in rows]
+    assert '4' in names and '3' not in names, \
+        "Failed test, expected interface 4 only at 1 Gb/s!"
+
+    step('\n########## Test show interface connector ##########\n')
+    xvrs = json.loads(sw1('show interface transceiver json'))
+    connector = [r['connector'] for r in xvrs if r['name'] == '1'][0]
+    assert connector, "Failed test, interface 1 has no connector!"
+    expected = [r['name'] for r in xvrs if r['connector'] == connector]
+    rows = json.loads(sw1('show interface connector %s json' % connector))
+    assert [r['name'] for r in rows] == expected, \
+        "Failed test, connector filter differs from the transceivers!"
+    rows = json.loads(sw1('show interface connector %s json'
+                          % connector.lower()))
+    assert [r['name'] for r in rows] == expected, \
+        "Failed test, connector filter is case sensitive!"
+    rows = json.loads(sw1('show interface connector NONE json'))
+    assert rows == [], "Failed test, unknown connector matched!"
+
+    step('\n########## Test combined filter modifiers ##########\n')
+    rows = json.loads(sw1('show interface speed 10G brief json'))
+    names = [r['name'] for r in rows]
+    assert '3' in names and '4' not in names, \
+        "Failed test, speed filter with brief json!"
+    out = sw1('show interface speed 10G brief')
+    lines = [line.split()[0] for line in out.splitlines() if line.strip()]
+    assert '3' in lines and '4' not in lines, \
+        "Failed test, speed filter with brief!"
+    rows = json.loads(sw1('show interface connector %s brief json'
+                          % connector))
+    assert [r['name'] for r in rows] == expected, \
+        "Failed test, connector filter with brief json!"
+
+    sw1('ovs-vsctl clear interface 3 link_speed', shell='bash')
+    sw1('ovs-vsctl clear interface 4 link_speed', shell='bash')
+
+    step('\n########## Test show interface split-children ##########\n')
+    split_interface(sw1, '50', 'split')
+    rows = json.loads(sw1('show interface split-children json'))
+    names = [r['name'] for r in rows]
+    for child in ('50-1', '50-2', '50-3', '50-4'):
+        assert child in names, "Failed test, %s missing!" % child
+    assert '50' not in names and '1' not in names, \
+        "Failed test, interface that is not a split child listed!"
+    assert all('-' in name for name in names), \
+        "Failed test, interface that is not a split child listed!"
+    out = sw1('show interface split-children brief')
+    lines = [line.split()[0] for line in out.splitlines() if line.strip()]
+    assert '50-1' in lines and '50' not in lines, \
+        "Failed test, split-children filter with brief!"
+    split_interface(sw1, '50', 'no split')
+
+    sw1('configure terminal')
+    sw1('interface 2')
+    sw1('shutdown')
+    sw1('exit')
+    sw1('interface 1')
+    sw1('no lag 1')
+    sw1('exit')
+    sw1('no interface lag 1')
+    sw1('end')
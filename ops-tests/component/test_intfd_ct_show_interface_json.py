@@ -0,0 +1,134 @@
+# Copyright (C) 2016 Hewlett Packard Enterprise Development LP
+# All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may
+# not use this file except in compliance with the License. You may obtain
+# a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations
+# under the License.
+
+import json
+
+TOPOLOGY = """
+#
+# +-------+
+# |  sw1  |
+# +-------+
+#
+
+# Nodes
+[type=openswitch name="Switch 1"] sw1
+"""
+
+
+def test_show_interface_json(topology, step):
+    sw1 = topology.get('sw1')
+
+    assert sw1 is not None
+
+    step('\n########## Test show interface json ##########\n')
+    sw1('configure terminal')
+    sw1('interface 1')
+    sw1('no shutdown')
+    sw1('mtu 1600')
+    sw1('end')
+
+    rows = json.loads(sw1('show interface 1 json'))
+    assert len(rows) == 1, "Failed test, expected one interface!"
+    row = rows[0]
+    assert row['name'] == '1'
+    assert row['admin_state'] == 'up'
+    assert row['mtu'] == 1600
+    assert 'rx_packets' in row['statistics'], \
+        "Failed test, statistics missing from the JSON output!"
+
+    step('\n########## Test show interface brief json ##########\n')
+    rows = json.loads(sw1('show interface brief json'))
+    names = [r['name'] for r in rows]
+    assert '1' in names, "Failed test, interface 1 missing!"
+    assert 'statistics' not in rows[0], \
+        "Failed test, brief output carries statistics!"
+
+    step('\n########## Test show interface transceiver json ##########\n')
+    rows = json.loads(sw1('show interface 1 transceiver json'))
+    assert rows[0]['name'] == '1'
+    assert 'connector' in rows[0]
+
+    step('\n########## Test json error output ##########\n')
+    out = json.loads(sw1('show interface 99 transceiver json'))
+    assert out == {'error': 'Invalid switch interface ID.'}, \
+        "Failed test, invalid interface not reported as a JSON error!"
+    out = json.loads(sw1('show interface speed fast json'))
+    assert out == {'error': 'Invalid speed fast.'}, \
+        "Failed test, invalid speed not reported as a JSON error!"
+
+    step('\n########## Test show interface dom json ##########\n')
+    rows = json.loads(sw1('show interface 1 dom json'))
+    assert len(rows) == 1, "Failed test, expected one interface!"
+    for key in ('name', 'connector', 'splittable', 'pluggable',
+                'module_present', 'module'):
+        assert key in rows[0], \
+            "Failed test, {} missing from the dom output!".format(key)
+    if rows[0]['module_present']:
+        assert isinstance(rows[0]['dom'], dict)
+    out = json.loads(sw1('show interface 99 dom json'))
+    assert out == {'error': 'Invalid switch interface ID.'}, \
+        "Failed test, invalid interface not reported as a JSON error!"
+
+    rows = json.loads(sw1('show interface transceiver json'))
+    assert len(rows) > 1, "Failed test, expected every interface!"
+    for row in rows:
+        for key in ('name', 'connector', 'module_present'):
+            assert key in row, \
+                "Failed test, {} missing from the transceiver output!" \
+                .format(key)
+
+    step('\n########## Test show ip interface json ##########\n')
+    sw1('configure terminal')
+    sw1('interface 1')
+    sw1('ip address 10.0.0.1/24')
+    sw1('ip address 10.0.1.1/24 secondary')
+    sw1('ipv6 address 2001::1/64')
+    sw1('end')
+
+    rows = json.loads(sw1('show ip interface json'))
+    row = [r for r in rows if r['name'] == '1']
+    assert len(row) == 1, "Failed test, interface 1 missing!"
+    row = row[0]
+    for key in ('name', 'admin_state', 'link_state', 'mac', 'address',
+                'secondary_addresses', 'mtu', 'statistics'):
+        assert key in row, \
+            "Failed test, {} missing from the ip output!".format(key)
+    assert row['address'] == '10.0.0.1/24'
+    assert row['secondary_addresses'] == ['10.0.1.1/24']
+    assert row['mtu'] == 1600
+    assert all(k.startswith('ipv4_') for k in row['statistics']), \
+        "Failed test, non-IPv4 statistics in the ip output!"
+
+    rows = json.loads(sw1('show ip interface 1 json'))
+    assert [r['name'] for r in rows] == ['1']
+
+    rows = json.loads(sw1('show ipv6 interface 1 json'))
+    assert len(rows) == 1, "Failed test, expected one interface!"
+    assert rows[0]['address'] == '2001::1/64'
+    assert rows[0]['secondary_addresses'] == []
+    assert all(k.startswith('ipv6_') for k in rows[0]['statistics']), \
+        "Failed test, non-IPv6 statistics in the ipv6 output!"
+
+    # Not L3: an empty list, not an error.
+    assert json.loads(sw1('show ip interface 2 json')) == []
+
+    sw1('configure terminal')
+    sw1('interface 1')
+    sw1('no ipv6 address 2001::1/64')
+    sw1('no ip address 10.0.1.1/24 secondary')
+    sw1('no ip address 10.0.0.1/24')
+    sw1('no mtu')
+    sw1('shutdown')
+    sw1('end')
@@ -0,0 +1,92 @@
+# Copyright (C) 2016 Hewlett Packard Enterprise Development LP
+# All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may
+# not use this file except in compliance with the License. You may obtain
+# a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations
+# under the License.
+
+import re
+from time import sleep, time
+
+TOPOLOGY = """
+#
+# +-------+
+# |  sw1  |
+# +-------+
+#
+
+# Nodes
+[type=openswitch name="Switch 1"] sw1
+"""
+
+# An idle interface gets its first sample two load intervals after the
+# last one.
+RATES_TIMEOUT = 45
+
+
+def wait_for_rate_samples(sw1, name, interval):
+    """
+    Polls ops-intfd/rates until interface 'name' has at least one sample
+    taken with the given load interval, or RATES_TIMEOUT seconds pass.
+    """
+    pattern = re.compile(r'Load interval %d seconds, ([0-9]+) of' % interval)
+    deadline = time() + RATES_TIMEOUT
+    while True:
+        out = sw1('ovs-appctl -t ops-intfd ops-intfd/rates ' + name,
+                  shell='bash')
+        match = pattern.search(out)
+        if match and int(match.group(1)) > 0:
+            return
+        assert time() < deadline, \
+            "Failed test, no rate sample for interface %s:\n%s" % (name, out)
+        sleep(1)
+
+
+def test_show_interface_rates(topology, step):
+    sw1 = topology.get('sw1')
+
+    assert sw1 is not None
+
+    step('\n########## Test load-interval ##########\n')
+    sw1('configure terminal')
+    sw1('interface 1')
+    sw1('load-interval 10')
+    sw1('end')
+
+    out = sw1('show running-config interface 1')
+    assert 'load-interval 10' in out, \
+        "Failed test, load-interval not in the running config!"
+
+    # Wait for the daemon to pick up the interval and take a sample.
+    wait_for_rate_samples(sw1, '1', 10)
+
+    step('\n########## Test show interface rates ##########\n')
+    out = sw1('show interface rates')
+    assert 'RX bits/sec' in out, "Failed test, no rates table!"
+    assert any(line.split()[:2] == ['1', '10s']
+               for line in out.splitlines() if line.strip()), \
+        "Failed test, interface 1 not listed with its load interval!"
+
+    out = sw1('show interface 1 rates')
+    assert 'Load interval 10 seconds' in out
+    assert 'Input rate' in out and 'Output rate' in out
+
+    out = sw1('show interface 99 rates')
+    assert 'Invalid switch interface ID.' in out
+
+    sw1('configure terminal')
+    sw1('interface 1')
+    sw1('no load-interval')
+    sw1('end')
+
+    out = sw1('show running-config interface 1')
+    assert 'load-interval' not in out, \
+        "Failed test, load-interval still in the running config!"
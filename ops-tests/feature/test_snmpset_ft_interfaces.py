@@ -0,0 +1,174 @@
+# -*- coding: utf-8 -*-
+# (C) Copyright 2016 Hewlett Packard Enterprise Development LP
+# All Rights Reserved.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License"); you may
+#    not use this file except in compliance with the License. You may obtain
+#    a copy of the License at
+#
+#         http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+#    WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+#    License for the specific language governing permissions and limitations
+#    under the License.
+#
+##########################################################################
+
+"""
+OpenSwitch Test for SNMP SET of the interface table writable columns.
+"""
+
+from pytest import mark
+from time import sleep
+
+
+TOPOLOGY = """
+# +--------+
+# |  ops1  |
+# +--------+
+
+# Nodes
+[type=openswitch name="OpenSwitch 1"] ops1
+"""
+
+V3_AUTH = "-u testv3user -l authNoPriv -a md5 -A password"
+
+
+def snmp_set(ops1, varbinds):
+    return ops1("snmpset -v3 " + V3_AUTH + " localhost " + varbinds,
+                shell='bash')
+
+
+def intf_user_config(ops1, key):
+    return ops1("get interface 1 user_config:" + key, shell='vsctl').strip()
+
+
+def port_admin(ops1):
+    return ops1("get port 1 admin", shell='vsctl').strip()
+
+
+def config(ops1):
+    # Configure auth user - testv3user
+    with ops1.libs.vtysh.Configure() as ctx:
+        ctx.snmpv3_user_auth_auth_pass('testv3user', auth_protocol='md5',
+                                       auth_password='password')
+
+    # Give interface 1 a Port row, so SET of ifAdminStatus also writes the
+    # Port's admin column.
+    with ops1.libs.vtysh.ConfigInterface('1') as ctx:
+        ctx.ip_address('10.0.10.1/24')
+        ctx.no_shutdown()
+
+
+def unconfig(ops1):
+    with ops1.libs.vtysh.ConfigInterface('1') as ctx:
+        ctx.no_ip_address('10.0.10.1/24')
+        ctx.shutdown()
+
+    with ops1.libs.vtysh.Configure() as ctx:
+        ctx.no_snmpv3_user_auth_auth_pass('testv3user', auth_protocol='md5',
+                                          auth_password='password')
+
+
+def snmpset_commit(ops1):
+    # Both tables in one PDU, committed in one OVSDB transaction.
+    retstruct = snmp_set(ops1, "IF-MIB::ifAdminStatus.1 i 2 "
+                         "IF-MIB::ifAlias.1 s uplink")
+    assert "IF-MIB::ifAdminStatus.1 = INTEGER: down(2)" in retstruct
+    assert "IF-MIB::ifAlias.1 = STRING: uplink" in retstruct
+    assert intf_user_config(ops1, "admin") == 'down'
+    assert intf_user_config(ops1, "description") == 'uplink'
+    assert port_admin(ops1) == 'down'
+
+    retstruct = snmp_set(ops1, "IF-MIB::ifAdminStatus.1 i 1")
+    assert "IF-MIB::ifAdminStatus.1 = INTEGER: up(1)" in retstruct
+    assert intf_user_config(ops1, "admin") == 'up'
+    assert port_admin(ops1) == 'up'
+
+
+def snmpset_testing_rejected(ops1):
+    retstruct = snmp_set(ops1, "IF-MIB::ifAdminStatus.1 i 3")
+    assert "wrongValue" in retstruct
+    assert intf_user_config(ops1, "admin") == 'up'
+
+
+def snmpset_not_writable(ops1):
+    retstruct = snmp_set(ops1, "IF-MIB::ifMtu.1 i 1600")
+    assert "notWritable" in retstruct
+
+    retstruct = snmp_set(ops1, "IF-MIB::ifName.1 s x")
+    assert "notWritable" in retstruct
+
+
+def snmpset_failed_varbind_keeps_ovsdb(ops1):
+    # ifAlias is valid, but the PDU fails on ifAdminStatus, so neither
+    # column may reach OVSDB.
+    retstruct = snmp_set(ops1, "IF-MIB::ifAlias.1 s downlink "
+                         "IF-MIB::ifAdminStatus.1 i 3")
+    assert "wrongValue" in retstruct
+    assert intf_user_config(ops1, "description") == 'uplink'
+    assert intf_user_config(ops1, "admin") == 'up'
+    assert port_admin(ops1) == 'up'
+
+
+def snmpset_mixed_tables(ops1):
+    # ifXTable before ifTable in the PDU: both columns land together.
+    retstruct = snmp_set(ops1, "IF-MIB::ifAlias.1 s core "
+                         "IF-MIB::ifAdminStatus.1 i 2")
+    assert "IF-MIB::ifAlias.1 = STRING: core" in retstruct
+    assert "IF-MIB::ifAdminStatus.1 = INTEGER: down(2)" in retstruct
+    assert intf_user_config(ops1, "description") == 'core'
+    assert intf_user_config(ops1, "admin") == 'down'
+    assert port_admin(ops1) == 'down'
+
+    # A valid ifAdminStatus with an ifAlias that is too long: the ifTable
+    # row must not be committed on its own.
+    retstruct = snmp_set(ops1, "IF-MIB::ifAdminStatus.1 i 1 "
+                         "IF-MIB::ifAlias.1 s " + "x" * 65)
+    assert "wrongLength" in retstruct
+    assert intf_user_config(ops1, "admin") == 'down'
+    assert intf_user_config(ops1, "description") == 'core'
+    assert port_admin(ops1) == 'down'
+
+    # The failing varbind is on another row of ifTable.
+    retstruct = snmp_set(ops1, "IF-MIB::ifAdminStatus.1 i 1 "
+                         "IF-MIB::ifAlias.1 s edge "
+                         "IF-MIB::ifAdminStatus.2 i 3")
+    assert "wrongValue" in retstruct
+    assert intf_user_config(ops1, "admin") == 'down'
+    assert intf_user_config(ops1, "description") == 'core'
+    assert port_admin(ops1) == 'down'
+
+    retstruct = snmp_set(ops1, "IF-MIB::ifAdminStatus.1 i 1 "
+                         "IF-MIB::ifAlias.1 s uplink")
+    assert "IF-MIB::ifAdminStatus.1 = INTEGER: up(1)" in retstruct
+    assert intf_user_config(ops1, "admin") == 'up'
+    assert port_admin(ops1) == 'up'
+
+
+@mark.platform_incompatible(['docker'])
+def test_snmpset_ft_interfaces(topology, step):
+    ops1 = topology.get("ops1")
+    assert ops1 is not None
+
+    config(ops1)
+    sleep(30)
+
+    step("SET of ifAdminStatus and ifAlias is committed to OVSDB")
+    snmpset_commit(ops1)
+
+    step("ifAdminStatus testing(3) is rejected with wrongValue")
+    snmpset_testing_rejected(ops1)
+
+    step("read-only columns return notWritable")
+    snmpset_not_writable(ops1)
+
+    step("a failing varbind leaves OVSDB untouched")
+    snmpset_failed_varbind_keeps_ovsdb(ops1)
+
+    step("ifTable and ifXTable columns of one PDU are applied together")
+    snmpset_mixed_tables(ops1)
+
+    unconfig(ops1)
@@ -0,0 +1,167 @@
+# -*- coding: utf-8 -*-
+# (C) Copyright 2016 Hewlett Packard Enterprise Development LP
+# All Rights Reserved.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License"); you may
+#    not use this file except in compliance with the License. You may obtain
+#    a copy of the License at
+#
+#         http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+#    WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+#    License for the specific language governing permissions and limitations
+#    under the License.
+#
+##########################################################################
+
+"""
+OpenSwitch Test for ifOperStatus, ifLastChange, ifTableLastChange and the
+linkUp/linkDown notifications.
+"""
+
+import re
+from pytest import mark
+from time import sleep
+
+
+TOPOLOGY = """
+# +-------+
+# |       |     +--------+
+# |  hs1  <----->  ops1  |
+# |       |     +--------+
+# +-------+
+
+# Nodes
+[type=openswitch name="OpenSwitch 1"] ops1
+[type=host name="Host 1"] hs1
+
+# Ports
+[force_name=oobm] ops1:sp1
+
+# Links
+hs1:1 -- ops1:sp1
+"""
+
+TRAP_LOG = "/tmp/snmptrapd.log"
+
+
+def snmp_get(ops1, oid):
+    return ops1("snmpget -v2c -cpublic localhost " + oid, shell='bash')
+
+
+def timeticks(retstruct):
+    match = re.search(r"Timeticks: \((\d+)\)", retstruct)
+    assert match is not None, retstruct
+    return int(match.group(1))
+
+
+def oper_status(ops1):
+    return snmp_get(ops1, "IF-MIB::ifOperStatus.1")
+
+
+def config(ops1, hs1):
+    with ops1.libs.vtysh.ConfigInterfaceMgmt() as ctx:
+        ctx.ip_static("10.10.10.4/24")
+    hs1.libs.ip.interface('1', addr='10.10.10.5/24', up=True)
+
+    sleep(3)
+    ping = hs1.libs.ping.ping(1, '10.10.10.4')
+    assert ping['transmitted'] == ping['received']
+
+    # hs1 receives the notifications.
+    hs1("snmptrapd -f -Lf " + TRAP_LOG + " --disableAuthorization=yes "
+        "udp:162 &")
+    ops1("configure terminal")
+    ops1("snmp-server host 10.10.10.5 trap version v2c")
+    ops1("end")
+
+    with ops1.libs.vtysh.ConfigInterface('1') as ctx:
+        ctx.no_shutdown()
+
+
+def unconfig(ops1, hs1):
+    with ops1.libs.vtysh.ConfigInterface('1') as ctx:
+        ctx.shutdown()
+
+    ops1("configure terminal")
+    ops1("no snmp-server host 10.10.10.5 trap version v2c")
+    ops1("end")
+    hs1("pkill snmptrapd")
+
+
+def link_down_up(ops1, hs1):
+    assert "up(1)" in oper_status(ops1)
+    before = timeticks(snmp_get(ops1, "IF-MIB::ifLastChange.1"))
+
+    with ops1.libs.vtysh.ConfigInterface('1') as ctx:
+        ctx.shutdown()
+    sleep(2)
+
+    # Served from the link state, not the next counters refresh.
+    assert "down(2)" in oper_status(ops1)
+    assert "down(2)" in snmp_get(ops1, "IF-MIB::ifAdminStatus.1")
+    down = timeticks(snmp_get(ops1, "IF-MIB::ifLastChange.1"))
+    assert down > before
+
+    with ops1.libs.vtysh.ConfigInterface('1') as ctx:
+        ctx.no_shutdown()
+    sleep(2)
+
+    assert "up(1)" in oper_status(ops1)
+    up = timeticks(snmp_get(ops1, "IF-MIB::ifLastChange.1"))
+    assert up > down
+
+    traps = hs1("cat " + TRAP_LOG)
+    assert "linkDown" in traps
+    assert "linkUp" in traps
+
+
+def table_last_change(ops1):
+    before = timeticks(snmp_get(ops1, "IF-MIB::ifTableLastChange.0"))
+
+    # A subinterface adds a row to ifTable.
+    ops1("configure terminal")
+    ops1("interface 1.10")
+    ops1("no shutdown")
+    ops1("end")
+    sleep(10)
+    added = timeticks(snmp_get(ops1, "IF-MIB::ifTableLastChange.0"))
+    assert added > before
+
+    ops1("configure terminal")
+    ops1("no interface 1.10")
+    ops1("end")
+    sleep(10)
+    removed = timeticks(snmp_get(ops1, "IF-MIB::ifTableLastChange.0"))
+    assert removed > added
+
+    # A change of state is not a change of the table.
+    with ops1.libs.vtysh.ConfigInterface('1') as ctx:
+        ctx.shutdown()
+    sleep(10)
+    assert timeticks(snmp_get(ops1, "IF-MIB::ifTableLastChange.0")) == \
+        removed
+    with ops1.libs.vtysh.ConfigInterface('1') as ctx:
+        ctx.no_shutdown()
+
+
+@mark.platform_incompatible(['docker'])
+def test_snmptrap_ft_interfaces(topology, step):
+    ops1 = topology.get("ops1")
+    hs1 = topology.get("hs1")
+    assert ops1 is not None
+    assert hs1 is not None
+
+    config(ops1, hs1)
+    sleep(30)
+
+    step("shutdown and no shutdown move ifOperStatus and ifLastChange "
+         "and send linkDown and linkUp")
+    link_down_up(ops1, hs1)
+
+    step("adding and removing a row moves ifTableLastChange")
+    table_last_change(ops1)
+
+    unconfig(ops1, hs1)
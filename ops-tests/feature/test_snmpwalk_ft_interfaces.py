@@ -20,6 +20,7 @@
 OpenSwitch Test for interface table related SNMP operations.
 """
 
+import re
 from pytest import mark
 from time import sleep
 
@@ -319,6 +320,59 @@ def snmpwalk_v3_test_remote(ops1, hs1):
         assert "Timeout: No Response" not in line, "snmpwalk timed out"
 
 
+def if_names(ops1):
+    # ifDescr is empty, ifName carries the interface name.
+    retstruct = snmp_walk(ops1, "v2c", "public", "localhost", "ifName")
+    names = {}
+    for line in retstruct.splitlines():
+        match = re.match(r"IF-MIB::ifName\.(\d+) = STRING: (\S+)", line)
+        if match:
+            names[int(match.group(1))] = match.group(2)
+    return names
+
+
+def split_interface(ops1, name, command):
+    # The split commands ask for a confirmation.
+    ops1('configure terminal')
+    ops1('interface ' + name)
+    ops1._shells['vtysh']._prompt = ('.*Do you want to continue [y/n]?')
+    ops1(command)
+    ops1._shells['vtysh']._prompt = ('(^|\n)switch(\\([\\-a-zA-Z0-9]*\\))?#')
+    ops1('y')
+    ops1('end')
+
+
+def snmpwalk_ifindex_registry(ops1):
+    split_interface(ops1, '49', 'split')
+    ops1('configure terminal')
+    ops1('interface 1.10')
+    ops1('no shutdown')
+    ops1('end')
+    sleep(10)
+
+    before = if_names(ops1)
+    by_name = dict((name, index) for index, name in before.items())
+
+    # Ports keep their number, the other interfaces are listed too.
+    assert before.get(1) == '1'
+    for name in ('49-1', '49-2', '49-3', '49-4', '1.10'):
+        assert name in by_name, "%s not in ifTable" % name
+        assert by_name[name] >= 1000
+
+    # The indexes survive a restart of snmpd.
+    ops1("systemctl restart snmpd", shell='bash')
+    sleep(30)
+    after = if_names(ops1)
+    for index, name in before.items():
+        assert after.get(index) == name, \
+            "ifIndex %d was %s, is %s" % (index, name, after.get(index))
+
+    ops1('configure terminal')
+    ops1('no interface 1.10')
+    ops1('end')
+    split_interface(ops1, '49', 'no split')
+
+
 @mark.platform_incompatible(['docker'])
 def test_snmpwalk_ft_interfaces(topology, step):
 
@@ -332,4 +386,5 @@ def test_snmpwalk_ft_interfaces(topology, step):
     snmpwalk_v1_test_remote(hs1)
     snmpwalk_v2c_test_remote(hs1)
     snmpwalk_v3_test_remote(ops1, hs1)
+    snmpwalk_ifindex_registry(ops1)
     unconfig(ops1, hs1)
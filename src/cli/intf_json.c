@@ -0,0 +1,223 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/****************************************************************************
+ * @ingroup cli
+ *
+ * @file intf_json.c
+ * Streaming JSON encoder for the "json" modifier of the show commands.
+ *
+ ***************************************************************************/
+
+#include <ctype.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "dynamic-string.h"
+#include "util.h"
+#include "intf_json.h"
+
+void
+intf_json_init(struct intf_json *json, struct ds *out)
+{
+    memset(json, 0, sizeof *json);
+    json->out = out;
+} /* intf_json_init */
+
+static void
+json_put_string(struct ds *out, const char *s)
+{
+    ds_put_char(out, '"');
+    for (; *s; s++) {
+        unsigned char c = *s;
+
+        switch (c) {
+        case '"':
+            ds_put_cstr(out, "\\\"");
+            break;
+        case '\\':
+            ds_put_cstr(out, "\\\\");
+            break;
+        case '\n':
+            ds_put_cstr(out, "\\n");
+            break;
+        case '\r':
+            ds_put_cstr(out, "\\r");
+            break;
+        case '\t':
+            ds_put_cstr(out, "\\t");
+            break;
+        default:
+            if (c < 0x20) {
+                ds_put_format(out, "\\u%04x", c);
+            } else {
+                ds_put_char(out, c);
+            }
+            break;
+        }
+    }
+    ds_put_char(out, '"');
+} /* json_put_string */
+
+/* Writes what precedes a value: the separator, the line break of a
+ * top-level element and the member name. */
+static void
+json_begin_value(struct intf_json *json, const char *name)
+{
+    struct ds *out = json->out;
+
+    if (json->has_values[json->depth]) {
+        ds_put_char(out, ',');
+    }
+    json->has_values[json->depth] = true;
+    if (json->depth == 1) {
+        ds_put_char(out, '\n');
+    }
+    if (name) {
+        json_put_string(out, name);
+        ds_put_char(out, ':');
+    }
+} /* json_begin_value */
+
+static void
+json_open(struct intf_json *json, const char *name, char c)
+{
+    ovs_assert(json->depth + 1 < INTF_JSON_MAX_DEPTH);
+
+    json_begin_value(json, name);
+    ds_put_char(json->out, c);
+    json->depth++;
+    json->has_values[json->depth] = false;
+} /* json_open */
+
+static void
+json_close(struct intf_json *json, char c)
+{
+    ovs_assert(json->depth > 0);
+
+    if (json->depth == 1 && json->has_values[1]) {
+        ds_put_char(json->out, '\n');
+    }
+    json->depth--;
+    ds_put_char(json->out, c);
+    if (!json->depth) {
+        ds_put_char(json->out, '\n');
+    }
+} /* json_close */
+
+void
+intf_json_object_start(struct intf_json *json, const char *name)
+{
+    json_open(json, name, '{');
+} /* intf_json_object_start */
+
+void
+intf_json_object_end(struct intf_json *json)
+{
+    json_close(json, '}');
+} /* intf_json_object_end */
+
+void
+intf_json_array_start(struct intf_json *json, const char *name)
+{
+    json_open(json, name, '[');
+} /* intf_json_array_start */
+
+void
+intf_json_array_end(struct intf_json *json)
+{
+    json_close(json, ']');
+} /* intf_json_array_end */
+
+void
+intf_json_string(struct intf_json *json, const char *name, const char *value)
+{
+    json_begin_value(json, name);
+    if (value) {
+        json_put_string(json->out, value);
+    } else {
+        ds_put_cstr(json->out, "null");
+    }
+} /* intf_json_string */
+
+void
+intf_json_int(struct intf_json *json, const char *name, int64_t value)
+{
+    json_begin_value(json, name);
+    ds_put_format(json->out, "%"PRId64, value);
+} /* intf_json_int */
+
+void
+intf_json_bool(struct intf_json *json, const char *name, bool value)
+{
+    json_begin_value(json, name);
+    ds_put_cstr(json->out, value ? "true" : "false");
+} /* intf_json_bool */
+
+/* Returns true if 's' is a number in JSON syntax. */
+static bool
+json_is_number(const char *s)
+{
+    const char *p = s;
+
+    if (*p == '-') {
+        p++;
+    }
+    if (*p == '0') {
+        p++;
+    } else if (isdigit((unsigned char) *p)) {
+        while (isdigit((unsigned char) *p)) {
+            p++;
+        }
+    } else {
+        return false;
+    }
+
+    if (*p == '.') {
+        p++;
+        if (!isdigit((unsigned char) *p)) {
+            return false;
+        }
+        while (isdigit((unsigned char) *p)) {
+            p++;
+        }
+    }
+
+    if (*p == 'e' || *p == 'E') {
+        p++;
+        if (*p == '+' || *p == '-') {
+            p++;
+        }
+        if (!isdigit((unsigned char) *p)) {
+            return false;
+        }
+        while (isdigit((unsigned char) *p)) {
+            p++;
+        }
+    }
+
+    return *p == '\0';
+} /* json_is_number */
+
+void
+intf_json_reading(struct intf_json *json, const char *name, const char *value)
+{
+    if (value && json_is_number(value)) {
+        json_begin_value(json, name);
+        ds_put_cstr(json->out, value);
+    } else {
+        intf_json_string(json, name, value);
+    }
+} /* intf_json_reading */
@@ -0,0 +1,86 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/****************************************************************************
+ * @ingroup cli
+ *
+ * @file intf_out.c
+ * Output builder for the long show commands.
+ *
+ * Only vty_out() and libovscommon are used, so the output benchmark links
+ * this file with a vty_out() of its own.
+ *
+ ***************************************************************************/
+
+#include <stdarg.h>
+#include <stdbool.h>
+
+#include "vtysh/vty.h"
+#include "dynamic-string.h"
+#include "intf_out.h"
+
+static struct ds intf_out_buf = DS_EMPTY_INITIALIZER;
+static bool intf_out_active;
+
+void
+intf_out_flush(struct vty *vty)
+{
+    if (intf_out_buf.length) {
+        vty_out(vty, "%s", ds_cstr(&intf_out_buf));
+        ds_clear(&intf_out_buf);
+    }
+}
+
+void
+intf_out(struct vty *vty, const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    ds_put_format_valist(&intf_out_buf, format, args);
+    va_end(args);
+
+    if (!intf_out_active) {
+        intf_out_flush(vty);
+    }
+}
+
+void
+intf_out_begin(void)
+{
+    intf_out_active = true;
+}
+
+/* Ends an interface block; writes the buffer if a chunk is full. */
+void
+intf_out_block_end(struct vty *vty)
+{
+    if (intf_out_buf.length >= INTF_OUT_CHUNK) {
+        intf_out_flush(vty);
+    }
+}
+
+void
+intf_out_end(struct vty *vty)
+{
+    intf_out_flush(vty);
+    intf_out_active = false;
+}
+
+struct ds *
+intf_out_buffer(void)
+{
+    return &intf_out_buf;
+}
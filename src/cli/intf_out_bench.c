@@ -0,0 +1,287 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/****************************************************************************
+ * @ingroup cli
+ *
+ * @file intf_out_bench.c
+ * Micro-benchmark for the buffered "show interface" output.
+ *
+ * Renders the "show interface" text of N synthetic interfaces twice
+ * through intf_out.c, the code the CLI uses: once outside of
+ * intf_out_begin()/intf_out_end(), where every intf_out() call is written
+ * straight through as vty_out() would, and once buffered and flushed in
+ * INTF_OUT_CHUNK sized chunks at interface block boundaries.  vty_out() is
+ * replaced by one write(2) per call to a temporary file, and both outputs
+ * are checked to be byte-identical.
+ *
+ * Usage: intf_out_bench [-n INTERFACES] [-r ROUNDS]
+ *
+ * Run it with "make bench-intf-out".
+ *
+ ***************************************************************************/
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "vtysh/vty.h"
+#include "util.h"
+#include "intf_out.h"
+
+#define BENCH_DEFAULT_INTERFACES    512
+#define BENCH_DEFAULT_ROUNDS        50
+
+#define NEWLINE                     "\n"
+
+/* Where vty_out() writes, and how often it did. */
+static int bench_fd = -1;
+static unsigned long bench_writes;
+
+/* Stands in for vtysh's vty_out(), with one write per call. */
+int
+vty_out(struct vty *vty, const char *format, ...)
+{
+    va_list args;
+    char *data;
+    size_t len;
+    int n;
+
+    va_start(args, format);
+    data = xvasprintf(format, args);
+    va_end(args);
+    n = strlen(data);
+
+    for (len = n; len; ) {
+        ssize_t written = write(bench_fd, data + (n - len), len);
+
+        if (written < 0) {
+            perror("intf_out_bench: write");
+            exit(EXIT_FAILURE);
+        }
+        len -= written;
+    }
+    bench_writes++;
+    free(data);
+
+    return n;
+} /* vty_out */
+
+/* One "show interface" block, with the fields and formats of
+ * cli_show_interface_exec() and show_interface_stats(). */
+static void
+bench_render_interface(unsigned int port)
+{
+    int64_t base = (int64_t) port * 1000003;
+    bool up = port % 3 != 0;
+
+    intf_out(NULL, "Interface %u is ", port);
+    if (up) {
+        intf_out(NULL, "%s %s", "up", NEWLINE);
+        intf_out(NULL, " Admin state is up%s", NEWLINE);
+    } else {
+        intf_out(NULL, "%s ", "down");
+        intf_out(NULL, "(Administratively down) %s", NEWLINE);
+        intf_out(NULL, " Admin state is down%s", NEWLINE);
+        intf_out(NULL, " State information: %s%s", "admin_down", NEWLINE);
+    }
+    intf_out(NULL, " Hardware: Ethernet, MAC Address: %s %s",
+             "70:72:cf:fd:e9:26", NEWLINE);
+    intf_out(NULL, " MTU %" PRIi64 " %s", (int64_t) 1500, NEWLINE);
+    intf_out(NULL, " Full-duplex %s", NEWLINE);
+    intf_out(NULL, " qos trust %s%s", "none", NEWLINE);
+    intf_out(NULL, " qos queue-profile %s%s", "default", NEWLINE);
+    intf_out(NULL, " qos schedule-profile %s%s", "default", NEWLINE);
+    intf_out(NULL, " Speed %" PRIi64 " Mb/s %s",
+             (int64_t) (up ? 10000 : 0), NEWLINE);
+    intf_out(NULL, " Auto-Negotiation is turned on %s", NEWLINE);
+    intf_out(NULL, " Input flow-control is off, "
+             "output flow-control is off%s", NEWLINE);
+
+    intf_out(NULL, " RX%s", NEWLINE);
+    intf_out(NULL, "   %10" PRIi64 " input packets  ", base);
+    intf_out(NULL, "   %10" PRIi64 " bytes  ", base * 64);
+    intf_out(NULL, "%s", NEWLINE);
+    intf_out(NULL, "   %10" PRIi64 " input error    ", base % 7);
+    intf_out(NULL, "   %10" PRIi64 " dropped  ", base % 11);
+    intf_out(NULL, "%s", NEWLINE);
+    intf_out(NULL, "   %10" PRIi64 " CRC/FCS  ", base % 5);
+    intf_out(NULL, "%s", NEWLINE);
+    intf_out(NULL, " TX%s", NEWLINE);
+    intf_out(NULL, "   %10" PRIi64 " output packets ", base / 2);
+    intf_out(NULL, "   %10" PRIi64 " bytes  ", base * 32);
+    intf_out(NULL, "%s", NEWLINE);
+    intf_out(NULL, "   %10" PRIi64 " input error    ", base % 3);
+    intf_out(NULL, "   %10" PRIi64 " dropped  ", base % 13);
+    intf_out(NULL, "%s", NEWLINE);
+    intf_out(NULL, "   %10" PRIi64 " collision  ", (int64_t) 0);
+    intf_out(NULL, "%s", NEWLINE);
+    intf_out(NULL, "%s", NEWLINE);
+
+    intf_out_block_end(NULL);
+} /* bench_render_interface */
+
+/* The loop of cli_show_interface_exec(). */
+static void
+bench_render(bool buffered, unsigned int n_intfs)
+{
+    unsigned int port;
+
+    if (buffered) {
+        intf_out_begin();
+    }
+    intf_out(NULL, "%s", NEWLINE);
+    for (port = 1; port <= n_intfs; port++) {
+        bench_render_interface(port);
+    }
+    if (buffered) {
+        intf_out_end(NULL);
+    }
+} /* bench_render */
+
+static uint64_t
+bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+} /* bench_now_ns */
+
+/* Renders 'rounds' times into a fresh temporary file, reports the time per
+ * rendering and returns the file, holding the output of the last round. */
+static FILE *
+bench_run(const char *method, bool buffered, unsigned int n_intfs,
+          unsigned rounds)
+{
+    uint64_t start, elapsed;
+    FILE *file = NULL;
+    unsigned r;
+
+    bench_writes = 0;
+    elapsed = 0;
+    for (r = 0; r < rounds; r++) {
+        if (file) {
+            fclose(file);
+        }
+        file = tmpfile();
+        if (!file) {
+            perror("intf_out_bench: tmpfile");
+            exit(EXIT_FAILURE);
+        }
+        bench_fd = fileno(file);
+
+        start = bench_now_ns();
+        bench_render(buffered, n_intfs);
+        elapsed += bench_now_ns() - start;
+    }
+
+    printf("%-12s %8u %8u %12.1f %10lu\n", method, n_intfs, rounds,
+           elapsed / 1e3 / rounds, bench_writes / rounds);
+
+    return file;
+} /* bench_run */
+
+static bool
+bench_same_output(FILE *a, FILE *b)
+{
+    int ca, cb;
+
+    rewind(a);
+    rewind(b);
+    do {
+        ca = getc(a);
+        cb = getc(b);
+        if (ca != cb) {
+            return false;
+        }
+    } while (ca != EOF);
+
+    return true;
+} /* bench_same_output */
+
+static void
+usage(const char *program_name)
+{
+    printf("%s: buffered show interface output micro-benchmark\n"
+           "usage: %s [OPTIONS]\n"
+           "\nOptions:\n"
+           "  -n, --interfaces=N      interfaces to render (default: %d)\n"
+           "  -r, --rounds=N          renderings per method (default: %d)\n"
+           "  -h, --help              display this help message\n",
+           program_name, program_name, BENCH_DEFAULT_INTERFACES,
+           BENCH_DEFAULT_ROUNDS);
+} /* usage */
+
+int
+main(int argc, char *argv[])
+{
+    static const struct option long_options[] = {
+        {"interfaces", required_argument, NULL, 'n'},
+        {"rounds",     required_argument, NULL, 'r'},
+        {"help",       no_argument,       NULL, 'h'},
+        {NULL,         0,                 NULL, 0},
+    };
+    unsigned int n_intfs = BENCH_DEFAULT_INTERFACES;
+    unsigned rounds = BENCH_DEFAULT_ROUNDS;
+    FILE *direct, *buffered;
+    bool same;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "n:r:h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'n':
+            n_intfs = strtoul(optarg, NULL, 10);
+            break;
+        case 'r':
+            rounds = strtoul(optarg, NULL, 10);
+            break;
+        case 'h':
+            usage(argv[0]);
+            return EXIT_SUCCESS;
+        default:
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (!n_intfs || !rounds) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    printf("%-12s %8s %8s %12s %10s\n", "method", "intfs", "rounds",
+           "us/show", "writes");
+
+    direct = bench_run("unbuffered", false, n_intfs, rounds);
+    buffered = bench_run("buffered", true, n_intfs, rounds);
+
+    same = bench_same_output(direct, buffered);
+    fclose(direct);
+    fclose(buffered);
+    if (!same) {
+        fprintf(stderr, "intf_out_bench: buffered output differs\n");
+        return EXIT_FAILURE;
+    }
+    printf("output identical for %u interfaces\n", n_intfs);
+
+    return EXIT_SUCCESS;
+} /* main */
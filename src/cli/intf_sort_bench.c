@@ -0,0 +1,330 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/****************************************************************************
+ * @ingroup cli
+ *
+ * @file intf_sort_bench.c
+ * Micro-benchmark for the CLI interface name sort.
+ *
+ * A shuffled set of physical, split, subinterface, VLAN, LAG and
+ * loopback names is sorted with the precomputed keys of intf_sort.c and
+ * with the previous string comparator, which is kept here as the
+ * reference.  Both orders are checked to be identical.
+ *
+ * Usage: intf_sort_bench [-n NAMES] [-r ROUNDS]
+ *
+ * Run it with "make bench-intf-sort".
+ *
+ ***************************************************************************/
+
+#include <ctype.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "intf_sort.h"
+
+#define BENCH_DEFAULT_NAMES     10000
+#define BENCH_DEFAULT_ROUNDS    20
+#define BENCH_NAME_SIZE         64
+
+/* Reference comparator, as used by sort_interface() before the sort keys.
+ * Every call may allocate and run sscanf(). */
+static char *
+ref_extract_intf_type(const char *intf_name)
+{
+    const char *p = intf_name;
+    int count = 0;
+    char *intf_type;
+
+    while (*p && !isdigit((unsigned char) *p)) {
+        p++;
+        count++;
+    }
+    intf_type = malloc(count + 1);
+    if (!intf_type) {
+        fprintf(stderr, "intf_sort_bench: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    strncpy(intf_type, intf_name, count);
+    intf_type[count] = '\0';
+
+    return intf_type;
+} /* ref_extract_intf_type */
+
+static unsigned long
+ref_extract_tag(const char *intf_name)
+{
+    unsigned long val = 0;
+    const char *p;
+
+    for (p = intf_name; *p; p++) {
+        if (isdigit((unsigned char) *p)) {
+            val = val * 10 + (*p - '0');
+        }
+    }
+
+    return val;
+} /* ref_extract_tag */
+
+static int
+ref_compare_names(const char *name1, const char *name2)
+{
+    char *type1 = ref_extract_intf_type(name1);
+    char *type2 = ref_extract_intf_type(name2);
+    int cmp = strcmp(type1, type2);
+    unsigned long tag1, tag2;
+
+    free(type1);
+    free(type2);
+    if (cmp) {
+        return cmp < 0 ? -1 : 1;
+    }
+
+    tag1 = ref_extract_tag(name1);
+    tag2 = ref_extract_tag(name2);
+    return tag1 == tag2 ? 0 : tag1 < tag2 ? -1 : 1;
+} /* ref_compare_names */
+
+static int
+ref_compare_numbers(const char *name1, const char *name2)
+{
+    unsigned int id1 = 0, id2 = 0, ext1 = 0, ext2 = 0;
+    unsigned long tag1 = 0, tag2 = 0;
+
+    sscanf(name1, "%u-%u.%lu", &id1, &ext1, &tag1);
+    sscanf(name2, "%u-%u.%lu", &id2, &ext2, &tag2);
+
+    if (strchr(name1, '.') && !strchr(name1, '-')) {
+        sscanf(name1, "%u.%lu", &id1, &tag1);
+    }
+    if (strchr(name2, '.') && !strchr(name2, '-')) {
+        sscanf(name2, "%u.%lu", &id2, &tag2);
+    }
+
+    if (id1 != id2) {
+        return id1 < id2 ? -1 : 1;
+    }
+    if (ext1 != ext2) {
+        return ext1 < ext2 ? -1 : 1;
+    }
+    return tag1 == tag2 ? 0 : tag1 < tag2 ? -1 : 1;
+} /* ref_compare_numbers */
+
+static int
+ref_compare(const void *a_, const void *b_)
+{
+    const char *name1 = *(const char *const *) a_;
+    const char *name2 = *(const char *const *) b_;
+
+    if (!strcmp(name1, "bridge_normal")) {
+        return -1;
+    } else if (!strcmp(name2, "bridge_normal")) {
+        return 1;
+    }
+
+    if (isdigit((unsigned char) *name1) && isdigit((unsigned char) *name2)) {
+        return ref_compare_numbers(name1, name2);
+    } else if (isdigit((unsigned char) *name1)) {
+        return -1;
+    } else if (isdigit((unsigned char) *name2)) {
+        return 1;
+    }
+    return ref_compare_names(name1, name2);
+} /* ref_compare */
+
+static uint64_t
+bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+
+} /* bench_now_ns */
+
+static void *
+bench_xmalloc(size_t size)
+{
+    void *p = malloc(size ? size : 1);
+
+    if (!p) {
+        fprintf(stderr, "intf_sort_bench: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+} /* bench_xmalloc */
+
+/* Fills 'names' with 'n' distinct names: about a third physical ports,
+ * with every fourth port split in four, the rest subinterfaces of those
+ * ports, plus a few VLAN, LAG and loopback interfaces and
+ * bridge_normal. */
+static void
+bench_build_names(char (*names)[BENCH_NAME_SIZE], size_t n)
+{
+    size_t i = 0, port = 1, sub = 0;
+    size_t n_phys = n / 3 + 2, n_logical = n / 20;
+
+    if (i < n) {
+        snprintf(names[i++], BENCH_NAME_SIZE, "bridge_normal");
+    }
+    while (i < n_phys) {
+        if (port % 4 == 0) {
+            int lane;
+            for (lane = 1; lane <= 4 && i < n_phys; lane++) {
+                snprintf(names[i++], BENCH_NAME_SIZE, "%zu-%d", port, lane);
+            }
+        } else {
+            snprintf(names[i++], BENCH_NAME_SIZE, "%zu", port);
+        }
+        port++;
+    }
+    while (i < n - n_logical) {
+        size_t parent = 1 + sub % (port - 1);
+        size_t tag = 1 + sub / (port - 1);
+
+        if (parent % 4 == 0) {
+            snprintf(names[i++], BENCH_NAME_SIZE, "%zu-%zu.%zu",
+                     parent, 1 + tag % 4, 1 + tag / 4);
+        } else {
+            snprintf(names[i++], BENCH_NAME_SIZE, "%zu.%zu", parent, tag);
+        }
+        sub++;
+    }
+    for (sub = 1; i < n; sub++) {
+        static const char *const prefixes[] = { "vlan", "lag", "lo" };
+        snprintf(names[i++], BENCH_NAME_SIZE, "%s%zu",
+                 prefixes[sub % 3], sub);
+    }
+
+    /* Shuffle with a fixed seed. */
+    srand(1);
+    for (i = n - 1; i > 0; i--) {
+        size_t j = (size_t) rand() % (i + 1);
+        char tmp[BENCH_NAME_SIZE];
+
+        memcpy(tmp, names[i], BENCH_NAME_SIZE);
+        memcpy(names[i], names[j], BENCH_NAME_SIZE);
+        memcpy(names[j], tmp, BENCH_NAME_SIZE);
+    }
+} /* bench_build_names */
+
+static void
+bench_report(const char *method, size_t n, unsigned rounds,
+             uint64_t elapsed_ns)
+{
+    double us_per_sort = rounds ? elapsed_ns / 1e3 / rounds : 0;
+
+    printf("%-12s %8zu %8u %14.1f\n", method, n, rounds, us_per_sort);
+} /* bench_report */
+
+static void
+usage(const char *program_name)
+{
+    printf("%s: CLI interface name sort micro-benchmark\n"
+           "usage: %s [OPTIONS]\n"
+           "\nOptions:\n"
+           "  -n, --names=N           interface names (default: %d)\n"
+           "  -r, --rounds=N          sorts per method (default: %d)\n"
+           "  -h, --help              display this help message\n",
+           program_name, program_name, BENCH_DEFAULT_NAMES,
+           BENCH_DEFAULT_ROUNDS);
+} /* usage */
+
+int
+main(int argc, char *argv[])
+{
+    static const struct option long_options[] = {
+        {"names",   required_argument, NULL, 'n'},
+        {"rounds",  required_argument, NULL, 'r'},
+        {"help",    no_argument,       NULL, 'h'},
+        {NULL,      0,                 NULL, 0},
+    };
+    size_t n = BENCH_DEFAULT_NAMES;
+    unsigned rounds = BENCH_DEFAULT_ROUNDS;
+    char (*names)[BENCH_NAME_SIZE];
+    const char **ref;
+    struct intf_sort_key *keys;
+    uint64_t start;
+    unsigned r;
+    size_t i;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "n:r:h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'n':
+            n = strtoul(optarg, NULL, 10);
+            break;
+        case 'r':
+            rounds = strtoul(optarg, NULL, 10);
+            break;
+        case 'h':
+            usage(argv[0]);
+            return EXIT_SUCCESS;
+        default:
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (n < 8 || !rounds) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    names = bench_xmalloc(n * sizeof *names);
+    ref = bench_xmalloc(n * sizeof *ref);
+    keys = bench_xmalloc(n * sizeof *keys);
+    bench_build_names(names, n);
+
+    printf("%-12s %8s %8s %14s\n", "method", "names", "rounds", "us/sort");
+
+    start = bench_now_ns();
+    for (r = 0; r < rounds; r++) {
+        for (i = 0; i < n; i++) {
+            ref[i] = names[i];
+        }
+        qsort(ref, n, sizeof *ref, ref_compare);
+    }
+    bench_report("strings", n, rounds, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (r = 0; r < rounds; r++) {
+        for (i = 0; i < n; i++) {
+            intf_sort_key_init(&keys[i], names[i], names[i]);
+        }
+        intf_sort_keys(keys, n);
+    }
+    bench_report("sort-keys", n, rounds, bench_now_ns() - start);
+
+    for (i = 0; i < n; i++) {
+        if (keys[i].data != ref[i]) {
+            fprintf(stderr, "intf_sort_bench: order differs at %zu: "
+                    "%s (keys) vs %s (strings)\n", i,
+                    (const char *) keys[i].data, ref[i]);
+            return EXIT_FAILURE;
+        }
+    }
+    printf("order identical for %zu names\n", n);
+
+    free(names);
+    free(ref);
+    free(keys);
+
+    return EXIT_SUCCESS;
+} /* main */
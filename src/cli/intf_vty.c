@@ -24,6 +24,7 @@
  */
 
 #include <inttypes.h>
+#include <stdarg.h>
 #include <sys/un.h>
 #include <setjmp.h>
 #include <sys/wait.h>
@@ -42,7 +43,20 @@
 #include "vswitch-idl.h"
 #include "ovsdb-idl.h"
 #include "intf_vty.h"
+#include "intf_json.h"
+#include "intf_out.h"
+#include "intf_sort.h"
+#include "intf_stats.h"
+#include "intfd_rates.h"
+#include "daemon.h"
+#include "dirs.h"
+#include "dynamic-string.h"
+#include "hash.h"
+#include "hmap.h"
+#include "jsonrpc.h"
 #include "smap.h"
+#include "svec.h"
+#include "unixctl.h"
 #include "openvswitch/vlog.h"
 #include "openswitch-idl.h"
 #include "qos_intf.h"
@@ -69,196 +83,306 @@ static struct cmd_node interface_node =
       "%s(config-if)# ",
    };
 
-/* Extract the interface type from interface name */
-static char *
-extract_intf_type (const char *intf_name)
+static struct cmd_node interface_range_node =
+   {
+      INTERFACE_RANGE_NODE,
+      "%s(config-if-range)# ",
+   };
+
+/*
+ * Sorting function for interface
+ * on success, returns sorted interface list.
+ */
+const struct shash_node **
+sort_interface(const struct shash *sh)
 {
-    const char *p = intf_name;
-    int count = 0;
+    if (shash_is_empty(sh)) {
+        return NULL;
+    } else {
+        const struct shash_node **nodes;
+        struct intf_sort_key *keys;
+        struct shash_node *node;
 
-    while (*p) {
-        if (isdigit (*p)) {
-            break;
+        size_t i, n;
+
+        /* Parse every name once and sort the keys with integer
+         * comparisons. */
+        n = shash_count(sh);
+        keys = xmalloc(n * sizeof *keys);
+        i = 0;
+        SHASH_FOR_EACH (node, sh) {
+            intf_sort_key_init(&keys[i++], node->name, node);
         }
-        else {
-            p ++;
-            count ++;
+        ovs_assert(i == n);
+
+        intf_sort_keys(keys, n);
+
+        nodes = xmalloc(n * sizeof *nodes);
+        for (i = 0; i < n; i++) {
+            nodes[i] = keys[i].data;
         }
+        free(keys);
+        return nodes;
     }
-    char *intf_type = (char *) malloc(sizeof (char) * (count + 1));
-    strncpy (intf_type, intf_name, count);
-    intf_type[count] = '\0';
-
-    return intf_type;
 }
 
-/* Extract the interface id from the interface-name */
-static unsigned long
-extract_tag_from_intf_name (const char *intf_name)
+/*
+ * Name-keyed indexes of the Interface and Port rows.  The IDL keeps row
+ * pointers and names across row modifications, so an index is only
+ * rebuilt when rows of its table were inserted or deleted since it was
+ * last checked.  The Interface index also keeps its rows in display
+ * order, shared by the show commands and the running-config interface
+ * context, and sorted on first use after a rebuild.
+ */
+struct row_index {
+    struct shash rows;          /* Row name -> IDL row. */
+    unsigned int seqno;         /* IDL seqno of the last check. */
+    bool valid;
+};
+
+static struct row_index intf_index = {
+    SHASH_INITIALIZER(&intf_index.rows), 0, false
+};
+static const struct shash_node **intf_index_nodes;
+static bool intf_index_sorted;
+
+static struct row_index port_index = {
+    SHASH_INITIALIZER(&port_index.rows), 0, false
+};
+
+/* Returns true if 'index' may be out of date and needs the table-wide
+ * insert/delete checks. */
+static bool
+row_index_needs_check(const struct row_index *index, struct ovsdb_idl *idl)
 {
-    unsigned long val = 0;
-    const char *p = intf_name;
-    while (*p) {
-        if (isdigit(*p)) {
-             val = val*10 + (*p-'0');
-        }
-        p++;
-   }
-   return val;
+    return !index->valid || ovsdb_idl_get_seqno(idl) != index->seqno;
 }
 
-static int
-compare_both_proper_intf_names (const char *name_intf1, const char *name_intf2)
+static void
+intf_index_refresh(struct ovsdb_idl *idl)
 {
-    char *type_intf1 = extract_intf_type (name_intf1);
-    char *type_intf2 = extract_intf_type (name_intf2);
+    const struct ovsrec_interface *row;
 
-    int str_comparison_result = strcmp (type_intf1, type_intf2);
-    free(type_intf1);
-    free(type_intf2);
-    if (str_comparison_result == 0)
-    {
-        unsigned long tag_intf1 = extract_tag_from_intf_name (name_intf1);
-        unsigned long tag_intf2 = extract_tag_from_intf_name (name_intf2);
+    if (!row_index_needs_check(&intf_index, idl)) {
+        return;
+    }
 
-        if (tag_intf1 == tag_intf2)
-            return 0;
-        else if (tag_intf1 < tag_intf2)
-            return -1;
-        else
-            return 1;
-     }
-     else if (str_comparison_result < 0) {
-        return -1;
-     }
-     else {
-        return 1;
-     }
+    /* The table-wide checks need a row. */
+    row = ovsrec_interface_first(idl);
+    if (!intf_index.valid
+        || (row ? (OVSREC_IDL_ANY_TABLE_ROWS_INSERTED(row, intf_index.seqno) ||
+                   OVSREC_IDL_ANY_TABLE_ROWS_DELETED(row, intf_index.seqno))
+                : !shash_is_empty(&intf_index.rows))) {
+        shash_clear(&intf_index.rows);
+        OVSREC_INTERFACE_FOR_EACH(row, idl) {
+            shash_add(&intf_index.rows, row->name, (void *)row);
+        }
+        free(intf_index_nodes);
+        intf_index_nodes = NULL;
+        intf_index_sorted = false;
+        intf_index.valid = true;
+    }
+    intf_index.seqno = ovsdb_idl_get_seqno(idl);
 }
 
-static int
-compare_both_intf_numbers (const char *name_intf1, const char *name_intf2)
+static void
+port_index_refresh(struct ovsdb_idl *idl)
 {
-     uint id_intf1 = 0, id_intf2 = 0;
-     uint ext_id_intf1 = 0, ext_id_intf2 = 0;
-     unsigned long tag_sub_intf1 = 0, tag_sub_intf2 = 0;
-
-     /* To  handle cases like 10, 54-2, 52-1.1 etc. */
-     sscanf(name_intf1, "%d-%d.%lu", &id_intf1, &ext_id_intf1, &tag_sub_intf1);
-     sscanf(name_intf2, "%d-%d.%lu", &id_intf2, &ext_id_intf2, &tag_sub_intf2);
-
-     /* To handle cases like 10.1, 54.2 etc. */
-     if (strchr (name_intf1, '.') && !strchr (name_intf1, '-')) {
-         sscanf(name_intf1, "%d.%lu", &id_intf1, &tag_sub_intf1);
-     }
-
-     if (strchr (name_intf2, '.') && !strchr (name_intf2, '-')) {
-         sscanf(name_intf2, "%d.%lu", &id_intf2, &tag_sub_intf2);
-     }
-
-     if(id_intf1 == id_intf2)
-     {
-        if(ext_id_intf1 == ext_id_intf2)
-        {
-           /* For proper positioning of subinterfaces */
-           if (tag_sub_intf1 == tag_sub_intf2)
-               return 0;
-           else if (tag_sub_intf1 < tag_sub_intf2)
-               return -1;
-           else
-               return 1;
-        }
-        else if(ext_id_intf1 < ext_id_intf2)
-           return -1;
-        else
-           return 1;
-     }
-     else if (id_intf1 < id_intf2)
-           return -1;
-     else
-           return 1;
+    const struct ovsrec_port *row;
+
+    if (!row_index_needs_check(&port_index, idl)) {
+        return;
+    }
+
+    row = ovsrec_port_first(idl);
+    if (!port_index.valid
+        || (row ? (OVSREC_IDL_ANY_TABLE_ROWS_INSERTED(row, port_index.seqno) ||
+                   OVSREC_IDL_ANY_TABLE_ROWS_DELETED(row, port_index.seqno))
+                : !shash_is_empty(&port_index.rows))) {
+        shash_clear(&port_index.rows);
+        OVSREC_PORT_FOR_EACH(row, idl) {
+            shash_add(&port_index.rows, row->name, (void *)row);
+        }
+        port_index.valid = true;
+    }
+    port_index.seqno = ovsdb_idl_get_seqno(idl);
 }
 
-static int
-compare_only_one_proper_intf_name (const char *name1, const char *name2)
+/*
+ * Returns all Interface rows in display order, with the row in each
+ * node's data, and stores their number in 'count'.  The array belongs to
+ * the index and stays valid until the next IDL update; callers must not
+ * free it.
+ */
+const struct shash_node **
+get_sorted_interfaces(struct ovsdb_idl *idl, int *count)
 {
-     if (isdigit(*name1)) {
-         return -1;
-    }
-     else {
-         return 1;
+    intf_index_refresh(idl);
+    if (!intf_index_sorted) {
+        intf_index_nodes = sort_interface(&intf_index.rows);
+        intf_index_sorted = true;
     }
+
+    *count = shash_count(&intf_index.rows);
+    return intf_index_nodes;
+}
+
+/* Returns the Interface row named 'name', or NULL. */
+const struct ovsrec_interface *
+intf_index_find(struct ovsdb_idl *idl, const char *name)
+{
+    intf_index_refresh(idl);
+    return shash_find_data(&intf_index.rows, name);
 }
 
-/* qsort comparator function.
- * Case 1: When both interface name consists of numbers only
- *         Example: 10 and 12-1 etc.
- * Case 2: When one interface name consists of numbers and other is proper name
- *         Example: 10 and vlan20 etc.
- * Case 3: When both interface names are proper names with interface type and id
- *         Example: vlan20 and lo23 etc.
+/* Returns the Port row named 'name', or NULL. */
+const struct ovsrec_port *
+port_index_find(struct ovsdb_idl *idl, const char *name)
+{
+    port_index_refresh(idl);
+    return shash_find_data(&port_index.rows, name);
+}
+
+/*
+ * Interface name -> Port row that holds the interface under another name,
+ * i.e. its LAG.  Membership changes modify Port rows without inserting or
+ * deleting any, so the map is not tied to the IDL seqno: the running-config
+ * interface context builds it once per walk and destroys it afterwards.
  */
-int
-compare_nodes_by_interface_name_and_tag (const void *a_, const void *b_)
+static struct shash lag_member_map = SHASH_INITIALIZER(&lag_member_map);
+static bool lag_member_map_valid;
+
+void
+lag_member_map_build(struct ovsdb_idl *idl)
 {
-    const struct shash_node *const *a = a_;
-    const struct shash_node *const *b = b_;
-    char *name_intf1 = (*a)->name;
-    char *name_intf2 = (*b)->name;
+    const struct ovsrec_port *port_row;
+    size_t i;
 
-    /* bridge_normal has to be at the top */
-    if (!strcmp (name_intf1, "bridge_normal"))
-        return -1;
-    else if (!strcmp (name_intf2, "bridge_normal"))
-        return 1;
+    shash_clear(&lag_member_map);
+    OVSREC_PORT_FOR_EACH(port_row, idl) {
+        for (i = 0; i < port_row->n_interfaces; i++) {
+            const char *if_name = port_row->interfaces[i]->name;
 
-    /* Case 1 */
-    if (isdigit(*name_intf1) && isdigit(*name_intf2))
-    {
-         return compare_both_intf_numbers (name_intf1, name_intf2);
-    }
-    /* Case 2 */
-    else if (isdigit(*name_intf1) || isdigit(*name_intf2))
-    {
-        return compare_only_one_proper_intf_name (name_intf1, name_intf2);
+            /* Keep the first owner, as a scan of the Port table would. */
+            if (strcmp(if_name, port_row->name)) {
+                shash_add_once(&lag_member_map, if_name, (void *)port_row);
+            }
+        }
     }
-    /* Case 3 */
-    else
-    {
-        return compare_both_proper_intf_names (name_intf1, name_intf2);
+    lag_member_map_valid = true;
+}
+
+void
+lag_member_map_destroy(void)
+{
+    shash_clear(&lag_member_map);
+    lag_member_map_valid = false;
+}
+
+/* If the LAG membership map is built, stores the LAG of interface 'name'
+ * (or NULL) in '*lag' and returns true.  Returns false otherwise. */
+bool
+lag_member_map_lookup(const char *name, const struct ovsrec_port **lag)
+{
+    if (!lag_member_map_valid) {
+        return false;
     }
 
-    return 0;
+    *lag = shash_find_data(&lag_member_map, name);
+    return true;
 }
 
 /*
- * Sorting function for interface
- * on success, returns sorted interface list.
+ * "interface range" state.  The range context is INTERFACE_RANGE_NODE,
+ * where only the attribute commands of this file are installed: they apply
+ * to every member of the range of the vty within a single transaction.
+ * vty->index points at the name of the range, e.g. "1-4,6".
  */
-const struct shash_node **
-sort_interface(const struct shash *sh)
+#define INTF_RANGE_NAME_SIZE    256
+#define INTF_RANGE_MAX_MEMBERS  1024
+
+struct intf_range {
+    struct hmap_node node;          /* In intf_ranges, by vty. */
+    const struct vty *vty;
+    char name[INTF_RANGE_NAME_SIZE];
+    struct svec members;
+};
+
+static struct hmap intf_ranges = HMAP_INITIALIZER(&intf_ranges);
+
+static void
+intf_range_free(struct intf_range *range)
 {
-    if (shash_is_empty(sh)) {
-        return NULL;
-    } else {
-        const struct shash_node **nodes;
-        struct shash_node *node;
+    hmap_remove(&intf_ranges, &range->node);
+    svec_destroy(&range->members);
+    free(range);
+}
 
-        size_t i, n;
+/* Drops the ranges whose vty has left the range context by any way, not
+ * only "exit" or "end": another context command, Ctrl-Z, or "interface
+ * range" again.  vtysh has no hook for a node change, so every lookup
+ * sweeps. */
+static void
+intf_range_sweep(void)
+{
+    struct intf_range *range, *next;
 
-        n = shash_count(sh);
-        nodes = xmalloc(n * sizeof *nodes);
-        i = 0;
-        SHASH_FOR_EACH (node, sh) {
-            nodes[i++] = node;
+    HMAP_FOR_EACH_SAFE (range, next, node, &intf_ranges) {
+        if (range->vty->node != INTERFACE_RANGE_NODE
+            || range->vty->index != range->name) {
+            intf_range_free(range);
         }
-        ovs_assert(i == n);
+    }
+}
 
-        qsort(nodes, n, sizeof *nodes, compare_nodes_by_interface_name_and_tag);
-        return nodes;
+static struct intf_range *
+intf_range_find(const struct vty *vty)
+{
+    struct intf_range *range;
+
+    intf_range_sweep();
+    HMAP_FOR_EACH_WITH_HASH (range, node, hash_pointer(vty, 0),
+                             &intf_ranges) {
+        if (range->vty == vty) {
+            return range;
+        }
+    }
+    return NULL;
+}
+
+/* Forgets the range of 'vty', if any. */
+static void
+intf_range_leave(const struct vty *vty)
+{
+    struct intf_range *range = intf_range_find(vty);
+
+    if (range) {
+        intf_range_free(range);
+    }
+}
+
+static bool
+intf_range_is_active(const struct vty *vty)
+{
+    return vty->node == INTERFACE_RANGE_NODE;
+}
+
+/* Returns the i'th interface name of the current interface context, or
+ * NULL past the last one. */
+static const char *
+intf_context_name(const struct vty *vty, size_t i)
+{
+    if (intf_range_is_active(vty)) {
+        const struct intf_range *range = intf_range_find(vty);
+
+        return range && i < range->members.n ? range->members.names[i]
+                                             : NULL;
     }
+    return i == 0 ? vty->index : NULL;
 }
 
+#define INTF_CONTEXT_FOR_EACH_NAME(NAME, I, VTY) \
+    for ((I) = 0; ((NAME) = intf_context_name(VTY, I)) != NULL; (I)++)
 
 /*
  * CLI "shutdown"
@@ -270,6 +394,8 @@ DEFUN (cli_intf_shutdown,
         "Enable/disable an interface\n")
 {
     const struct ovsrec_interface * row = NULL;
+    const char *if_name;
+    size_t i;
     const struct ovsrec_port *port_row = NULL;
     struct ovsdb_idl_txn* status_txn = cli_do_config_start();
     enum ovsdb_idl_txn_status status;
@@ -289,9 +415,10 @@ DEFUN (cli_intf_shutdown,
         return CMD_OVSDB_FAILURE;
     }
 
-    OVSREC_INTERFACE_FOR_EACH(row, idl)
+    INTF_CONTEXT_FOR_EACH_NAME (if_name, i, vty)
     {
-        if (strcmp(row->name, (char*)vty->index) == 0)
+        row = intf_index_find(idl, if_name);
+        if (row)
         {
             smap_clone(&smap_user_config, &row->user_config);
 
@@ -308,13 +435,11 @@ DEFUN (cli_intf_shutdown,
                         OVSREC_INTERFACE_USER_CONFIG_ADMIN_DOWN);
             }
             ovsrec_interface_set_user_config(row, &smap_user_config);
-            break;
+            smap_destroy(&smap_user_config);
         }
-    }
 
-    OVSREC_PORT_FOR_EACH(port_row, idl)
-    {
-        if(strcmp(port_row->name, (char*)vty->index) == 0)
+        port_row = port_index_find(idl, if_name);
+        if (port_row)
         {
             if(vty_flags & CMD_FLAG_NO_CMD)
             {
@@ -326,14 +451,11 @@ DEFUN (cli_intf_shutdown,
                 ovsrec_port_set_admin(port_row,
                         OVSREC_INTERFACE_ADMIN_STATE_DOWN);
             }
-            break;
         }
     }
 
     status = cli_do_config_finish(status_txn);
 
-    smap_destroy(&smap_user_config);
-
     if (status == TXN_SUCCESS || status == TXN_UNCHANGED)
     {
         return CMD_SUCCESS;
@@ -366,11 +488,9 @@ dyncb_helpstr_speeds(struct cmd_token *token, struct vty *vty, \
         return;
     }
 
-    OVSREC_INTERFACE_FOR_EACH(row, idl)
+    row = intf_index_find(idl, intf_context_name(vty, 0));
+    if (row)
     {
-        if(strcmp(row->name, vty->index) != 0)
-            continue;
-
         speeds_list = smap_get(&row->hw_intf_info, "speeds");
         if (speeds_list != NULL)
         {
@@ -411,6 +531,8 @@ DEFUN_DYN_HELPSTR (cli_intf_speed,
       "\ndyncb_helpstr_40G\ndyncb_helpstr_50G\ndyncb_helpstr_100G")
 {
     const struct ovsrec_interface * row = NULL;
+    const char *if_name;
+    size_t i;
     struct ovsdb_idl_txn* status_txn = cli_do_config_start();
     enum ovsdb_idl_txn_status status;
     struct smap smap_user_config;
@@ -433,77 +555,78 @@ DEFUN_DYN_HELPSTR (cli_intf_speed,
         return CMD_OVSDB_FAILURE;
     }
 
-    OVSREC_INTERFACE_FOR_EACH(row, idl)
+    INTF_CONTEXT_FOR_EACH_NAME (if_name, i, vty)
     {
-        if (strcmp(row->name, (char*)vty->index) == 0)
+        row = intf_index_find(idl, if_name);
+        if (!row)
         {
-            if (is_parent_interface_split(row))
-            {
-                vty_out(vty,
-                        "This interface has been split. Operation"
-                        " not allowed%s", VTY_NEWLINE);
-                cli_do_config_abort (status_txn);
-                return CMD_SUCCESS;
-            }
-            smap_clone(&smap_user_config,&row->user_config);
+            continue;
+        }
 
-            if (vty_flags & CMD_FLAG_NO_CMD)
+        if (is_parent_interface_split(row))
+        {
+            vty_out(vty,
+                    "This interface has been split. Operation"
+                    " not allowed%s", VTY_NEWLINE);
+            cli_do_config_abort (status_txn);
+            return CMD_SUCCESS;
+        }
+        smap_clone(&smap_user_config,&row->user_config);
+
+        if (vty_flags & CMD_FLAG_NO_CMD)
+        {
+            smap_remove(&smap_user_config,
+                    INTERFACE_USER_CONFIG_MAP_SPEEDS);
+        }
+        else
+        {
+            if (strcmp(INTERFACE_USER_CONFIG_MAP_SPEEDS_DEFAULT,
+                    argv[0]) == 0)
             {
                 smap_remove(&smap_user_config,
                         INTERFACE_USER_CONFIG_MAP_SPEEDS);
             }
             else
             {
-                if (strcmp(INTERFACE_USER_CONFIG_MAP_SPEEDS_DEFAULT,
-                        argv[0]) == 0)
-                {
-                    smap_remove(&smap_user_config,
-                            INTERFACE_USER_CONFIG_MAP_SPEEDS);
-                }
-                else
+                speeds_list = smap_get(&row->hw_intf_info, "speeds");
+                support_flag = 0;
+                if (speeds_list != NULL)
                 {
-                    speeds_list = smap_get(&row->hw_intf_info, "speeds");
-                    support_flag = 0;
-                    if (speeds_list != NULL)
+                    cur_state = calloc(strlen(speeds_list) + 1,
+                                                       sizeof(char));
+                    strcpy(cur_state, speeds_list);
+                    tmp = strtok(cur_state, ",");
+                    while (tmp != NULL)
                     {
-                        cur_state = calloc(strlen(speeds_list) + 1,
-                                                           sizeof(char));
-                        strcpy(cur_state, speeds_list);
-                        tmp = strtok(cur_state, ",");
-                        while (tmp != NULL)
+                        if (strcmp(tmp, argv[0]) == 0)
                         {
-                            if (strcmp(tmp, argv[0]) == 0)
-                            {
-                                support_flag = 1;
-                                break;
-                            }
-                            tmp = strtok(NULL, ",");
+                            support_flag = 1;
+                            break;
                         }
-                        free(cur_state);
-                        if (support_flag == 0)
-                        {
-                            vty_out(vty, "Interface doesn't support %s (Mb/s). "
-                                        "Supported speed(s) : %s (Mb/s).%s",
-                                        argv[0], speeds_list, VTY_NEWLINE);
-                            cli_do_config_abort(status_txn);
-                            smap_destroy(&smap_user_config);
-                            return CMD_SUCCESS;
-                         }
-                            smap_replace(&smap_user_config,
-                                         INTERFACE_USER_CONFIG_MAP_SPEEDS,
-                                         argv[0]);
-                      }
-                }
+                        tmp = strtok(NULL, ",");
+                    }
+                    free(cur_state);
+                    if (support_flag == 0)
+                    {
+                        vty_out(vty, "Interface doesn't support %s (Mb/s). "
+                                    "Supported speed(s) : %s (Mb/s).%s",
+                                    argv[0], speeds_list, VTY_NEWLINE);
+                        cli_do_config_abort(status_txn);
+                        smap_destroy(&smap_user_config);
+                        return CMD_SUCCESS;
+                     }
+                        smap_replace(&smap_user_config,
+                                     INTERFACE_USER_CONFIG_MAP_SPEEDS,
+                                     argv[0]);
+                  }
             }
-            ovsrec_interface_set_user_config(row, &smap_user_config);
-            break;
         }
+        ovsrec_interface_set_user_config(row, &smap_user_config);
+        smap_destroy(&smap_user_config);
     }
 
     status = cli_do_config_finish(status_txn);
 
-    smap_destroy(&smap_user_config);
-
     if (status == TXN_SUCCESS || status == TXN_UNCHANGED)
     {
         return CMD_SUCCESS;
@@ -556,6 +679,8 @@ DEFUN_DYN_HELPSTR (cli_intf_mtu,
         "\n\ndyncb_helpstr_mtu\n")
 {
     const struct ovsrec_interface * row = NULL;
+    const char *if_name;
+    size_t i;
     enum ovsdb_idl_txn_status status;
     struct smap smap_user_config;
     struct ovsdb_idl_txn* status_txn;
@@ -586,49 +711,48 @@ DEFUN_DYN_HELPSTR (cli_intf_mtu,
         return CMD_OVSDB_FAILURE;
     }
 
-    OVSREC_INTERFACE_FOR_EACH(row, idl)
+    INTF_CONTEXT_FOR_EACH_NAME (if_name, i, vty)
     {
-        if (strcmp(row->name, (char*)vty->index) == 0)
+        row = intf_index_find(idl, if_name);
+        if (!row)
         {
-            if (is_parent_interface_split(row))
-            {
-                vty_out(vty,
-                        "This interface has been split. Operation"
-                        " not allowed%s", VTY_NEWLINE);
-                cli_do_config_abort (status_txn);
-                return CMD_SUCCESS;
-            }
-            smap_clone(&smap_user_config, &row->user_config);
+            continue;
+        }
 
-            if (vty_flags & CMD_FLAG_NO_CMD)
+        if (is_parent_interface_split(row))
+        {
+            vty_out(vty,
+                    "This interface has been split. Operation"
+                    " not allowed%s", VTY_NEWLINE);
+            cli_do_config_abort (status_txn);
+            return CMD_SUCCESS;
+        }
+        smap_clone(&smap_user_config, &row->user_config);
+
+        if (vty_flags & CMD_FLAG_NO_CMD)
+        {
+            smap_remove(&smap_user_config, INTERFACE_USER_CONFIG_MAP_MTU);
+        }
+        else
+        {
+            if (strcmp(INTERFACE_USER_CONFIG_MAP_MTU_DEFAULT,
+                    argv[0]) == 0)
             {
-                smap_remove(&smap_user_config, INTERFACE_USER_CONFIG_MAP_MTU);
+                smap_remove(&smap_user_config,
+                        INTERFACE_USER_CONFIG_MAP_MTU);
             }
             else
             {
-                if (strcmp(INTERFACE_USER_CONFIG_MAP_MTU_DEFAULT,
-                        argv[0]) == 0)
-                {
-                    smap_remove(&smap_user_config,
-                            INTERFACE_USER_CONFIG_MAP_MTU);
-                }
-                else
-                {
-                    smap_replace(&smap_user_config,
-                            INTERFACE_USER_CONFIG_MAP_MTU, argv[0]);
-                }
+                smap_replace(&smap_user_config,
+                        INTERFACE_USER_CONFIG_MAP_MTU, argv[0]);
             }
-            ovsrec_interface_set_user_config(row, &smap_user_config);
-            break;
         }
+        ovsrec_interface_set_user_config(row, &smap_user_config);
+        smap_destroy(&smap_user_config);
     }
 
     status = cli_do_config_finish(status_txn);
 
-    if (status == TXN_SUCCESS || status == TXN_UNCHANGED)
-
-        smap_destroy(&smap_user_config);
-
     if (status == TXN_SUCCESS || status == TXN_UNCHANGED)
     {
         return CMD_SUCCESS;
@@ -646,6 +770,74 @@ DEFUN_NO_FORM (cli_intf_mtu,
         "mtu",
         "Configure mtu for the interface\n");
 
+/*
+ * CLI "load-interval"
+ * default : 30 seconds
+ */
+DEFUN (cli_intf_load_interval,
+        cli_intf_load_interval_cmd,
+        "load-interval <5-300>",
+        "Configure the interval the interface rates are computed over\n"
+        "Interval in seconds (Default: 30)\n")
+{
+    const struct ovsrec_interface * row = NULL;
+    const char *if_name;
+    size_t i;
+    enum ovsdb_idl_txn_status status;
+    struct smap smap_user_config;
+    struct ovsdb_idl_txn* status_txn;
+
+    status_txn = cli_do_config_start();
+    if (status_txn == NULL)
+    {
+        VLOG_ERR(OVSDB_TXN_CREATE_ERROR);
+        cli_do_config_abort(status_txn);
+        return CMD_OVSDB_FAILURE;
+    }
+
+    INTF_CONTEXT_FOR_EACH_NAME (if_name, i, vty)
+    {
+        row = intf_index_find(idl, if_name);
+        if (!row)
+        {
+            continue;
+        }
+
+        smap_clone(&smap_user_config, &row->user_config);
+        if ((vty_flags & CMD_FLAG_NO_CMD)
+            || atoi(argv[0]) == INTFD_LOAD_INTERVAL_DEFAULT)
+        {
+            smap_remove(&smap_user_config,
+                        INTFD_USER_CONFIG_MAP_LOAD_INTERVAL);
+        }
+        else
+        {
+            smap_replace(&smap_user_config,
+                         INTFD_USER_CONFIG_MAP_LOAD_INTERVAL, argv[0]);
+        }
+        ovsrec_interface_set_user_config(row, &smap_user_config);
+        smap_destroy(&smap_user_config);
+    }
+
+    status = cli_do_config_finish(status_txn);
+
+    if (status == TXN_SUCCESS || status == TXN_UNCHANGED)
+    {
+        return CMD_SUCCESS;
+    }
+    else
+    {
+        VLOG_ERR(OVSDB_TXN_COMMIT_ERROR);
+    }
+
+    return CMD_OVSDB_FAILURE;
+}
+
+DEFUN_NO_FORM (cli_intf_load_interval,
+        cli_intf_load_interval_cmd,
+        "load-interval",
+        "Configure the interval the interface rates are computed over\n");
+
 
 /*
  * CLI "duplex"
@@ -659,6 +851,8 @@ DEFUN (cli_intf_duplex,
         "Configure full-duplex (Default)")
 {
     const struct ovsrec_interface * row = NULL;
+    const char *if_name;
+    size_t i;
     struct ovsdb_idl_txn* status_txn = cli_do_config_start();
     enum ovsdb_idl_txn_status status;
     struct smap smap_user_config;
@@ -677,41 +871,42 @@ DEFUN (cli_intf_duplex,
         return CMD_OVSDB_FAILURE;
     }
 
-    OVSREC_INTERFACE_FOR_EACH(row, idl)
+    INTF_CONTEXT_FOR_EACH_NAME (if_name, i, vty)
     {
-        if (strcmp(row->name, (char*)vty->index) == 0)
+        row = intf_index_find(idl, if_name);
+        if (!row)
         {
-            if (is_parent_interface_split(row))
-            {
-                vty_out(vty,
-                        "This interface has been split. Operation"
-                        " not allowed%s", VTY_NEWLINE);
-                cli_do_config_abort (status_txn);
-                return CMD_SUCCESS;
-            }
-            smap_clone(&smap_user_config, &row->user_config);
+            continue;
+        }
 
-            if ((vty_flags & CMD_FLAG_NO_CMD)
-                    || (strcmp(argv[0], "full") == 0))
-            {
-                smap_remove(&smap_user_config,
-                        INTERFACE_USER_CONFIG_MAP_DUPLEX);
-            }
-            else
-            {
-                smap_replace(&smap_user_config,
-                        INTERFACE_USER_CONFIG_MAP_DUPLEX,
-                        INTERFACE_USER_CONFIG_MAP_DUPLEX_HALF);
-            }
-            ovsrec_interface_set_user_config(row, &smap_user_config);
-            break;
+        if (is_parent_interface_split(row))
+        {
+            vty_out(vty,
+                    "This interface has been split. Operation"
+                    " not allowed%s", VTY_NEWLINE);
+            cli_do_config_abort (status_txn);
+            return CMD_SUCCESS;
+        }
+        smap_clone(&smap_user_config, &row->user_config);
+
+        if ((vty_flags & CMD_FLAG_NO_CMD)
+                || (strcmp(argv[0], "full") == 0))
+        {
+            smap_remove(&smap_user_config,
+                    INTERFACE_USER_CONFIG_MAP_DUPLEX);
         }
+        else
+        {
+            smap_replace(&smap_user_config,
+                    INTERFACE_USER_CONFIG_MAP_DUPLEX,
+                    INTERFACE_USER_CONFIG_MAP_DUPLEX_HALF);
+        }
+        ovsrec_interface_set_user_config(row, &smap_user_config);
+        smap_destroy(&smap_user_config);
     }
 
     status = cli_do_config_finish(status_txn);
 
-    smap_destroy(&smap_user_config);
-
     if (status == TXN_SUCCESS || status == TXN_UNCHANGED)
     {
         return CMD_SUCCESS;
@@ -742,6 +937,8 @@ DEFUN (cli_intf_flowcontrol,
         "Turn off flow-control (Default)\nTurn on flow-control\n")
 {
     const struct ovsrec_interface * row = NULL;
+    const char *if_name;
+    size_t i;
     struct ovsdb_idl_txn* status_txn = cli_do_config_start();
     enum ovsdb_idl_txn_status status;
     struct smap smap_user_config;
@@ -760,107 +957,108 @@ DEFUN (cli_intf_flowcontrol,
         return CMD_OVSDB_FAILURE;
     }
 
-    OVSREC_INTERFACE_FOR_EACH(row, idl)
+    INTF_CONTEXT_FOR_EACH_NAME (if_name, i, vty)
     {
-        if (strcmp(row->name, (char*)vty->index) == 0)
+        row = intf_index_find(idl, if_name);
+        if (!row)
         {
-            if (is_parent_interface_split(row))
-            {
-                vty_out(vty,
-                        "This interface has been split. Operation"
-                        " not allowed%s", VTY_NEWLINE);
-                cli_do_config_abort (status_txn);
-                return CMD_SUCCESS;
-            }
-            const char *state_value = smap_get(&row->user_config,
-                    INTERFACE_USER_CONFIG_MAP_PAUSE);
-            char new_value[INTF_NAME_SIZE] = {0};
-            smap_clone(&smap_user_config, &row->user_config);
-            if (strcmp(argv[0], "send") == 0)
+            continue;
+        }
+
+        if (is_parent_interface_split(row))
+        {
+            vty_out(vty,
+                    "This interface has been split. Operation"
+                    " not allowed%s", VTY_NEWLINE);
+            cli_do_config_abort (status_txn);
+            return CMD_SUCCESS;
+        }
+        const char *state_value = smap_get(&row->user_config,
+                INTERFACE_USER_CONFIG_MAP_PAUSE);
+        char new_value[INTF_NAME_SIZE] = {0};
+        smap_clone(&smap_user_config, &row->user_config);
+        if (strcmp(argv[0], "send") == 0)
+        {
+            if (strcmp(argv[1], "on") == 0)
             {
-                if (strcmp(argv[1], "on") == 0)
+                if ((NULL == state_value)
+                        || (strcmp(state_value,
+                                INTERFACE_USER_CONFIG_MAP_PAUSE_TX) == 0))
                 {
-                    if ((NULL == state_value)
-                            || (strcmp(state_value,
-                                    INTERFACE_USER_CONFIG_MAP_PAUSE_TX) == 0))
-                    {
-                        strcpy(new_value, INTERFACE_USER_CONFIG_MAP_PAUSE_TX);
-                    }
-                    else
-                    {
-                        strcpy(new_value,
-                                INTERFACE_USER_CONFIG_MAP_PAUSE_RXTX);
-                    }
+                    strcpy(new_value, INTERFACE_USER_CONFIG_MAP_PAUSE_TX);
                 }
-                else /* both "flowcontrol send off" and "no flowcontrol send"*/
+                else
                 {
-                    if ((NULL == state_value) ||
-                            (strcmp(state_value,
-                                    INTERFACE_USER_CONFIG_MAP_PAUSE_TX) == 0))
-                    {
-                        strcpy(new_value,
-                                INTERFACE_USER_CONFIG_MAP_PAUSE_NONE);
-                    }
-                    else
-                    {
-                        strcpy(new_value, INTERFACE_USER_CONFIG_MAP_PAUSE_RX);
-                    }
+                    strcpy(new_value,
+                            INTERFACE_USER_CONFIG_MAP_PAUSE_RXTX);
                 }
             }
-            else /* flowcontrol receive */
+            else /* both "flowcontrol send off" and "no flowcontrol send"*/
             {
-                if (strcmp(argv[1], "on") == 0)
+                if ((NULL == state_value) ||
+                        (strcmp(state_value,
+                                INTERFACE_USER_CONFIG_MAP_PAUSE_TX) == 0))
                 {
-
-                    if ((NULL == state_value)
-                            || (strcmp(state_value,
-                                    INTERFACE_USER_CONFIG_MAP_PAUSE_RX) == 0))
-                    {
-                        strcpy(new_value, INTERFACE_USER_CONFIG_MAP_PAUSE_RX);
-                    }
-                    else
-                    {
-                        strcpy(new_value,
-                                INTERFACE_USER_CONFIG_MAP_PAUSE_RXTX);
-                    }
+                    strcpy(new_value,
+                            INTERFACE_USER_CONFIG_MAP_PAUSE_NONE);
                 }
                 else
                 {
-                    /* both "flowcontrol receive off"
-                       and "no flowcontrol receive" */
-                    if ((NULL == state_value) ||
-                            (strcmp(state_value,
-                                    INTERFACE_USER_CONFIG_MAP_PAUSE_RX) == 0))
-                    {
-                        strcpy(new_value,
-                                INTERFACE_USER_CONFIG_MAP_PAUSE_NONE);
-                    }
-                    else
-                    {
-                        strcpy(new_value, INTERFACE_USER_CONFIG_MAP_PAUSE_TX);
-                    }
+                    strcpy(new_value, INTERFACE_USER_CONFIG_MAP_PAUSE_RX);
                 }
             }
-
-            if (strcmp(new_value, INTERFACE_USER_CONFIG_MAP_PAUSE_NONE) == 0)
+        }
+        else /* flowcontrol receive */
+        {
+            if (strcmp(argv[1], "on") == 0)
             {
-                smap_remove(&smap_user_config,
-                        INTERFACE_USER_CONFIG_MAP_PAUSE);
+
+                if ((NULL == state_value)
+                        || (strcmp(state_value,
+                                INTERFACE_USER_CONFIG_MAP_PAUSE_RX) == 0))
+                {
+                    strcpy(new_value, INTERFACE_USER_CONFIG_MAP_PAUSE_RX);
+                }
+                else
+                {
+                    strcpy(new_value,
+                            INTERFACE_USER_CONFIG_MAP_PAUSE_RXTX);
+                }
             }
             else
             {
-                smap_replace(&smap_user_config,
-                        INTERFACE_USER_CONFIG_MAP_PAUSE, new_value);
+                /* both "flowcontrol receive off"
+                   and "no flowcontrol receive" */
+                if ((NULL == state_value) ||
+                        (strcmp(state_value,
+                                INTERFACE_USER_CONFIG_MAP_PAUSE_RX) == 0))
+                {
+                    strcpy(new_value,
+                            INTERFACE_USER_CONFIG_MAP_PAUSE_NONE);
+                }
+                else
+                {
+                    strcpy(new_value, INTERFACE_USER_CONFIG_MAP_PAUSE_TX);
+                }
             }
-            ovsrec_interface_set_user_config(row, &smap_user_config);
-            break;
         }
+
+        if (strcmp(new_value, INTERFACE_USER_CONFIG_MAP_PAUSE_NONE) == 0)
+        {
+            smap_remove(&smap_user_config,
+                    INTERFACE_USER_CONFIG_MAP_PAUSE);
+        }
+        else
+        {
+            smap_replace(&smap_user_config,
+                    INTERFACE_USER_CONFIG_MAP_PAUSE, new_value);
+        }
+        ovsrec_interface_set_user_config(row, &smap_user_config);
+        smap_destroy(&smap_user_config);
     }
 
     status = cli_do_config_finish(status_txn);
 
-    smap_destroy(&smap_user_config);
-
     if (status == TXN_SUCCESS || status == TXN_UNCHANGED)
     {
         return CMD_SUCCESS;
@@ -892,6 +1090,8 @@ DEFUN (cli_intf_autoneg,
         "Turn off autonegotiation\nTurn on autonegotiation (Default)\n")
 {
     const struct ovsrec_interface * row = NULL;
+    const char *if_name;
+    size_t i;
     struct ovsdb_idl_txn *status_txn = cli_do_config_start();
     enum ovsdb_idl_txn_status status;
     struct smap smap_user_config;
@@ -910,48 +1110,49 @@ DEFUN (cli_intf_autoneg,
         return CMD_OVSDB_FAILURE;
     }
 
-    OVSREC_INTERFACE_FOR_EACH(row, idl)
+    INTF_CONTEXT_FOR_EACH_NAME (if_name, i, vty)
     {
-        if (strcmp(row->name, (char*)vty->index) == 0)
+        row = intf_index_find(idl, if_name);
+        if (!row)
         {
-            if (is_parent_interface_split(row))
-            {
-                vty_out(vty,
-                        "This interface has been split. Operation"
-                        " not allowed%s", VTY_NEWLINE);
-                cli_do_config_abort (status_txn);
-                return CMD_SUCCESS;
-            }
-            smap_clone(&smap_user_config, &row->user_config);
+            continue;
+        }
 
-            if (vty_flags & CMD_FLAG_NO_CMD)
+        if (is_parent_interface_split(row))
+        {
+            vty_out(vty,
+                    "This interface has been split. Operation"
+                    " not allowed%s", VTY_NEWLINE);
+            cli_do_config_abort (status_txn);
+            return CMD_SUCCESS;
+        }
+        smap_clone(&smap_user_config, &row->user_config);
+
+        if (vty_flags & CMD_FLAG_NO_CMD)
+        {
+            smap_remove(&smap_user_config,
+                    INTERFACE_USER_CONFIG_MAP_AUTONEG);
+        }
+        else
+        {
+            if (strcmp(INTERFACE_USER_CONFIG_MAP_AUTONEG_DEFAULT,
+                    argv[0]) == 0)
             {
                 smap_remove(&smap_user_config,
                         INTERFACE_USER_CONFIG_MAP_AUTONEG);
             }
             else
             {
-                if (strcmp(INTERFACE_USER_CONFIG_MAP_AUTONEG_DEFAULT,
-                        argv[0]) == 0)
-                {
-                    smap_remove(&smap_user_config,
-                            INTERFACE_USER_CONFIG_MAP_AUTONEG);
-                }
-                else
-                {
-                    smap_replace(&smap_user_config,
-                            INTERFACE_USER_CONFIG_MAP_AUTONEG, argv[0]);
-                }
+                smap_replace(&smap_user_config,
+                        INTERFACE_USER_CONFIG_MAP_AUTONEG, argv[0]);
             }
-            ovsrec_interface_set_user_config(row, &smap_user_config);
-            break;
         }
+        ovsrec_interface_set_user_config(row, &smap_user_config);
+        smap_destroy(&smap_user_config);
     }
 
     status = cli_do_config_finish(status_txn);
 
-    smap_destroy(&smap_user_config);
-
     if (status == TXN_SUCCESS || status == TXN_UNCHANGED)
     {
         return CMD_SUCCESS;
@@ -1141,80 +1342,77 @@ DEFUN (cli_intf_split,
       return CMD_OVSDB_FAILURE;
     }
 
-  OVSREC_INTERFACE_FOR_EACH(row, idl)
+  row = intf_index_find(idl, (char*)vty->index);
+  if (row)
     {
-      if (strcmp(row->name, (char*)vty->index) == 0)
-        {
-          /* if not splittable, warn */
-          const char *split_value = NULL;
-          struct smap smap_user_config;
+      /* if not splittable, warn */
+      const char *split_value = NULL;
+      struct smap smap_user_config;
 
-          smap_clone(&smap_user_config,&row->user_config);
+      smap_clone(&smap_user_config,&row->user_config);
 
-          split_value = smap_get(&row->hw_intf_info,
-                  INTERFACE_HW_INTF_INFO_MAP_SPLIT_4);
-          if ((split_value == NULL) ||
-                  (strcmp(split_value,
-                          INTERFACE_HW_INTF_INFO_MAP_SPLIT_4_TRUE) != 0))
-            {
-               vty_out(vty, "Warning: split operation only applies to"
-                       " QSFP interfaces with split capability%s",
-                       VTY_NEWLINE);
-            }
+      split_value = smap_get(&row->hw_intf_info,
+              INTERFACE_HW_INTF_INFO_MAP_SPLIT_4);
+      if ((split_value == NULL) ||
+              (strcmp(split_value,
+                      INTERFACE_HW_INTF_INFO_MAP_SPLIT_4_TRUE) != 0))
+        {
+           vty_out(vty, "Warning: split operation only applies to"
+                   " QSFP interfaces with split capability%s",
+                   VTY_NEWLINE);
+        }
+      if (vty_flags & CMD_FLAG_NO_CMD)
+        {
+          smap_remove(&smap_user_config,
+                  INTERFACE_USER_CONFIG_MAP_LANE_SPLIT);
+        }
+      else
+        {
+          smap_replace(&smap_user_config,
+                  INTERFACE_USER_CONFIG_MAP_LANE_SPLIT,
+                  INTERFACE_USER_CONFIG_MAP_LANE_SPLIT_SPLIT);
+        }
+      ovsrec_interface_set_user_config (row, &smap_user_config);
+      /* Reconfiguration should only be done when split/no split commands
+       * are entered on split parent interfaces */
+      if ((split_value != NULL) &&
+          (strcmp(split_value,
+                  INTERFACE_HW_INTF_INFO_MAP_SPLIT_4_TRUE) == 0))
+        {
           if (vty_flags & CMD_FLAG_NO_CMD)
             {
-              smap_remove(&smap_user_config,
-                      INTERFACE_USER_CONFIG_MAP_LANE_SPLIT);
+              vty_out (vty, "Warning: This will remove all L2/L3 configuration"
+                       " on child interfaces.\nDo you want to continue [y/n]? ");
             }
           else
             {
-              smap_replace(&smap_user_config,
-                      INTERFACE_USER_CONFIG_MAP_LANE_SPLIT,
-                      INTERFACE_USER_CONFIG_MAP_LANE_SPLIT_SPLIT);
+              vty_out (vty, "Warning: This will remove all L2/L3 configuration"
+                       " on parent interface.\nDo you want to continue [y/n]? ");
             }
-          ovsrec_interface_set_user_config (row, &smap_user_config);
-          /* Reconfiguration should only be done when split/no split commands
-           * are entered on split parent interfaces */
-          if ((split_value != NULL) &&
-              (strcmp(split_value,
-                      INTERFACE_HW_INTF_INFO_MAP_SPLIT_4_TRUE) == 0))
+          while (1)
             {
-              if (vty_flags & CMD_FLAG_NO_CMD)
+              scanf (" %c", &flag);
+              if (flag == 'y' || flag == 'Y')
                 {
-                  vty_out (vty, "Warning: This will remove all L2/L3 configuration"
-                           " on child interfaces.\nDo you want to continue [y/n]? ");
+                  handle_port_config (row,
+                                      (vty_flags & CMD_FLAG_NO_CMD) ? false : true);
+                  proceed = true;
+                  break;
                 }
-              else
+              else if (flag == 'n' || flag == 'N')
                 {
-                  vty_out (vty, "Warning: This will remove all L2/L3 configuration"
-                           " on parent interface.\nDo you want to continue [y/n]? ");
+                  vty_out (vty,"%s",VTY_NEWLINE);
+                  proceed = false;
+                  break;
                 }
-              while (1)
+              else
                 {
-                  scanf (" %c", &flag);
-                  if (flag == 'y' || flag == 'Y')
-                    {
-                      handle_port_config (row,
-                                          (vty_flags & CMD_FLAG_NO_CMD) ? false : true);
-                      proceed = true;
-                      break;
-                    }
-                  else if (flag == 'n' || flag == 'N')
-                    {
-                      vty_out (vty,"%s",VTY_NEWLINE);
-                      proceed = false;
-                      break;
-                    }
-                  else
-                    {
-                      vty_out (vty, "\r                                  ");
-                      vty_out (vty, "\rDo you wish to continue [y/n]? ");
-                    }
+                  vty_out (vty, "\r                                  ");
+                  vty_out (vty, "\rDo you wish to continue [y/n]? ");
                 }
             }
-          smap_destroy(&smap_user_config);
-          break;
         }
+      smap_destroy(&smap_user_config);
     }
 
   if (!proceed)
@@ -1262,7 +1460,7 @@ parse_vlan(const char *if_name, struct vty* vty)
     const struct ovsrec_port *port_row;
     int i;
 
-    port_row = port_find(if_name);
+    port_row = port_index_find(idl, if_name);
     if (port_row == NULL)
     {
         return 0;
@@ -1332,7 +1530,7 @@ parse_l3config(const char *if_name, struct vty *vty)
     const struct ovsrec_vrf *vrf_row;
     size_t i;
 
-    port_row = port_find(if_name);
+    port_row = port_index_find(idl, if_name);
     if (!port_row) {
         return 0;
     }
@@ -1698,7 +1896,7 @@ show_sflow_config(const char *name, const char *align, bool show_cmd)
         return;
     }
 
-    port_row = port_find(name);
+    port_row = port_index_find(idl, name);
     if (port_row == NULL) {
         VLOG_DBG("No port entry found for %s. Can't display sflow info on it.", name);
         return;
@@ -1711,9 +1909,9 @@ show_sflow_config(const char *name, const char *align, bool show_cmd)
         if (strcmp(value,
                    PORT_OTHER_CONFIG_SFLOW_PER_INTERFACE_VALUE_FALSE) == 0) {
             if (show_cmd) {
-                vty_out(vty, "%ssFlow is disabled%s", align, VTY_NEWLINE);
+                intf_out(vty, "%ssFlow is disabled%s", align, VTY_NEWLINE);
             } else {
-                vty_out(vty, "%sno sflow enable%s", align, VTY_NEWLINE);
+                intf_out(vty, "%sno sflow enable%s", align, VTY_NEWLINE);
             }
         }
     }
@@ -1730,7 +1928,6 @@ cli_show_run_interface_exec (struct cmd_element *self, struct vty *vty,
     const struct ovsrec_udp_bcast_forwarder_server *udp_row_serv = NULL;
     const struct ovsdb_datum *datum = NULL;
     const char *cur_state =NULL;
-    struct shash sorted_interfaces;
     bool bPrinted = false;
     size_t i = 0;
     int udp_dport = 0;
@@ -1738,14 +1935,7 @@ cli_show_run_interface_exec (struct cmd_element *self, struct vty *vty,
     const struct shash_node **nodes;
     int idx, count;
 
-    shash_init(&sorted_interfaces);
-
-    OVSREC_INTERFACE_FOR_EACH(row, idl) {
-       shash_add(&sorted_interfaces, row->name, (void *)row);
-    }
-
-    nodes = sort_interface(&sorted_interfaces);
-    count = shash_count(&sorted_interfaces);
+    nodes = get_sorted_interfaces(idl, &count);
 
     for (idx = 0; idx < count; idx++) {
 
@@ -1797,6 +1987,14 @@ cli_show_run_interface_exec (struct cmd_element *self, struct vty *vty,
             vty_out(vty, "   mtu %s %s", cur_state, VTY_NEWLINE);
         }
 
+        cur_state = smap_get(&row->user_config,
+                INTFD_USER_CONFIG_MAP_LOAD_INTERVAL);
+        if (NULL != cur_state)
+        {
+            PRINT_INT_HEADER_IN_SHOW_RUN;
+            vty_out(vty, "   load-interval %s %s", cur_state, VTY_NEWLINE);
+        }
+
         cur_state = smap_get(&row->user_config,
                 INTERFACE_USER_CONFIG_MAP_DUPLEX);
         if ((NULL != cur_state)
@@ -1807,7 +2005,8 @@ cli_show_run_interface_exec (struct cmd_element *self, struct vty *vty,
             vty_out(vty, "   duplex %s %s", cur_state, VTY_NEWLINE);
         }
 
-        const struct ovsrec_port* port_row = port_find(row->name);
+        const struct ovsrec_port* port_row = port_index_find(idl,
+                                                             row->name);
         qos_trust_port_show_running_config(port_row, &bPrinted, "interface");
         qos_apply_port_show_running_config(port_row, &bPrinted, "interface");
         qos_cos_port_show_running_config(port_row, &bPrinted, "interface");
@@ -1863,7 +2062,7 @@ cli_show_run_interface_exec (struct cmd_element *self, struct vty *vty,
             vty_out(vty, "   split %s", VTY_NEWLINE);
         }
 
-        if (port_find(row->name))
+        if (port_row)
         {
             PRINT_INT_HEADER_IN_SHOW_RUN;
         }
@@ -1942,9 +2141,6 @@ cli_show_run_interface_exec (struct cmd_element *self, struct vty *vty,
         }
     }
 
-    shash_destroy(&sorted_interfaces);
-    free(nodes);
-
     parse_lag(vty, argc, argv);
 
     return CMD_SUCCESS;
@@ -2054,12 +2250,237 @@ DEFUN (cli_intf_show_run_intf_mgmt,
     return cli_show_run_interface_mgmt_exec (self, vty);
 }
 
+/*
+ * "json" modifier of the show commands.  The renderers below take the
+ * fields of the text output straight from the IDL rows and stream them
+ * through the show output buffer, one interface per line.
+ */
+#define JSON_STR "Show the output in JSON format\n"
+
+static int64_t
+intf_json_link_speed(const struct ovsrec_interface *ifrow)
+{
+    const struct ovsdb_datum *datum;
+
+    datum = ovsrec_interface_get_link_speed(ifrow, OVSDB_TYPE_INTEGER);
+    return (datum && datum->n > 0) ? datum->keys[0].integer : 0;
+}
+
+/* Adds the state members shared by the interface renderers. */
+static void
+intf_json_put_state(struct intf_json *json,
+                    const struct ovsrec_interface *ifrow)
+{
+    const char *admin = smap_get(&ifrow->user_config,
+                                 INTERFACE_USER_CONFIG_MAP_ADMIN);
+    bool admin_up = admin && strcmp(admin,
+                                    OVSREC_INTERFACE_USER_CONFIG_ADMIN_DOWN);
+    const char *link_state = ifrow->link_state;
+
+    /* Like the text output, internal interfaces report their admin state
+     * as link state. */
+    if (!strcmp(ifrow->type, OVSREC_INTERFACE_TYPE_INTERNAL)) {
+        link_state = admin_up ? "up" : "down";
+    }
+
+    intf_json_string(json, "name", ifrow->name);
+    intf_json_string(json, "type", ifrow->type);
+    intf_json_string(json, "admin_state", admin_up ? "up" : "down");
+    intf_json_string(json, "link_state", link_state);
+    intf_json_string(json, "reason", ifrow->error);
+    intf_json_int(json, "speed_mbps", intf_json_link_speed(ifrow) / 1000000);
+}
+
+/* Adds the statistics column entries whose key starts with 'prefix' as
+ * object 'name'. */
+static void
+intf_json_put_statistics(struct intf_json *json, const char *name,
+                         const struct ovsrec_interface *ifrow,
+                         const char *prefix)
+{
+    const struct ovsdb_datum *datum;
+    size_t prefix_len = strlen(prefix);
+    size_t i;
+
+    datum = ovsrec_interface_get_statistics(ifrow, OVSDB_TYPE_STRING,
+                                            OVSDB_TYPE_INTEGER);
+    intf_json_object_start(json, name);
+    for (i = 0; datum && i < datum->n; i++) {
+        if (!strncmp(datum->keys[i].string, prefix, prefix_len)) {
+            intf_json_int(json, datum->keys[i].string,
+                          datum->values[i].integer);
+        }
+    }
+    intf_json_object_end(json);
+}
+
+static void
+show_interface_json_row(struct intf_json *json,
+                        const struct ovsrec_interface *ifrow, bool brief)
+{
+    const struct ovsrec_port *port_row = port_index_find(idl, ifrow->name);
+    const char *value;
+
+    intf_json_object_start(json, NULL);
+    intf_json_put_state(json, ifrow);
+    intf_json_string(json, "speed_config",
+                     smap_get(&ifrow->user_config,
+                              INTERFACE_USER_CONFIG_MAP_SPEEDS));
+
+    if (brief) {
+        /* Same rules as the VLAN and Mode columns of the text output. */
+        if (!port_row || (!port_row->vlan_tag && !port_row->vlan_mode)) {
+            intf_json_string(json, "vlan_id", NULL);
+            intf_json_string(json, "mode", VLAN_MODE_ROUTED);
+        } else if (port_row->vlan_tag && port_row->vlan_mode) {
+            intf_json_int(json, "vlan_id", ops_port_get_tag(port_row));
+            intf_json_string(json, "mode",
+                             !strncmp(port_row->vlan_mode,
+                                      OVSREC_PORT_VLAN_MODE_ACCESS,
+                                      strlen(OVSREC_PORT_VLAN_MODE_ACCESS))
+                             ? OVSREC_PORT_VLAN_MODE_ACCESS
+                             : OVSREC_PORT_VLAN_MODE_TRUNK);
+        } else {
+            intf_json_string(json, "vlan_id", NULL);
+            intf_json_string(json, "mode", NULL);
+        }
+        intf_json_object_end(json);
+        return;
+    }
+
+    intf_json_string(json, "mac", ifrow->mac_in_use);
+    intf_json_bool(json, "proxy_arp",
+                   port_row && smap_get(&port_row->other_config,
+                                PORT_OTHER_CONFIG_MAP_PROXY_ARP_ENABLED));
+    intf_json_bool(json, "local_proxy_arp",
+                   port_row && smap_get(&port_row->other_config,
+                                PORT_OTHER_CONFIG_MAP_LOCAL_PROXY_ARP_ENABLED));
+
+    if (strcmp(ifrow->type, OVSREC_INTERFACE_TYPE_INTERNAL)) {
+        value = smap_get(&ifrow->user_config, INTERFACE_USER_CONFIG_MAP_MTU);
+        intf_json_int(json, "mtu",
+                      atoi(value ? value
+                                 : INTERFACE_USER_CONFIG_MAP_MTU_DEFAULT));
+
+        value = smap_get(&ifrow->user_config,
+                         INTERFACE_USER_CONFIG_MAP_DUPLEX);
+        intf_json_string(json, "duplex",
+                         (!value || !strcmp(value, "full")) ? "full"
+                                                            : "half");
+
+        value = smap_get(&ifrow->user_config,
+                         INTERFACE_USER_CONFIG_MAP_AUTONEG);
+        intf_json_bool(json, "autoneg", !value || strcmp(value, "off"));
+
+        value = smap_get(&ifrow->user_config, INTERFACE_USER_CONFIG_MAP_PAUSE);
+        intf_json_bool(json, "input_flow_control",
+                       value
+                       && strcmp(value, INTERFACE_USER_CONFIG_MAP_PAUSE_NONE)
+                       && strcmp(value, INTERFACE_USER_CONFIG_MAP_PAUSE_TX));
+        intf_json_bool(json, "output_flow_control",
+                       value
+                       && strcmp(value, INTERFACE_USER_CONFIG_MAP_PAUSE_NONE)
+                       && strcmp(value, INTERFACE_USER_CONFIG_MAP_PAUSE_RX));
+    }
+
+    intf_json_put_statistics(json, "statistics", ifrow, "");
+    intf_json_object_end(json);
+}
+
+static void
+show_interface_json(struct vty *vty, const struct ovsrec_interface **rows,
+                    int n_rows, bool brief)
+{
+    struct intf_json json;
+    int idx;
+
+    intf_out_begin();
+    intf_json_init(&json, intf_out_buffer());
+    intf_json_array_start(&json, NULL);
+    for (idx = 0; idx < n_rows; idx++)
+    {
+        show_interface_json_row(&json, rows[idx], brief);
+        intf_out_block_end(vty);
+    }
+    intf_json_array_end(&json);
+    intf_out_end(vty);
+}
+
+/* Reports an error of a json mode command as {"error": "<message>"}, so
+ * that the output still parses. */
+static void __attribute__((format(printf, 2, 3)))
+show_json_error(struct vty *vty, const char *format, ...)
+{
+    struct intf_json json;
+    va_list args;
+    char *message;
+
+    va_start(args, format);
+    message = xvasprintf(format, args);
+    va_end(args);
+
+    intf_out_begin();
+    intf_json_init(&json, intf_out_buffer());
+    intf_json_object_start(&json, NULL);
+    intf_json_string(&json, "error", message);
+    intf_json_object_end(&json);
+    intf_out_end(vty);
+    free(message);
+}
+
+/* Returns true if the transceiver commands accept interface 'name'. */
+static bool
+xvr_json_interface_valid(const char *name)
+{
+    const struct ovsrec_interface *ifrow = intf_index_find(idl, name);
+
+    return ifrow && strcmp(ifrow->type, OVSREC_INTERFACE_TYPE_INTERNAL);
+}
+
+/* Adds the connector and transceiver module members of 'ifrow'.  Returns
+ * true if a module is present. */
+static bool
+xvr_json_put_module(struct intf_json *json,
+                    const struct ovsrec_interface *ifrow)
+{
+    const char *value;
+    const char *module = NULL;
+    bool pluggable;
+
+    intf_json_string(json, "name", ifrow->name);
+    intf_json_string(json, "connector",
+                     smap_get(&ifrow->hw_intf_info,
+                              INTERFACE_HW_INTF_INFO_MAP_CONNECTOR));
+    value = smap_get(&ifrow->hw_intf_info,
+                     INTERFACE_HW_INTF_INFO_MAP_SPLIT_4);
+    intf_json_bool(json, "splittable",
+                   value && !strcmp(value,
+                                    INTERFACE_HW_INTF_INFO_MAP_SPLIT_4_TRUE));
+    value = smap_get(&ifrow->hw_intf_info,
+                     INTERFACE_HW_INTF_INFO_MAP_PLUGGABLE);
+    pluggable = value && !strcmp(value,
+                                 INTERFACE_HW_INTF_INFO_MAP_PLUGGABLE_TRUE);
+    intf_json_bool(json, "pluggable", pluggable);
+
+    if (pluggable) {
+        module = smap_get(&ifrow->pm_info, INTERFACE_PM_INFO_MAP_CONNECTOR);
+        if (module && !strcmp(module,
+                              OVSREC_INTERFACE_PM_INFO_CONNECTOR_ABSENT)) {
+            module = NULL;
+        }
+    }
+    intf_json_bool(json, "module_present", module != NULL);
+    intf_json_string(json, "module", module);
+
+    return module != NULL;
+}
+
 int cli_show_xvr_exec (struct cmd_element *self, struct vty *vty,
-        int flags, int argc, const char *argv[], bool brief)
+        int flags, int argc, const char *argv[], bool brief, bool json)
 {
     const struct ovsrec_interface *ifrow = NULL;
+    struct intf_json js;
     const char *cur_state =NULL;
-    struct shash sorted_interfaces;
     const struct shash_node **nodes;
     int idx, count;
     bool validIntf = false;
@@ -2080,16 +2501,20 @@ int cli_show_xvr_exec (struct cmd_element *self, struct vty *vty,
         { NULL, NULL }
     };
 
-    shash_init(&sorted_interfaces);
-
-    OVSREC_INTERFACE_FOR_EACH(ifrow, idl)
+    if (json && (NULL != argv[0]) && !xvr_json_interface_valid(argv[0]))
     {
-        shash_add(&sorted_interfaces, ifrow->name, (void *)ifrow);
+        show_json_error(vty, "Invalid switch interface ID.");
+        return CMD_OVSDB_FAILURE;
     }
 
-    nodes = sort_interface(&sorted_interfaces);
+    nodes = get_sorted_interfaces(idl, &count);
 
-    count = shash_count(&sorted_interfaces);
+    intf_json_init(&js, intf_out_buffer());
+    if (json)
+    {
+        intf_out_begin();
+        intf_json_array_start(&js, NULL);
+    }
 
     for (idx = 0; idx < count; idx++)
     {
@@ -2107,6 +2532,25 @@ int cli_show_xvr_exec (struct cmd_element *self, struct vty *vty,
         }
         validIntf = true;
 
+        if (json)
+        {
+            int i;
+
+            intf_json_object_start(&js, NULL);
+            if (xvr_json_put_module(&js, ifrow))
+            {
+                for (i = 0; pluggable_keys[i].key != NULL; i++)
+                {
+                    intf_json_string(&js, pluggable_keys[i].key,
+                                     smap_get(&ifrow->pm_info,
+                                              pluggable_keys[i].key));
+                }
+            }
+            intf_json_object_end(&js);
+            intf_out_block_end(vty);
+            continue;
+        }
+
         if (brief)
         {
             vty_out(vty, "%s", VTY_NEWLINE);
@@ -2309,8 +2753,12 @@ int cli_show_xvr_exec (struct cmd_element *self, struct vty *vty,
         }
     }
 
-    shash_destroy(&sorted_interfaces);
-    free(nodes);
+    if (json)
+    {
+        intf_json_array_end(&js);
+        intf_out_end(vty);
+        return CMD_SUCCESS;
+    }
 
     if (validIntf)
     {
@@ -2509,14 +2957,12 @@ show_lacp_queue_stats (struct vty *vty, char* interface_queue_stats_keys[],
 }
 
 void
-show_lacp_interfaces (struct vty *vty, char* interface_statistics_keys[],
-                      const char *argv[])
+show_lacp_interfaces (struct vty *vty, const char *argv[])
 {
     const struct ovsrec_port *lag_port = NULL;
     const struct ovsrec_interface *if_row = NULL;
     const char *aggregate_mode = NULL;
     const struct ovsdb_datum *datum;
-    unsigned int index;
     const char* ipv4_address = NULL;
     const char* ipv6_address = NULL;
     int i = 0;
@@ -2525,12 +2971,10 @@ show_lacp_interfaces (struct vty *vty, char* interface_statistics_keys[],
 
     // Indexes for loops
     int interface_index = 0;
-    int stat_index = 0;
     bool lag_found = false;
 
-    // Array to keep the statistics for each lag while adding the
-    // stats for each interface in the lag.
-    uint64_t lag_statistics [12] = {0};
+    // Statistics of each lag, adding the stats of each interface in it.
+    struct intf_stats lag_statistics, if_statistics;
 
     // Aggregation-key variables
     size_t aggr_key_len = 6;
@@ -2538,8 +2982,6 @@ show_lacp_interfaces (struct vty *vty, char* interface_statistics_keys[],
 
     OVSREC_PORT_FOR_EACH(lag_port, idl)
     {
-        union ovsdb_atom atom;
-
         if ((NULL != argv[0]) && (0 != strcmp(argv[0],lag_port->name)))
         {
             continue;
@@ -2555,6 +2997,7 @@ show_lacp_interfaces (struct vty *vty, char* interface_statistics_keys[],
         vty_out(vty, " Aggregated-interfaces : ");
 
         lag_speed = 0;
+        memset(&lag_statistics, 0, sizeof lag_statistics);
         for (interface_index = 0; interface_index < lag_port->n_interfaces; interface_index++)
         {
             if_row = lag_port->interfaces[interface_index];
@@ -2566,16 +3009,9 @@ show_lacp_interfaces (struct vty *vty, char* interface_statistics_keys[],
                 lag_speed += datum->keys[0].integer;
             }
 
-            datum = ovsrec_interface_get_statistics(if_row,
-                                OVSDB_TYPE_STRING, OVSDB_TYPE_INTEGER);
-
             // Adding statistic value for each interface in the lag
-            for (stat_index = 0; stat_index < sizeof(lag_statistics)/sizeof(int64_t); stat_index++)
-            {
-                atom.string = interface_statistics_keys[stat_index];
-                index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-                lag_statistics[stat_index] += (index == UINT_MAX)? 0 : datum->values[index].integer;
-            }
+            intf_stats_from_interface(if_row, &if_statistics);
+            intf_stats_add(&lag_statistics, &if_statistics);
         }
         vty_out(vty, "%s", VTY_NEWLINE);
 
@@ -2618,27 +3054,27 @@ show_lacp_interfaces (struct vty *vty, char* interface_statistics_keys[],
         qos_dscp_port_show(lag_port, lag_port->name);
 
         vty_out(vty, " RX%s", VTY_NEWLINE);
-        vty_out(vty, "   %10" PRIu64 " input packets  ", lag_statistics[0]);
-        vty_out(vty, "   %10" PRIu64 " bytes  ",lag_statistics[1]);
+        vty_out(vty, "   %10" PRIu64 " input packets  ", lag_statistics.rx_packets);
+        vty_out(vty, "   %10" PRIu64 " bytes  ", lag_statistics.rx_bytes);
         vty_out(vty, "%s", VTY_NEWLINE);
 
-        vty_out(vty, "   %10" PRIu64 " input error    ",lag_statistics[8]);
-        vty_out(vty, "   %10" PRIu64 " dropped  ",lag_statistics[4]);
+        vty_out(vty, "   %10" PRIu64 " input error    ", lag_statistics.rx_errors);
+        vty_out(vty, "   %10" PRIu64 " dropped  ", lag_statistics.rx_dropped);
         vty_out(vty, "%s", VTY_NEWLINE);
 
-        vty_out(vty, "   %10" PRIu64 " CRC/FCS  ",lag_statistics[7]);
+        vty_out(vty, "   %10" PRIu64 " CRC/FCS  ", lag_statistics.rx_crc_err);
         vty_out(vty, "%s", VTY_NEWLINE);
         vty_out(vty, " TX%s", VTY_NEWLINE);
 
-        vty_out(vty, "   %10" PRIu64 " output packets ",lag_statistics[2]);
-        vty_out(vty, "   %10" PRIu64 " bytes  ",lag_statistics[3]);
+        vty_out(vty, "   %10" PRIu64 " output packets ", lag_statistics.tx_packets);
+        vty_out(vty, "   %10" PRIu64 " bytes  ", lag_statistics.tx_bytes);
         vty_out(vty, "%s", VTY_NEWLINE);
 
-        vty_out(vty, "   %10" PRIu64 " input error    ",lag_statistics[11]);
-        vty_out(vty, "   %10" PRIu64 " dropped  ",lag_statistics[9]);
+        vty_out(vty, "   %10" PRIu64 " input error    ", lag_statistics.tx_errors);
+        vty_out(vty, "   %10" PRIu64 " dropped  ", lag_statistics.tx_dropped);
         vty_out(vty, "%s", VTY_NEWLINE);
 
-        vty_out(vty, "   %10" PRIu64 " collision  ",lag_statistics[10]);
+        vty_out(vty, "   %10" PRIu64 " collision  ", lag_statistics.collisions);
         vty_out(vty, "%s", VTY_NEWLINE);
     }
 
@@ -2651,82 +3087,55 @@ show_lacp_interfaces (struct vty *vty, char* interface_statistics_keys[],
 }
 
 void
-show_interface_stats(struct vty *vty, const struct ovsrec_interface *ifrow,
-        char *interface_statistics_keys[])
+show_interface_stats(struct vty *vty, const struct ovsrec_interface *ifrow)
 {
     const struct ovsdb_datum *datum;
-    union ovsdb_atom atom;
-    unsigned int index;
+    struct intf_stats stats;
     bool l3_intf = (check_iface_in_vrf(ifrow->name) &&
-            port_find(ifrow->name));
+            port_index_find(idl, ifrow->name));
 
     datum = ovsrec_interface_get_statistics(ifrow, OVSDB_TYPE_STRING, OVSDB_TYPE_INTEGER);
     if (NULL==datum)
         return;
+    intf_stats_decode(datum, &stats);
 
-    vty_out(vty, " RX%s", VTY_NEWLINE);
+    intf_out(vty, " RX%s", VTY_NEWLINE);
 
-    atom.string = interface_statistics_keys[0];
-    index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-    vty_out(vty, "   %10" PRIi64 " input packets  ",
-            (index == UINT_MAX)? 0 : datum->values[index].integer);
-    atom.string = interface_statistics_keys[1];
-    index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-    vty_out(vty, "   %10" PRIi64 " bytes  ",
-            (index == UINT_MAX)? 0 : datum->values[index].integer);
-    vty_out(vty, "%s", VTY_NEWLINE);
+    intf_out(vty, "   %10" PRIu64 " input packets  ", stats.rx_packets);
+    intf_out(vty, "   %10" PRIu64 " bytes  ", stats.rx_bytes);
+    intf_out(vty, "%s", VTY_NEWLINE);
 
-    atom.string = interface_statistics_keys[8];
-    index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-    vty_out(vty, "   %10" PRIi64 " input error    ",
-            (index == UINT_MAX)? 0 : datum->values[index].integer);
-    atom.string = interface_statistics_keys[4];
-    index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-    vty_out(vty, "   %10" PRIi64 " dropped  ",
-            (index == UINT_MAX)? 0 : datum->values[index].integer);
-    vty_out(vty, "%s", VTY_NEWLINE);
+    intf_out(vty, "   %10" PRIu64 " input error    ", stats.rx_errors);
+    intf_out(vty, "   %10" PRIu64 " dropped  ", stats.rx_dropped);
+    intf_out(vty, "%s", VTY_NEWLINE);
 
-    atom.string = interface_statistics_keys[7];
-    index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-    vty_out(vty, "   %10" PRIi64 " CRC/FCS  ",
-            (index == UINT_MAX)? 0 : datum->values[index].integer);
-    vty_out(vty, "%s", VTY_NEWLINE);
+    intf_out(vty, "   %10" PRIu64 " CRC/FCS  ", stats.rx_crc_err);
+    intf_out(vty, "%s", VTY_NEWLINE);
 
-    if (l3_intf)
+    if (l3_intf) {
+        intf_out_flush(vty);
         show_l3_interface_rx_stats(vty, datum);
+    }
 
-    vty_out(vty, " TX%s", VTY_NEWLINE);
+    intf_out(vty, " TX%s", VTY_NEWLINE);
 
-    atom.string = interface_statistics_keys[2];
-    index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-    vty_out(vty, "   %10" PRIi64 " output packets ",
-            (index == UINT_MAX)? 0 : datum->values[index].integer);
-    atom.string = interface_statistics_keys[3];
-    index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-    vty_out(vty, "   %10" PRIi64 " bytes  ",
-            (index == UINT_MAX)? 0 : datum->values[index].integer);
-    vty_out(vty, "%s", VTY_NEWLINE);
+    intf_out(vty, "   %10" PRIu64 " output packets ", stats.tx_packets);
+    intf_out(vty, "   %10" PRIu64 " bytes  ", stats.tx_bytes);
+    intf_out(vty, "%s", VTY_NEWLINE);
 
-    atom.string = interface_statistics_keys[11];
-    index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-    vty_out(vty, "   %10" PRIi64 " input error    ",
-            (index == UINT_MAX)? 0 : datum->values[index].integer);
-    atom.string = interface_statistics_keys[9];
-    index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-    vty_out(vty, "   %10" PRIi64 " dropped  ",
-            (index == UINT_MAX)? 0 : datum->values[index].integer);
-    vty_out(vty, "%s", VTY_NEWLINE);
+    intf_out(vty, "   %10" PRIu64 " input error    ", stats.tx_errors);
+    intf_out(vty, "   %10" PRIu64 " dropped  ", stats.tx_dropped);
+    intf_out(vty, "%s", VTY_NEWLINE);
 
-    atom.string = interface_statistics_keys[10];
-    index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-    vty_out(vty, "   %10" PRIi64 " collision  ",
-            (index == UINT_MAX)? 0 : datum->values[index].integer);
-    vty_out(vty, "%s", VTY_NEWLINE);
+    intf_out(vty, "   %10" PRIu64 " collision  ", stats.collisions);
+    intf_out(vty, "%s", VTY_NEWLINE);
 
-    if (l3_intf)
+    if (l3_intf) {
+        intf_out_flush(vty);
         show_l3_interface_tx_stats(vty, datum);
+    }
 
-    vty_out(vty, "%s", VTY_NEWLINE);
+    intf_out(vty, "%s", VTY_NEWLINE);
 }
 
 static void
@@ -2738,7 +3147,7 @@ show_interface_status(struct vty *vty, const const struct ovsrec_interface *ifro
     {
         const struct ovsrec_port *port_row;
         port_row = port_check_and_add(ifrow->name, false, false, NULL);
-        vty_out (vty, " %-15s ", ifrow->name);
+        intf_out(vty, " %-15s ", ifrow->name);
 
         /* Display vlan mode and vid for an L3 interface,
          * port table by default is not populated unless
@@ -2746,28 +3155,28 @@ show_interface_status(struct vty *vty, const const struct ovsrec_interface *ifro
          */
         if (port_row == NULL ||
             (port_row->vlan_tag == NULL && port_row->vlan_mode == NULL)) {
-            vty_out(vty, "--      "); /*vid */
-            vty_out(vty, "eth  "); /*type */
-            vty_out(vty, "%-7s", VLAN_MODE_ROUTED);
+            intf_out(vty, "--      "); /*vid */
+            intf_out(vty, "eth  "); /*type */
+            intf_out(vty, "%-7s", VLAN_MODE_ROUTED);
         }
         /* Display vlan mode and vid for interface VLAN*/
         else if (port_row->vlan_tag != NULL && port_row->vlan_mode == NULL) {
-            vty_out(vty, "--      "); /*vid */
-            vty_out(vty, "eth  "); /*type */
-            vty_out(vty, "       "); /* mode - routed or not */
+            intf_out(vty, "--      "); /*vid */
+            intf_out(vty, "eth  "); /*type */
+            intf_out(vty, "       "); /* mode - routed or not */
         }
         /* Display vlan mode and vid for an l2 interface */
         else if (port_row->vlan_tag != NULL && port_row->vlan_mode != NULL) {
-            vty_out(vty, "%-8d", ops_port_get_tag(port_row)); /*vid */
-            vty_out(vty, "eth  "); /*type */
+            intf_out(vty, "%-8d", ops_port_get_tag(port_row)); /*vid */
+            intf_out(vty, "eth  "); /*type */
             if (strncmp(port_row->vlan_mode, OVSREC_PORT_VLAN_MODE_ACCESS,
                         strlen(OVSREC_PORT_VLAN_MODE_ACCESS)) == 0){
                 /* Default in access mode */
-                vty_out(vty, "%-7s", OVSREC_PORT_VLAN_MODE_ACCESS);
+                intf_out(vty, "%-7s", OVSREC_PORT_VLAN_MODE_ACCESS);
             }
             else {
                 /* Trunk mode - trunk, native-tagged or native-untagged*/
-                 vty_out(vty, "%-7s", OVSREC_PORT_VLAN_MODE_TRUNK);
+                 intf_out(vty, "%-7s", OVSREC_PORT_VLAN_MODE_TRUNK);
             }
         }
 
@@ -2778,23 +3187,23 @@ show_interface_status(struct vty *vty, const const struct ovsrec_interface *ifro
                         OVSREC_INTERFACE_USER_CONFIG_ADMIN_DOWN) == 0))
         {
             if(internal_if)
-                vty_out (vty, "%-6s ", "down");
+                intf_out(vty, "%-6s ", "down");
             else
-                vty_out (vty, "%-6s ", ifrow->link_state);
-            vty_out (vty, "Administratively down    ");
+                intf_out(vty, "%-6s ", ifrow->link_state);
+            intf_out(vty, "Administratively down    ");
         }
         else
         {
             if(internal_if)
-                vty_out (vty, "%-6s ", "up");
+                intf_out(vty, "%-6s ", "up");
             else
-                vty_out (vty, "%-6s ", ifrow->link_state);
-            vty_out (vty, "                         ");
+                intf_out(vty, "%-6s ", ifrow->link_state);
+            intf_out(vty, "                         ");
         }
     }
     else
     {
-        vty_out (vty, "Interface %s is ", ifrow->name);
+        intf_out(vty, "Interface %s is ", ifrow->name);
         state_value = smap_get(&ifrow->user_config,
                                INTERFACE_USER_CONFIG_MAP_ADMIN);
         if ((NULL == state_value)
@@ -2802,25 +3211,25 @@ show_interface_status(struct vty *vty, const const struct ovsrec_interface *ifro
                         OVSREC_INTERFACE_USER_CONFIG_ADMIN_DOWN) == 0)
         {
             if(internal_if)
-                vty_out (vty, "down ");
+                intf_out(vty, "down ");
             else
-                vty_out (vty, "%s ", ifrow->link_state);
-            vty_out (vty, "(Administratively down) %s", VTY_NEWLINE);
-            vty_out (vty, " Admin state is down%s",
+                intf_out(vty, "%s ", ifrow->link_state);
+            intf_out(vty, "(Administratively down) %s", VTY_NEWLINE);
+            intf_out(vty, " Admin state is down%s",
                     VTY_NEWLINE);
         }
         else
         {
             if(internal_if)
-                vty_out (vty, "up %s", VTY_NEWLINE);
+                intf_out(vty, "up %s", VTY_NEWLINE);
             else
-                vty_out (vty, "%s %s", ifrow->link_state, VTY_NEWLINE);
-            vty_out (vty, " Admin state is up%s", VTY_NEWLINE);
+                intf_out(vty, "%s %s", ifrow->link_state, VTY_NEWLINE);
+            intf_out(vty, " Admin state is up%s", VTY_NEWLINE);
         }
 
         if (ifrow->error != NULL)
         {
-            vty_out (vty, " State information: %s%s",
+            intf_out(vty, " State information: %s%s",
                     ifrow->error, VTY_NEWLINE);
         }
     }
@@ -2831,7 +3240,6 @@ cli_show_interface_queue_stats (struct cmd_element *self, struct vty *vty,
                                          int argc, const char *argv[])
 {
     const struct ovsrec_interface *ifrow = NULL;
-    struct shash sorted_interfaces;
     const struct shash_node **nodes;
     int idx, count, q = 0;
 
@@ -2843,10 +3251,12 @@ cli_show_interface_queue_stats (struct cmd_element *self, struct vty *vty,
 
     const struct ovsdb_datum *datum[QOS_QUEUE_STATS];
 
-    shash_init(&sorted_interfaces);
+    nodes = get_sorted_interfaces(idl, &count);
 
-    OVSREC_INTERFACE_FOR_EACH(ifrow, idl)
+    for (idx = 0; idx < count; idx++)
     {
+        ifrow = (const struct ovsrec_interface *)nodes[idx]->data;
+
         if ((NULL != argv[0]) && (0 != strcmp(argv[0], ifrow->name)))
         {
             continue;
@@ -2857,18 +3267,6 @@ cli_show_interface_queue_stats (struct cmd_element *self, struct vty *vty,
             continue;
         }
 
-        shash_add(&sorted_interfaces, ifrow->name, (void *)ifrow);
-    }
-
-    nodes = sort_interface(&sorted_interfaces);
-
-    count = shash_count(&sorted_interfaces);
-
-    for (idx = 0; idx < count; idx++)
-    {
-        ifrow = (const struct ovsrec_interface *)nodes[idx]->data;
-
-
         vty_out (vty, "Interface %s is %s ", ifrow->name, ifrow->link_state);
         const char *state_value = smap_get(&ifrow->user_config,
                                INTERFACE_USER_CONFIG_MAP_ADMIN);
@@ -2930,9 +3328,6 @@ cli_show_interface_queue_stats (struct cmd_element *self, struct vty *vty,
         vty_out(vty, "%s", VTY_NEWLINE);
     }
 
-    shash_destroy(&sorted_interfaces);
-    free(nodes);
-
     show_lacp_queue_stats (vty, interface_queue_stats_keys, argv);
 
     return CMD_SUCCESS;
@@ -2942,30 +3337,153 @@ void
 display_header(bool brief) {
     if (brief) {
         /* Display the brief information */
-        vty_out(vty, "%s", VTY_NEWLINE);
-        vty_out(vty, "--------------------------------------------------"
-                     "---------------------------------%s", VTY_NEWLINE);
-        vty_out(vty, "Ethernet         VLAN    Type Mode   Status  Reason  "
-                     "                 Speed    Port%s", VTY_NEWLINE);
-        vty_out(vty, "Interface                                            "
-                     "                 (Mb/s)   Ch#%s", VTY_NEWLINE);
-        vty_out(vty, "--------------------------------------------------"
-                     "---------------------------------%s", VTY_NEWLINE);
+        intf_out(vty, "%s", VTY_NEWLINE);
+        intf_out(vty, "--------------------------------------------------"
+                      "---------------------------------%s", VTY_NEWLINE);
+        intf_out(vty, "Ethernet         VLAN    Type Mode   Status  Reason  "
+                      "                 Speed    Port%s", VTY_NEWLINE);
+        intf_out(vty, "Interface                                            "
+                      "                 (Mb/s)   Ch#%s", VTY_NEWLINE);
+        intf_out(vty, "--------------------------------------------------"
+                      "---------------------------------%s", VTY_NEWLINE);
     }
     else {
-        vty_out (vty, "%s", VTY_NEWLINE);
+        intf_out(vty, "%s", VTY_NEWLINE);
+    }
+}
+
+/*
+ * Predicates of "show interface <predicate> {brief|json}".  They are
+ * checked while picking the rows to display, so interfaces that do not
+ * match never reach the formatting code.
+ */
+enum intf_show_filter_type {
+    INTF_SHOW_FILTER_STATUS,        /* Link state, as displayed. */
+    INTF_SHOW_FILTER_ERROR,         /* Interface "error" column. */
+    INTF_SHOW_FILTER_CONNECTOR,     /* hw_intf_info:connector. */
+    INTF_SHOW_FILTER_SPEED,         /* Link speed. */
+    INTF_SHOW_FILTER_LAG,           /* Member of a LAG. */
+    INTF_SHOW_FILTER_SPLIT_CHILDREN /* Children of split interfaces. */
+};
+
+struct intf_show_filter {
+    enum intf_show_filter_type type;
+    const char *value;
+    int64_t speed;                  /* INTF_SHOW_FILTER_SPEED: in b/s. */
+    char lag[INTF_NAME_SIZE];       /* INTF_SHOW_FILTER_LAG: Port name. */
+};
+
+/* Returns the "show interface transceiver" name of connector 'type'. */
+static const char *
+intf_connector_display_name(const char *type)
+{
+    if (!strcmp(type, INTERFACE_HW_INTF_INFO_MAP_CONNECTOR_SFP_PLUS)) {
+        return "SFP+";
+    } else if (!strcmp(type, INTERFACE_HW_INTF_INFO_MAP_CONNECTOR_QSFP_PLUS)) {
+        return "QSFP+";
+    }
+    return type;
+}
+
+/* Completes 'filter' from its value.  Returns false after reporting an
+ * invalid value on 'vty', as a JSON error object if 'json'. */
+static bool
+intf_show_filter_prepare(struct vty *vty, struct intf_show_filter *filter,
+                         bool json)
+{
+    char *end;
+
+    switch (filter->type) {
+    case INTF_SHOW_FILTER_SPEED:
+        /* Mb/s, or Gb/s with a "G" suffix, as in "10000" or "10G". */
+        filter->speed = strtoll(filter->value, &end, 10);
+        if (end == filter->value || filter->speed < 0) {
+            break;
+        }
+        if (*end == 'G' || *end == 'g') {
+            filter->speed *= 1000;
+            end++;
+        }
+        if (*end != '\0') {
+            break;
+        }
+        filter->speed *= 1000000;
+        return true;
+
+    case INTF_SHOW_FILTER_LAG:
+        snprintf(filter->lag, sizeof filter->lag, "%s%s",
+                 strncmp(filter->value, LAG_PORT_NAME_PREFIX,
+                         LAG_PORT_NAME_PREFIX_LENGTH)
+                 ? LAG_PORT_NAME_PREFIX : "", filter->value);
+        return true;
+
+    default:
+        return true;
+    }
+
+    if (json) {
+        show_json_error(vty, "Invalid speed %s.", filter->value);
+    } else {
+        vty_out(vty, "Invalid speed %s.%s", filter->value, VTY_NEWLINE);
+    }
+    return false;
+}
+
+static bool
+intf_show_filter_match(const struct intf_show_filter *filter,
+                       const struct ovsrec_interface *ifrow)
+{
+    const struct ovsrec_port *lag;
+    const char *value;
+
+    switch (filter->type) {
+    case INTF_SHOW_FILTER_STATUS:
+        if (!strcmp(ifrow->type, OVSREC_INTERFACE_TYPE_INTERNAL)) {
+            value = smap_get(&ifrow->user_config,
+                             INTERFACE_USER_CONFIG_MAP_ADMIN);
+            value = (value && strcmp(value,
+                                     OVSREC_INTERFACE_USER_CONFIG_ADMIN_DOWN))
+                    ? "up" : "down";
+        } else {
+            value = ifrow->link_state;
+        }
+        return value && !strcmp(value, filter->value);
+
+    case INTF_SHOW_FILTER_ERROR:
+        return ifrow->error && !strcmp(ifrow->error, filter->value);
+
+    case INTF_SHOW_FILTER_CONNECTOR:
+        value = smap_get(&ifrow->hw_intf_info,
+                         INTERFACE_HW_INTF_INFO_MAP_CONNECTOR);
+        return value
+               && (!strcasecmp(value, filter->value)
+                   || !strcasecmp(intf_connector_display_name(value),
+                                  filter->value));
+
+    case INTF_SHOW_FILTER_SPEED:
+        return intf_json_link_speed(ifrow) == filter->speed;
+
+    case INTF_SHOW_FILTER_LAG:
+        return lag_member_map_lookup(ifrow->name, &lag) && lag
+               && !strcmp(lag->name, filter->lag);
+
+    case INTF_SHOW_FILTER_SPLIT_CHILDREN:
+        return ifrow->split_parent != NULL;
     }
+
+    return false;
 }
 
 int
 cli_show_interface_exec (struct cmd_element *self, struct vty *vty,
-        int flags, int argc, const char *argv[], bool brief)
+        int flags, int argc, const char *argv[], bool brief, bool json,
+        const struct intf_show_filter *filter)
 {
     const struct ovsrec_interface *ifrow = NULL;
     const char *cur_state = NULL;
-    struct shash sorted_interfaces;
     const struct shash_node **nodes;
-    int idx, count;
+    const struct ovsrec_interface **rows;
+    int idx, count, n_rows = 0;
     const struct ovsrec_port *port_row;
     bool internal_if = false;
     bool isLag = true;
@@ -2973,29 +3491,19 @@ cli_show_interface_exec (struct cmd_element *self, struct vty *vty,
     const char *cur_duplex = NULL;
     const char *cur_mtu = NULL;
     const char *cur_flow_control = NULL;
-    static char *interface_statistics_keys [] = {
-        "rx_packets",
-        "rx_bytes",
-        "tx_packets",
-        "tx_bytes",
-        "rx_dropped",
-        "rx_frame_err",
-        "rx_over_err",
-        "rx_crc_err",
-        "rx_errors",
-        "tx_dropped",
-        "collisions",
-        "tx_errors"
-    };
     int64_t intVal = 0;
     const char *user_config_speed = NULL;
 
-    shash_init(&sorted_interfaces);
+    /* Pick the interfaces to display from the sorted index. */
+    nodes = get_sorted_interfaces(idl, &count);
+    rows = xmalloc(count * sizeof *rows);
 
-    OVSREC_INTERFACE_FOR_EACH(ifrow, idl)
+    for (idx = 0; idx < count; idx++)
     {
         const char *state_value;
 
+        ifrow = (const struct ovsrec_interface *)nodes[idx]->data;
+
         if(!ifrow->split_parent)
         {
             /*Parent (orphan) interface */
@@ -3009,9 +3517,16 @@ cli_show_interface_exec (struct cmd_element *self, struct vty *vty,
 
                 /* can't show parent config, when the interface is split */
                 if ((argv[0] != NULL) && !strcmp(ifrow->name, argv[0])) {
-                    vty_out (vty, "Interface %s is split. Check the child interfaces"
-                                  " for configuration. %s", ifrow->name,
-                                  VTY_NEWLINE);
+                    if (json) {
+                        show_json_error(vty, "Interface %s is split. Check "
+                                        "the child interfaces for "
+                                        "configuration.", ifrow->name);
+                    } else {
+                        vty_out (vty, "Interface %s is split. Check the child interfaces"
+                                      " for configuration. %s", ifrow->name,
+                                      VTY_NEWLINE);
+                    }
+                    free(rows);
                     return CMD_SUCCESS;
                 }
 
@@ -3031,9 +3546,17 @@ cli_show_interface_exec (struct cmd_element *self, struct vty *vty,
 
                /* can't show child interface config when parent is not split */
                if ((argv[0] != NULL) && !strcmp(ifrow->name, argv[0])) {
-                    vty_out (vty, "Parent interface of %s is not split. "
-                                  "Check the parent interface for "
-                                  "configuration.%s", ifrow->name, VTY_NEWLINE);
+                    if (json) {
+                        show_json_error(vty, "Parent interface of %s is not "
+                                        "split. Check the parent interface "
+                                        "for configuration.", ifrow->name);
+                    } else {
+                        vty_out (vty, "Parent interface of %s is not split. "
+                                      "Check the parent interface for "
+                                      "configuration.%s", ifrow->name,
+                                      VTY_NEWLINE);
+                    }
+                    free(rows);
                     return CMD_SUCCESS;
                 }
 
@@ -3048,10 +3571,16 @@ cli_show_interface_exec (struct cmd_element *self, struct vty *vty,
         else if ((NULL != argv[0]) &&
             (strcmp(ifrow->type, OVSREC_INTERFACE_TYPE_VLANSUBINT) == 0))
         {
+             if (json)
+             {
+                 rows[n_rows++] = ifrow;
+                 break;
+             }
+
              display_header(brief);
 
              cli_show_subinterface_row(ifrow, brief);
-             shash_destroy(&sorted_interfaces);
+             free(rows);
              return CMD_SUCCESS;
         }
 
@@ -3061,17 +3590,28 @@ cli_show_interface_exec (struct cmd_element *self, struct vty *vty,
             continue;
         }
 
-        shash_add(&sorted_interfaces, ifrow->name, (void *)ifrow);
+        if (filter && !intf_show_filter_match(filter, ifrow))
+        {
+            continue;
+        }
+
+        rows[n_rows++] = ifrow;
     }
 
-    display_header(brief);
+    if (json)
+    {
+        /* Interface rows only; LAGs keep the text output. */
+        show_interface_json(vty, rows, n_rows, brief);
+        free(rows);
+        return CMD_SUCCESS;
+    }
 
-    nodes = sort_interface(&sorted_interfaces);
-    count = shash_count(&sorted_interfaces);
+    intf_out_begin();
+    display_header(brief);
 
-    for (idx = 0; idx < count; idx++)
+    for (idx = 0; idx < n_rows; idx++)
     {
-        ifrow = (const struct ovsrec_interface *)nodes[idx]->data;
+        ifrow = rows[idx];
         internal_if = (strcmp(ifrow->type, OVSREC_INTERFACE_TYPE_INTERNAL) == 0) ? true : false;
 
         if (brief)
@@ -3084,11 +3624,11 @@ cli_show_interface_exec (struct cmd_element *self, struct vty *vty,
             {
                 user_config_speed = smap_get(&ifrow->user_config, INTERFACE_USER_CONFIG_MAP_SPEEDS);
                 if (user_config_speed != NULL) {
-                    vty_out(vty,"%-6s", user_config_speed);
+                    intf_out(vty,"%-6s", user_config_speed);
                 }
                 else
                 {
-                    vty_out(vty," --    ");
+                    intf_out(vty," --    ");
                 }
             }
             else
@@ -3102,15 +3642,15 @@ cli_show_interface_exec (struct cmd_element *self, struct vty *vty,
 
                 if(intVal == 0)
                 {
-                    vty_out(vty, " %-6s", "auto");
+                    intf_out(vty, " %-6s", "auto");
                 }
                 else
                 {
-                    vty_out(vty, " %-6" PRIi64, intVal/1000000);
+                    intf_out(vty, " %-6" PRIi64, intVal/1000000);
                 }
             }
-            vty_out(vty, "   -- ");  /* Port channel */
-            vty_out (vty, "%s", VTY_NEWLINE);
+            intf_out(vty, "   -- ");  /* Port channel */
+            intf_out(vty, "%s", VTY_NEWLINE);
         }
         else
         {
@@ -3118,24 +3658,28 @@ cli_show_interface_exec (struct cmd_element *self, struct vty *vty,
             isLag = false;
             show_interface_status(vty, ifrow, internal_if, brief);
 
-            vty_out (vty, " Hardware: Ethernet, MAC Address: %s %s",
+            intf_out(vty, " Hardware: Ethernet, MAC Address: %s %s",
                     ifrow->mac_in_use, VTY_NEWLINE);
 
-            port_row = port_find(ifrow->name);
+            port_row = port_index_find(idl, ifrow->name);
             if (port_row && smap_get(&port_row->other_config,
                   PORT_OTHER_CONFIG_MAP_PROXY_ARP_ENABLED))
             {
-                vty_out(vty, " Proxy ARP is enabled%s", VTY_NEWLINE);
+                intf_out(vty, " Proxy ARP is enabled%s", VTY_NEWLINE);
             }
 
             if (port_row && smap_get(&port_row->other_config,
                   PORT_OTHER_CONFIG_MAP_LOCAL_PROXY_ARP_ENABLED))
             {
-                vty_out(vty, " Local Proxy ARP is enabled%s", VTY_NEWLINE);
+                intf_out(vty, " Local Proxy ARP is enabled%s", VTY_NEWLINE);
             }
 
             /* Displaying ipv4 and ipv6 primary and secondary addresses*/
-            show_ip_addresses(ifrow->name, vty);
+            if (port_row) {
+                /* Addresses live on the Port row. */
+                intf_out_flush(vty);
+                show_ip_addresses(ifrow->name, vty);
+            }
 
             if(!internal_if)
             {
@@ -3148,21 +3692,22 @@ cli_show_interface_exec (struct cmd_element *self, struct vty *vty,
                     intVal = atoi(INTERFACE_USER_CONFIG_MAP_MTU_DEFAULT);
                 }
 
-                vty_out(vty, " MTU %" PRIi64 " %s", intVal, VTY_NEWLINE);
+                intf_out(vty, " MTU %" PRIi64 " %s", intVal, VTY_NEWLINE);
 
                 cur_duplex = smap_get(&ifrow->user_config,
                                       INTERFACE_USER_CONFIG_MAP_DUPLEX);
                 if ((NULL == cur_duplex) ||
                         !strcmp(cur_duplex, "full"))
                 {
-                    vty_out(vty, " Full-duplex %s", VTY_NEWLINE);
+                    intf_out(vty, " Full-duplex %s", VTY_NEWLINE);
                 }
                 else
                 {
-                    vty_out(vty, " Half-duplex %s", VTY_NEWLINE);
+                    intf_out(vty, " Half-duplex %s", VTY_NEWLINE);
                 }
 
-                const struct ovsrec_port* port_row = port_find(ifrow->name);
+                const struct ovsrec_port* port_row =
+                    port_index_find(idl, ifrow->name);
                 qos_trust_port_show(port_row, ifrow->name);
                 qos_apply_port_show(port_row, ifrow->name);
                 qos_cos_port_show(port_row, ifrow->name);
@@ -3174,18 +3719,18 @@ cli_show_interface_exec (struct cmd_element *self, struct vty *vty,
                 {
                     intVal = datum->keys[0].integer;
                 }
-                vty_out(vty, " Speed %" PRIi64 " Mb/s %s",intVal/1000000 , VTY_NEWLINE);
+                intf_out(vty, " Speed %" PRIi64 " Mb/s %s",intVal/1000000 , VTY_NEWLINE);
 
                 cur_state = smap_get(&ifrow->user_config,
                                        INTERFACE_USER_CONFIG_MAP_AUTONEG);
                 if ((NULL == cur_state) ||
                     strcmp(cur_state, "off") !=0)
                 {
-                    vty_out(vty, " Auto-Negotiation is turned on %s", VTY_NEWLINE);
+                    intf_out(vty, " Auto-Negotiation is turned on %s", VTY_NEWLINE);
                 }
                 else
                 {
-                    vty_out(vty, " Auto-Negotiation is turned off %s",
+                    intf_out(vty, " Auto-Negotiation is turned off %s",
                         VTY_NEWLINE);
                 }
 
@@ -3197,30 +3742,30 @@ cli_show_interface_exec (struct cmd_element *self, struct vty *vty,
                         INTERFACE_USER_CONFIG_MAP_PAUSE_NONE) == 0)
 
                     {
-                        vty_out(vty, " Input flow-control is off, "
+                        intf_out(vty, " Input flow-control is off, "
                             "output flow-control is off%s",VTY_NEWLINE);
                     }
                     else if (strcmp(cur_flow_control,
                         INTERFACE_USER_CONFIG_MAP_PAUSE_RX) == 0)
                     {
-                        vty_out(vty, " Input flow-control is on, "
+                        intf_out(vty, " Input flow-control is on, "
                             "output flow-control is off%s",VTY_NEWLINE);
                     }
                     else if (strcmp(cur_flow_control,
                         INTERFACE_USER_CONFIG_MAP_PAUSE_TX) == 0)
                     {
-                        vty_out(vty, " Input flow-control is off, "
+                        intf_out(vty, " Input flow-control is off, "
                             "output flow-control is on%s",VTY_NEWLINE);
                     }
                     else
                     {
-                        vty_out(vty, " Input flow-control is on, "
+                        intf_out(vty, " Input flow-control is on, "
                             "output flow-control is on%s",VTY_NEWLINE);
                     }
                 }
                 else
                 {
-                    vty_out(vty, " Input flow-control is off, "
+                    intf_out(vty, " Input flow-control is off, "
                         "output flow-control is off%s",VTY_NEWLINE);
                 }
             }
@@ -3228,15 +3773,25 @@ cli_show_interface_exec (struct cmd_element *self, struct vty *vty,
             /* show sFlow config, if present */
             show_sflow_config(ifrow->name, " ", true);
 
-            if(internal_if)
+            if(internal_if) {
+                intf_out_flush(vty);
                 show_l3_stats(vty, ifrow);
+            }
             else
-                show_interface_stats(vty, ifrow, interface_statistics_keys);
+                show_interface_stats(vty, ifrow);
         }
+
+        intf_out_block_end(vty);
     }
 
-    shash_destroy(&sorted_interfaces);
-    free(nodes);
+    intf_out_end(vty);
+    free(rows);
+
+    /* Predicates select interfaces only. */
+    if (filter)
+    {
+        return CMD_SUCCESS;
+    }
 
     if(brief)
     {
@@ -3244,7 +3799,7 @@ cli_show_interface_exec (struct cmd_element *self, struct vty *vty,
     }
     else if (isLag)
     {
-        show_lacp_interfaces(vty, interface_statistics_keys, argv);
+        show_lacp_interfaces(vty, argv);
     }
 
     return CMD_SUCCESS;
@@ -3283,15 +3838,12 @@ DEFUN (vtysh_interface,
         char if_name_str[5];
         sprintf(if_name_str, "%u", parent_if_number);
 
-        OVSREC_INTERFACE_FOR_EACH (if_row, idl) {
-           if (!strcmp (if_row->name, if_name_str)) {
-                if (!is_parent_interface_split (if_row)) {
-                     vty_out (vty, "Configuration not allowed as parent "
-                              "interface of %s is not split.%s",
-                              argv[0],VTY_NEWLINE);
-                     return CMD_ERR_NOTHING_TODO;
-                }
-           }
+        if_row = intf_index_find(idl, if_name_str);
+        if (if_row && !is_parent_interface_split (if_row)) {
+             vty_out (vty, "Configuration not allowed as parent "
+                      "interface of %s is not split.%s",
+                      argv[0],VTY_NEWLINE);
+             return CMD_ERR_NOTHING_TODO;
         }
     }
 
@@ -3331,16 +3883,11 @@ DEFUN (vtysh_interface,
          } else if (strlen(argv[0]) < MAX_IFNAME_LENGTH) {
                    strncpy(ifnumber_temp, argv[0], MAX_IFNAME_LENGTH);
 
-                   OVSREC_INTERFACE_FOR_EACH (if_row, idl)
-                   {
-                       if (strcmp (if_row->name, ifnumber_temp) == 0) {
-                           if ((if_row->error != NULL) &&
-                               ((strcmp(if_row->error, "lanes_split")) == 0)) {
-                              vty_out(vty, "Interface Warning : Split Interface\n");
-                              flag = 0;
-                              break;
-                           }
-                       }
+                   if_row = intf_index_find(idl, ifnumber_temp);
+                   if (if_row && (if_row->error != NULL) &&
+                       ((strcmp(if_row->error, "lanes_split")) == 0)) {
+                      vty_out(vty, "Interface Warning : Split Interface\n");
+                      flag = 0;
                    }
                    if (flag) {
                       default_port_add(ifnumber_temp);
@@ -3355,6 +3902,199 @@ DEFUN (vtysh_interface,
     return CMD_SUCCESS;
 }
 
+/*
+ * Expands the "interface range" list 'spec' into 'members'.  The list is
+ * a comma separated list of:
+ *      N           interface N, e.g. 50
+ *      N-M         interfaces N to M, e.g. 1-48
+ *      P-L         split child L of interface P, e.g. 52-1, if there is
+ *                  such an interface; otherwise interfaces P to L
+ *      P-L-P-M     split children L to M of interface P, e.g. 52-1-52-4
+ *      IF.T        subinterface T of interface IF, e.g. 1.10 or 52-1.10
+ *      IF.T-U      subinterfaces T to U of interface IF, e.g. 1.10-20
+ * Returns false after reporting the problem on 'vty'.
+ */
+static bool
+intf_range_parse(struct vty *vty, const char *spec, struct svec *members)
+{
+    char *list = xstrdup(spec);
+    char *save_ptr = NULL;
+    char *token;
+    bool ok = true;
+
+    for (token = strtok_r(list, ",", &save_ptr); token && ok;
+         token = strtok_r(NULL, ",", &save_ptr)) {
+        char name[MAX_IFNAME_LENGTH];
+        unsigned int parent = 0, parent_last = 0;
+        unsigned int first = 0, last = 0, n;
+        const char *base = NULL;
+        char *dot = strchr(token, '.');
+        int len = 0;
+
+        if (dot) {
+            /* Subinterfaces of a single interface. */
+            *dot = '\0';
+            base = token;
+            if (sscanf(dot + 1, "%u-%u%n", &first, &last, &len) != 2
+                || dot[1 + len] != '\0') {
+                len = 0;
+                if (sscanf(dot + 1, "%u%n", &first, &len) != 1
+                    || dot[1 + len] != '\0') {
+                    ok = false;
+                }
+                last = first;
+            }
+        } else if (sscanf(token, "%u-%u-%u-%u%n", &parent, &first,
+                          &parent_last, &last, &len) == 4
+                   && token[len] == '\0') {
+            /* Split children of a single interface. */
+            ok = (parent == parent_last);
+        } else if (sscanf(token, "%u-%u%n", &first, &last, &len) == 2
+                   && token[len] == '\0') {
+            const struct ovsrec_interface *if_row;
+
+            /* "52-1" names a split child, not the interfaces 52 down to
+             * 1. */
+            if_row = intf_index_find(idl, token);
+            if (if_row && if_row->split_parent) {
+                parent = first;
+                first = last;
+            }
+        } else if (sscanf(token, "%u%n", &first, &len) == 1
+                   && token[len] == '\0') {
+            last = first;
+        } else {
+            ok = false;
+        }
+
+        if (!ok || !*token || first > last
+            || last - first >= INTF_RANGE_MAX_MEMBERS) {
+            vty_out(vty, "Invalid interface range %s.%s", spec, VTY_NEWLINE);
+            ok = false;
+            break;
+        }
+
+        for (n = first; ; n++) {
+            if (base) {
+                snprintf(name, sizeof name, "%s.%u", base, n);
+            } else if (parent) {
+                snprintf(name, sizeof name, "%u-%u", parent, n);
+            } else {
+                snprintf(name, sizeof name, "%u", n);
+            }
+            svec_add(members, name);
+            if (n == last) {
+                break;
+            }
+        }
+
+        if (members->n > INTF_RANGE_MAX_MEMBERS) {
+            vty_out(vty, "An interface range is limited to %d interfaces.%s",
+                    INTF_RANGE_MAX_MEMBERS, VTY_NEWLINE);
+            ok = false;
+        }
+    }
+
+    free(list);
+    return ok;
+}
+
+/*
+ * CLI "interface range"
+ * Enters the range context for several interfaces.  Its attribute
+ * commands change all of them in one transaction.
+ */
+DEFUN (vtysh_interface_range,
+      vtysh_interface_range_cmd,
+      "interface range RANGE",
+      "Select an interface to configure\n"
+      "Configure a range of interfaces\n"
+      "Interface list, e.g. 1-48,50,52-1-52-4 or 1.10-20\n")
+{
+    struct svec members = SVEC_EMPTY_INITIALIZER;
+    const struct ovsrec_interface *if_row;
+    struct intf_range *range;
+    const char *name;
+    size_t i;
+
+    if (strlen(argv[0]) >= INTF_RANGE_NAME_SIZE) {
+        vty_out(vty, "Invalid interface range %s.%s", argv[0], VTY_NEWLINE);
+        return CMD_ERR_NOTHING_TODO;
+    }
+
+    if (!intf_range_parse(vty, argv[0], &members)) {
+        svec_destroy(&members);
+        return CMD_ERR_NOTHING_TODO;
+    }
+    svec_sort_unique(&members);
+
+    SVEC_FOR_EACH (i, name, &members) {
+        if_row = intf_index_find(idl, name);
+        if (!if_row) {
+            vty_out(vty, "Interface %s does not exist.%s", name, VTY_NEWLINE);
+            svec_destroy(&members);
+            return CMD_ERR_NOTHING_TODO;
+        }
+        if (if_row->split_parent
+            && !is_parent_interface_split(if_row->split_parent)) {
+            vty_out(vty, "Configuration not allowed as parent "
+                    "interface of %s is not split.%s", name, VTY_NEWLINE);
+            svec_destroy(&members);
+            return CMD_ERR_NOTHING_TODO;
+        }
+        if (is_parent_interface_split(if_row)) {
+            vty_out(vty, "Interface %s is split. Use its child "
+                    "interfaces instead.%s", name, VTY_NEWLINE);
+            svec_destroy(&members);
+            return CMD_ERR_NOTHING_TODO;
+        }
+    }
+
+    /* Same as "interface IFNAME" for each physical member. */
+    SVEC_FOR_EACH (i, name, &members) {
+        if (!strchr(name, '.') && !port_index_find(idl, name)) {
+            default_port_add(name);
+        }
+    }
+
+    range = intf_range_find(vty);
+    if (!range) {
+        range = xzalloc(sizeof *range);
+        range->vty = vty;
+        svec_init(&range->members);
+        hmap_insert(&intf_ranges, &range->node, hash_pointer(vty, 0));
+    }
+    svec_swap(&range->members, &members);
+    svec_destroy(&members);
+    strcpy(range->name, argv[0]);
+
+    vty->node = INTERFACE_RANGE_NODE;
+    vty->index = range->name;
+    return CMD_SUCCESS;
+}
+
+DEFUN (vtysh_exit_interface_range,
+      vtysh_exit_interface_range_cmd,
+      "exit",
+      "Exit current mode and down to previous mode\n")
+{
+    intf_range_leave(vty);
+    vty->node = CONFIG_NODE;
+    vty->index = NULL;
+    return CMD_SUCCESS;
+}
+
+DEFUN (vtysh_end_interface_range,
+      vtysh_end_interface_range_cmd,
+      "end",
+      "End current mode and change to enable mode\n")
+{
+    intf_range_leave(vty);
+    vty->node = ENABLE_NODE;
+    vty->index = NULL;
+    return CMD_SUCCESS;
+}
+
 DEFUN (no_vtysh_interface,
       no_vtysh_interface_cmd,
       "no interface IFNAME",
@@ -3405,11 +4145,11 @@ DEFUN (no_vtysh_interface,
  * Interface Diagnostics Information
  */
 int cli_show_xvr_dom_exec (struct cmd_element *self, struct vty *vty,
-        int flags, int argc, const char *argv[])
+        int flags, int argc, const char *argv[], bool json)
 {
     const struct ovsrec_interface *ifrow = NULL;
+    struct intf_json js;
     const char *cur_state =NULL;
-    struct shash sorted_interfaces;
     const struct shash_node **nodes;
     int idx, count;
     bool validIntf = false;
@@ -3548,16 +4288,20 @@ int cli_show_xvr_dom_exec (struct cmd_element *self, struct vty *vty,
         { NULL, NULL, NULL }
     };
 
-    shash_init(&sorted_interfaces);
-
-    OVSREC_INTERFACE_FOR_EACH(ifrow, idl)
+    if (json && (NULL != argv[0]) && !xvr_json_interface_valid(argv[0]))
     {
-        shash_add(&sorted_interfaces, ifrow->name, (void *)ifrow);
+        show_json_error(vty, "Invalid switch interface ID.");
+        return CMD_OVSDB_FAILURE;
     }
 
-    nodes = sort_interface(&sorted_interfaces);
+    nodes = get_sorted_interfaces(idl, &count);
 
-    count = shash_count(&sorted_interfaces);
+    intf_json_init(&js, intf_out_buffer());
+    if (json)
+    {
+        intf_out_begin();
+        intf_json_array_start(&js, NULL);
+    }
 
     for (idx = 0; idx < count; idx++)
     {
@@ -3580,6 +4324,28 @@ int cli_show_xvr_dom_exec (struct cmd_element *self, struct vty *vty,
 
         int i;
 
+        if (json)
+        {
+            intf_json_object_start(&js, NULL);
+            if (xvr_json_put_module(&js, ifrow))
+            {
+                /* Readings only; the "-" entries are lane headings. */
+                intf_json_object_start(&js, "dom");
+                for (i = 0; dom_keys[i].key != NULL; i++)
+                {
+                    cur_state = smap_get(&ifrow->pm_info, dom_keys[i].key);
+                    if (cur_state != NULL && strcmp(dom_keys[i].key, "-"))
+                    {
+                        intf_json_reading(&js, dom_keys[i].key, cur_state);
+                    }
+                }
+                intf_json_object_end(&js);
+            }
+            intf_json_object_end(&js);
+            intf_out_block_end(vty);
+            continue;
+        }
+
         /* Display transceiver information */
         vty_out (vty, "Interface %s:%s", ifrow->name, VTY_NEWLINE);
 
@@ -3693,8 +4459,12 @@ int cli_show_xvr_dom_exec (struct cmd_element *self, struct vty *vty,
         vty_out (vty, "%s", VTY_NEWLINE);
     }
 
-    shash_destroy(&sorted_interfaces);
-    free(nodes);
+    if (json)
+    {
+        intf_json_array_end(&js);
+        intf_out_end(vty);
+        return CMD_SUCCESS;
+    }
 
     if (validIntf)
     {
@@ -3715,7 +4485,19 @@ DEFUN (cli_intf_show_interface_ifname_dom,
         IFNAME_STR
         "Show transceiver diagnostics info for interface\n")
 {
-    return cli_show_xvr_dom_exec (self, vty, vty_flags, argc, argv);
+    return cli_show_xvr_dom_exec (self, vty, vty_flags, argc, argv, false);
+}
+
+DEFUN (cli_intf_show_interface_ifname_dom_json,
+        cli_intf_show_interface_ifname_dom_json_cmd,
+        "show interface IFNAME dom json",
+        SHOW_STR
+        INTERFACE_STR
+        IFNAME_STR
+        "Show transceiver diagnostics info for interface\n"
+        JSON_STR)
+{
+    return cli_show_xvr_dom_exec (self, vty, vty_flags, argc, argv, true);
 }
 
 DEFUN (cli_intf_show_interface_dom,
@@ -3726,22 +4508,36 @@ DEFUN (cli_intf_show_interface_dom,
         "Show transceiver diagnostics info for interfaces\n")
 {
     argv[0] = NULL;
-    return cli_show_xvr_dom_exec (self, vty, vty_flags, argc, argv);
+    return cli_show_xvr_dom_exec (self, vty, vty_flags, argc, argv, false);
+}
+
+DEFUN (cli_intf_show_interface_dom_json,
+        cli_intf_show_interface_dom_json_cmd,
+        "show interface dom json",
+        SHOW_STR
+        INTERFACE_STR
+        "Show transceiver diagnostics info for interfaces\n"
+        JSON_STR)
+{
+    argv[0] = NULL;
+    return cli_show_xvr_dom_exec (self, vty, vty_flags, argc, argv, true);
 }
 
 
 DEFUN (cli_intf_show_intferface_ifname,
         cli_intf_show_intferface_ifname_cmd,
-        "show interface IFNAME {brief|transceiver|queues}",
+        "show interface IFNAME {brief|transceiver|queues|json}",
         SHOW_STR
         INTERFACE_STR
         IFNAME_STR
         "Show brief info of interface\n"
         "Show transceiver info for interface\n"
-        "Show tx queue info for interface\n")
+        "Show tx queue info for interface\n"
+        JSON_STR)
 {
     bool brief = false;
     bool transceiver = false;
+    bool json = false;
     int rc = CMD_SUCCESS;
 
     if ((NULL != argv[1]) && (strcmp(argv[1], "brief") == 0))
@@ -3757,14 +4553,19 @@ DEFUN (cli_intf_show_intferface_ifname,
     {
         return (cli_show_interface_queue_stats (self, vty, argc, argv));
     }
+    if ((NULL != argv[4]) && (strcmp(argv[4], "json") == 0))
+    {
+        json = true;
+    }
 
     if (transceiver)
     {
-        rc = cli_show_xvr_exec (self, vty, vty_flags, argc, argv, brief);
+        rc = cli_show_xvr_exec (self, vty, vty_flags, argc, argv, brief, json);
     }
     else
     {
-        rc = cli_show_interface_exec (self, vty, vty_flags, argc, argv, brief);
+        rc = cli_show_interface_exec (self, vty, vty_flags, argc, argv, brief,
+                                      json, NULL);
     }
 
     return rc;
@@ -3772,15 +4573,17 @@ DEFUN (cli_intf_show_intferface_ifname,
 
 DEFUN (cli_intf_show_intferface_ifname_br,
         cli_intf_show_intferface_ifname_br_cmd,
-        "show interface {brief|transceiver|queues}",
+        "show interface {brief|transceiver|queues|json}",
         SHOW_STR
         INTERFACE_STR
         "Show brief info of interfaces\n"
         "Show transceiver info for interfaces\n"
-        "Show tx queue info for interfaces\n")
+        "Show tx queue info for interfaces\n"
+        JSON_STR)
 {
     bool brief = false;
     bool transceiver = false;
+    bool json = false;
     int rc = CMD_SUCCESS;
 
     if ((NULL != argv[0]) && (strcmp(argv[0], "brief") == 0))
@@ -3796,92 +4599,257 @@ DEFUN (cli_intf_show_intferface_ifname_br,
     {
         return (cli_show_interface_queue_stats (self, vty, argc, argv));
     }
+    if ((NULL != argv[3]) && (strcmp(argv[3], "json") == 0))
+    {
+        json = true;
+    }
 
     argv[0] = NULL;
 
     if (transceiver)
     {
-        rc = cli_show_xvr_exec (self, vty, vty_flags, argc, argv, brief);
+        rc = cli_show_xvr_exec (self, vty, vty_flags, argc, argv, brief, json);
     }
     else
     {
-        rc = cli_show_interface_exec (self, vty, vty_flags, argc, argv, brief);
+        rc = cli_show_interface_exec (self, vty, vty_flags, argc, argv, brief,
+                                      json, NULL);
+    }
+    return rc;
+}
+
+/* Runs "show interface" for the interfaces matching one predicate.
+ * 'brief' and 'json' are the arguments of the optional modifiers. */
+static int
+cli_show_interface_filtered (struct cmd_element *self, struct vty *vty,
+                             enum intf_show_filter_type type,
+                             const char *value, const char *brief,
+                             const char *json)
+{
+    struct intf_show_filter filter;
+    const char *no_ifname[] = { NULL };
+    bool json_mode = json && !strcmp(json, "json");
+    int rc;
+
+    memset(&filter, 0, sizeof filter);
+    filter.type = type;
+    filter.value = value;
+    if (!intf_show_filter_prepare(vty, &filter, json_mode))
+    {
+        return CMD_ERR_NOTHING_TODO;
+    }
+
+    if (type == INTF_SHOW_FILTER_LAG)
+    {
+        lag_member_map_build(idl);
+    }
+    rc = cli_show_interface_exec (self, vty, vty_flags, 0, no_ifname,
+                                  brief && !strcmp(brief, "brief"),
+                                  json_mode, &filter);
+    if (type == INTF_SHOW_FILTER_LAG)
+    {
+        lag_member_map_destroy();
     }
+
     return rc;
 }
 
+#define SHOW_INTF_FILTER_STR \
+        SHOW_STR \
+        INTERFACE_STR
+
+#define SHOW_INTF_MODIFIER_STR \
+        "Show brief info of interfaces\n" \
+        JSON_STR
+
+DEFUN (cli_intf_show_interface_status,
+        cli_intf_show_interface_status_cmd,
+        "show interface status (up|down) {brief|json}",
+        SHOW_INTF_FILTER_STR
+        "Show interfaces by link state\n"
+        "Link up\n"
+        "Link down\n"
+        SHOW_INTF_MODIFIER_STR)
+{
+    return cli_show_interface_filtered (self, vty, INTF_SHOW_FILTER_STATUS,
+                                        argv[0], argv[1], argv[2]);
+}
+
+DEFUN (cli_intf_show_interface_error,
+        cli_intf_show_interface_error_cmd,
+        "show interface error WORD {brief|json}",
+        SHOW_INTF_FILTER_STR
+        "Show interfaces by state information\n"
+        "Reason, e.g. module_unsupported\n"
+        SHOW_INTF_MODIFIER_STR)
+{
+    return cli_show_interface_filtered (self, vty, INTF_SHOW_FILTER_ERROR,
+                                        argv[0], argv[1], argv[2]);
+}
+
+DEFUN (cli_intf_show_interface_connector,
+        cli_intf_show_interface_connector_cmd,
+        "show interface connector WORD {brief|json}",
+        SHOW_INTF_FILTER_STR
+        "Show interfaces by connector\n"
+        "Connector type, e.g. RJ45, SFP+ or QSFP28\n"
+        SHOW_INTF_MODIFIER_STR)
+{
+    return cli_show_interface_filtered (self, vty, INTF_SHOW_FILTER_CONNECTOR,
+                                        argv[0], argv[1], argv[2]);
+}
+
+DEFUN (cli_intf_show_interface_speed,
+        cli_intf_show_interface_speed_cmd,
+        "show interface speed WORD {brief|json}",
+        SHOW_INTF_FILTER_STR
+        "Show interfaces by link speed\n"
+        "Speed in Mb/s, or in Gb/s with a G suffix, e.g. 10000 or 10G\n"
+        SHOW_INTF_MODIFIER_STR)
+{
+    return cli_show_interface_filtered (self, vty, INTF_SHOW_FILTER_SPEED,
+                                        argv[0], argv[1], argv[2]);
+}
+
+DEFUN (cli_intf_show_interface_lag_members,
+        cli_intf_show_interface_lag_members_cmd,
+        "show interface lag WORD {brief|json}",
+        SHOW_INTF_FILTER_STR
+        "Show the member interfaces of a LAG\n"
+        "LAG name, e.g. lag1 or 1\n"
+        SHOW_INTF_MODIFIER_STR)
+{
+    return cli_show_interface_filtered (self, vty, INTF_SHOW_FILTER_LAG,
+                                        argv[0], argv[1], argv[2]);
+}
+
+DEFUN (cli_intf_show_interface_split_children,
+        cli_intf_show_interface_split_children_cmd,
+        "show interface split-children {brief|json}",
+        SHOW_INTF_FILTER_STR
+        "Show the child interfaces of split interfaces\n"
+        SHOW_INTF_MODIFIER_STR)
+{
+    return cli_show_interface_filtered (self, vty,
+                                        INTF_SHOW_FILTER_SPLIT_CHILDREN,
+                                        NULL, argv[0], argv[1]);
+}
+
+/* Prints the rates ops-intfd keeps for 'ifname', or for every interface
+ * if it is NULL.  They are read from the daemon over its unixctl socket,
+ * like "ovs-appctl -t ops-intfd ops-intfd/rates" does. */
+static int
+cli_show_interface_rates_exec (struct vty *vty, const char *ifname)
+{
+    char *args[1];
+    char *pidfile, *path;
+    char *result = NULL, *err = NULL;
+    struct jsonrpc *client;
+    const char *line, *end;
+    pid_t pid;
+    int error;
+
+    if (ifname && !intf_index_find(idl, ifname))
+    {
+        vty_out (vty, "Invalid switch interface ID.%s", VTY_NEWLINE);
+        return CMD_OVSDB_FAILURE;
+    }
+
+    pidfile = xasprintf("%s/ops-intfd.pid", ovs_rundir());
+    pid = read_pidfile(pidfile);
+    free(pidfile);
+    if (pid < 0)
+    {
+        vty_out (vty, "Interface rates are not available.%s", VTY_NEWLINE);
+        return CMD_WARNING;
+    }
+
+    path = xasprintf("%s/ops-intfd.%ld.ctl", ovs_rundir(), (long int) pid);
+    error = unixctl_client_create(path, &client);
+    free(path);
+    if (error)
+    {
+        vty_out (vty, "Interface rates are not available.%s", VTY_NEWLINE);
+        return CMD_WARNING;
+    }
+
+    args[0] = (char *) ifname;
+    error = unixctl_client_transact(client, "ops-intfd/rates", ifname ? 1 : 0,
+                                    args, &result, &err);
+    jsonrpc_close(client);
+    if (error || err)
+    {
+        vty_out (vty, "%s%s", err ? err : "Interface rates are not available.",
+                 VTY_NEWLINE);
+        free(result);
+        free(err);
+        return CMD_WARNING;
+    }
+
+    /* The reply ends its lines with '\n', a vty wants VTY_NEWLINE. */
+    for (line = result; line && *line; line = end + 1)
+    {
+        end = strchr(line, '\n');
+        if (!end)
+        {
+            vty_out (vty, "%s%s", line, VTY_NEWLINE);
+            break;
+        }
+        vty_out (vty, "%.*s%s", (int) (end - line), line, VTY_NEWLINE);
+    }
+    free(result);
+
+    return CMD_SUCCESS;
+}
+
+DEFUN (cli_intf_show_interface_rates,
+        cli_intf_show_interface_rates_cmd,
+        "show interface rates",
+        SHOW_STR
+        INTERFACE_STR
+        "Show the input and output rates of interfaces\n")
+{
+    return cli_show_interface_rates_exec (vty, NULL);
+}
+
+DEFUN (cli_intf_show_interface_ifname_rates,
+        cli_intf_show_interface_ifname_rates_cmd,
+        "show interface IFNAME rates",
+        SHOW_STR
+        INTERFACE_STR
+        IFNAME_STR
+        "Show the input and output rates of the interface\n")
+{
+    return cli_show_interface_rates_exec (vty, argv[0]);
+}
+
 static void
 show_ip_stats(struct vty *vty, bool isIpv6, const struct ovsdb_datum *datum)
 {
-    char *ipv4_interface_statistics_keys [] = {
-        "ipv4_uc_rx_packets",
-        "ipv4_uc_rx_bytes",
-        "ipv4_mc_rx_packets",
-        "ipv4_mc_rx_bytes",
-        "ipv4_uc_tx_packets",
-        "ipv4_uc_tx_bytes",
-        "ipv4_mc_tx_packets",
-        "ipv4_mc_tx_bytes"
-    };
-
-    char *ipv6_interface_statistics_keys [] = {
-        "ipv6_uc_rx_packets",
-        "ipv6_uc_rx_bytes",
-        "ipv6_mc_rx_packets",
-        "ipv6_mc_rx_bytes",
-        "ipv6_uc_tx_packets",
-        "ipv6_uc_tx_bytes",
-        "ipv6_mc_tx_packets",
-        "ipv6_mc_tx_bytes"
-    };
+    struct intf_stats stats;
+    const struct intf_ip_stats *ip;
 
-    unsigned int index;
-    union ovsdb_atom atom;
-    char **stat_keys = (isIpv6 == true) ? ipv6_interface_statistics_keys :
-        ipv4_interface_statistics_keys;
+    intf_stats_decode(datum, &stats);
+    ip = isIpv6 ? &stats.ipv6 : &stats.ipv4;
 
     vty_out(vty, " RX%s", VTY_NEWLINE);
 
-    atom.string = stat_keys[0];
-    index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-    vty_out(vty, "%10sucast: %"PRIu64" packets, ", "",
-            (index == UINT_MAX)? 0 : datum->values[index].integer);
-    atom.string = stat_keys[1];
-    index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-    vty_out(vty, "%"PRIu64" bytes",
-            (index == UINT_MAX)? 0 : datum->values[index].integer);
+    vty_out(vty, "%10sucast: %"PRIu64" packets, ", "", ip->uc_rx_packets);
+    vty_out(vty, "%"PRIu64" bytes", ip->uc_rx_bytes);
     vty_out(vty, "%s", VTY_NEWLINE);
 
-    atom.string = stat_keys[2];
-    index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-    vty_out(vty, "%10smcast: %"PRIu64" packets, ", "",
-            (index == UINT_MAX)? 0 : datum->values[index].integer);
-    atom.string = stat_keys[3];
-    index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-    vty_out(vty, "%"PRIu64" bytes",
-            (index == UINT_MAX)? 0 : datum->values[index].integer);
+    vty_out(vty, "%10smcast: %"PRIu64" packets, ", "", ip->mc_rx_packets);
+    vty_out(vty, "%"PRIu64" bytes", ip->mc_rx_bytes);
     vty_out(vty, "%s", VTY_NEWLINE);
 
     vty_out(vty, " TX%s", VTY_NEWLINE);
 
-    atom.string = stat_keys[4];
-    index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-    vty_out(vty, "%10sucast: %"PRIu64" packets, ", "",
-            (index == UINT_MAX)? 0 : datum->values[index].integer);
-    atom.string = stat_keys[5];
-    index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-    vty_out(vty, "%"PRIu64" bytes",
-            (index == UINT_MAX)? 0 : datum->values[index].integer);
+    vty_out(vty, "%10sucast: %"PRIu64" packets, ", "", ip->uc_tx_packets);
+    vty_out(vty, "%"PRIu64" bytes", ip->uc_tx_bytes);
     vty_out(vty, "%s", VTY_NEWLINE);
 
-    atom.string = stat_keys[6];
-    index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-    vty_out(vty, "%10smcast: %"PRIu64" packets, ", "",
-            (index == UINT_MAX)? 0 : datum->values[index].integer);
-    atom.string = stat_keys[7];
-    index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-    vty_out(vty, "%"PRIu64" bytes",
-            (index == UINT_MAX)? 0 : datum->values[index].integer);
+    vty_out(vty, "%10smcast: %"PRIu64" packets, ", "", ip->mc_tx_packets);
+    vty_out(vty, "%"PRIu64" bytes", ip->mc_tx_bytes);
     vty_out(vty, "%s", VTY_NEWLINE);
 }
 
@@ -3961,7 +4929,6 @@ cli_show_ip_interface_exec(const char *argv[], int argc,
     const struct ovsrec_interface *if_parent_row = NULL;
     const struct ovsrec_port *port_row = NULL;
     const struct ovsdb_datum *datum;
-    struct shash sorted_interfaces;
     const struct shash_node **nodes;
     int idx, count, i;
     int64_t intVal = 0;
@@ -3975,16 +4942,7 @@ cli_show_ip_interface_exec(const char *argv[], int argc,
     if(argc > 1 && NULL != argv[1])
         if_name = argv[1];
 
-    shash_init(&sorted_interfaces);
-
-    OVSREC_INTERFACE_FOR_EACH(ifrow, idl)
-    {
-        shash_add(&sorted_interfaces, ifrow->name, (void *)ifrow);
-    }
-
-    nodes = sort_interface(&sorted_interfaces);
-
-    count = shash_count(&sorted_interfaces);
+    nodes = get_sorted_interfaces(idl, &count);
 
     for (idx = 0; idx < count; idx++)
     {
@@ -3993,7 +4951,8 @@ cli_show_ip_interface_exec(const char *argv[], int argc,
         if (if_name && (0 != strcmp(if_name, ifrow->name)))
             continue;
 
-        if (!check_iface_in_vrf(ifrow->name) || !(port_row = port_find(ifrow->name)))
+        if (!check_iface_in_vrf(ifrow->name)
+            || !(port_row = port_index_find(idl, ifrow->name)))
         {
             if(if_name)
             {
@@ -4106,6 +5065,112 @@ cli_show_ip_interface_exec(const char *argv[], int argc,
     return 0;
 }
 
+/* Adds the primary and secondary addresses of one family of 'port_row'. */
+static void
+ip_json_put_addresses(struct intf_json *json,
+                      const struct ovsrec_port *port_row, bool isIpv6)
+{
+    char **secondary = isIpv6 ? port_row->ip6_address_secondary
+                              : port_row->ip4_address_secondary;
+    size_t n_secondary = isIpv6 ? port_row->n_ip6_address_secondary
+                                : port_row->n_ip4_address_secondary;
+    size_t i;
+
+    intf_json_string(json, "address",
+                     isIpv6 ? port_row->ip6_address : port_row->ip4_address);
+    intf_json_array_start(json, "secondary_addresses");
+    for (i = 0; i < n_secondary; i++) {
+        intf_json_string(json, NULL, secondary[i]);
+    }
+    intf_json_array_end(json);
+}
+
+/*
+ * "show (ip|ipv6) interface [IFNAME] json".  Lists the same L3 interfaces
+ * as the text output, and the LAG named IFNAME when no interface is.  An
+ * IFNAME that is not L3 gives an empty list.
+ */
+static int
+cli_show_ip_interface_json(struct vty *vty, bool isIpv6, const char *if_name)
+{
+    const struct ovsrec_interface *ifrow;
+    const struct ovsrec_port *port_row;
+    const struct ovsdb_datum *datum;
+    const struct shash_node **nodes;
+    struct intf_json json;
+    bool found = false;
+    int idx, count;
+
+    intf_out_begin();
+    intf_json_init(&json, intf_out_buffer());
+    intf_json_array_start(&json, NULL);
+
+    nodes = get_sorted_interfaces(idl, &count);
+    for (idx = 0; idx < count; idx++) {
+        ifrow = (const struct ovsrec_interface *)nodes[idx]->data;
+
+        if (if_name && strcmp(if_name, ifrow->name)) {
+            continue;
+        }
+        found = true;
+
+        port_row = port_index_find(idl, ifrow->name);
+        if (!port_row || !check_iface_in_vrf(ifrow->name)
+            || !(isIpv6 ? port_row->ip6_address : port_row->ip4_address)) {
+            continue;
+        }
+
+        intf_json_object_start(&json, NULL);
+        intf_json_put_state(&json, ifrow);
+        if (!strcmp(ifrow->type, OVSREC_INTERFACE_TYPE_VLANSUBINT)) {
+            intf_json_string(&json, "mac",
+                             ifrow->n_subintf_parent > 0
+                             ? ifrow->value_subintf_parent[0]->mac_in_use
+                             : NULL);
+        } else if (!strcmp(ifrow->type, OVSREC_INTERFACE_TYPE_LOOPBACK)) {
+            intf_json_string(&json, "mac", NULL);
+        } else {
+            intf_json_string(&json, "mac", ifrow->mac_in_use);
+        }
+        ip_json_put_addresses(&json, port_row, isIpv6);
+
+        if (!strcmp(ifrow->type, OVSREC_INTERFACE_TYPE_SYSTEM)) {
+            datum = ovsrec_interface_get_mtu(ifrow, OVSDB_TYPE_INTEGER);
+            intf_json_int(&json, "mtu", (datum && datum->n > 0)
+                                        ? datum->keys[0].integer : 0);
+            intf_json_put_statistics(&json, "statistics", ifrow,
+                                     isIpv6 ? "ipv6_" : "ipv4_");
+        }
+        intf_json_object_end(&json);
+        intf_out_block_end(vty);
+    }
+
+    /* Check if this is a LAG interface */
+    port_row = (if_name && !found) ? port_index_find(idl, if_name) : NULL;
+    if (port_row
+        && !strncmp(port_row->name, LAG_PORT_NAME_PREFIX,
+                    LAG_PORT_NAME_PREFIX_LENGTH)
+        && check_port_in_vrf(port_row->name)) {
+        intf_json_object_start(&json, NULL);
+        intf_json_string(&json, "name", port_row->name);
+        intf_json_string(&json, "type", "lag");
+        intf_json_bool(&json, "forwarding",
+                       smap_get_bool(&port_row->forwarding_state,
+                                     PORT_FORWARDING_STATE_MAP_FORWARDING,
+                                     false));
+        intf_json_bool(&json, "port_aggregation_forwarding",
+                       smap_get_bool(&port_row->forwarding_state,
+                           PORT_FORWARDING_STATE_MAP_PORT_AGGREGATION_FORWARDING,
+                           false));
+        ip_json_put_addresses(&json, port_row, isIpv6);
+        intf_json_object_end(&json);
+    }
+
+    intf_json_array_end(&json);
+    intf_out_end(vty);
+    return CMD_SUCCESS;
+}
+
 DEFUN (cli_intf_show_ip_intferface,
         cli_intf_show_ip_intferface_ifname_cmd,
         "show (ip|ipv6) interface [IFNAME]",
@@ -4120,6 +5185,31 @@ DEFUN (cli_intf_show_ip_intferface,
     return CMD_SUCCESS;
 }
 
+DEFUN (cli_intf_show_ip_intferface_json,
+        cli_intf_show_ip_intferface_json_cmd,
+        "show (ip|ipv6) interface json",
+        SHOW_STR
+        IP_STR
+        IPV6_STR
+        INTERFACE_STR
+        JSON_STR)
+{
+    return cli_show_ip_interface_json(vty, !strcmp(argv[0], "ipv6"), NULL);
+}
+
+DEFUN (cli_intf_show_ip_intferface_ifname_json,
+        cli_intf_show_ip_intferface_ifname_json_cmd,
+        "show (ip|ipv6) interface IFNAME json",
+        SHOW_STR
+        IP_STR
+        IPV6_STR
+        INTERFACE_STR
+        IFNAME_STR
+        JSON_STR)
+{
+    return cli_show_ip_interface_json(vty, !strcmp(argv[0], "ipv6"), argv[1]);
+}
+
 /*******************************************************************
  * @func        : tempd_ovsdb_init
  * @detail      : Add interface related table & columns to ops-cli
@@ -4174,6 +5264,8 @@ void cli_pre_init(void)
 
     install_node (&interface_node, NULL);
     vtysh_install_default (INTERFACE_NODE);
+    install_node (&interface_range_node, NULL);
+    vtysh_install_default (INTERFACE_RANGE_NODE);
     install_dyn_helpstr_funcptr("dyncb_helpstr_1G", dyncb_helpstr_speeds);
     install_dyn_helpstr_funcptr("dyncb_helpstr_10G", dyncb_helpstr_speeds);
     install_dyn_helpstr_funcptr("dyncb_helpstr_25G", dyncb_helpstr_speeds);
@@ -4205,6 +5297,7 @@ void cli_post_init(void)
     /* Config commands */
     install_element (INTERFACE_NODE, &cli_intf_shutdown_cmd);
     install_element (CONFIG_NODE, &vtysh_interface_cmd);
+    install_element (CONFIG_NODE, &vtysh_interface_range_cmd);
     install_element (INTERFACE_NODE, &no_cli_intf_shutdown_cmd);
     install_element (CONFIG_NODE, &no_vtysh_interface_cmd);
     install_element (INTERFACE_NODE, &vtysh_exit_interface_cmd);
@@ -4214,6 +5307,8 @@ void cli_post_init(void)
     install_element (INTERFACE_NODE, &no_cli_intf_speed_cmd);
     install_element (INTERFACE_NODE, &cli_intf_mtu_cmd);
     install_element (INTERFACE_NODE, &no_cli_intf_mtu_cmd);
+    install_element (INTERFACE_NODE, &cli_intf_load_interval_cmd);
+    install_element (INTERFACE_NODE, &no_cli_intf_load_interval_cmd);
     install_element (INTERFACE_NODE, &cli_intf_duplex_cmd);
     install_element (INTERFACE_NODE, &no_cli_intf_duplex_cmd);
     install_element (INTERFACE_NODE, &cli_intf_flowcontrol_cmd);
@@ -4221,12 +5316,43 @@ void cli_post_init(void)
     install_element (INTERFACE_NODE, &cli_intf_autoneg_cmd);
     install_element (INTERFACE_NODE, &no_cli_intf_autoneg_cmd);
 
+    /* The commands of the range context, which apply to every member. */
+    install_element (INTERFACE_RANGE_NODE, &vtysh_exit_interface_range_cmd);
+    install_element (INTERFACE_RANGE_NODE, &vtysh_end_interface_range_cmd);
+    install_element (INTERFACE_RANGE_NODE, &cli_intf_shutdown_cmd);
+    install_element (INTERFACE_RANGE_NODE, &no_cli_intf_shutdown_cmd);
+    install_element (INTERFACE_RANGE_NODE, &cli_intf_speed_cmd);
+    install_element (INTERFACE_RANGE_NODE, &no_cli_intf_speed_cmd);
+    install_element (INTERFACE_RANGE_NODE, &cli_intf_mtu_cmd);
+    install_element (INTERFACE_RANGE_NODE, &no_cli_intf_mtu_cmd);
+    install_element (INTERFACE_RANGE_NODE, &cli_intf_duplex_cmd);
+    install_element (INTERFACE_RANGE_NODE, &no_cli_intf_duplex_cmd);
+    install_element (INTERFACE_RANGE_NODE, &cli_intf_flowcontrol_cmd);
+    install_element (INTERFACE_RANGE_NODE, &no_cli_intf_flowcontrol_cmd);
+    install_element (INTERFACE_RANGE_NODE, &cli_intf_autoneg_cmd);
+    install_element (INTERFACE_RANGE_NODE, &no_cli_intf_autoneg_cmd);
+
     /* Show commands */
     install_element (ENABLE_NODE, &cli_intf_show_intferface_ifname_cmd);
     install_element (ENABLE_NODE, &cli_intf_show_intferface_ifname_br_cmd);
+    install_element (ENABLE_NODE, &cli_intf_show_interface_status_cmd);
+    install_element (ENABLE_NODE, &cli_intf_show_interface_error_cmd);
+    install_element (ENABLE_NODE, &cli_intf_show_interface_connector_cmd);
+    install_element (ENABLE_NODE, &cli_intf_show_interface_speed_cmd);
+    install_element (ENABLE_NODE, &cli_intf_show_interface_lag_members_cmd);
+    install_element (ENABLE_NODE, &cli_intf_show_interface_rates_cmd);
+    install_element (ENABLE_NODE, &cli_intf_show_interface_ifname_rates_cmd);
+    install_element (ENABLE_NODE,
+                     &cli_intf_show_interface_split_children_cmd);
     install_element (ENABLE_NODE, &cli_intf_show_ip_intferface_ifname_cmd);
+    install_element (ENABLE_NODE, &cli_intf_show_ip_intferface_json_cmd);
+    install_element (ENABLE_NODE,
+                     &cli_intf_show_ip_intferface_ifname_json_cmd);
     install_element (ENABLE_NODE, &cli_intf_show_interface_dom_cmd);
     install_element (ENABLE_NODE, &cli_intf_show_interface_ifname_dom_cmd);
+    install_element (ENABLE_NODE, &cli_intf_show_interface_dom_json_cmd);
+    install_element (ENABLE_NODE,
+                     &cli_intf_show_interface_ifname_dom_json_cmd);
     install_element (ENABLE_NODE, &cli_intf_show_run_intf_cmd);
     install_element (ENABLE_NODE, &cli_intf_show_run_intf_if_cmd);
     install_element (ENABLE_NODE, &cli_intf_show_run_intf_mgmt_cmd);
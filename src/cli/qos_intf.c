@@ -21,6 +21,8 @@
 #include "vswitch-idl.h"
 #include "ovsdb-idl.h"
 #include "qos_intf.h"
+#include "intf_vty.h"
+#include "intf_out.h"
 #include "smap.h"
 #include "memory.h"
 #include "openvswitch/vlog.h"
@@ -32,10 +34,16 @@ extern struct ovsdb_idl *idl;
 
 /**
  * Returns the lag for which the given port_name is a member, or
- * NULL if the port_name is not a member of a lag.
+ * NULL if the port_name is not a member of a lag.  Uses the LAG
+ * membership map while show running-config has it built.
  */
 static const struct ovsrec_port * get_owning_lag(const char *port_name) {
     const struct ovsrec_port *port_row;
+
+    if (lag_member_map_lookup(port_name, &port_row)) {
+        return port_row;
+    }
+
     OVSREC_PORT_FOR_EACH(port_row, idl) {
         int i;
         for (i = 0; i < port_row->n_interfaces; i++) {
@@ -167,7 +175,7 @@ void qos_trust_port_show(const struct ovsrec_port *port_row,
         }
     }
 
-    vty_out(vty, " qos trust %s%s", qos_trust_name, VTY_NEWLINE);
+    intf_out(vty, " qos trust %s%s", qos_trust_name, VTY_NEWLINE);
 }
 
 void qos_cos_port_show(const struct ovsrec_port *port_row,
@@ -189,7 +197,7 @@ void qos_cos_port_show(const struct ovsrec_port *port_row,
         return;
     }
 
-    vty_out(vty, " qos cos override %s%s", cos_map_index, VTY_NEWLINE);
+    intf_out(vty, " qos cos override %s%s", cos_map_index, VTY_NEWLINE);
 }
 
 void qos_apply_port_show(const struct ovsrec_port *port_row,
@@ -226,12 +234,12 @@ void qos_apply_port_show(const struct ovsrec_port *port_row,
     if (queue_profile_status != NULL && strncmp(queue_profile_name,
             queue_profile_status, QOS_MAX_BUFFER_SIZE) != 0) {
         /* Print the status, if it differs from the config. */
-        vty_out(vty, " qos queue-profile %s, status is %s%s",
+        intf_out(vty, " qos queue-profile %s, status is %s%s",
                 queue_profile_name,
                 queue_profile_status,
                 VTY_NEWLINE);
     } else {
-        vty_out(vty, " qos queue-profile %s%s",
+        intf_out(vty, " qos queue-profile %s%s",
                 queue_profile_name,
                 VTY_NEWLINE);
     }
@@ -240,12 +248,12 @@ void qos_apply_port_show(const struct ovsrec_port *port_row,
     if (schedule_profile_status != NULL && strncmp(schedule_profile_name,
             schedule_profile_status, QOS_MAX_BUFFER_SIZE) != 0) {
         /* Print the status, if it differs from the config. */
-        vty_out(vty, " qos schedule-profile %s, status is %s%s",
+        intf_out(vty, " qos schedule-profile %s, status is %s%s",
                 schedule_profile_name,
                 schedule_profile_status,
                 VTY_NEWLINE);
     } else {
-        vty_out(vty, " qos schedule-profile %s%s",
+        intf_out(vty, " qos schedule-profile %s%s",
                 schedule_profile_name,
                 VTY_NEWLINE);
     }
@@ -270,5 +278,5 @@ void qos_dscp_port_show(const struct ovsrec_port *port_row,
         return;
     }
 
-    vty_out(vty, " qos dscp override %s%s", dscp_map_index, VTY_NEWLINE);
+    intf_out(vty, " qos dscp override %s%s", dscp_map_index, VTY_NEWLINE);
 }
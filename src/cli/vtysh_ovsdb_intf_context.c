@@ -36,12 +36,11 @@
 #include "vtysh/vtysh_ovsdb_config.h"
 #include "vtysh_ovsdb_intf_context.h"
 #include "intf_vty.h"
+#include "intfd_rates.h"
 #include "vtysh/utils/lacp_vtysh_utils.h"
 #include "vtysh/utils/intf_vtysh_utils.h"
 #include "vtysh/utils/vlan_vtysh_utils.h"
 
-static struct shash sorted_interfaces;
-
 typedef struct vtysh_ovsdb_intf_cfg_struct
 {
   bool disp_intf_cfg;
@@ -108,20 +107,14 @@ struct feature_sorted_list *
 vtysh_intf_context_init(void *p_private)
 {
    vtysh_ovsdb_cbmsg_ptr p_msg = (vtysh_ovsdb_cbmsg *)p_private;
-   const struct ovsrec_interface *ifrow;
    const struct shash_node **nodes;
    struct feature_sorted_list *sorted_list = NULL;
    int count;
 
-   shash_init(&sorted_interfaces);
-
-   OVSREC_INTERFACE_FOR_EACH(ifrow, p_msg->idl)
-   {
-       shash_add(&sorted_interfaces, ifrow->name, (void *)ifrow);
-   }
-
-   nodes = sort_interface(&sorted_interfaces);
-   count = shash_count(&sorted_interfaces);
+   /* The nodes belong to the shared sorted interface index. */
+   nodes = get_sorted_interfaces(p_msg->idl, &count);
+   /* Answers the LAG membership checks of the QoS callbacks. */
+   lag_member_map_build(p_msg->idl);
    sorted_list = (struct feature_sorted_list *)
                  malloc (sizeof(struct feature_sorted_list));
    if (sorted_list != NULL) {
@@ -181,7 +174,7 @@ vtysh_intf_context_clientcallback(void *p_private)
    }
 
    /* sFlow config */
-   if ((port_row = port_find(ifrow->name))!=NULL)
+   if ((port_row = port_index_find(p_msg->idl, ifrow->name))!=NULL)
    {
        cur_state = smap_get(&port_row->other_config,
                             PORT_OTHER_CONFIG_SFLOW_PER_INTERFACE_KEY_STR);
@@ -232,6 +225,14 @@ vtysh_intf_context_clientcallback(void *p_private)
       vtysh_ovsdb_cli_print(p_msg, "%4s%s %s", "", "mtu", cur_state);
    }
 
+   cur_state = smap_get(&ifrow->user_config,
+                        INTFD_USER_CONFIG_MAP_LOAD_INTERVAL);
+   if (NULL != cur_state)
+   {
+      PRINT_INT_HEADER_IN_SHOW_RUN;
+      vtysh_ovsdb_cli_print(p_msg, "%4s%s %s", "", "load-interval", cur_state);
+   }
+
    cur_state = smap_get(&ifrow->user_config, INTERFACE_USER_CONFIG_MAP_DUPLEX);
    if ((NULL != cur_state)
          && (strcmp(cur_state, INTERFACE_USER_CONFIG_MAP_DUPLEX_FULL) != 0))
@@ -270,7 +271,7 @@ vtysh_intf_context_clientcallback(void *p_private)
       vtysh_ovsdb_cli_print(p_msg, "%4s%s %s", "", "autonegotiation", cur_state);
    }
 
-   const struct ovsrec_port *qos_port_row = port_lookup(ifrow->name, p_msg->idl);
+   const struct ovsrec_port *qos_port_row = port_row;
    qos_trust_port_show_running_config(qos_port_row, &intfcfg.disp_intf_cfg, "interface");
    qos_apply_port_show_running_config(qos_port_row, &intfcfg.disp_intf_cfg, "interface");
    qos_cos_port_show_running_config(qos_port_row, &intfcfg.disp_intf_cfg, "interface");
@@ -284,7 +285,6 @@ vtysh_intf_context_clientcallback(void *p_private)
 void
 vtysh_intf_context_exit(struct feature_sorted_list *list)
 {
-   shash_destroy(&sorted_interfaces);
-   free(list->nodes);
+   lag_member_map_destroy();
    free(list);
 }
@@ -0,0 +1,179 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/****************************************************************************
+ * @ingroup cli
+ *
+ * @file intf_sort.c
+ * Precomputed sort keys for displaying interfaces in name order.
+ *
+ * Shared by the CLI and the rate engine of ops-intfd.  Only libc is used,
+ * so the interface sort benchmark links this file without vtysh.
+ *
+ ***************************************************************************/
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "intf_sort.h"
+
+#define INTF_SORT_BRIDGE_NORMAL "bridge_normal"
+
+/* Parses the decimal number at 'p' into '*value', wrapping like the
+ * "%d"/"%lu" conversions it replaces.  Returns the first byte after it. */
+static const char *
+parse_number(const char *p, uint64_t *value)
+{
+    uint64_t val = 0;
+
+    while (isdigit((unsigned char) *p)) {
+        val = val * 10 + (*p - '0');
+        p++;
+    }
+    *value = val;
+
+    return p;
+} /* parse_number */
+
+/* Numbered names: "10", "54-2", "52-1.1" and "10.1".  A '.' only starts
+ * the subinterface tag directly after the port when the name has no
+ * '-' at all. */
+static void
+parse_numbered(struct intf_sort_key *key, const char *name)
+{
+    uint64_t port, lane = 0, tag = 0;
+    const char *p;
+
+    p = parse_number(name, &port);
+    if (p[0] == '-' && isdigit((unsigned char) p[1])) {
+        p = parse_number(p + 1, &lane);
+        if (p[0] == '.' && isdigit((unsigned char) p[1])) {
+            parse_number(p + 1, &tag);
+        }
+    } else if (p[0] == '.' && isdigit((unsigned char) p[1])
+               && !strchr(p, '-')) {
+        parse_number(p + 1, &tag);
+    }
+
+    key->major = ((port & UINT32_MAX) << 32) | (lane & UINT32_MAX);
+    key->minor = tag;
+} /* parse_numbered */
+
+/* Named interfaces: "vlan20", "lo23", "lag1".  The prefix up to the first
+ * digit is packed big-endian so that integer order matches strcmp(). */
+static void
+parse_named(struct intf_sort_key *key, const char *name)
+{
+    uint64_t packed = 0, digits = 0;
+    const char *p = name;
+    size_t len;
+
+    while (*p && !isdigit((unsigned char) *p)) {
+        p++;
+    }
+    len = p - name;
+
+    for (p = name; p < name + INTF_SORT_PACKED_PREFIX_LEN; p++) {
+        packed <<= 8;
+        if (p < name + len) {
+            packed |= (unsigned char) *p;
+        }
+    }
+
+    for (p = name + len; *p; p++) {
+        if (isdigit((unsigned char) *p)) {
+            digits = digits * 10 + (*p - '0');
+        }
+    }
+
+    key->major = packed;
+    key->minor = digits;
+    key->prefix_len = len;
+} /* parse_named */
+
+void
+intf_sort_key_init(struct intf_sort_key *key, const char *name,
+                   const void *data)
+{
+    memset(key, 0, sizeof *key);
+    key->name = name;
+    key->data = data;
+
+    if (!strcmp(name, INTF_SORT_BRIDGE_NORMAL)) {
+        key->cls = INTF_SORT_CLASS_BRIDGE_NORMAL;
+    } else if (isdigit((unsigned char) *name)) {
+        key->cls = INTF_SORT_CLASS_NUMBERED;
+        parse_numbered(key, name);
+    } else {
+        key->cls = INTF_SORT_CLASS_NAMED;
+        parse_named(key, name);
+    }
+} /* intf_sort_key_init */
+
+/* Orders type prefixes longer than INTF_SORT_PACKED_PREFIX_LEN whose
+ * packed bytes are equal. */
+static int
+compare_long_prefix(const struct intf_sort_key *a,
+                    const struct intf_sort_key *b)
+{
+    size_t len = a->prefix_len < b->prefix_len ? a->prefix_len
+                                               : b->prefix_len;
+    int cmp = memcmp(a->name, b->name, len);
+
+    if (cmp) {
+        return cmp < 0 ? -1 : 1;
+    }
+    if (a->prefix_len != b->prefix_len) {
+        return a->prefix_len < b->prefix_len ? -1 : 1;
+    }
+
+    return 0;
+} /* compare_long_prefix */
+
+/* qsort comparator for 'struct intf_sort_key'. */
+int
+intf_sort_key_compare(const void *a_, const void *b_)
+{
+    const struct intf_sort_key *a = a_;
+    const struct intf_sort_key *b = b_;
+
+    if (a->cls != b->cls) {
+        return a->cls < b->cls ? -1 : 1;
+    }
+    if (a->major != b->major) {
+        return a->major < b->major ? -1 : 1;
+    }
+    if (a->cls == INTF_SORT_CLASS_NAMED
+        && (a->prefix_len > INTF_SORT_PACKED_PREFIX_LEN
+            || b->prefix_len > INTF_SORT_PACKED_PREFIX_LEN)) {
+        int cmp = compare_long_prefix(a, b);
+
+        if (cmp) {
+            return cmp;
+        }
+    }
+    if (a->minor != b->minor) {
+        return a->minor < b->minor ? -1 : 1;
+    }
+
+    return 0;
+} /* intf_sort_key_compare */
+
+void
+intf_sort_keys(struct intf_sort_key *keys, size_t n)
+{
+    qsort(keys, n, sizeof *keys, intf_sort_key_compare);
+} /* intf_sort_keys */
@@ -0,0 +1,122 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup ops-intfd
+ *
+ * @file
+ * Source for the Interface "statistics" column decoder.
+ *
+ ***************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "ovsdb-data.h"
+#include "ovsdb-idl.h"
+#include "vswitch-idl.h"
+#include "intf_stats.h"
+
+#define STAT(KEY, MEMBER) { KEY, offsetof(struct intf_stats, MEMBER) }
+
+/* The keys intf_stats knows, in strcmp() order like the keys of a datum.
+ * Keep it sorted: intf_stats_decode() relies on it. */
+static const struct intf_stats_key {
+    const char *key;
+    size_t offset;
+} intf_stats_keys[] = {
+    STAT("collisions",         collisions),
+    STAT("ipv4_mc_rx_bytes",   ipv4.mc_rx_bytes),
+    STAT("ipv4_mc_rx_packets", ipv4.mc_rx_packets),
+    STAT("ipv4_mc_tx_bytes",   ipv4.mc_tx_bytes),
+    STAT("ipv4_mc_tx_packets", ipv4.mc_tx_packets),
+    STAT("ipv4_uc_rx_bytes",   ipv4.uc_rx_bytes),
+    STAT("ipv4_uc_rx_packets", ipv4.uc_rx_packets),
+    STAT("ipv4_uc_tx_bytes",   ipv4.uc_tx_bytes),
+    STAT("ipv4_uc_tx_packets", ipv4.uc_tx_packets),
+    STAT("ipv6_mc_rx_bytes",   ipv6.mc_rx_bytes),
+    STAT("ipv6_mc_rx_packets", ipv6.mc_rx_packets),
+    STAT("ipv6_mc_tx_bytes",   ipv6.mc_tx_bytes),
+    STAT("ipv6_mc_tx_packets", ipv6.mc_tx_packets),
+    STAT("ipv6_uc_rx_bytes",   ipv6.uc_rx_bytes),
+    STAT("ipv6_uc_rx_packets", ipv6.uc_rx_packets),
+    STAT("ipv6_uc_tx_bytes",   ipv6.uc_tx_bytes),
+    STAT("ipv6_uc_tx_packets", ipv6.uc_tx_packets),
+    STAT("rx_bytes",           rx_bytes),
+    STAT("rx_crc_err",         rx_crc_err),
+    STAT("rx_dropped",         rx_dropped),
+    STAT("rx_errors",          rx_errors),
+    STAT("rx_frame_err",       rx_frame_err),
+    STAT("rx_over_err",        rx_over_err),
+    STAT("rx_packets",         rx_packets),
+    STAT("tx_bytes",           tx_bytes),
+    STAT("tx_dropped",         tx_dropped),
+    STAT("tx_errors",          tx_errors),
+    STAT("tx_packets",         tx_packets),
+};
+
+#define N_INTF_STATS_KEYS (sizeof intf_stats_keys / sizeof intf_stats_keys[0])
+
+void
+intf_stats_decode(const struct ovsdb_datum *datum, struct intf_stats *stats)
+{
+    size_t i, k;
+
+    memset(stats, 0, sizeof *stats);
+    if (!datum) {
+        return;
+    }
+
+    /* Both sides are sorted: advance whichever one has the smaller key. */
+    for (i = k = 0; i < datum->n && k < N_INTF_STATS_KEYS; ) {
+        int cmp = strcmp(datum->keys[i].string, intf_stats_keys[k].key);
+
+        if (cmp < 0) {
+            i++;
+        } else if (cmp > 0) {
+            k++;
+        } else {
+            *(uint64_t *) ((char *) stats + intf_stats_keys[k].offset)
+                = datum->values[i].integer;
+            i++;
+            k++;
+        }
+    }
+} /* intf_stats_decode */
+
+void
+intf_stats_from_interface(const struct ovsrec_interface *ifrow,
+                          struct intf_stats *stats)
+{
+    intf_stats_decode(ovsrec_interface_get_statistics(ifrow,
+                                                      OVSDB_TYPE_STRING,
+                                                      OVSDB_TYPE_INTEGER),
+                      stats);
+} /* intf_stats_from_interface */
+
+void
+intf_stats_add(struct intf_stats *restrict sum,
+               const struct intf_stats *restrict stats)
+{
+    uint64_t *restrict dst = (uint64_t *) sum;
+    const uint64_t *restrict src = (const uint64_t *) stats;
+    size_t i;
+
+    /* struct intf_stats is nothing but uint64_t counters: add them as one
+     * dense array, which the compiler vectorizes. */
+    for (i = 0; i < sizeof *sum / sizeof *dst; i++) {
+        dst[i] += src[i];
+    }
+} /* intf_stats_add */
@@ -62,6 +62,8 @@
 #include <shash.h>
 
 #include "intfd.h"
+#include "intfd_rates.h"
+#include "intfd_record.h"
 #include "eventlog.h"
 #include <diag_dump.h>
 
@@ -83,6 +85,9 @@ usage(void)
     daemon_usage();
     vlog_usage();
     printf("\nOther options:\n"
+           "  --record=FILE           record the OVSDB update stream to FILE\n"
+           "  --standby               keep state current while another instance\n"
+           "                          holds the ops_intfd lock (hot standby)\n"
            "  --unixctl=SOCKET        override default control socket name\n"
            "  -h, --help              display this help message\n");
     exit(EXIT_SUCCESS);
@@ -100,6 +105,34 @@ intfd_unixctl_dump(struct unixctl_conn *conn, int argc,
     ds_destroy(&ds);
 } /* intfd_unixctl_dump */
 
+static void
+intfd_unixctl_record(struct unixctl_conn *conn, int argc OVS_UNUSED,
+                     const char *argv[], void *aux OVS_UNUSED)
+{
+    if (!strcmp(argv[1], "stop")) {
+        intfd_record_stop();
+        unixctl_command_reply(conn, NULL);
+    } else if (intfd_record_start(argv[1])) {
+        unixctl_command_reply(conn, NULL);
+    } else {
+        unixctl_command_reply_error(conn, "Could not open record file");
+    }
+} /* intfd_unixctl_record */
+
+static void
+intfd_unixctl_rates(struct unixctl_conn *conn, int argc,
+                    const char *argv[], void *aux OVS_UNUSED)
+{
+    struct ds ds = DS_EMPTY_INITIALIZER;
+
+    if (intfd_rates_dump(&ds, argc > 1 ? argv[1] : NULL)) {
+        unixctl_command_reply(conn, ds_cstr(&ds));
+    } else {
+        unixctl_command_reply_error(conn, "No such interface");
+    }
+    ds_destroy(&ds);
+} /* intfd_unixctl_rates */
+
 /*
  * Function         : intfd_diag_dump_basic_cb
  * Responsibility   : callback handler function for diagnostic dump basic
@@ -150,6 +183,10 @@ intfd_init(const char *db_path)
 
     /* Register ovs-appctl commands for this daemon. */
     unixctl_command_register("ops-intfd/dump", "", 0, 1, intfd_unixctl_dump, NULL);
+    unixctl_command_register("ops-intfd/record", "FILE|stop", 1, 1,
+                             intfd_unixctl_record, NULL);
+    unixctl_command_register("ops-intfd/rates", "[IFNAME]", 0, 1,
+                             intfd_unixctl_rates, NULL);
 } /* intfd_init */
 
 static void
@@ -159,16 +196,21 @@ intfd_exit(void)
 } /* intfd_exit */
 
 static char *
-parse_options(int argc, char *argv[], char **unixctl_pathp)
+parse_options(int argc, char *argv[], char **unixctl_pathp,
+              char **record_pathp, bool *standbyp)
 {
     enum {
         OPT_UNIXCTL = UCHAR_MAX + 1,
+        OPT_RECORD,
+        OPT_STANDBY,
         VLOG_OPTION_ENUMS,
         DAEMON_OPTION_ENUMS,
     };
     static const struct option long_options[] = {
         {"help",        no_argument, NULL, 'h'},
         {"unixctl",     required_argument, NULL, OPT_UNIXCTL},
+        {"record",      required_argument, NULL, OPT_RECORD},
+        {"standby",     no_argument, NULL, OPT_STANDBY},
         DAEMON_LONG_OPTIONS,
         VLOG_LONG_OPTIONS,
         {NULL, 0, NULL, 0},
@@ -191,6 +233,14 @@ parse_options(int argc, char *argv[], char **unixctl_pathp)
             *unixctl_pathp = optarg;
             break;
 
+        case OPT_RECORD:
+            *record_pathp = optarg;
+            break;
+
+        case OPT_STANDBY:
+            *standbyp = true;
+            break;
+
         VLOG_OPTION_HANDLERS
         DAEMON_OPTION_HANDLERS
 
@@ -232,6 +282,8 @@ int
 main(int argc, char *argv[])
 {
     char *appctl_path = NULL;
+    char *record_path = NULL;
+    bool standby = false;
     struct unixctl_server *appctl;
     char *ovsdb_sock;
     bool exiting;
@@ -242,7 +294,8 @@ main(int argc, char *argv[])
     fatal_ignore_sigpipe();
 
     /* Parse commandline args and get the name of the OVSDB socket. */
-    ovsdb_sock = parse_options(argc, argv, &appctl_path);
+    ovsdb_sock = parse_options(argc, argv, &appctl_path, &record_path,
+                               &standby);
 
     /* Initialize the metadata for the IDL cache. */
     ovsrec_init();
@@ -263,6 +316,11 @@ main(int argc, char *argv[])
     /* Create the IDL cache of the dB at ovsdb_sock. */
     intfd_init(ovsdb_sock);
     free(ovsdb_sock);
+    intfd_ovsdb_set_standby(standby);
+
+    if (record_path && !intfd_record_start(record_path)) {
+        exit(EXIT_FAILURE);
+    }
 
     /* Notify parent of startup completion. */
     daemonize_complete();
@@ -0,0 +1,1216 @@
+/*
+ * (c) Copyright 2015 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup intfd
+ *
+ * @file
+ * Source for the intfd interface decision logic.
+ *
+ * Everything in here works on the plain structs declared in intfd_core.h.
+ * There is no IDL, smap or logging dependency and nothing is allocated,
+ * so the same object code is linked into ops-intfd, ops-intfd-replay and
+ * intfd_core_bench.
+ *
+ ***************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include <openswitch-idl.h>
+
+#include "intfd_core.h"
+
+/** @ingroup intfd
+ * @{ */
+
+static uint64_t
+get_connector_flags(enum ovsrec_interface_pm_info_connector_e connector)
+{
+    switch (connector) {
+    case INTERFACE_PM_INFO_CONNECTOR_SFP_RJ45:
+    case INTERFACE_PM_INFO_CONNECTOR_SFP_SX:
+        return PM_SFP_FLAGS;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_SFP_SR:
+    case INTERFACE_PM_INFO_CONNECTOR_SFP_LR:
+    case INTERFACE_PM_INFO_CONNECTOR_SFP_ER:
+    case INTERFACE_PM_INFO_CONNECTOR_SFP_LRM:
+    case INTERFACE_PM_INFO_CONNECTOR_SFP_DAC:
+        return PM_SFP_PLUS_FLAGS;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_SFP28_SR:
+    case INTERFACE_PM_INFO_CONNECTOR_SFP28_LR:
+    case INTERFACE_PM_INFO_CONNECTOR_SFP28_CR:
+        return PM_SFP28_25G_FLAGS;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_QSFP_CR4:
+    case INTERFACE_PM_INFO_CONNECTOR_QSFP_SR4:
+    case INTERFACE_PM_INFO_CONNECTOR_QSFP_LR4:
+        return PM_QSFP_PLUS_40G_FLAGS;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_SR4:
+    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_LR4:
+    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_CR4:
+    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_CLR4:
+    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_PSM4:
+    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_CWDM4:
+        return PM_QSFP28_100G_FLAGS;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_ABSENT:
+    case INTERFACE_PM_INFO_CONNECTOR_UNKNOWN:
+    case INTERFACE_PM_INFO_CONNECTOR_SFP_LX:
+    case INTERFACE_PM_INFO_CONNECTOR_SFP_CX:
+    case INTERFACE_PM_INFO_CONNECTOR_SFP_FC:
+    default:
+        return PM_UNSUPPORTED_FLAG;
+        break;
+    }
+} /* get_connector_flags */
+
+static enum ovsrec_interface_hw_intf_config_interface_type_e
+get_connector_if_type(enum ovsrec_interface_pm_info_connector_e connector)
+{
+    switch (connector) {
+    case INTERFACE_PM_INFO_CONNECTOR_SFP_SX:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_1GBASE_SX;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_SFP_RJ45:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_1GBASE_T;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_SFP_DAC:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_10GBASE_CR;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_SFP_SR:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_10GBASE_SR;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_SFP_LR:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_10GBASE_LR;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_SFP_ER:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_10GBASE_ER;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_QSFP_CR4:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_40GBASE_CR4;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_QSFP_SR4:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_40GBASE_SR4;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_QSFP_LR4:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_40GBASE_LR4;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_SFP28_CR:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_25GBASE_CR;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_SFP28_SR:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_25GBASE_SR;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_SFP28_LR:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_25GBASE_LR;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_CR4:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_100GBASE_CR4;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_SR4:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_100GBASE_SR4;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_LR4:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_100GBASE_LR4;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_CLR4:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_100GBASE_CLR4;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_PSM4:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_100GBASE_PSM4;
+        break;
+    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_CWDM4:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_100GBASE_CWDM4;
+        break;
+    default:
+        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_UNKNOWN;
+        break;
+    }
+} /* get_connector_if_type */
+
+static bool
+is_a_number(const char *nbr)
+{
+    while (*nbr) {
+        if (!isdigit(*nbr++)) {
+            return (false);
+        }
+    }
+
+    return (true);
+
+} /* is_a_number */
+
+static int
+parse_speeds(const char *speeds_str, uint32_t *speeds)
+{
+    const char *ptr = speeds_str;
+    const char *end;
+    int i = 0;
+
+    if (speeds_str == NULL) {
+        return (0);
+    }
+
+    /* Same rules as a strtok(",") walk, without the copy: empty
+     * entries are skipped and every entry must be all digits. */
+    while (*ptr) {
+        if (*ptr == ',') {
+            ptr++;
+            continue;
+        }
+
+        for (end = ptr; *end && *end != ','; end++) {
+            if (!isdigit(*end)) {
+                return (-1);
+            }
+        }
+
+        if (i >= INTFD_MAX_SPEEDS_ALLOWED) {
+            return (-1);
+        }
+        speeds[i] = atoi(ptr);
+        i++;
+        ptr = end;
+    }
+
+    return (i);
+
+} /* parse_speeds */
+
+void
+intfd_core_parse_hw_info(struct intf_hw_info *hw_info,
+                         const struct intf_hw_info_raw *raw)
+{
+    const char *data = NULL;
+
+    /* hw_info:pluggable */
+    hw_info->is_pluggable = false;
+
+    /* Check if the interface is pluggable. */
+    data = raw->pluggable;
+    if (data && (STR_EQ(data, INTERFACE_HW_INTF_INFO_MAP_PLUGGABLE_TRUE))) {
+        hw_info->is_pluggable = true;
+    }
+
+    /* hw_info:connector */
+    hw_info->connector = INTERFACE_HW_INTF_INFO_CONNECTOR_UNKNOWN;
+
+    /* Check the connector type. */
+    data = raw->connector;
+    if (data && (STR_EQ(data, INTERFACE_HW_INTF_INFO_MAP_CONNECTOR_RJ45))) {
+        hw_info->connector = INTERFACE_HW_INTF_INFO_CONNECTOR_RJ45;
+
+    } else if (data && (STR_EQ(data, INTERFACE_HW_INTF_INFO_MAP_CONNECTOR_SFP_PLUS))) {
+        hw_info->connector = INTERFACE_HW_INTF_INFO_CONNECTOR_SFP_PLUS;
+
+    } else if (data && (STR_EQ(data, INTERFACE_HW_INTF_INFO_MAP_CONNECTOR_QSFP_PLUS))) {
+        hw_info->connector = INTERFACE_HW_INTF_INFO_CONNECTOR_QSFP_PLUS;
+
+    } else if (data && (STR_EQ(data, INTERFACE_HW_INTF_INFO_MAP_CONNECTOR_QSFP28))) {
+        hw_info->connector = INTERFACE_HW_INTF_INFO_CONNECTOR_QSFP28;
+
+    }
+
+    memset(hw_info->speeds, 0, sizeof(hw_info->speeds));
+    hw_info->n_speeds = 0;
+    data = raw->speeds;
+    if (data) {
+        hw_info->n_speeds = parse_speeds(data, hw_info->speeds);
+    }
+
+    hw_info->max_speed = 0;
+    data = raw->max_speed;
+    if (data) {
+        hw_info->max_speed = atoi(data);
+    }
+
+} /* intfd_core_parse_hw_info */
+
+void
+intfd_core_parse_user_cfg(struct intf_user_cfg *user_config,
+                          const struct intf_user_cfg_raw *raw,
+                          const char *hw_info_speeds,
+                          int32_t max_mtu)
+{
+    const char *data = NULL;
+    struct intf_hw_info hw_supported_speeds;
+
+    /* FIXME: Add functions to validate the user_config data.
+     * Without meta-schema we can't do such validation. */
+
+    /* user_config:admin_state */
+    user_config->admin_state = INTERFACE_USER_CONFIG_ADMIN_DOWN;
+
+    data = raw->admin;
+    if (data && (STR_EQ(data, OVSREC_INTERFACE_USER_CONFIG_ADMIN_UP))) {
+        user_config->admin_state = INTERFACE_USER_CONFIG_ADMIN_UP;
+    }
+
+    /* user_config:autoneg */
+    user_config->autoneg = INTERFACE_USER_CONFIG_AUTONEG_DEFAULT;
+
+    data = raw->autoneg;
+    if (data && (STR_EQ(data, INTERFACE_USER_CONFIG_MAP_AUTONEG_OFF))) {
+        user_config->autoneg = INTERFACE_USER_CONFIG_AUTONEG_OFF;
+
+    } else if (data && (STR_EQ(data, INTERFACE_USER_CONFIG_MAP_AUTONEG_ON))) {
+        user_config->autoneg = INTERFACE_USER_CONFIG_AUTONEG_ON;
+    }
+
+    /* user_config:pause */
+    user_config->pause = INTERFACE_USER_CONFIG_PAUSE_NONE;
+
+    data = raw->pause;
+    if (data && (STR_EQ(data, INTERFACE_USER_CONFIG_MAP_PAUSE_RXTX))) {
+        user_config->pause = INTERFACE_USER_CONFIG_PAUSE_RXTX;
+
+    } else if (data && (STR_EQ(data, INTERFACE_USER_CONFIG_MAP_PAUSE_TX))) {
+        user_config->pause = INTERFACE_USER_CONFIG_PAUSE_TX;
+
+    } else if (data && (STR_EQ(data, INTERFACE_USER_CONFIG_MAP_PAUSE_RX))) {
+        user_config->pause = INTERFACE_USER_CONFIG_PAUSE_RX;
+    }
+
+    /* user_config:duplex */
+    user_config->duplex = INTERFACE_USER_CONFIG_DUPLEX_FULL;
+
+    data = raw->duplex;
+    if (data && (STR_EQ(data, INTERFACE_USER_CONFIG_MAP_DUPLEX_HALF))) {
+        user_config->duplex = INTERFACE_USER_CONFIG_DUPLEX_HALF;
+    }
+
+    /* Get user supplied speeds which can be passed on to vswitchd.
+     * data (user supplied speeds) is a comma separated list of numeric strings.
+     * Need to verify user input against supported speeds list.
+    */
+    user_config->n_speeds = 0;
+    data = raw->speeds;
+    if (data) {
+        int i, j, found;
+
+        memset(user_config->speeds, 0, sizeof(user_config->speeds));
+        /* parse_speeds() returns -1 if invalid user input */
+        user_config->n_speeds =
+                        parse_speeds(data, user_config->speeds);
+
+        if (user_config->n_speeds > 0) {
+            /* Get speeds from hw_info */
+            hw_supported_speeds.n_speeds = parse_speeds(hw_info_speeds,
+                                           hw_supported_speeds.speeds);
+            if (user_config->n_speeds <= hw_supported_speeds.n_speeds) {
+                for (i = 0; i < user_config->n_speeds; i++) {
+                    found = false;
+                    for (j = 0; j < hw_supported_speeds.n_speeds; j++) {
+                        if (user_config->speeds[i] ==
+                            hw_supported_speeds.speeds[j]) {
+
+                            found = true;
+                            break;
+                        }
+                    }
+                    if (!found) {
+                        user_config->n_speeds = -1;
+                        break;
+                    }
+                }
+            } else {
+                user_config->n_speeds = -1;
+            }
+        }
+    }
+
+    user_config->mtu = 0;
+    data = raw->mtu;
+    if (data) {
+        user_config->mtu = -1;
+        if (is_a_number(data)) {
+            user_config->mtu = atoi(data);
+            if ((user_config->mtu < INTFD_MIN_ALLOWED_USER_SPECIFIED_MTU) ||
+                (user_config->mtu > max_mtu)) {
+
+                user_config->mtu = -1;
+            }
+        }
+    }
+
+    /* user_config:lane_split */
+    user_config->lane_split = INTERFACE_USER_CONFIG_LANE_SPLIT_NO_SPLIT;
+    data = raw->lane_split;
+    if (data && (STR_EQ(data, INTERFACE_USER_CONFIG_MAP_LANE_SPLIT_SPLIT))) {
+        user_config->lane_split = INTERFACE_USER_CONFIG_LANE_SPLIT_SPLIT;
+    }
+
+} /* intfd_core_parse_user_cfg */
+
+void
+intfd_core_parse_split_pm_info(struct intf_pm_info *pm_info,
+                               const struct intf_pm_info_raw *parent_raw)
+{
+    const char *data = NULL;
+    const char *sup_speed = NULL;
+
+    /* pm_info:connector_status */
+    pm_info->connector_status = INTERFACE_PM_INFO_CONNECTOR_STATUS_UNRECOGNIZED;
+
+    data = parent_raw->connector_status;
+    if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_STATUS_UNSUPPORTED))) {
+        pm_info->connector_status = INTERFACE_PM_INFO_CONNECTOR_STATUS_UNSUPPORTED;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_STATUS_SUPPORTED))) {
+        pm_info->connector_status = INTERFACE_PM_INFO_CONNECTOR_STATUS_SUPPORTED;
+    }
+
+    data = parent_raw->connector;
+    if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_CWDM4))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP28_LR;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_PSM4))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP28_LR;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_CLR4))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP28_LR;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_CR4))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP28_CR;
+        //check if 40G DAC is connected; by reading the supported speed
+        sup_speed = parent_raw->supported_speeds;
+        if ( sup_speed  && (STR_EQ( sup_speed, "40000"))) {
+            pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_DAC;
+        }
+
+    }  else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_LR4))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP28_LR;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_SR4))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP28_SR;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP_CR4))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_DAC;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP_LR4))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_LR;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP_SR4))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_SR;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_ABSENT))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_ABSENT;
+
+    } else {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_UNKNOWN;
+        pm_info->connector_status = INTERFACE_PM_INFO_CONNECTOR_STATUS_UNSUPPORTED;
+    }
+
+    pm_info->op_connector_flags = get_connector_flags(pm_info->connector);
+    pm_info->intf_type = get_connector_if_type(pm_info->connector);
+
+} /* intfd_core_parse_split_pm_info */
+
+void
+intfd_core_parse_pm_info(const struct intf_hw_info *hw_info,
+                         struct intf_pm_info *pm_info,
+                         const struct intf_pm_info_raw *raw)
+{
+    const char *data = NULL;
+
+    /* If the interface is a fixed port (non-pluggable). */
+    if (hw_info->is_pluggable == false) {
+
+        pm_info->connector_status = INTERFACE_PM_INFO_CONNECTOR_STATUS_SUPPORTED;
+
+        /* Currently intfd only cares about non-pluggable fixed ports of type RJ45.
+         * All other connector types are pluggable, and for them
+         * pm_info will give the details about the pluggable module.
+         */
+        if (hw_info->connector == INTERFACE_HW_INTF_INFO_CONNECTOR_RJ45) {
+            pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_RJ45;
+
+        } else {
+            pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_UNKNOWN;
+            pm_info->connector_status = INTERFACE_PM_INFO_CONNECTOR_STATUS_UNRECOGNIZED;
+        }
+
+        pm_info->op_connector_flags = get_connector_flags(pm_info->connector);
+        pm_info->intf_type = get_connector_if_type(pm_info->connector);
+
+        return;
+    }
+
+
+    /* pm_info:connector_status */
+    pm_info->connector_status = INTERFACE_PM_INFO_CONNECTOR_STATUS_UNRECOGNIZED;
+
+    data = raw->connector_status;
+    if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_STATUS_UNSUPPORTED))) {
+        pm_info->connector_status = INTERFACE_PM_INFO_CONNECTOR_STATUS_UNSUPPORTED;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_STATUS_SUPPORTED))) {
+        pm_info->connector_status = INTERFACE_PM_INFO_CONNECTOR_STATUS_SUPPORTED;
+    }
+
+    /* pm_info:connector */
+    pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_UNKNOWN;
+
+    data = raw->connector;
+    if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_CWDM4))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_QSFP28_CWDM4;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_PSM4))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_QSFP28_PSM4;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_CLR4))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_QSFP28_CLR4;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_CR4))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_QSFP28_CR4;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_LR4))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_QSFP28_LR4;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_SR4))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_QSFP28_SR4;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP28_CR))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP28_CR;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP28_LR))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP28_LR;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP28_SR))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP28_SR;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP_CR4))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_QSFP_CR4;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP_LR4))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_QSFP_LR4;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP_SR4))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_QSFP_SR4;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_CX))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_CX;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_DAC))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_DAC;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_FC))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_FC;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_LR))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_LR;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_LRM))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_LRM;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_ER))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_ER;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_LX))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_LX;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_RJ45))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_RJ45;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_SR))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_SR;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_SX))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_SX;
+
+    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_ABSENT))) {
+        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_ABSENT;
+    }
+
+    pm_info->op_connector_flags = get_connector_flags(pm_info->connector);
+    pm_info->intf_type = get_connector_if_type(pm_info->connector);
+
+} /* intfd_core_parse_pm_info */
+
+static void
+set_op_state_pause(struct iface *intf)
+{
+    enum ovsrec_interface_hw_intf_config_pause_e hw_pause;
+
+    switch(intf->user_cfg.pause) {
+
+    case INTERFACE_USER_CONFIG_PAUSE_RXTX:
+        hw_pause = INTERFACE_HW_INTF_CONFIG_PAUSE_RXTX;
+        break;
+
+    case INTERFACE_USER_CONFIG_PAUSE_TX:
+        hw_pause = INTERFACE_HW_INTF_CONFIG_PAUSE_TX;
+        break;
+
+    case INTERFACE_USER_CONFIG_PAUSE_RX:
+        hw_pause = INTERFACE_HW_INTF_CONFIG_PAUSE_RX;
+        break;
+
+    case INTERFACE_USER_CONFIG_PAUSE_NONE:
+    default:
+        hw_pause = INTERFACE_HW_INTF_CONFIG_PAUSE_NONE;
+        break;
+    }
+    intf->op_state.pause = hw_pause;
+
+} /* set_op_state_pause */
+
+static uint32_t
+intfd_highest_speed(uint32_t *speeds, int num_speeds)
+{
+    uint32_t speed;
+    int i;
+
+    if (num_speeds < 1) {
+        return 0;
+    }
+
+    speed = speeds[0];
+    for (i = 1; i < num_speeds; i++) {
+        if (speeds[i] > speed) {
+            speed = speeds[i];
+        }
+    }
+
+    return (speed);
+
+} /* intfd_highest_speed */
+
+static void
+set_op_state_duplex(struct iface *intf)
+{
+    enum ovsrec_interface_hw_intf_config_duplex_e hw_duplex;
+
+    switch(intf->user_cfg.duplex) {
+
+    case INTERFACE_USER_CONFIG_DUPLEX_HALF:
+        hw_duplex = INTERFACE_HW_INTF_CONFIG_DUPLEX_HALF;
+        break;
+
+    case INTERFACE_USER_CONFIG_DUPLEX_FULL:
+    default:
+       hw_duplex = INTERFACE_HW_INTF_CONFIG_DUPLEX_FULL;
+        break;
+    }
+    intf->op_state.duplex = hw_duplex;
+
+} /* set_op_state_duplex */
+
+/* FUNCTION: calc_intf_op_state_n_reason()
+ *
+ * This function determines an interface's operational state & reasons:
+ *
+ *    - op state:        Interface "hw_intf_config:enable"
+ *    - op state reason: Interface "error"
+ *
+ * Following is a complete summary of the different operational states
+ * and the associated reasons for an interface, listed in order of
+ * priority, with the highest priority values listed first.
+ *
+ * Note that if multiple reasons apply to an interface, only the
+ * highest priority reason is displayed.  E.g., if a pluggable
+ * interface does not have any pluggable module installed, and its
+ * interface admin state is set to disabled by an administrator, then
+ * "error" will only show "admin_down".  It becomes "unpopulated"
+ * after its admin interface state is set to enabled.
+ *
+ * OP STATE  OP STATE REASON        NOTES
+ * --------  ---------------        -----
+ *
+ * disabled  lanes_split
+ *                  Interface is not usable due to the interface being
+ *                  configured in split mode.  Applicable to
+ *                  splittable primary interface only (e.g. QSFP+, QSFP28).
+ *
+ * disabled  lanes_not_split
+ *                  Interface is not usable due to the interface being
+ *                  configured in non-split mode. Applicable to
+ *                  splittable subinterfaces only (e.g. QSFP+, QSFP28).
+ *
+ * disabled  admin_down
+ *                  Interface "user_config:admin" property is set to
+ *                  "down" by an administrator.
+ *
+ * disabled  module_missing
+ *                  Interface is pluggable, but no pluggable module is
+ *                  present.
+ *
+ * disabled  module_unrecognized
+ *                  Interface is pluggable, but the pluggable module
+ *                  identification information cannot be read.
+ *
+ * disabled  module_unsupported
+ *                  Interface is pluggable, but the pluggable module
+ *                  type is not supported.  This may be one of the
+ *                  following reasons:
+ *                   1. Unsupported module.
+ *                   2. Enet 1/10/40G modules in an interface that
+ *                      does not support that particular Ethernet
+ *                      speed.
+ *
+ * disabled  invalid_mtu
+ *                  User specified MTU is invalid.
+ *
+ * disabled  invalid_speeds
+ *                  User specified speeds is invalid.
+ *
+ * disabled  autoneg_required
+ *                  User specified autoneg=off when it is required
+ *
+ * disabled  autoneg_not_supported
+ *                  User specified autoneg=on when it is not supported
+ *
+ * NOTE: All new checks should be added above the following
+ *
+ * enabled   ok
+ *                  A supported module is present and everything is
+ *                  fine.  Interface is enabled.  This does not imply
+ *                  link is necessarily up; it simply means a
+ *                  interface is enabled at the h/w level.
+ */
+static void
+calc_intf_op_state_n_reason(struct iface *intf)
+{
+    /* Default the interface to disabled. */
+    intf->op_state.enabled = false;
+    intf->op_state.reason = INTERFACE_ERROR_UNINITIALIZED;
+
+    if (intf->type_class != INTFD_TYPE_CLASS_SYSTEM) {
+        if (intf->user_cfg.admin_state == INTERFACE_USER_CONFIG_ADMIN_DOWN) {
+            intf->op_state.reason = INTERFACE_ERROR_ADMIN_DOWN;
+
+        /* Checking for port admin as down */
+        } else if (intf->port_admin == PORT_ADMIN_CONFIG_DOWN) {
+            intf->op_state.reason = PORT_ERROR_ADMIN_DOWN;
+        } else {
+            intf->op_state.enabled = true;
+            intf->op_state.reason = INTERFACE_ERROR_OK;
+        }
+        return;
+    }
+
+    /* Checking for splittable primary interface & lanes_split condition. */
+    if (intf->split_children != NULL &&
+        intf->user_cfg.lane_split == INTERFACE_USER_CONFIG_LANE_SPLIT_SPLIT) {
+        intf->op_state.reason = INTERFACE_ERROR_LANES_SPLIT;
+
+    /* Checking for splittable subinterface & lanes_not_split condition. */
+    } else if (intf->split_parent != NULL &&
+               intf->split_parent->user_cfg.lane_split == INTERFACE_USER_CONFIG_LANE_SPLIT_NO_SPLIT) {
+        intf->op_state.reason = INTERFACE_ERROR_LANES_NOT_SPLIT;
+
+    /* Checking admin state. */
+    } else if (intf->user_cfg.admin_state == INTERFACE_USER_CONFIG_ADMIN_DOWN) {
+        intf->op_state.reason = INTERFACE_ERROR_ADMIN_DOWN;
+
+    /* Checking for missing pluggable module. */
+    } else if (intf->pm_info.connector == INTERFACE_PM_INFO_CONNECTOR_ABSENT) {
+        intf->op_state.reason = INTERFACE_ERROR_MODULE_MISSING;
+
+    /* Checking for unrecognized pluggable module. */
+    } else if (intf->pm_info.connector_status == INTERFACE_PM_INFO_CONNECTOR_STATUS_UNRECOGNIZED) {
+        intf->op_state.reason = INTERFACE_ERROR_MODULE_UNRECOGNIZED;
+
+    /* Checking for unsupported pluggable module. */
+    } else if ((intf->pm_info.connector_status ==
+                    INTERFACE_PM_INFO_CONNECTOR_STATUS_UNSUPPORTED) ||
+               (intf->pm_info.op_connector_flags == PM_UNSUPPORTED_FLAG)) {
+        intf->op_state.reason = INTERFACE_ERROR_MODULE_UNSUPPORTED;
+
+    /* Checking for invalid mtu. */
+    } else if (intf->op_state.mtu == -1) {
+        intf->op_state.reason = INTERFACE_ERROR_INVALID_MTU;
+
+    /* Checking for invalid speeds. */
+    } else if (intf->op_state.n_speeds == -1) {
+        intf->op_state.reason = INTERFACE_ERROR_INVALID_SPEEDS;
+
+    /* Checking for invalid autoneg. */
+    } else if (intf->op_state.autoneg_state == INTFD_AUTONEG_STATE_INVALID) {
+        intf->op_state.reason = intf->op_state.autoneg_reason;
+
+    /* Checking for port admin as down */
+    } else if (intf->port_admin == PORT_ADMIN_CONFIG_DOWN) {
+        intf->op_state.reason = PORT_ERROR_ADMIN_DOWN;
+
+    } else {
+        /* FIXME: Lots of other business logic needs to be added here. */
+        /* If we get here, everything's fine. */
+
+        intf->op_state.enabled = true;
+        intf->op_state.reason = INTERFACE_ERROR_OK;
+    }
+
+} /* calc_intf_op_state_n_reason */
+
+static void
+validate_n_set_interface_capability(struct iface *intf)
+{
+    /*
+     * This function determines if an interface supports, requires, or does not
+     * support auto-negotiation along with the supported speeds.
+     * It then looks at user input for AN and speeds and either reports an
+     * error if invalid user input or sets the appropriate value(s) for
+     * AN and speeds.
+    */
+
+    /* FIXME: Add support for multi-speed capable transceivers (or
+       fixed ports). Hard coded for now to single speed.
+    */
+
+    /* If the user input an invalid "speeds", return */
+    if (intf->user_cfg.n_speeds == -1) {
+        intf->op_state.n_speeds = -1;
+        return;
+    }
+
+    /* If the user input an invalid mtu, return */
+    if (intf->user_cfg.mtu == -1) {
+        return;
+    }
+
+    if (CONNECTOR_IS_SFP_PLUS_10G(intf)) {
+        intf->op_state.autoneg_capability = INTFD_AUTONEG_CAPABILITY_UNSUPPORTED;
+        intf->op_state.speeds[0] = SPEED_10G;
+        intf->op_state.n_speeds = 1;
+
+    } else if (CONNECTOR_IS_SFP28_25G(intf)) {
+        /* SFP28 CR requires AN, SR/LR do not. */
+        if (INTERFACE_PM_INFO_CONNECTOR_SFP28_CR == intf->pm_info.connector) {
+            intf->op_state.autoneg_capability = INTFD_AUTONEG_CAPABILITY_REQUIRED;
+        } else {
+            intf->op_state.autoneg_capability = INTFD_AUTONEG_CAPABILITY_UNSUPPORTED;
+        }
+
+        intf->op_state.speeds[0] = SPEED_25G;
+        intf->op_state.n_speeds = 1;
+
+    } else if (CONNECTOR_IS_SFP(intf)) {
+        intf->op_state.autoneg_capability = INTFD_AUTONEG_CAPABILITY_REQUIRED;
+        /* FIXME: Currently not supporting tri-speed devices */
+        intf->op_state.speeds[0] = SPEED_1G;
+        intf->op_state.n_speeds = 1;
+
+    } else if (CONNECTOR_IS_QSFP_PLUS_40G(intf)) {
+        /* QSFP+ CR4 requires AN, SR4/LR4 do not. */
+        if (INTERFACE_PM_INFO_CONNECTOR_QSFP_CR4 == intf->pm_info.connector) {
+            intf->op_state.autoneg_capability = INTFD_AUTONEG_CAPABILITY_REQUIRED;
+        } else {
+            intf->op_state.autoneg_capability = INTFD_AUTONEG_CAPABILITY_UNSUPPORTED;
+        }
+
+        intf->op_state.speeds[0] = SPEED_40G;
+        intf->op_state.n_speeds = 1;
+
+    } else if (CONNECTOR_IS_QSFP28_100G(intf)) {
+        /* QSFP28 CR4 requires AN, SR4/LR4 do not. */
+        if (INTERFACE_PM_INFO_CONNECTOR_QSFP28_CR4 == intf->pm_info.connector) {
+            intf->op_state.autoneg_capability = INTFD_AUTONEG_CAPABILITY_REQUIRED;
+        } else {
+            intf->op_state.autoneg_capability = INTFD_AUTONEG_CAPABILITY_UNSUPPORTED;
+        }
+
+        intf->op_state.speeds[0] = SPEED_100G;
+        intf->op_state.n_speeds = 1;
+
+    } else {
+        /* This should be midplane connectors.  As of now,
+         * all midplane connections are of KR/KR2 variety,
+         * which requires auto-negotiation, even if a
+         * specific speed is specified later. */
+        intf->op_state.autoneg_capability = INTFD_AUTONEG_CAPABILITY_REQUIRED;
+        intf->op_state.speeds[0] = 0;
+        intf->op_state.n_speeds = 0;
+    }
+
+    /* Override autoneg and speeds based on user input */
+    intf->op_state.autoneg_reason = INTERFACE_ERROR_UNINITIALIZED;
+
+    /* If autoneg=true and didn't set speeds */
+    if ((intf->user_cfg.autoneg == INTERFACE_USER_CONFIG_AUTONEG_ON) &&
+        (intf->user_cfg.n_speeds == 0)) {
+
+        intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_ENABLED;
+
+        if (intf->op_state.autoneg_capability == INTFD_AUTONEG_CAPABILITY_UNSUPPORTED) {
+            /* report error */
+            intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_INVALID;
+            intf->op_state.autoneg_reason = INTERFACE_ERROR_AUTONEG_NOT_SUPPORTED;
+        }
+
+    /* If autoneg=false and didn't set speeds */
+    } else if ((intf->user_cfg.autoneg == INTERFACE_USER_CONFIG_AUTONEG_OFF) &&
+               (intf->user_cfg.n_speeds == 0)) {
+
+        intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_DISABLED;
+
+        if (intf->op_state.autoneg_capability ==
+                                        INTFD_AUTONEG_CAPABILITY_REQUIRED) {
+            /* report error */
+            intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_INVALID;
+            intf->op_state.autoneg_reason = INTERFACE_ERROR_AUTONEG_REQUIRED;
+
+        } else if (intf->op_state.autoneg_capability ==
+                                        INTFD_AUTONEG_CAPABILITY_OPTIONAL) {
+
+            /* use highest supported speed */
+            intf->op_state.speeds[0] = intfd_highest_speed(intf->hw_info.speeds,
+                                                           intf->hw_info.n_speeds);
+            intf->op_state.n_speeds = 1;
+        }
+
+    /* If not set autoneg and set speeds */
+    } else if ((intf->user_cfg.autoneg == INTERFACE_USER_CONFIG_AUTONEG_DEFAULT) &&
+               (intf->user_cfg.n_speeds > 0)) {
+
+        if (intf->op_state.autoneg_capability != INTFD_AUTONEG_CAPABILITY_UNSUPPORTED) {
+
+            intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_ENABLED;
+
+            /* Use user speeds */
+            memcpy(intf->op_state.speeds, intf->user_cfg.speeds,
+                   sizeof(intf->user_cfg.speeds));
+            intf->op_state.n_speeds = intf->user_cfg.n_speeds;
+
+        } else {
+
+            intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_DISABLED;
+
+            /* get first speed supplied by user */
+            intf->op_state.speeds[0] = intf->user_cfg.speeds[0];
+            intf->op_state.n_speeds = 1;
+        }
+
+    /* If autoneg=true and set speeds */
+    } else if ((intf->user_cfg.autoneg == INTERFACE_USER_CONFIG_AUTONEG_ON) &&
+               (intf->user_cfg.n_speeds > 0)) {
+
+        if ((intf->op_state.autoneg_capability == INTFD_AUTONEG_CAPABILITY_REQUIRED) ||
+            (intf->op_state.autoneg_capability == INTFD_AUTONEG_CAPABILITY_OPTIONAL)) {
+
+            intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_ENABLED;
+
+            /* Use user speeds */
+            memcpy(intf->op_state.speeds, intf->user_cfg.speeds,
+                   sizeof(intf->user_cfg.speeds));
+            intf->op_state.n_speeds = intf->user_cfg.n_speeds;
+
+        } else {
+            /* report error */
+            intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_INVALID;
+            intf->op_state.autoneg_reason = INTERFACE_ERROR_AUTONEG_NOT_SUPPORTED;
+        }
+
+    /* If autoneg=false and set speeds */
+    } else if ((intf->user_cfg.autoneg == INTERFACE_USER_CONFIG_AUTONEG_OFF) &&
+               (intf->user_cfg.n_speeds > 0)) {
+
+        intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_DISABLED;
+
+        if (intf->op_state.autoneg_capability == INTFD_AUTONEG_CAPABILITY_REQUIRED) {
+
+            /* report error */
+            intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_INVALID;
+            intf->op_state.autoneg_reason = INTERFACE_ERROR_AUTONEG_REQUIRED;
+        } else {
+            /* Use first entry in user speeds */
+            intf->op_state.speeds[0] = intf->user_cfg.speeds[0];
+            intf->op_state.n_speeds = 1;
+        }
+
+    /* If not set autoneg and not set speeds */
+    } else {
+        if (intf->op_state.autoneg_capability == INTFD_AUTONEG_CAPABILITY_UNSUPPORTED) {
+            intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_DISABLED;
+        } else {
+            intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_ENABLED;
+        }
+    }
+
+} /* validate_n_set_interface_capability */
+
+static void
+set_op_state_mtu(struct iface *intf)
+{
+    /* Use the user MTU if specified and valid, else use default */
+    switch (intf->user_cfg.mtu) {
+        case -1:
+            intf->op_state.mtu = -1;
+            break;
+        case 0:
+            intf->op_state.mtu = INTFD_DEFAULT_MTU;
+            break;
+        default:
+            intf->op_state.mtu = intf->user_cfg.mtu;
+            break;
+    }
+} /* set_op_state_mtu */
+
+/* Derive the operational state of an interface from the configuration
+ * and module information already parsed into 'intf'. */
+void
+intfd_core_calc_op_state(struct iface *intf)
+{
+    /* Set mtu. */
+    set_op_state_mtu(intf);
+
+    /* Update autoneg capabilities of the interface. */
+    validate_n_set_interface_capability(intf);
+
+    /* Figure out if interface can be enabled. */
+    calc_intf_op_state_n_reason(intf);
+
+    if (intf->op_state.enabled == true) {
+
+        set_op_state_pause(intf);
+
+        set_op_state_duplex(intf);
+    }
+
+} /* intfd_core_calc_op_state */
+
+/* Fill 'hw_config' with the hw_intf_config values for 'intf'.  Returns
+ * the string to write to the Interface "error" column, or NULL if the
+ * interface is enabled. */
+const char *
+intfd_core_get_hw_config(const struct iface *intf,
+                         struct intf_hw_config *hw_config)
+{
+    const char *error = NULL;
+
+    if (intf->op_state.enabled != true) {
+        error = intfd_get_error_str(intf->op_state.reason);
+    }
+
+    /* hw_intf_config:enabled */
+    hw_config->enable = (intf->op_state.enabled == true);
+
+    /* The remaining keys are only present for enabled interfaces. */
+    hw_config->link_config = false;
+    if ((intf->op_state.enabled == true) &&
+        ((intf->type_class != INTFD_TYPE_CLASS_INTERNAL) ||
+        (intf->type_class != INTFD_TYPE_CLASS_VLANSUBINT)  ||
+        (intf->type_class != INTFD_TYPE_CLASS_LOOPBACK)))  {
+
+        hw_config->link_config = true;
+
+        /* hw_intf_config:autoneg */
+        hw_config->autoneg = INTERFACE_HW_INTF_CONFIG_MAP_AUTONEG_OFF;
+        if (intf->op_state.autoneg_state == INTFD_AUTONEG_STATE_ENABLED) {
+            hw_config->autoneg = INTERFACE_HW_INTF_CONFIG_MAP_AUTONEG_ON;
+        }
+
+        /* hw_intf_config:duplex */
+        hw_config->duplex = INTERFACE_HW_INTF_CONFIG_MAP_DUPLEX_FULL;
+        if (intf->op_state.duplex == INTERFACE_HW_INTF_CONFIG_DUPLEX_HALF) {
+            hw_config->duplex = INTERFACE_HW_INTF_CONFIG_MAP_DUPLEX_HALF;
+        }
+
+        /* hw_intf_config:pause */
+        hw_config->pause = INTERFACE_HW_INTF_CONFIG_MAP_PAUSE_NONE;
+        if (intf->op_state.pause == INTERFACE_HW_INTF_CONFIG_PAUSE_RXTX) {
+            hw_config->pause = INTERFACE_HW_INTF_CONFIG_MAP_PAUSE_RXTX;
+
+        } else if (intf->op_state.pause == INTERFACE_HW_INTF_CONFIG_PAUSE_TX) {
+            hw_config->pause = INTERFACE_HW_INTF_CONFIG_MAP_PAUSE_TX;
+
+        } else if (intf->op_state.pause == INTERFACE_HW_INTF_CONFIG_PAUSE_RX) {
+            hw_config->pause = INTERFACE_HW_INTF_CONFIG_MAP_PAUSE_RX;
+        }
+
+        /* hw_intf_config:mtu, 0 when not to be written */
+        hw_config->mtu = 0;
+        if (intf->op_state.mtu >= INTFD_MIN_ALLOWED_USER_SPECIFIED_MTU) {
+            hw_config->mtu = intf->op_state.mtu;
+        }
+
+        /* hw_intf_config:speeds, n_speeds 0 when not to be written */
+        hw_config->n_speeds = 0;
+        if (intf->op_state.n_speeds > 0) {
+            hw_config->n_speeds = intf->op_state.n_speeds;
+            memcpy(hw_config->speeds, intf->op_state.speeds,
+                   hw_config->n_speeds * sizeof(hw_config->speeds[0]));
+        }
+
+        hw_config->interface_type =
+            intfd_get_intf_type_str(intf->pm_info.intf_type);
+    }
+
+    return error;
+
+} /* intfd_core_get_hw_config */
+
+/* Map a raw Interface "type" value to the class intfd evaluates. */
+enum intfd_type_class
+intfd_core_type_class(const char *type)
+{
+    if (type == NULL) {
+        return INTFD_TYPE_CLASS_SYSTEM;
+
+    } else if (STR_EQ(type, OVSREC_INTERFACE_TYPE_INTERNAL)) {
+        return INTFD_TYPE_CLASS_INTERNAL;
+
+    } else if (STR_EQ(type, OVSREC_INTERFACE_TYPE_VLANSUBINT)) {
+        return INTFD_TYPE_CLASS_VLANSUBINT;
+
+    } else if (STR_EQ(type, OVSREC_INTERFACE_TYPE_LOOPBACK)) {
+        return INTFD_TYPE_CLASS_LOOPBACK;
+    }
+
+    return INTFD_TYPE_CLASS_SYSTEM;
+
+} /* intfd_core_type_class */
+
+
+const char*
+intfd_get_lane_split_str(enum ovsrec_interface_user_config_lane_split_e ls)
+{
+    switch(ls) {
+    case INTERFACE_USER_CONFIG_LANE_SPLIT_NO_SPLIT:
+        return INTERFACE_USER_CONFIG_MAP_LANE_SPLIT_NO_SPLIT;
+
+    case INTERFACE_USER_CONFIG_LANE_SPLIT_SPLIT:
+        return INTERFACE_USER_CONFIG_MAP_LANE_SPLIT_SPLIT;
+
+    case INTERFACE_USER_CONFIG_LANE_SPLIT_DEFAULT:
+    default:
+        return "unset by user";
+    }
+} /* intfd_get_lane_split_str */
+
+const char*
+intfd_get_error_str(enum ovsrec_interface_error_e reason)
+{
+    switch(reason) {
+
+    case INTERFACE_ERROR_UNINITIALIZED:
+        return OVSREC_INTERFACE_ERROR_UNINITIALIZED;
+
+    case INTERFACE_ERROR_ADMIN_DOWN:
+        return OVSREC_INTERFACE_ERROR_ADMIN_DOWN;
+
+    case INTERFACE_ERROR_MODULE_MISSING:
+        return OVSREC_INTERFACE_ERROR_MODULE_MISSING;
+
+    case INTERFACE_ERROR_MODULE_UNRECOGNIZED:
+        return OVSREC_INTERFACE_ERROR_MODULE_UNRECOGNIZED;
+
+    case INTERFACE_ERROR_MODULE_UNSUPPORTED:
+        return OVSREC_INTERFACE_ERROR_MODULE_UNSUPPORTED;
+
+    case INTERFACE_ERROR_LANES_SPLIT:
+        return OVSREC_INTERFACE_ERROR_LANES_SPLIT;
+
+    case INTERFACE_ERROR_LANES_NOT_SPLIT:
+        return OVSREC_INTERFACE_ERROR_LANES_NOT_SPLIT;
+
+    case INTERFACE_ERROR_INVALID_MTU:
+        return OVSREC_INTERFACE_ERROR_INVALID_MTU;
+
+    case INTERFACE_ERROR_INVALID_SPEEDS:
+        return OVSREC_INTERFACE_ERROR_INVALID_SPEEDS;
+
+    case INTERFACE_ERROR_AUTONEG_NOT_SUPPORTED:
+        return OVSREC_INTERFACE_ERROR_AUTONEG_NOT_SUPPORTED;
+
+    case INTERFACE_ERROR_AUTONEG_REQUIRED:
+        return OVSREC_INTERFACE_ERROR_AUTONEG_REQUIRED;
+
+    case PORT_ERROR_ADMIN_DOWN:
+        return OVSREC_PORT_ERROR_ADMIN_DOWN;
+
+    case INTERFACE_ERROR_OK:
+        return OVSREC_INTERFACE_ERROR_OK;
+    default:
+        return "???";
+    }
+
+} /* intfd_get_error_str */
+
+const char*
+intfd_get_intf_type_str(enum ovsrec_interface_hw_intf_config_interface_type_e intf_type)
+{
+    switch(intf_type) {
+
+    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_UNKNOWN:
+        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_UNKNOWN;
+
+    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_BACKPLANE:
+        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_BACKPLANE;
+
+    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_1GBASE_SX:
+        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_1GBASE_SX;
+
+    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_1GBASE_T:
+        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_1GBASE_T;
+
+    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_10GBASE_CR:
+        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_10GBASE_CR;
+
+    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_10GBASE_SR:
+        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_10GBASE_SR;
+
+    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_10GBASE_LR:
+        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_10GBASE_LR;
+
+    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_10GBASE_LRM:
+        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_10GBASE_LRM;
+
+    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_10GBASE_ER:
+        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_10GBASE_ER;
+
+    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_25GBASE_CR:
+        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_25GBASE_CR;
+
+    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_25GBASE_SR:
+        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_25GBASE_SR;
+
+    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_25GBASE_LR:
+        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_25GBASE_LR;
+
+    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_40GBASE_CR4:
+        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_40GBASE_CR4;
+
+    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_40GBASE_SR4:
+        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_40GBASE_SR4;
+
+    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_40GBASE_LR4:
+        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_40GBASE_LR4;
+
+    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_100GBASE_CR4:
+        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_100GBASE_CR4;
+
+    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_100GBASE_SR4:
+        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_100GBASE_SR4;
+
+    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_100GBASE_LR4:
+        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_100GBASE_LR4;
+
+    default:
+        return "unknown";
+    }
+
+} /* intfd_get_intf_type_str */
+
+/** @} end of group intfd */
@@ -0,0 +1,397 @@
+/*
+ * (c) Copyright 2015 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup ops-intfd
+ *
+ * @file
+ * Micro-benchmark for the intfd interface decision logic (libintfd_core).
+ *
+ * A set of synthetic interfaces is built for each connector/config mix
+ * and evaluated over and over.  Two phases are timed per mix:
+ *
+ *      parse+eval  Parse the raw user_config and pm_info values, derive
+ *                  the op state and build the hw_intf_config values,
+ *                  i.e. what ops-intfd does for a modified Interface row.
+ *
+ *      eval        Derive the op state and hw_intf_config values only.
+ *
+ * Usage: intfd_core_bench [-n INTERFACES] [-r ROUNDS]
+ *
+ * Run it with "make bench-intfd-core".
+ *
+ ***************************************************************************/
+
+#include <getopt.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <openswitch-idl.h>
+
+#include "intfd_core.h"
+
+/** @ingroup ops-intfd
+ * @{ */
+
+#define BENCH_DEFAULT_INTERFACES    1024
+#define BENCH_DEFAULT_ROUNDS        1000
+#define BENCH_MAX_MTU               9192
+
+/* One synthetic Interface row.  A split parent is followed by its
+ * MAX_SPLIT_COUNT children, which use 'split_child' cases. */
+struct bench_case {
+    const char                  *type;
+    bool                        split_child;
+    struct intf_hw_info_raw     hw;
+    struct intf_user_cfg_raw    user;
+    struct intf_pm_info_raw     pm;
+};
+
+struct bench_mix {
+    const char                  *name;
+    const struct bench_case     *cases;
+    size_t                      n_cases;
+};
+
+#define RJ45_HW     { NULL, INTERFACE_HW_INTF_INFO_MAP_CONNECTOR_RJ45, "1000", "1000" }
+#define SFPP_HW     { INTERFACE_HW_INTF_INFO_MAP_PLUGGABLE_TRUE, \
+                      INTERFACE_HW_INTF_INFO_MAP_CONNECTOR_SFP_PLUS, \
+                      "1000,10000", "10000" }
+#define QSFPP_HW    { INTERFACE_HW_INTF_INFO_MAP_PLUGGABLE_TRUE, \
+                      INTERFACE_HW_INTF_INFO_MAP_CONNECTOR_QSFP_PLUS, \
+                      "10000,40000", "40000" }
+#define QSFP28_HW   { INTERFACE_HW_INTF_INFO_MAP_PLUGGABLE_TRUE, \
+                      INTERFACE_HW_INTF_INFO_MAP_CONNECTOR_QSFP28, \
+                      "25000,40000,100000", "100000" }
+
+#define ADMIN_UP    OVSREC_INTERFACE_USER_CONFIG_ADMIN_UP
+#define SUPPORTED   OVSREC_INTERFACE_PM_INFO_CONNECTOR_STATUS_SUPPORTED
+#define UNSUPPORTED OVSREC_INTERFACE_PM_INFO_CONNECTOR_STATUS_UNSUPPORTED
+#define SPLIT       INTERFACE_USER_CONFIG_MAP_LANE_SPLIT_SPLIT
+
+/* Fixed RJ45 ports, the common top-of-rack case. */
+static const struct bench_case fixed_rj45_cases[] = {
+    { "", false, RJ45_HW, { ADMIN_UP }, { NULL } },
+    { "", false, RJ45_HW, { NULL }, { NULL } },
+    { "", false, RJ45_HW, { ADMIN_UP, NULL, NULL, NULL, NULL, "9000" }, { NULL } },
+    { "", false, RJ45_HW,
+      { ADMIN_UP, INTERFACE_USER_CONFIG_MAP_AUTONEG_ON, NULL,
+        INTERFACE_USER_CONFIG_MAP_DUPLEX_HALF, "1000" }, { NULL } },
+    { "", false, RJ45_HW,
+      { ADMIN_UP, INTERFACE_USER_CONFIG_MAP_AUTONEG_OFF }, { NULL } },
+};
+
+/* SFP+ cages with a mix of modules, including empty and bad ones. */
+static const struct bench_case sfp_plus_cases[] = {
+    { "", false, SFPP_HW, { ADMIN_UP },
+      { SUPPORTED, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_SR } },
+    { "", false, SFPP_HW,
+      { ADMIN_UP, NULL, INTERFACE_USER_CONFIG_MAP_PAUSE_RXTX, NULL, NULL, "1518" },
+      { SUPPORTED, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_LR } },
+    { "", false, SFPP_HW, { ADMIN_UP },
+      { SUPPORTED, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_RJ45 } },
+    { "", false, SFPP_HW, { ADMIN_UP },
+      { NULL, OVSREC_INTERFACE_PM_INFO_CONNECTOR_ABSENT } },
+    { "", false, SFPP_HW, { ADMIN_UP },
+      { UNSUPPORTED, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_FC } },
+    { "", false, SFPP_HW, { ADMIN_UP, NULL, NULL, NULL, "10000,1000" },
+      { SUPPORTED, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_DAC } },
+    { "", false, SFPP_HW,
+      { ADMIN_UP, INTERFACE_USER_CONFIG_MAP_AUTONEG_ON },
+      { SUPPORTED, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_SR } },
+};
+
+/* Split QSFP+/QSFP28 cages: one parent followed by its four children. */
+static const struct bench_case qsfp_split_cases[] = {
+    { "", false, QSFPP_HW,
+      { ADMIN_UP, NULL, NULL, NULL, NULL, NULL, SPLIT },
+      { SUPPORTED, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP_SR4 } },
+    { "", true, QSFPP_HW, { ADMIN_UP }, { NULL } },
+    { "", true, QSFPP_HW, { ADMIN_UP }, { NULL } },
+    { "", true, QSFPP_HW, { NULL }, { NULL } },
+    { "", true, QSFPP_HW, { ADMIN_UP, NULL, NULL, NULL, NULL, "9000" }, { NULL } },
+    { "", false, QSFP28_HW,
+      { ADMIN_UP, NULL, NULL, NULL, NULL, NULL, SPLIT },
+      { SUPPORTED, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_CR4,
+        "100000" } },
+    { "", true, QSFP28_HW, { ADMIN_UP }, { NULL } },
+    { "", true, QSFP28_HW, { ADMIN_UP }, { NULL } },
+    { "", true, QSFP28_HW, { ADMIN_UP }, { NULL } },
+    { "", true, QSFP28_HW,
+      { ADMIN_UP, INTERFACE_USER_CONFIG_MAP_AUTONEG_OFF }, { NULL } },
+    { "", false, QSFP28_HW, { ADMIN_UP },
+      { SUPPORTED, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_SR4 } },
+};
+
+/* Invalid user configuration, every interface ends up disabled. */
+static const struct bench_case invalid_cfg_cases[] = {
+    { "", false, SFPP_HW, { ADMIN_UP, NULL, NULL, NULL, "25000" },
+      { SUPPORTED, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_SR } },
+    { "", false, SFPP_HW, { ADMIN_UP, NULL, NULL, NULL, "10G" },
+      { SUPPORTED, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_SR } },
+    { "", false, RJ45_HW, { ADMIN_UP, NULL, NULL, NULL, NULL, "100" }, { NULL } },
+    { "", false, RJ45_HW, { ADMIN_UP, NULL, NULL, NULL, NULL, "65536" }, { NULL } },
+    { "", false, QSFP28_HW,
+      { ADMIN_UP, INTERFACE_USER_CONFIG_MAP_AUTONEG_OFF },
+      { SUPPORTED, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_CR4 } },
+};
+
+/* Logical interfaces, which skip most of the decision logic. */
+static const struct bench_case logical_cases[] = {
+    { OVSREC_INTERFACE_TYPE_VLANSUBINT, false, { NULL }, { ADMIN_UP }, { NULL } },
+    { OVSREC_INTERFACE_TYPE_LOOPBACK, false, { NULL }, { ADMIN_UP }, { NULL } },
+    { OVSREC_INTERFACE_TYPE_INTERNAL, false, { NULL }, { NULL }, { NULL } },
+};
+
+#define BENCH_MIX(NAME, CASES) { NAME, CASES, sizeof(CASES) / sizeof(CASES[0]) }
+
+static const struct bench_mix bench_mixes[] = {
+    BENCH_MIX("fixed-rj45", fixed_rj45_cases),
+    BENCH_MIX("sfp-plus", sfp_plus_cases),
+    BENCH_MIX("qsfp-split", qsfp_split_cases),
+    BENCH_MIX("invalid-config", invalid_cfg_cases),
+    BENCH_MIX("logical", logical_cases),
+};
+
+#define N_BENCH_MIXES (sizeof(bench_mixes) / sizeof(bench_mixes[0]))
+
+/* The interfaces of one mix.  'cases[i]' describes 'ifaces[i]' and
+ * 'parents[i]' is the raw pm_info of the split parent of 'ifaces[i]'. */
+struct bench_set {
+    struct iface                    *ifaces;
+    const struct bench_case         **cases;
+    const struct intf_pm_info_raw   **parents;
+    struct iface                    **children;
+    size_t                          n;
+};
+
+/* Checksum of the results, printed so the work cannot be optimized out. */
+static uint64_t bench_checksum;
+
+static uint64_t
+bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+
+} /* bench_now_ns */
+
+static void
+bench_set_build(struct bench_set *set, const struct bench_mix *mix, size_t n)
+{
+    struct iface *parent = NULL;
+    size_t i;
+
+    set->n = n;
+    set->ifaces = calloc(n, sizeof *set->ifaces);
+    set->cases = calloc(n, sizeof *set->cases);
+    set->parents = calloc(n, sizeof *set->parents);
+    set->children = calloc(n, sizeof *set->children);
+    if (!set->ifaces || !set->cases || !set->parents || !set->children) {
+        fprintf(stderr, "intfd_core_bench: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < n; i++) {
+        const struct bench_case *bc = &mix->cases[i % mix->n_cases];
+        struct iface *intf = &set->ifaces[i];
+
+        set->cases[i] = bc;
+        intf->type_class = intfd_core_type_class(bc->type);
+        intfd_core_parse_hw_info(&intf->hw_info, &bc->hw);
+
+        if (bc->split_child && parent) {
+            intf->split_parent = parent;
+            set->parents[i] = &set->cases[parent - set->ifaces]->pm;
+            parent->split_children[parent->n_split_children++] = intf;
+
+        } else if (bc->user.lane_split) {
+            parent = intf;
+            intf->split_children = &set->children[i];
+        } else {
+            parent = NULL;
+        }
+    }
+
+} /* bench_set_build */
+
+static void
+bench_set_destroy(struct bench_set *set)
+{
+    free(set->ifaces);
+    free(set->cases);
+    free(set->parents);
+    free(set->children);
+
+} /* bench_set_destroy */
+
+static inline void
+bench_parse(struct bench_set *set, size_t i)
+{
+    const struct bench_case *bc = set->cases[i];
+    struct iface *intf = &set->ifaces[i];
+
+    intfd_core_parse_user_cfg(&intf->user_cfg, &bc->user, bc->hw.speeds,
+                              BENCH_MAX_MTU);
+    if (set->parents[i]) {
+        intfd_core_parse_split_pm_info(&intf->pm_info, set->parents[i]);
+    } else {
+        intfd_core_parse_pm_info(&intf->hw_info, &intf->pm_info, &bc->pm);
+    }
+
+} /* bench_parse */
+
+static inline void
+bench_eval(struct bench_set *set, size_t i)
+{
+    struct iface *intf = &set->ifaces[i];
+    struct intf_hw_config hw_config;
+    const char *error;
+
+    intfd_core_calc_op_state(intf);
+    error = intfd_core_get_hw_config(intf, &hw_config);
+
+    bench_checksum += intf->op_state.reason + hw_config.enable
+                      + (hw_config.link_config ? hw_config.n_speeds : 0)
+                      + (error ? (uint8_t) error[0] : 0);
+
+} /* bench_eval */
+
+static void
+bench_report(const char *mix, const char *phase, uint64_t n_evals,
+             uint64_t elapsed_ns)
+{
+    double ns_per_eval = n_evals ? (double) elapsed_ns / n_evals : 0;
+    double evals_per_sec = elapsed_ns ? n_evals * 1e9 / elapsed_ns : 0;
+
+    printf("%-16s %-12s %12llu %10.1f %14.0f\n", mix, phase,
+           (unsigned long long) n_evals, ns_per_eval, evals_per_sec);
+
+} /* bench_report */
+
+static void
+bench_run_mix(const struct bench_mix *mix, size_t n_ifaces, unsigned rounds)
+{
+    struct bench_set set;
+    uint64_t start;
+    unsigned r;
+    size_t i;
+
+    bench_set_build(&set, mix, n_ifaces);
+
+    /* Warm up, and leave every interface parsed for the eval phase. */
+    for (i = 0; i < set.n; i++) {
+        bench_parse(&set, i);
+        bench_eval(&set, i);
+    }
+
+    start = bench_now_ns();
+    for (r = 0; r < rounds; r++) {
+        for (i = 0; i < set.n; i++) {
+            bench_parse(&set, i);
+            bench_eval(&set, i);
+        }
+    }
+    bench_report(mix->name, "parse+eval", (uint64_t) rounds * set.n,
+                 bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (r = 0; r < rounds; r++) {
+        for (i = 0; i < set.n; i++) {
+            bench_eval(&set, i);
+        }
+    }
+    bench_report(mix->name, "eval", (uint64_t) rounds * set.n,
+                 bench_now_ns() - start);
+
+    bench_set_destroy(&set);
+
+} /* bench_run_mix */
+
+static void
+usage(const char *program_name)
+{
+    printf("%s: intfd decision logic micro-benchmark\n"
+           "usage: %s [OPTIONS]\n"
+           "\nOptions:\n"
+           "  -n, --interfaces=N      interfaces per mix (default: %d)\n"
+           "  -r, --rounds=N          evaluations of every interface "
+           "(default: %d)\n"
+           "  -h, --help              display this help message\n",
+           program_name, program_name, BENCH_DEFAULT_INTERFACES,
+           BENCH_DEFAULT_ROUNDS);
+
+} /* usage */
+
+int
+main(int argc, char *argv[])
+{
+    static const struct option long_options[] = {
+        {"interfaces", required_argument, NULL, 'n'},
+        {"rounds",     required_argument, NULL, 'r'},
+        {"help",       no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    long n_ifaces = BENCH_DEFAULT_INTERFACES;
+    long rounds = BENCH_DEFAULT_ROUNDS;
+    size_t i;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "n:r:h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'n':
+            n_ifaces = strtol(optarg, NULL, 10);
+            break;
+
+        case 'r':
+            rounds = strtol(optarg, NULL, 10);
+            break;
+
+        case 'h':
+            usage(argv[0]);
+            exit(EXIT_SUCCESS);
+
+        default:
+            usage(argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (n_ifaces <= 0 || rounds <= 0) {
+        fprintf(stderr, "intfd_core_bench: interfaces and rounds must be "
+                "positive\n");
+        exit(EXIT_FAILURE);
+    }
+
+    printf("%-16s %-12s %12s %10s %14s\n",
+           "mix", "phase", "evaluations", "ns/eval", "evals/sec");
+
+    for (i = 0; i < N_BENCH_MIXES; i++) {
+        bench_run_mix(&bench_mixes[i], n_ifaces, rounds);
+    }
+
+    printf("checksum %llu\n", (unsigned long long) bench_checksum);
+
+    return 0;
+
+} /* main */
+
+/** @} end of group ops-intfd */
@@ -47,8 +47,12 @@
 #include <openswitch-idl.h>
 #include <hash.h>
 #include <shash.h>
+#include <sset.h>
 
 #include "intfd.h"
+#include "intfd_core.h"
+#include "intfd_rates.h"
+#include "intfd_record.h"
 #include "intfd_utils.h"
 
 #include "eventlog.h"
@@ -69,61 +73,6 @@ static struct shash all_interfaces = SHASH_INITIALIZER(&all_interfaces);
 /* Mapping of all the ports. */
 static struct shash all_ports = SHASH_INITIALIZER(&all_ports);
 
-struct intf_hw_info {
-    bool is_pluggable;
-    enum ovsrec_interface_hw_intf_connector_e      connector;
-    uint32_t    speeds[INTFD_MAX_SPEEDS_ALLOWED];
-    int32_t     n_speeds;
-    uint32_t    max_speed;
-};
-
-struct intf_user_cfg {
-    enum ovsrec_interface_user_config_admin_e      admin_state;
-    enum ovsrec_interface_user_config_autoneg_e    autoneg;
-    enum ovsrec_interface_user_config_pause_e      pause;
-    enum ovsrec_interface_user_config_duplex_e     duplex;
-    enum ovsrec_interface_user_config_lane_split_e lane_split;
-
-    uint32_t   speeds[INTFD_MAX_SPEEDS_ALLOWED];
-    int32_t    n_speeds;
-    int32_t    mtu;
-};
-
-struct intf_oper_state {
-    bool        enabled;
-    enum ovsrec_interface_error_e reason;
-    enum ovsrec_interface_error_e autoneg_reason;
-
-    enum ovsrec_interface_hw_intf_config_duplex_e   duplex;
-    enum ovsrec_interface_hw_intf_config_pause_e    pause;
-    int32_t     autoneg_capability;
-    int32_t     autoneg_state;
-    int32_t     mtu;
-    uint32_t    speeds[INTFD_MAX_SPEEDS_ALLOWED];
-    int32_t     n_speeds;
-};
-
-struct intf_pm_info {
-    uint64_t    op_connector_flags;
-    enum ovsrec_interface_pm_info_connector_e           connector;
-    enum ovsrec_interface_pm_info_connector_status_e    connector_status;
-
-    enum ovsrec_interface_hw_intf_config_interface_type_e   intf_type;
-};
-
-struct iface {
-    char                        *name;
-    struct intf_hw_info         hw_info;
-    enum ovsrec_port_config_admin_e  port_admin;
-    char                        *type;
-    struct intf_user_cfg        user_cfg;
-    struct intf_oper_state      op_state;
-    struct intf_pm_info         pm_info;
-    struct iface                *split_parent;
-    struct iface                **split_children;
-    int                         n_split_children;
-};
-
 struct port_info {
     char                      *name;
     size_t                    n_interfaces;
@@ -164,16 +113,59 @@ char *iface_config_autoneg_strings[] = {
     INTERFACE_USER_CONFIG_MAP_AUTONEG_DEFAULT
 };
 
-typedef struct subsystem {
+/* Subsystem that owns every interface not listed in the "interfaces"
+ * column of any Subsystem row. */
+#define INTFD_BASE_SUBSYSTEM "base"
+
+/* Per-subsystem state.  The subsystem's max_transmission_unit is the
+ * upper bound for user_config:mtu on the interfaces it owns. */
+struct subsystem_info {
     char         *name;
     int32_t      mtu;
-} subsystem_t;
+    struct sset  interfaces;    /* Interfaces listed in the row. */
+};
 
-/* FIXME: Need to modify to handle multiple subsystems */
-/* Hardcoding this for now as the base subsytem */
-subsystem_t                     base_subsys = {0};
+/* Subsystems, indexed by subsystem name. */
+static struct shash all_subsystems = SHASH_INITIALIZER(&all_subsystems);
+
+/* Owning 'struct subsystem_info' of every interface listed by some
+ * Subsystem row, indexed by interface name.  Interfaces missing here
+ * belong to INTFD_BASE_SUBSYSTEM. */
+static struct shash intf_subsystems = SHASH_INITIALIZER(&intf_subsystems);
+
+/* Interfaces whose MTU limit changed in the current batch.  Their
+ * user_config is re-validated by handle_interfaces_config_mods(). */
+static struct sset mtu_revalidate = SSET_INITIALIZER(&mtu_revalidate);
+
+/* Hot standby (--standby).
+ *
+ * Without the ops_intfd lock the daemon still processes every update and
+ * keeps all_interfaces, all_ports and the op state current, but instead
+ * of writing hw_intf_config/error it stashes the last values it would
+ * have written in 'standby_outputs'.  Once it takes the lock over, only
+ * the stashed values that differ from the dB are written, so failover
+ * does not start from scratch. */
+static bool standby_enabled = false;
+
+/* Running without the lock; nothing may be written to the dB. */
+static bool standby = false;
+
+/* The lock was taken over and the stash has not been committed yet. */
+static bool standby_takeover = false;
+
+struct standby_output {
+    bool            write_error;        /* False: leave "error" as it is. */
+    char            *error;             /* NULL: no error. */
+    struct smap     hw_intf_config;
+};
+
+static struct shash standby_outputs = SHASH_INITIALIZER(&standby_outputs);
 
 static void del_old_interface(struct shash_node *sh_node);
+static void reset_intf_hw_config_in_db(const struct ovsrec_interface *ifrow);
+static void standby_drop_output(const char *name);
+static void standby_clear_outputs(void);
+static void del_old_subsystem(struct shash_node *sh_node);
 
 void set_interface_config(const struct ovsrec_interface *ifrow, struct iface *intf);
 int remove_interface_from_port(const struct ovsrec_port *port_row);
@@ -191,6 +183,12 @@ intfd_debug_dump(struct ds *ds, int argc, const char *argv[])
         interface_name = argv[1];
     }
 
+    if (standby_enabled) {
+        ds_put_format(ds, "Hot standby: %s, %"PRIuSIZE" stashed interface "
+                      "updates\n", standby ? "standing by" : "active",
+                      shash_count(&standby_outputs));
+    }
+
     if (list_all_intf) {
         ds_put_cstr(ds, "================ Interfaces ================\n");
     } else {
@@ -265,114 +263,6 @@ intfd_debug_dump(struct ds *ds, int argc, const char *argv[])
 
 } /* intfd_debug_dump */
 
-static uint64_t
-get_connector_flags(enum ovsrec_interface_pm_info_connector_e connector)
-{
-    switch (connector) {
-    case INTERFACE_PM_INFO_CONNECTOR_SFP_RJ45:
-    case INTERFACE_PM_INFO_CONNECTOR_SFP_SX:
-        return PM_SFP_FLAGS;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_SFP_SR:
-    case INTERFACE_PM_INFO_CONNECTOR_SFP_LR:
-    case INTERFACE_PM_INFO_CONNECTOR_SFP_ER:
-    case INTERFACE_PM_INFO_CONNECTOR_SFP_LRM:
-    case INTERFACE_PM_INFO_CONNECTOR_SFP_DAC:
-        return PM_SFP_PLUS_FLAGS;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_SFP28_SR:
-    case INTERFACE_PM_INFO_CONNECTOR_SFP28_LR:
-    case INTERFACE_PM_INFO_CONNECTOR_SFP28_CR:
-        return PM_SFP28_25G_FLAGS;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_QSFP_CR4:
-    case INTERFACE_PM_INFO_CONNECTOR_QSFP_SR4:
-    case INTERFACE_PM_INFO_CONNECTOR_QSFP_LR4:
-        return PM_QSFP_PLUS_40G_FLAGS;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_SR4:
-    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_LR4:
-    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_CR4:
-    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_CLR4:
-    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_PSM4:
-    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_CWDM4:
-        return PM_QSFP28_100G_FLAGS;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_ABSENT:
-    case INTERFACE_PM_INFO_CONNECTOR_UNKNOWN:
-    case INTERFACE_PM_INFO_CONNECTOR_SFP_LX:
-    case INTERFACE_PM_INFO_CONNECTOR_SFP_CX:
-    case INTERFACE_PM_INFO_CONNECTOR_SFP_FC:
-    default:
-        return PM_UNSUPPORTED_FLAG;
-        break;
-    }
-} /* get_connector_flags */
-
-static enum ovsrec_interface_hw_intf_config_interface_type_e
-get_connector_if_type(enum ovsrec_interface_pm_info_connector_e connector)
-{
-    switch (connector) {
-    case INTERFACE_PM_INFO_CONNECTOR_SFP_SX:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_1GBASE_SX;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_SFP_RJ45:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_1GBASE_T;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_SFP_DAC:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_10GBASE_CR;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_SFP_SR:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_10GBASE_SR;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_SFP_LR:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_10GBASE_LR;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_SFP_ER:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_10GBASE_ER;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_QSFP_CR4:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_40GBASE_CR4;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_QSFP_SR4:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_40GBASE_SR4;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_QSFP_LR4:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_40GBASE_LR4;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_SFP28_CR:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_25GBASE_CR;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_SFP28_SR:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_25GBASE_SR;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_SFP28_LR:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_25GBASE_LR;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_CR4:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_100GBASE_CR4;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_SR4:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_100GBASE_SR4;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_LR4:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_100GBASE_LR4;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_CLR4:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_100GBASE_CLR4;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_PSM4:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_100GBASE_PSM4;
-        break;
-    case INTERFACE_PM_INFO_CONNECTOR_QSFP28_CWDM4:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_100GBASE_CWDM4;
-        break;
-    default:
-        return INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_UNKNOWN;
-        break;
-    }
-} /* get_connector_if_type */
-
 /* Create a connection to the OVSDB at db_path and create a dB cache
  * for this daemon. */
 void
@@ -397,6 +287,7 @@ intfd_ovsdb_init(const char *db_path)
     ovsdb_idl_add_column(idl, &ovsrec_system_col_cur_cfg);
     ovsdb_idl_add_column(idl, &ovsrec_subsystem_col_name);
     ovsdb_idl_add_column(idl, &ovsrec_subsystem_col_other_info);
+    ovsdb_idl_add_column(idl, &ovsrec_subsystem_col_interfaces);
     ovsdb_idl_add_column(idl, &ovsrec_interface_col_name);
     ovsdb_idl_add_column(idl, &ovsrec_interface_col_user_config);
     ovsdb_idl_add_column(idl, &ovsrec_interface_col_pm_info);
@@ -409,6 +300,11 @@ intfd_ovsdb_init(const char *db_path)
     ovsdb_idl_add_column(idl, &ovsrec_interface_col_hw_intf_info);
     ovsdb_idl_omit_alert(idl, &ovsrec_interface_col_hw_intf_info);
 
+    /* Only the rate engine reads the statistics, whenever the daemon wakes
+     * up, so they need not change the seqno. */
+    ovsdb_idl_add_column(idl, &ovsrec_interface_col_statistics);
+    ovsdb_idl_omit_alert(idl, &ovsrec_interface_col_statistics);
+
     /* Mark the following columns write-only. */
     ovsdb_idl_add_column(idl, &ovsrec_interface_col_error);
     ovsdb_idl_omit_alert(idl, &ovsrec_interface_col_error);
@@ -432,48 +328,16 @@ intfd_ovsdb_exit(void)
     SHASH_FOR_EACH_SAFE(sh_node, sh_next, &all_interfaces) {
         del_old_interface(sh_node);
     }
+    SHASH_FOR_EACH_SAFE(sh_node, sh_next, &all_subsystems) {
+        del_old_subsystem(sh_node);
+    }
+    sset_clear(&mtu_revalidate);
+    standby_clear_outputs();
+    intfd_rates_exit();
+    intfd_record_stop();
     ovsdb_idl_destroy(idl);
 } /* intfd_ovsdb_exit */
 
-static bool
-is_a_number(const char *nbr)
-{
-    while (*nbr) {
-        if (!isdigit(*nbr++)) {
-            return (false);
-        }
-    }
-
-    return (true);
-
-} /* is_a_number */
-
-static int
-parse_speeds(const char *speeds_str, uint32_t *speeds)
-{
-    char *ptr;
-    char *sp;
-    int i = 0;
-
-    sp = xstrdup(speeds_str);  /* strtok doesn't work with const char * */
-
-    ptr = strtok(sp, ",");
-    while (ptr) {
-        if (i >= INTFD_MAX_SPEEDS_ALLOWED || !is_a_number(
-                                                (const char *) ptr)) {
-            i = -1;
-            break;
-        }
-        speeds[i] = atoi(ptr);
-        i++;
-        ptr = strtok(NULL, ",");
-    }
-
-    free(sp);
-    return (i);
-
-} /* parse_speeds */
-
 /* Function : get_matching_port_row()
  * Desc     : search the ovsdb and get the matching
  *            port row based on the interface row name.
@@ -551,367 +415,6 @@ intf_parse_admin(const struct ovsrec_interface *intf_row) {
     return rc;
 }
 
-static void
-intfd_parse_hw_info(struct intf_hw_info *hw_info,
-                    const struct smap *ifrow_hw_info)
-{
-    const char *data = NULL;
-
-    /* hw_info:pluggable */
-    hw_info->is_pluggable = false;
-
-    /* Check if the interface is pluggable. */
-    data = smap_get(ifrow_hw_info, INTERFACE_HW_INTF_INFO_MAP_PLUGGABLE);
-    if (data && (STR_EQ(data, INTERFACE_HW_INTF_INFO_MAP_PLUGGABLE_TRUE))) {
-        hw_info->is_pluggable = true;
-    }
-
-    /* hw_info:connector */
-    hw_info->connector = INTERFACE_HW_INTF_INFO_CONNECTOR_UNKNOWN;
-
-    /* Check the connector type. */
-    data = smap_get(ifrow_hw_info, INTERFACE_HW_INTF_INFO_MAP_CONNECTOR);
-    if (data && (STR_EQ(data, INTERFACE_HW_INTF_INFO_MAP_CONNECTOR_RJ45))) {
-        hw_info->connector = INTERFACE_HW_INTF_INFO_CONNECTOR_RJ45;
-
-    } else if (data && (STR_EQ(data, INTERFACE_HW_INTF_INFO_MAP_CONNECTOR_SFP_PLUS))) {
-        hw_info->connector = INTERFACE_HW_INTF_INFO_CONNECTOR_SFP_PLUS;
-
-    } else if (data && (STR_EQ(data, INTERFACE_HW_INTF_INFO_MAP_CONNECTOR_QSFP_PLUS))) {
-        hw_info->connector = INTERFACE_HW_INTF_INFO_CONNECTOR_QSFP_PLUS;
-
-    } else if (data && (STR_EQ(data, INTERFACE_HW_INTF_INFO_MAP_CONNECTOR_QSFP28))) {
-        hw_info->connector = INTERFACE_HW_INTF_INFO_CONNECTOR_QSFP28;
-
-    }
-
-    memset(hw_info->speeds, 0, sizeof(hw_info->speeds));
-    hw_info->n_speeds = 0;
-    data = smap_get(ifrow_hw_info, INTERFACE_HW_INTF_INFO_MAP_SPEEDS);
-    if (data) {
-        hw_info->n_speeds = parse_speeds(data, hw_info->speeds);
-    }
-
-    if (hw_info->n_speeds == 0) {
-        VLOG_WARN("value for speeds not set in h/w description file");
-    }
-
-    hw_info->max_speed = 0;
-    data = smap_get(ifrow_hw_info, INTERFACE_HW_INTF_INFO_MAP_MAX_SPEED);
-    if (data) {
-        hw_info->max_speed = atoi(data);
-    }
-
-    if (hw_info->max_speed == 0) {
-        VLOG_WARN("value for max_speed not set in h/w description file");
-    }
-
-} /* intfd_parse_hw_info */
-
-static void
-intfd_parse_user_cfg(struct intf_user_cfg *user_config,
-                     const struct smap *ifrow_config,
-                     const struct smap *ifrow_hw_intf_info)
-{
-    const char *data = NULL;
-    const char *hw_info_speeds = NULL;
-    struct intf_hw_info hw_supported_speeds;
-
-    VLOG_DBG("Updating user config\n");
-    intfd_print_smap("interface_user_config", ifrow_config);
-
-    /* FIXME: Add functions to validate the user_config data.
-     * Without meta-schema we can't do such validation. */
-
-    /* user_config:admin_state */
-    user_config->admin_state = INTERFACE_USER_CONFIG_ADMIN_DOWN;
-
-    data = smap_get(ifrow_config, INTERFACE_USER_CONFIG_MAP_ADMIN);
-    if (data && (STR_EQ(data, OVSREC_INTERFACE_USER_CONFIG_ADMIN_UP))) {
-        user_config->admin_state = INTERFACE_USER_CONFIG_ADMIN_UP;
-    }
-
-    /* user_config:autoneg */
-    user_config->autoneg = INTERFACE_USER_CONFIG_AUTONEG_DEFAULT;
-
-    data = smap_get(ifrow_config, INTERFACE_USER_CONFIG_MAP_AUTONEG);
-    if (data && (STR_EQ(data, INTERFACE_USER_CONFIG_MAP_AUTONEG_OFF))) {
-        user_config->autoneg = INTERFACE_USER_CONFIG_AUTONEG_OFF;
-
-    } else if (data && (STR_EQ(data, INTERFACE_USER_CONFIG_MAP_AUTONEG_ON))) {
-        user_config->autoneg = INTERFACE_USER_CONFIG_AUTONEG_ON;
-    }
-
-    /* user_config:pause */
-    user_config->pause = INTERFACE_USER_CONFIG_PAUSE_NONE;
-
-    data = smap_get(ifrow_config, INTERFACE_USER_CONFIG_MAP_PAUSE);
-    if (data && (STR_EQ(data, INTERFACE_USER_CONFIG_MAP_PAUSE_RXTX))) {
-        user_config->pause = INTERFACE_USER_CONFIG_PAUSE_RXTX;
-
-    } else if (data && (STR_EQ(data, INTERFACE_USER_CONFIG_MAP_PAUSE_TX))) {
-        user_config->pause = INTERFACE_USER_CONFIG_PAUSE_TX;
-
-    } else if (data && (STR_EQ(data, INTERFACE_USER_CONFIG_MAP_PAUSE_RX))) {
-        user_config->pause = INTERFACE_USER_CONFIG_PAUSE_RX;
-    }
-
-    /* user_config:duplex */
-    user_config->duplex = INTERFACE_USER_CONFIG_DUPLEX_FULL;
-
-    data = smap_get(ifrow_config, INTERFACE_USER_CONFIG_MAP_DUPLEX);
-    if (data && (STR_EQ(data, INTERFACE_USER_CONFIG_MAP_DUPLEX_HALF))) {
-        user_config->duplex = INTERFACE_USER_CONFIG_DUPLEX_HALF;
-    }
-
-    /* Get user supplied speeds which can be passed on to vswitchd.
-     * data (user supplied speeds) is a comma separated list of numeric strings.
-     * Need to verify user input against supported speeds list.
-    */
-    user_config->n_speeds = 0;
-    data = smap_get(ifrow_config, INTERFACE_USER_CONFIG_MAP_SPEEDS);
-    if (data) {
-        int i, j, found;
-
-        memset(user_config->speeds, 0, sizeof(user_config->speeds));
-        /* parse_speeds() returns -1 if invalid user input */
-        user_config->n_speeds =
-                        parse_speeds(data, user_config->speeds);
-
-        if (user_config->n_speeds > 0) {
-            /* Get speeds from hw_info */
-            hw_info_speeds = smap_get(ifrow_hw_intf_info,
-                                      INTERFACE_HW_INTF_INFO_MAP_SPEEDS);
-            hw_supported_speeds.n_speeds = parse_speeds(hw_info_speeds,
-                                           hw_supported_speeds.speeds);
-            if (user_config->n_speeds <= hw_supported_speeds.n_speeds) {
-                for (i = 0; i < user_config->n_speeds; i++) {
-                    found = false;
-                    for (j = 0; j < hw_supported_speeds.n_speeds; j++) {
-                        if (user_config->speeds[i] ==
-                            hw_supported_speeds.speeds[j]) {
-
-                            found = true;
-                            break;
-                        }
-                    }
-                    if (!found) {
-                        user_config->n_speeds = -1;
-                        break;
-                    }
-                }
-            } else {
-                user_config->n_speeds = -1;
-            }
-        }
-    }
-
-    user_config->mtu = 0;
-    data = smap_get(ifrow_config, INTERFACE_USER_CONFIG_MAP_MTU);
-    if (data) {
-        user_config->mtu = -1;
-        if (is_a_number(data)) {
-            user_config->mtu = atoi(data);
-            if ((user_config->mtu < INTFD_MIN_ALLOWED_USER_SPECIFIED_MTU) ||
-                (user_config->mtu > base_subsys.mtu)) {
-
-                user_config->mtu = -1;
-            }
-        }
-    }
-
-    /* user_config:lane_split */
-    user_config->lane_split = INTERFACE_USER_CONFIG_LANE_SPLIT_NO_SPLIT;
-    data = smap_get(ifrow_config, INTERFACE_USER_CONFIG_MAP_LANE_SPLIT);
-    if (data && (STR_EQ(data, INTERFACE_USER_CONFIG_MAP_LANE_SPLIT_SPLIT))) {
-        user_config->lane_split = INTERFACE_USER_CONFIG_LANE_SPLIT_SPLIT;
-    }
-
-} /* intfd_parse_user_cfg */
-
-static void
-intfd_parse_split_pm_info(struct intf_pm_info *pm_info, const struct smap *ifrow_pm_info)
-{
-    const char *data = NULL;
-    const char *sup_speed = NULL;
-
-    /* pm_info:connector_status */
-    pm_info->connector_status = INTERFACE_PM_INFO_CONNECTOR_STATUS_UNRECOGNIZED;
-
-    data = smap_get(ifrow_pm_info, INTERFACE_PM_INFO_MAP_CONNECTOR_STATUS);
-    if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_STATUS_UNSUPPORTED))) {
-        pm_info->connector_status = INTERFACE_PM_INFO_CONNECTOR_STATUS_UNSUPPORTED;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_STATUS_SUPPORTED))) {
-        pm_info->connector_status = INTERFACE_PM_INFO_CONNECTOR_STATUS_SUPPORTED;
-    }
-
-    data = smap_get(ifrow_pm_info, INTERFACE_PM_INFO_MAP_CONNECTOR);
-    if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_CWDM4))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP28_LR;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_PSM4))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP28_LR;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_CLR4))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP28_LR;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_CR4))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP28_CR;
-        //check if 40G DAC is connected; by reading the supported speed
-        sup_speed = smap_get(ifrow_pm_info, "supported_speeds");
-        if ( sup_speed  && (STR_EQ( sup_speed, "40000"))) {
-            pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_DAC;
-        }
-
-    }  else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_LR4))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP28_LR;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_SR4))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP28_SR;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP_CR4))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_DAC;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP_LR4))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_LR;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP_SR4))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_SR;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_ABSENT))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_ABSENT;
-
-    } else {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_UNKNOWN;
-        pm_info->connector_status = INTERFACE_PM_INFO_CONNECTOR_STATUS_UNSUPPORTED;
-    }
-
-    pm_info->op_connector_flags = get_connector_flags(pm_info->connector);
-    pm_info->intf_type = get_connector_if_type(pm_info->connector);
-
-} /* intfd_parse_split_pm_info */
-
-static void
-intfd_parse_pm_info(struct intf_hw_info *hw_info, struct intf_pm_info *pm_info,
-                    const struct smap *ifrow_pm_info)
-{
-    const char *data = NULL;
-
-    /* If the interface is a fixed port (non-pluggable). */
-    if (hw_info->is_pluggable == false) {
-
-        pm_info->connector_status = INTERFACE_PM_INFO_CONNECTOR_STATUS_SUPPORTED;
-
-        /* Currently intfd only cares about non-pluggable fixed ports of type RJ45.
-         * All other connector types are pluggable, and for them
-         * pm_info will give the details about the pluggable module.
-         */
-        if (hw_info->connector == INTERFACE_HW_INTF_INFO_CONNECTOR_RJ45) {
-            pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_RJ45;
-
-        } else {
-            pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_UNKNOWN;
-            pm_info->connector_status = INTERFACE_PM_INFO_CONNECTOR_STATUS_UNRECOGNIZED;
-        }
-
-        pm_info->op_connector_flags = get_connector_flags(pm_info->connector);
-        pm_info->intf_type = get_connector_if_type(pm_info->connector);
-
-        return;
-    }
-
-
-    /* pm_info:connector_status */
-    pm_info->connector_status = INTERFACE_PM_INFO_CONNECTOR_STATUS_UNRECOGNIZED;
-
-    data = smap_get(ifrow_pm_info, INTERFACE_PM_INFO_MAP_CONNECTOR_STATUS);
-    if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_STATUS_UNSUPPORTED))) {
-        pm_info->connector_status = INTERFACE_PM_INFO_CONNECTOR_STATUS_UNSUPPORTED;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_STATUS_SUPPORTED))) {
-        pm_info->connector_status = INTERFACE_PM_INFO_CONNECTOR_STATUS_SUPPORTED;
-    }
-
-    /* pm_info:connector */
-    pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_UNKNOWN;
-
-    data = smap_get(ifrow_pm_info, INTERFACE_PM_INFO_MAP_CONNECTOR);
-    if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_CWDM4))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_QSFP28_CWDM4;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_PSM4))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_QSFP28_PSM4;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_CLR4))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_QSFP28_CLR4;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_CR4))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_QSFP28_CR4;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_LR4))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_QSFP28_LR4;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP28_SR4))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_QSFP28_SR4;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP28_CR))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP28_CR;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP28_LR))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP28_LR;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP28_SR))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP28_SR;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP_CR4))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_QSFP_CR4;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP_LR4))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_QSFP_LR4;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_QSFP_SR4))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_QSFP_SR4;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_CX))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_CX;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_DAC))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_DAC;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_FC))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_FC;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_LR))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_LR;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_LRM))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_LRM;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_ER))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_ER;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_LX))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_LX;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_RJ45))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_RJ45;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_SR))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_SR;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_SFP_SX))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_SFP_SX;
-
-    } else if (data && (STR_EQ(data, OVSREC_INTERFACE_PM_INFO_CONNECTOR_ABSENT))) {
-        pm_info->connector = INTERFACE_PM_INFO_CONNECTOR_ABSENT;
-    }
-
-    pm_info->op_connector_flags = get_connector_flags(pm_info->connector);
-    pm_info->intf_type = get_connector_if_type(pm_info->connector);
-
-} /* intfd_parse_pm_info */
-
 static void
 intfd_process_parent_child(struct iface *intf,
                            const struct ovsrec_interface *ifrow)
@@ -962,103 +465,285 @@ intfd_process_parent_child(struct iface *intf,
 } /* intfd_process_parent_child */
 
 static void
-set_op_state_pause(struct iface *intf)
+add_new_port(const struct ovsrec_port *port_row)
 {
-    enum ovsrec_interface_hw_intf_config_pause_e hw_pause;
+    struct port_info *new_port = NULL;
+    int i;
 
-    switch(intf->user_cfg.pause) {
+    VLOG_DBG("Port %s being added!\n", port_row->name);
 
-    case INTERFACE_USER_CONFIG_PAUSE_RXTX:
-        hw_pause = INTERFACE_HW_INTF_CONFIG_PAUSE_RXTX;
-        break;
+    /* If the port already exists, return. */
+    if (NULL != shash_find(&all_ports, port_row->name)) {
+        VLOG_WARN("Interface %s specified twice", port_row->name);
+        return;
+    }
 
-    case INTERFACE_USER_CONFIG_PAUSE_TX:
-        hw_pause = INTERFACE_HW_INTF_CONFIG_PAUSE_TX;
-        break;
+    /* Allocate structure to save state information for this port. */
+    new_port = xzalloc(sizeof(struct port_info));
 
-    case INTERFACE_USER_CONFIG_PAUSE_RX:
-        hw_pause = INTERFACE_HW_INTF_CONFIG_PAUSE_RX;
-        break;
+    shash_add(&all_ports, port_row->name, new_port);
 
-    case INTERFACE_USER_CONFIG_PAUSE_NONE:
-    default:
-        hw_pause = INTERFACE_HW_INTF_CONFIG_PAUSE_NONE;
-        break;
+    new_port->name = xstrdup(port_row->name);
+    new_port->interface = xmalloc(port_row->n_interfaces * sizeof(struct ovsrec_interface *));
+    new_port->n_interfaces = port_row->n_interfaces;
+    for (i = 0; i < port_row->n_interfaces; i++) {
+        new_port->interface[i] = port_row->interfaces[i];
     }
-    intf->op_state.pause = hw_pause;
 
-} /* set_op_state_pause */
+    VLOG_DBG("Created local data structure for port %s", port_row->name);
+
+} /* add_new_port */
 
-static uint32_t
-intfd_highest_speed(uint32_t *speeds, int num_speeds)
+/* Returns the subsystem that owns interface 'name', or NULL if neither
+ * an owner nor the base subsystem is known yet. */
+static struct subsystem_info *
+intf_subsystem(const char *name)
 {
-    uint32_t speed;
-    int i;
+    struct subsystem_info *subsys = shash_find_data(&intf_subsystems, name);
 
-    if (num_speeds < 1) {
-        return 0;
+    return subsys ? subsys
+                  : shash_find_data(&all_subsystems, INTFD_BASE_SUBSYSTEM);
+} /* intf_subsystem */
+
+static int32_t
+intf_max_mtu(const char *name)
+{
+    struct subsystem_info *subsys = intf_subsystem(name);
+
+    return subsys ? subsys->mtu : 0;
+} /* intf_max_mtu */
+
+static int32_t
+subsystem_parse_mtu(const struct ovsrec_subsystem *subrow)
+{
+    const char *data;
+    int32_t mtu = 0;
+
+    data = smap_get(&subrow->other_info,
+                    SUBSYSTEM_OTHER_INFO_MAX_TRANSMISSION_UNIT);
+    if (data) {
+        mtu = atoi(data);
+        if (mtu < INTFD_MIN_ALLOWED_USER_SPECIFIED_MTU) {
+            VLOG_WARN("MTU in hw description file for subsystem %s is "
+                      "less than minimum allowed of %d",
+                      subrow->name, INTFD_MIN_ALLOWED_USER_SPECIFIED_MTU);
+        }
     }
 
-    speed = speeds[0];
-    for (i = 1; i < num_speeds; i++) {
-        if (speeds[i] > speed) {
-            speed = speeds[i];
+    return mtu;
+} /* subsystem_parse_mtu */
+
+/* Queues every interface whose MTU limit comes from 'subsys' for
+ * re-validation. */
+static void
+subsystem_revalidate(const struct subsystem_info *subsys)
+{
+    struct shash_node *sh_node;
+    const char *name;
+
+    SSET_FOR_EACH(name, &subsys->interfaces) {
+        if (shash_find_data(&intf_subsystems, name) == subsys) {
+            sset_add(&mtu_revalidate, name);
+        }
+    }
+
+    /* The base subsystem also owns all unlisted interfaces. */
+    if (STR_EQ(subsys->name, INTFD_BASE_SUBSYSTEM)) {
+        SHASH_FOR_EACH(sh_node, &all_interfaces) {
+            if (!shash_find(&intf_subsystems, sh_node->name)) {
+                sset_add(&mtu_revalidate, sh_node->name);
+            }
         }
     }
+} /* subsystem_revalidate */
 
-    return (speed);
+/* Looks for another subsystem listing interface 'name' after 'subsys'
+ * dropped it. */
+static struct subsystem_info *
+subsystem_find_other_owner(const struct subsystem_info *subsys,
+                           const char *name)
+{
+    struct shash_node *sh_node;
 
-} /* intfd_highest_speed */
+    SHASH_FOR_EACH(sh_node, &all_subsystems) {
+        struct subsystem_info *other = sh_node->data;
 
+        if (other != subsys && sset_contains(&other->interfaces, name)) {
+            return other;
+        }
+    }
+
+    return NULL;
+} /* subsystem_find_other_owner */
+
+/* Replaces the interfaces listed by 'subsys' with 'new_interfaces' and
+ * queues every interface whose owner changed for re-validation. */
 static void
-set_op_state_duplex(struct iface *intf)
+subsystem_set_interfaces(struct subsystem_info *subsys,
+                         struct sset *new_interfaces)
 {
-    enum ovsrec_interface_hw_intf_config_duplex_e hw_duplex;
+    struct sset old_interfaces;
+    const char *name;
 
-    switch(intf->user_cfg.duplex) {
+    sset_init(&old_interfaces);
+    sset_swap(&subsys->interfaces, &old_interfaces);
+    sset_swap(&subsys->interfaces, new_interfaces);
 
-    case INTERFACE_USER_CONFIG_DUPLEX_HALF:
-        hw_duplex = INTERFACE_HW_INTF_CONFIG_DUPLEX_HALF;
-        break;
+    SSET_FOR_EACH(name, &old_interfaces) {
+        if (!sset_contains(&subsys->interfaces, name) &&
+            shash_find_data(&intf_subsystems, name) == subsys) {
+            struct subsystem_info *other;
 
-    case INTERFACE_USER_CONFIG_DUPLEX_FULL:
-    default:
-       hw_duplex = INTERFACE_HW_INTF_CONFIG_DUPLEX_FULL;
-        break;
+            other = subsystem_find_other_owner(subsys, name);
+            if (other) {
+                shash_replace(&intf_subsystems, name, other);
+            } else {
+                shash_find_and_delete(&intf_subsystems, name);
+            }
+            sset_add(&mtu_revalidate, name);
+        }
     }
-    intf->op_state.duplex = hw_duplex;
 
-} /* set_op_state_duplex */
+    SSET_FOR_EACH(name, &subsys->interfaces) {
+        struct subsystem_info *owner;
+
+        if (sset_contains(&old_interfaces, name)) {
+            continue;
+        }
+
+        owner = shash_find_data(&intf_subsystems, name);
+        if (!owner) {
+            shash_add(&intf_subsystems, name, subsys);
+            sset_add(&mtu_revalidate, name);
+        } else if (owner != subsys) {
+            VLOG_WARN("Interface %s is listed by subsystems %s and %s, "
+                      "using %s", name, owner->name, subsys->name,
+                      owner->name);
+        }
+    }
+
+    sset_destroy(&old_interfaces);
+} /* subsystem_set_interfaces */
 
 static void
-add_new_port(const struct ovsrec_port *port_row)
+subsystem_update_interfaces(struct subsystem_info *subsys,
+                            const struct ovsrec_subsystem *subrow)
 {
-    struct port_info *new_port = NULL;
-    int i;
+    struct sset new_interfaces;
+    size_t i;
 
-    VLOG_DBG("Port %s being added!\n", port_row->name);
+    sset_init(&new_interfaces);
+    for (i = 0; i < subrow->n_interfaces; i++) {
+        sset_add(&new_interfaces, subrow->interfaces[i]->name);
+    }
+    subsystem_set_interfaces(subsys, &new_interfaces);
+    sset_destroy(&new_interfaces);
+} /* subsystem_update_interfaces */
 
-    /* If the port already exists, return. */
-    if (NULL != shash_find(&all_ports, port_row->name)) {
-        VLOG_WARN("Interface %s specified twice", port_row->name);
+static void
+del_old_subsystem(struct shash_node *sh_node)
+{
+    struct subsystem_info *subsys = sh_node->data;
+    struct sset no_interfaces;
+
+    VLOG_DBG("Deleting subsystem %s", subsys->name);
+
+    /* Everything this subsystem owned loses its MTU limit. */
+    subsystem_revalidate(subsys);
+
+    sset_init(&no_interfaces);
+    subsystem_set_interfaces(subsys, &no_interfaces);
+    sset_destroy(&no_interfaces);
+
+    shash_delete(&all_subsystems, sh_node);
+    sset_destroy(&subsys->interfaces);
+    free(subsys->name);
+    free(subsys);
+} /* del_old_subsystem */
+
+/* Function : subsystem_reconfigure()
+ * Desc     : Keeps 'all_subsystems' and 'intf_subsystems' in sync with the
+ *            Subsystem table.  other_info:max_transmission_unit is only
+ *            re-read when that column changed, and only the interfaces of
+ *            a subsystem whose MTU actually changed are queued in
+ *            'mtu_revalidate'.
+ * Param    : None
+ * Return   : None
+ */
+static void
+subsystem_reconfigure(void)
+{
+    const struct ovsrec_subsystem *subrow = NULL;
+    struct shash sh_idl_subsystems;
+    struct shash_node *sh_node = NULL, *sh_next = NULL;
+    bool mtu_modified, interfaces_modified;
+
+    subrow = ovsrec_subsystem_first(idl);
+
+    /* The table-wide macros need a row; an empty table with subsystems
+     * still cached means they were all deleted. */
+    if (subrow ? (!OVSREC_IDL_ANY_TABLE_ROWS_MODIFIED(subrow, idl_seqno) &&
+                  !OVSREC_IDL_ANY_TABLE_ROWS_DELETED(subrow, idl_seqno) &&
+                  !OVSREC_IDL_ANY_TABLE_ROWS_INSERTED(subrow, idl_seqno))
+               : shash_is_empty(&all_subsystems)) {
         return;
     }
 
-    /* Allocate structure to save state information for this port. */
-    new_port = xzalloc(sizeof(struct port_info));
+    mtu_modified = OVSREC_IDL_IS_COLUMN_MODIFIED(
+                        ovsrec_subsystem_col_other_info, idl_seqno);
+    interfaces_modified = OVSREC_IDL_IS_COLUMN_MODIFIED(
+                        ovsrec_subsystem_col_interfaces, idl_seqno);
 
-    shash_add(&all_ports, port_row->name, new_port);
+    shash_init(&sh_idl_subsystems);
+    OVSREC_SUBSYSTEM_FOR_EACH(subrow, idl) {
+        if (!shash_add_once(&sh_idl_subsystems, subrow->name, subrow)) {
+            VLOG_WARN("subsystem %s specified twice", subrow->name);
+        }
+    }
 
-    new_port->name = xstrdup(port_row->name);
-    new_port->interface = xmalloc(port_row->n_interfaces * sizeof(struct ovsrec_interface *));
-    new_port->n_interfaces = port_row->n_interfaces;
-    for (i = 0; i < port_row->n_interfaces; i++) {
-        new_port->interface[i] = port_row->interfaces[i];
+    /* Delete old subsystems. */
+    SHASH_FOR_EACH_SAFE(sh_node, sh_next, &all_subsystems) {
+        if (!shash_find(&sh_idl_subsystems, sh_node->name)) {
+            del_old_subsystem(sh_node);
+        }
     }
 
-    VLOG_DBG("Created local data structure for port %s", port_row->name);
+    /* Add new subsystems and handle changes to existing ones. */
+    SHASH_FOR_EACH(sh_node, &sh_idl_subsystems) {
+        struct subsystem_info *subsys;
+        bool is_new = false;
+        int32_t mtu;
+
+        subrow = sh_node->data;
+        subsys = shash_find_data(&all_subsystems, sh_node->name);
+        if (!subsys) {
+            VLOG_DBG("Adding new subsystem %s", subrow->name);
+            subsys = xzalloc(sizeof *subsys);
+            subsys->name = xstrdup(subrow->name);
+            sset_init(&subsys->interfaces);
+            shash_add(&all_subsystems, subrow->name, subsys);
+            is_new = true;
+        } else if (!OVSREC_IDL_IS_ROW_MODIFIED(subrow, idl_seqno)) {
+            continue;
+        }
 
-} /* add_new_port */
+        if (is_new || interfaces_modified) {
+            subsystem_update_interfaces(subsys, subrow);
+        }
+
+        if (is_new || mtu_modified) {
+            mtu = subsystem_parse_mtu(subrow);
+            if (mtu != subsys->mtu) {
+                VLOG_DBG("Subsystem %s MTU changed from %d to %d",
+                         subsys->name, subsys->mtu, mtu);
+                subsys->mtu = mtu;
+                subsystem_revalidate(subsys);
+            }
+        }
+    }
+
+    shash_destroy(&sh_idl_subsystems);
+} /* subsystem_reconfigure */
 
 static void
 add_new_interface(const struct ovsrec_interface *ifrow)
@@ -1082,9 +767,9 @@ add_new_interface(const struct ovsrec_interface *ifrow)
 
     intfd_parse_hw_info(&(new_intf->hw_info), &(ifrow->hw_intf_info));
     intfd_parse_user_cfg(&(new_intf->user_cfg), &(ifrow->user_config),
-                         &(ifrow->hw_intf_info));
+                         &(ifrow->hw_intf_info), intf_max_mtu(ifrow->name));
 
-    new_intf->type = xstrdup(ifrow->type);
+    new_intf->type_class = intfd_core_type_class(ifrow->type);
 
     /* Check for pm_info only if the interface is not internal */
     intfd_parse_pm_info(&(new_intf->hw_info), &(new_intf->pm_info), &(ifrow->pm_info));
@@ -1102,8 +787,8 @@ del_old_interface(struct shash_node *sh_node)
 {
     if (sh_node) {
         struct iface *intf = sh_node->data;
+        standby_drop_output(intf->name);
         free(intf->name);
-        free(intf->type);
         if (intf->split_children) {
             free(intf->split_children);
         }
@@ -1117,12 +802,10 @@ del_old_port(struct shash_node *sh_node)
 {
     int j;
     const struct ovsrec_interface *intf_row = NULL;
-    struct smap hw_cfg_smap;
 
     if (sh_node) {
         struct port_info *port_data = sh_node->data;
         for(j = 0; j < port_data->n_interfaces; j++) {
-            smap_init(&hw_cfg_smap);
             intf_row = port_data->interface[j];
             /* logical interface details will not be there in
                interface table since it has been deleted */
@@ -1134,12 +817,9 @@ del_old_port(struct shash_node *sh_node)
                 if (!get_matching_port_row(intf_row->name))
                 {
                     VLOG_DBG("Port delete : reset interface %s\n", intf_row->name);
-                    smap_add(&hw_cfg_smap, INTERFACE_HW_INTF_CONFIG_MAP_ENABLE,
-                             INTERFACE_HW_INTF_CONFIG_MAP_ENABLE_FALSE);
-                    ovsrec_interface_set_hw_intf_config(intf_row, &hw_cfg_smap);
+                    reset_intf_hw_config_in_db(intf_row);
                 }
             }
-            smap_destroy(&hw_cfg_smap);
         }
         free(port_data->name);
         free(port_data->interface);
@@ -1148,470 +828,172 @@ del_old_port(struct shash_node *sh_node)
     }
 } /* del_old_port */
 
-/* FUNCTION: calc_intf_op_state_n_reason()
- *
- * This function determines an interface's operational state & reasons:
- *
- *    - op state:        Interface "hw_intf_config:enable"
- *    - op state reason: Interface "error"
- *
- * Following is a complete summary of the different operational states
- * and the associated reasons for an interface, listed in order of
- * priority, with the highest priority values listed first.
- *
- * Note that if multiple reasons apply to an interface, only the
- * highest priority reason is displayed.  E.g., if a pluggable
- * interface does not have any pluggable module installed, and its
- * interface admin state is set to disabled by an administrator, then
- * "error" will only show "admin_down".  It becomes "unpopulated"
- * after its admin interface state is set to enabled.
- *
- * OP STATE  OP STATE REASON        NOTES
- * --------  ---------------        -----
- *
- * disabled  lanes_split
- *                  Interface is not usable due to the interface being
- *                  configured in split mode.  Applicable to
- *                  splittable primary interface only (e.g. QSFP+, QSFP28).
- *
- * disabled  lanes_not_split
- *                  Interface is not usable due to the interface being
- *                  configured in non-split mode. Applicable to
- *                  splittable subinterfaces only (e.g. QSFP+, QSFP28).
- *
- * disabled  admin_down
- *                  Interface "user_config:admin" property is set to
- *                  "down" by an administrator.
- *
- * disabled  module_missing
- *                  Interface is pluggable, but no pluggable module is
- *                  present.
- *
- * disabled  module_unrecognized
- *                  Interface is pluggable, but the pluggable module
- *                  identification information cannot be read.
- *
- * disabled  module_unsupported
- *                  Interface is pluggable, but the pluggable module
- *                  type is not supported.  This may be one of the
- *                  following reasons:
- *                   1. Unsupported module.
- *                   2. Enet 1/10/40G modules in an interface that
- *                      does not support that particular Ethernet
- *                      speed.
- *
- * disabled  invalid_mtu
- *                  User specified MTU is invalid.
- *
- * disabled  invalid_speeds
- *                  User specified speeds is invalid.
- *
- * disabled  autoneg_required
- *                  User specified autoneg=off when it is required
- *
- * disabled  autoneg_not_supported
- *                  User specified autoneg=on when it is not supported
- *
- * NOTE: All new checks should be added above the following
- *
- * enabled   ok
- *                  A supported module is present and everything is
- *                  fine.  Interface is enabled.  This does not imply
- *                  link is necessarily up; it simply means a
- *                  interface is enabled at the h/w level.
- */
 static void
-calc_intf_op_state_n_reason(struct iface *intf)
+standby_output_destroy(struct standby_output *out)
 {
-    VLOG_DBG("Checking interface %s in hardware.\n", intf->name);
+    free(out->error);
+    smap_destroy(&out->hw_intf_config);
+    free(out);
 
-    /* Default the interface to disabled. */
-    intf->op_state.enabled = false;
-    intf->op_state.reason = INTERFACE_ERROR_UNINITIALIZED;
+} /* standby_output_destroy */
 
-    if ((STR_EQ(intf->type, OVSREC_INTERFACE_TYPE_INTERNAL))
-       || (STR_EQ(intf->type, OVSREC_INTERFACE_TYPE_VLANSUBINT))
-       || (STR_EQ(intf->type, OVSREC_INTERFACE_TYPE_LOOPBACK))) {
-        if (intf->user_cfg.admin_state == INTERFACE_USER_CONFIG_ADMIN_DOWN) {
-            intf->op_state.reason = INTERFACE_ERROR_ADMIN_DOWN;
+/* Remember what would have been written to 'name' while in standby. */
+static void
+standby_stash_output(const char *name, const char *error,
+                     bool error_unchanged, const struct smap *hw_intf_config)
+{
+    struct standby_output *out = shash_find_data(&standby_outputs, name);
 
-        /* Checking for port admin as down */
-        } else if (intf->port_admin == PORT_ADMIN_CONFIG_DOWN) {
-            intf->op_state.reason = PORT_ERROR_ADMIN_DOWN;
-        } else {
-            intf->op_state.enabled = true;
-            intf->op_state.reason = INTERFACE_ERROR_OK;
-        }
-        return;
+    if (!out) {
+        out = xzalloc(sizeof *out);
+        smap_init(&out->hw_intf_config);
+        shash_add(&standby_outputs, name, out);
     }
 
-    /* Checking for splittable primary interface & lanes_split condition. */
-    if (intf->split_children != NULL &&
-        intf->user_cfg.lane_split == INTERFACE_USER_CONFIG_LANE_SPLIT_SPLIT) {
-        intf->op_state.reason = INTERFACE_ERROR_LANES_SPLIT;
-
-    /* Checking for splittable subinterface & lanes_not_split condition. */
-    } else if (intf->split_parent != NULL &&
-               intf->split_parent->user_cfg.lane_split == INTERFACE_USER_CONFIG_LANE_SPLIT_NO_SPLIT) {
-        intf->op_state.reason = INTERFACE_ERROR_LANES_NOT_SPLIT;
-
-    /* Checking admin state. */
-    } else if (intf->user_cfg.admin_state == INTERFACE_USER_CONFIG_ADMIN_DOWN) {
-        intf->op_state.reason = INTERFACE_ERROR_ADMIN_DOWN;
-        VLOG_DBG("calc_state: Set admin state to DOWN\n");
-
-    /* Checking for missing pluggable module. */
-    } else if (intf->pm_info.connector == INTERFACE_PM_INFO_CONNECTOR_ABSENT) {
-        intf->op_state.reason = INTERFACE_ERROR_MODULE_MISSING;
-
-    /* Checking for unrecognized pluggable module. */
-    } else if (intf->pm_info.connector_status == INTERFACE_PM_INFO_CONNECTOR_STATUS_UNRECOGNIZED) {
-        intf->op_state.reason = INTERFACE_ERROR_MODULE_UNRECOGNIZED;
-
-    /* Checking for unsupported pluggable module. */
-    } else if ((intf->pm_info.connector_status ==
-                    INTERFACE_PM_INFO_CONNECTOR_STATUS_UNSUPPORTED) ||
-               (intf->pm_info.op_connector_flags == PM_UNSUPPORTED_FLAG)) {
-        intf->op_state.reason = INTERFACE_ERROR_MODULE_UNSUPPORTED;
-
-    /* Checking for invalid mtu. */
-    } else if (intf->op_state.mtu == -1) {
-        intf->op_state.reason = INTERFACE_ERROR_INVALID_MTU;
-
-    /* Checking for invalid speeds. */
-    } else if (intf->op_state.n_speeds == -1) {
-        intf->op_state.reason = INTERFACE_ERROR_INVALID_SPEEDS;
-
-    /* Checking for invalid autoneg. */
-    } else if (intf->op_state.autoneg_state == INTFD_AUTONEG_STATE_INVALID) {
-        intf->op_state.reason = intf->op_state.autoneg_reason;
-
-    /* Checking for port admin as down */
-    } else if (intf->port_admin == PORT_ADMIN_CONFIG_DOWN) {
-        intf->op_state.reason = PORT_ERROR_ADMIN_DOWN;
-
-    } else {
-        /* FIXME: Lots of other business logic needs to be added here. */
-        /* If we get here, everything's fine. */
-
-        intf->op_state.enabled = true;
-        intf->op_state.reason = INTERFACE_ERROR_OK;
-        VLOG_DBG("Need to enable interface %s in hardware.\n", intf->name);
-
+    /* A reset keeps the "error" a previous update would have written. */
+    if (!error_unchanged) {
+        free(out->error);
+        out->error = nullable_xstrdup(error);
+        out->write_error = true;
     }
 
-} /* calc_intf_op_state_n_reason */
+    smap_destroy(&out->hw_intf_config);
+    smap_clone(&out->hw_intf_config, hw_intf_config);
+
+} /* standby_stash_output */
 
+/* Forget the stashed values of 'name', which are either being written
+ * now or belong to an interface that no longer exists. */
 static void
-validate_n_set_interface_capability(struct iface *intf)
+standby_drop_output(const char *name)
 {
-    /*
-     * This function determines if an interface supports, requires, or does not
-     * support auto-negotiation along with the supported speeds.
-     * It then looks at user input for AN and speeds and either reports an
-     * error if invalid user input or sets the appropriate value(s) for
-     * AN and speeds.
-    */
-
-    /* FIXME: Add support for multi-speed capable transceivers (or
-       fixed ports). Hard coded for now to single speed.
-    */
-
-    /* If the user input an invalid "speeds", return */
-    if (intf->user_cfg.n_speeds == -1) {
-        intf->op_state.n_speeds = -1;
-        return;
-    }
+    struct standby_output *out;
 
-    /* If the user input an invalid mtu, return */
-    if (intf->user_cfg.mtu == -1) {
+    if (shash_is_empty(&standby_outputs)) {
         return;
     }
 
-    if (CONNECTOR_IS_SFP_PLUS_10G(intf)) {
-        intf->op_state.autoneg_capability = INTFD_AUTONEG_CAPABILITY_UNSUPPORTED;
-        intf->op_state.speeds[0] = SPEED_10G;
-        intf->op_state.n_speeds = 1;
-
-    } else if (CONNECTOR_IS_SFP28_25G(intf)) {
-        /* SFP28 CR requires AN, SR/LR do not. */
-        if (INTERFACE_PM_INFO_CONNECTOR_SFP28_CR == intf->pm_info.connector) {
-            intf->op_state.autoneg_capability = INTFD_AUTONEG_CAPABILITY_REQUIRED;
-        } else {
-            intf->op_state.autoneg_capability = INTFD_AUTONEG_CAPABILITY_UNSUPPORTED;
-        }
-
-        intf->op_state.speeds[0] = SPEED_25G;
-        intf->op_state.n_speeds = 1;
-
-    } else if (CONNECTOR_IS_SFP(intf)) {
-        intf->op_state.autoneg_capability = INTFD_AUTONEG_CAPABILITY_REQUIRED;
-        /* FIXME: Currently not supporting tri-speed devices */
-        intf->op_state.speeds[0] = SPEED_1G;
-        intf->op_state.n_speeds = 1;
-
-    } else if (CONNECTOR_IS_QSFP_PLUS_40G(intf)) {
-        /* QSFP+ CR4 requires AN, SR4/LR4 do not. */
-        if (INTERFACE_PM_INFO_CONNECTOR_QSFP_CR4 == intf->pm_info.connector) {
-            intf->op_state.autoneg_capability = INTFD_AUTONEG_CAPABILITY_REQUIRED;
-        } else {
-            intf->op_state.autoneg_capability = INTFD_AUTONEG_CAPABILITY_UNSUPPORTED;
-        }
-
-        intf->op_state.speeds[0] = SPEED_40G;
-        intf->op_state.n_speeds = 1;
+    out = shash_find_and_delete(&standby_outputs, name);
+    if (out) {
+        standby_output_destroy(out);
+    }
 
-    } else if (CONNECTOR_IS_QSFP28_100G(intf)) {
-        /* QSFP28 CR4 requires AN, SR4/LR4 do not. */
-        if (INTERFACE_PM_INFO_CONNECTOR_QSFP28_CR4 == intf->pm_info.connector) {
-            intf->op_state.autoneg_capability = INTFD_AUTONEG_CAPABILITY_REQUIRED;
-        } else {
-            intf->op_state.autoneg_capability = INTFD_AUTONEG_CAPABILITY_UNSUPPORTED;
-        }
+} /* standby_drop_output */
 
-        intf->op_state.speeds[0] = SPEED_100G;
-        intf->op_state.n_speeds = 1;
+static void
+standby_clear_outputs(void)
+{
+    struct shash_node *sh_node, *sh_next;
 
-    } else {
-        /* This should be midplane connectors.  As of now,
-         * all midplane connections are of KR/KR2 variety,
-         * which requires auto-negotiation, even if a
-         * specific speed is specified later. */
-        intf->op_state.autoneg_capability = INTFD_AUTONEG_CAPABILITY_REQUIRED;
-        intf->op_state.speeds[0] = 0;
-        intf->op_state.n_speeds = 0;
+    SHASH_FOR_EACH_SAFE(sh_node, sh_next, &standby_outputs) {
+        standby_output_destroy(sh_node->data);
+        shash_delete(&standby_outputs, sh_node);
     }
 
-    /* Override autoneg and speeds based on user input */
-    intf->op_state.autoneg_reason = INTERFACE_ERROR_UNINITIALIZED;
+} /* standby_clear_outputs */
 
-    /* If autoneg=true and didn't set speeds */
-    if ((intf->user_cfg.autoneg == INTERFACE_USER_CONFIG_AUTONEG_ON) &&
-        (intf->user_cfg.n_speeds == 0)) {
+/* Write the stashed values that differ from the dB, after taking the
+ * lock over.  Returns the number of interfaces written. */
+static int
+standby_reconcile(void)
+{
+    const struct ovsrec_interface *ifrow = NULL;
+    int n_written = 0;
 
-        intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_ENABLED;
+    OVSREC_INTERFACE_FOR_EACH(ifrow, idl) {
+        struct standby_output *out = shash_find_data(&standby_outputs,
+                                                     ifrow->name);
+        const char *error = INTFD_RECORD_ERROR_UNCHANGED;
+        bool changed = false;
 
-        if (intf->op_state.autoneg_capability == INTFD_AUTONEG_CAPABILITY_UNSUPPORTED) {
-            /* report error */
-            intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_INVALID;
-            intf->op_state.autoneg_reason = INTERFACE_ERROR_AUTONEG_NOT_SUPPORTED;
+        if (!out) {
+            continue;
         }
 
-    /* If autoneg=false and didn't set speeds */
-    } else if ((intf->user_cfg.autoneg == INTERFACE_USER_CONFIG_AUTONEG_OFF) &&
-               (intf->user_cfg.n_speeds == 0)) {
-
-        intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_DISABLED;
-
-        if (intf->op_state.autoneg_capability ==
-                                        INTFD_AUTONEG_CAPABILITY_REQUIRED) {
-            /* report error */
-            intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_INVALID;
-            intf->op_state.autoneg_reason = INTERFACE_ERROR_AUTONEG_REQUIRED;
-
-        } else if (intf->op_state.autoneg_capability ==
-                                        INTFD_AUTONEG_CAPABILITY_OPTIONAL) {
-
-            /* use highest supported speed */
-            intf->op_state.speeds[0] = intfd_highest_speed(intf->hw_info.speeds,
-                                                           intf->hw_info.n_speeds);
-            intf->op_state.n_speeds = 1;
+        if (out->write_error) {
+            error = out->error;
+            if (!nullable_string_is_equal(error, ifrow->error)) {
+                ovsrec_interface_set_error(ifrow, error);
+                changed = true;
+            }
         }
 
-    /* If not set autoneg and set speeds */
-    } else if ((intf->user_cfg.autoneg == INTERFACE_USER_CONFIG_AUTONEG_DEFAULT) &&
-               (intf->user_cfg.n_speeds > 0)) {
-
-        if (intf->op_state.autoneg_capability != INTFD_AUTONEG_CAPABILITY_UNSUPPORTED) {
-
-            intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_ENABLED;
-
-            /* Use user speeds */
-            memcpy(intf->op_state.speeds, intf->user_cfg.speeds,
-                   sizeof(intf->user_cfg.speeds));
-            intf->op_state.n_speeds = intf->user_cfg.n_speeds;
-
-        } else {
-
-            intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_DISABLED;
-
-            /* get first speed supplied by user */
-            intf->op_state.speeds[0] = intf->user_cfg.speeds[0];
-            intf->op_state.n_speeds = 1;
+        if (!smap_equal(&out->hw_intf_config, &ifrow->hw_intf_config)) {
+            ovsrec_interface_set_hw_intf_config(ifrow, &out->hw_intf_config);
+            changed = true;
         }
 
-    /* If autoneg=true and set speeds */
-    } else if ((intf->user_cfg.autoneg == INTERFACE_USER_CONFIG_AUTONEG_ON) &&
-               (intf->user_cfg.n_speeds > 0)) {
-
-        if ((intf->op_state.autoneg_capability == INTFD_AUTONEG_CAPABILITY_REQUIRED) ||
-            (intf->op_state.autoneg_capability == INTFD_AUTONEG_CAPABILITY_OPTIONAL)) {
-
-            intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_ENABLED;
-
-            /* Use user speeds */
-            memcpy(intf->op_state.speeds, intf->user_cfg.speeds,
-                   sizeof(intf->user_cfg.speeds));
-            intf->op_state.n_speeds = intf->user_cfg.n_speeds;
-
-        } else {
-            /* report error */
-            intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_INVALID;
-            intf->op_state.autoneg_reason = INTERFACE_ERROR_AUTONEG_NOT_SUPPORTED;
+        if (changed) {
+            intfd_record_output(ifrow->name, error, &out->hw_intf_config);
+            n_written++;
         }
+    }
 
-    /* If autoneg=false and set speeds */
-    } else if ((intf->user_cfg.autoneg == INTERFACE_USER_CONFIG_AUTONEG_OFF) &&
-               (intf->user_cfg.n_speeds > 0)) {
-
-        intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_DISABLED;
-
-        if (intf->op_state.autoneg_capability == INTFD_AUTONEG_CAPABILITY_REQUIRED) {
-
-            /* report error */
-            intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_INVALID;
-            intf->op_state.autoneg_reason = INTERFACE_ERROR_AUTONEG_REQUIRED;
-        } else {
-            /* Use first entry in user speeds */
-            intf->op_state.speeds[0] = intf->user_cfg.speeds[0];
-            intf->op_state.n_speeds = 1;
-        }
+    VLOG_INFO("Took over the ops_intfd lock, %d of %"PRIuSIZE" interfaces "
+              "differed from the standby state",
+              n_written, shash_count(&standby_outputs));
 
-    /* If not set autoneg and not set speeds */
-    } else {
-        if (intf->op_state.autoneg_capability == INTFD_AUTONEG_CAPABILITY_UNSUPPORTED) {
-            intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_DISABLED;
-        } else {
-            intf->op_state.autoneg_state = INTFD_AUTONEG_STATE_ENABLED;
-        }
-    }
+    return n_written;
 
-} /* validate_n_set_interface_capability */
+} /* standby_reconcile */
 
 void
 set_intf_hw_config_in_db(const struct ovsrec_interface *ifrow, struct iface *intf)
 {
-    const char *tmp_str = NULL;
+    const char *error = NULL;
 
     struct smap smap = SMAP_INITIALIZER(&smap);
 
-    /* Write H/W config changes to the interface row in OVSDB. */
-    tmp_str = NULL;
-    if (intf->op_state.enabled != true) {
-        tmp_str = intfd_get_error_str(intf->op_state.reason);
-    }
-    ovsrec_interface_set_error(ifrow, tmp_str);
-
-    /* We want to build up a new hw_intf_config map. */
-
-    /* hw_intf_config:enabled */
-    tmp_str = INTERFACE_HW_INTF_CONFIG_MAP_ENABLE_FALSE;
-    if (intf->op_state.enabled == true) {
-        tmp_str = INTERFACE_HW_INTF_CONFIG_MAP_ENABLE_TRUE;
-    }
-
-    smap_add(&smap, INTERFACE_HW_INTF_CONFIG_MAP_ENABLE, tmp_str);
-
-    if ((intf->op_state.enabled == true) &&
-        ((!STR_EQ(intf->type, OVSREC_INTERFACE_TYPE_INTERNAL)) ||
-        (!STR_EQ(intf->type, OVSREC_INTERFACE_TYPE_VLANSUBINT))  ||
-        (!STR_EQ(intf->type, OVSREC_INTERFACE_TYPE_LOOPBACK))))  {
-
-        /* hw_intf_config:autoneg */
-        tmp_str = INTERFACE_HW_INTF_CONFIG_MAP_AUTONEG_OFF;
-        if (intf->op_state.autoneg_state == INTFD_AUTONEG_STATE_ENABLED) {
-            tmp_str = INTERFACE_HW_INTF_CONFIG_MAP_AUTONEG_ON;
-        }
+    error = intfd_build_hw_intf_config(intf, &smap);
 
-        smap_add(&smap, INTERFACE_HW_INTF_CONFIG_MAP_AUTONEG, tmp_str);
+    if (standby) {
+        standby_stash_output(ifrow->name, error, false, &smap);
 
-        /* hw_intf_config:duplex */
-        tmp_str = INTERFACE_HW_INTF_CONFIG_MAP_DUPLEX_FULL;
-        if (intf->op_state.duplex == INTERFACE_HW_INTF_CONFIG_DUPLEX_HALF) {
-            tmp_str = INTERFACE_HW_INTF_CONFIG_MAP_DUPLEX_HALF;
-        }
-
-        smap_add(&smap, INTERFACE_HW_INTF_CONFIG_MAP_DUPLEX, tmp_str);
-
-        /* hw_intf_config:pause */
-        tmp_str = INTERFACE_HW_INTF_CONFIG_MAP_PAUSE_NONE;
-        if (intf->op_state.pause == INTERFACE_HW_INTF_CONFIG_PAUSE_RXTX) {
-            tmp_str = INTERFACE_HW_INTF_CONFIG_MAP_PAUSE_RXTX;
-
-        } else if (intf->op_state.pause == INTERFACE_HW_INTF_CONFIG_PAUSE_TX) {
-            tmp_str = INTERFACE_HW_INTF_CONFIG_MAP_PAUSE_TX;
-
-        } else if (intf->op_state.pause == INTERFACE_HW_INTF_CONFIG_PAUSE_RX) {
-            tmp_str = INTERFACE_HW_INTF_CONFIG_MAP_PAUSE_RX;
-        }
-
-        smap_add(&smap, INTERFACE_HW_INTF_CONFIG_MAP_PAUSE, tmp_str);
-
-        /* hw_intf_config:mtu */
-        if (intf->op_state.mtu >= INTFD_MIN_ALLOWED_USER_SPECIFIED_MTU) {
-            smap_add_format(&smap, INTERFACE_HW_INTF_CONFIG_MAP_MTU, "%d",
-                            intf->op_state.mtu);
-        }
-
-        /* Set speeds */
-        if (intf->op_state.n_speeds > 0) {
-            /* Use user-configured speeds. */
-            char speed_string[INTFD_MAX_SPEEDS_ALLOWED*20];
-            int i = 0;
-
-            sprintf(speed_string, "%d", intf->op_state.speeds[0]);
-            for (i = 1; i < intf->op_state.n_speeds; i++) {
-                sprintf(speed_string+strlen(speed_string), ",%d",
-                        intf->op_state.speeds[i]);
-            }
-
-            smap_add(&smap, INTERFACE_HW_INTF_CONFIG_MAP_SPEEDS, speed_string);
-        }
-        smap_add(&smap, INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE,
-                  intfd_get_intf_type_str(intf->pm_info.intf_type));
+    } else {
+        /* Write H/W config changes to the interface row in OVSDB. */
+        standby_drop_output(ifrow->name);
+        ovsrec_interface_set_error(ifrow, error);
+        ovsrec_interface_set_hw_intf_config(ifrow, &smap);
+        intfd_record_output(ifrow->name, error, &smap);
     }
 
-    ovsrec_interface_set_hw_intf_config(ifrow, &smap);
+    smap_destroy(&smap);
 
 } /* set_intf_hw_config_in_db */
 
+/* Disable an interface in h/w that is no longer part of any port.
+ * The "error" column is left untouched. */
 static void
-set_op_state_mtu(struct iface *intf)
+reset_intf_hw_config_in_db(const struct ovsrec_interface *ifrow)
 {
-    /* Use the user MTU if specified and valid, else use default */
-    switch (intf->user_cfg.mtu) {
-        case -1:
-            intf->op_state.mtu = -1;
-            break;
-        case 0:
-            intf->op_state.mtu = INTFD_DEFAULT_MTU;
-            break;
-        default:
-            intf->op_state.mtu = intf->user_cfg.mtu;
-            break;
+    struct smap hw_cfg_smap;
+
+    VLOG_DBG("reset interface %s\n", ifrow->name);
+    smap_init(&hw_cfg_smap);
+    smap_add(&hw_cfg_smap,
+             INTERFACE_HW_INTF_CONFIG_MAP_ENABLE,
+             INTERFACE_HW_INTF_CONFIG_MAP_ENABLE_FALSE);
+    if (standby) {
+        standby_stash_output(ifrow->name, NULL, true, &hw_cfg_smap);
+    } else {
+        ovsrec_interface_set_hw_intf_config(ifrow, &hw_cfg_smap);
+        intfd_record_output(ifrow->name, INTFD_RECORD_ERROR_UNCHANGED,
+                            &hw_cfg_smap);
     }
-} /* set_op_state_mtu */
+    smap_destroy(&hw_cfg_smap);
+
+} /* reset_intf_hw_config_in_db */
 
 void
 set_interface_config(const struct ovsrec_interface *ifrow, struct iface *intf)
 {
     VLOG_DBG("Received new config for interface %s", ifrow->name);
 
-    /* Set mtu. */
-    set_op_state_mtu(intf);
-
-    /* Update autoneg capabilities of the interface. */
-    validate_n_set_interface_capability(intf);
-
-    /* Figure out if interface can be enabled. */
-    calc_intf_op_state_n_reason(intf);
-
-    if (intf->op_state.enabled == true) {
-
-        set_op_state_pause(intf);
-
-        set_op_state_duplex(intf);
-    }
+    /* Derive mtu, autoneg, speeds and the op state. */
+    intfd_core_calc_op_state(intf);
+    VLOG_DBG("Interface %s is %s in hardware (%s).", intf->name,
+             intf->op_state.enabled ? "enabled" : "disabled",
+             intfd_get_error_str(intf->op_state.reason));
 
     /* One interface needs to be reconfigured in h/w. */
     set_intf_hw_config_in_db(ifrow, intf);
@@ -1647,11 +1029,13 @@ handle_interfaces_config_mods(struct shash *sh_idl_interfaces)
             set_interface_config(ifrow, intf);
             rc++;
 
-        } else if (OVSREC_IDL_IS_ROW_MODIFIED(ifrow, idl_seqno)) {
+        } else if (OVSREC_IDL_IS_ROW_MODIFIED(ifrow, idl_seqno) ||
+                   sset_contains(&mtu_revalidate, sh_node->name)) {
 
             VLOG_DBG("Something got modified\n");
             intfd_parse_user_cfg(&new_user_cfg, &ifrow->user_config,
-                                 &ifrow->hw_intf_info);
+                                 &ifrow->hw_intf_info,
+                                 intf_max_mtu(ifrow->name));
 
             port_parse_admin(&(intf->port_admin), ifrow);
 
@@ -1823,8 +1207,10 @@ add_del_interface_handle_port_config_mods(void)
                                     INTERFACE_USER_CONFIG_MAP_ADMIN);
                     if (data && (STR_EQ(data, OVSREC_INTERFACE_USER_CONFIG_ADMIN_UP))) {
                         intf->user_cfg.admin_state = INTERFACE_USER_CONFIG_ADMIN_UP;
-                        log_event("INTERFACE_UP", EV_KV("interface", intf->name));
-                    } else {
+                        if (!standby) {
+                            log_event("INTERFACE_UP", EV_KV("interface", intf->name));
+                        }
+                    } else if (!standby) {
                         log_event("INTERFACE_DOWN", EV_KV("interface", intf->name));
                     }
                     set_interface_config(intf_row, intf);
@@ -1855,7 +1241,6 @@ remove_interface_from_port(const struct ovsrec_port *port_row)
     int rc = 0, i, j;
     int found;
     const struct ovsrec_interface *intf_row = NULL;
-    struct smap hw_cfg_smap;
     struct port_info *port_data;
     struct iface *intf;
 
@@ -1879,13 +1264,7 @@ remove_interface_from_port(const struct ovsrec_port *port_row)
                 VLOG_INFO("Set the new admin state based on the port state\n");
                 set_interface_config(intf_row, intf);
             } else {
-                VLOG_DBG("reset interface %s\n", intf_row->name);
-                smap_init(&hw_cfg_smap);
-                smap_add(&hw_cfg_smap,
-                        INTERFACE_HW_INTF_CONFIG_MAP_ENABLE,
-                        INTERFACE_HW_INTF_CONFIG_MAP_ENABLE_FALSE);
-                ovsrec_interface_set_hw_intf_config(intf_row, &hw_cfg_smap);
-                smap_destroy(&hw_cfg_smap);
+                reset_intf_hw_config_in_db(intf_row);
             }
         }
         rc++;
@@ -1910,13 +1289,7 @@ remove_interface_from_port(const struct ovsrec_port *port_row)
                 intf->user_cfg.admin_state = intf_parse_admin(intf_row);
                 set_interface_config(intf_row, intf);
             } else {
-                VLOG_DBG("reset interface %s\n", intf_row->name);
-                smap_init(&hw_cfg_smap);
-                smap_add(&hw_cfg_smap,
-                        INTERFACE_HW_INTF_CONFIG_MAP_ENABLE,
-                        INTERFACE_HW_INTF_CONFIG_MAP_ENABLE_FALSE);
-                ovsrec_interface_set_hw_intf_config(intf_row, &hw_cfg_smap);
-                smap_destroy(&hw_cfg_smap);
+                reset_intf_hw_config_in_db(intf_row);
             }
             rc++;
 
@@ -2009,6 +1382,12 @@ intfd_arbiter_run(void)
     const struct ovsrec_interface *ifrow = NULL;
     struct smap forwarding_state;
 
+    /* The forwarding state is derived from the dB alone, so a standby
+     * instance has nothing to keep; it runs once it holds the lock. */
+    if (standby) {
+        return 0;
+    }
+
     /* Walk through all the interfaces and update the forwarding states
      * for each layer and the final forwarding state. */
     OVSREC_INTERFACE_FOR_EACH(ifrow, idl) {
@@ -2031,7 +1410,6 @@ intfd_reconfigure(void)
 {
     int rc = 0;
     const struct ovsrec_interface *ifrow = NULL;
-    const struct ovsrec_subsystem *subrow = NULL;
     unsigned int new_idl_seqno = 0;
     struct shash sh_idl_interfaces;
     struct shash_node *sh_node = NULL, *sh_next = NULL;
@@ -2043,31 +1421,12 @@ intfd_reconfigure(void)
     }
     VLOG_DBG("Intfd_reconfigure\n");
 
-    /* Need MTU from subsystem table.
-     *
-     * FIXME: need to add multiple subsystem support
-     *
-     * For now, hard coding to look for "base" and continue to assume
-     * that all interfaces belong to the "base" subsystem.
-    */
+    /* Log the row changes of this batch if recording is enabled. */
+    intfd_record_updates(idl, idl_seqno);
 
-    base_subsys.mtu = 0;
-    OVSREC_SUBSYSTEM_FOR_EACH(subrow, idl) {
-        const char *data;
-        if (strcmp(subrow->name, "base") == 0) {
-            data = smap_get(&subrow->other_info,
-                            SUBSYSTEM_OTHER_INFO_MAX_TRANSMISSION_UNIT);
-            if (data) {
-                base_subsys.mtu = atoi(data);
-                if (base_subsys.mtu < INTFD_MIN_ALLOWED_USER_SPECIFIED_MTU) {
-                    VLOG_WARN("MTU in hw description file for subsystem %s is "
-                              "less than minimum allowed of %d",
-                              subrow->name,
-                              INTFD_MIN_ALLOWED_USER_SPECIFIED_MTU);
-                }
-            }
-        }
-    }
+    /* Pick up subsystem MTU and interface ownership changes before
+     * any interface is parsed against its subsystem's MTU. */
+    subsystem_reconfigure();
 
     /* Collect all the interfaces in the dB. */
     shash_init(&sh_idl_interfaces);
@@ -2108,6 +1467,9 @@ intfd_reconfigure(void)
 
     /* Update idl_seqno after handling all OVSDB updates. */
     idl_seqno = new_idl_seqno;
+    sset_clear(&mtu_revalidate);
+
+    intfd_record_commit();
 
     /* Destroy the shash of the IDL interfaces. */
     shash_destroy(&sh_idl_interfaces);
@@ -2135,22 +1497,44 @@ intfd_system_is_configured(void)
     return false;
 } /* intfd_system_is_configured */
 
+void
+intfd_ovsdb_set_standby(bool enable)
+{
+    standby_enabled = enable;
+} /* intfd_ovsdb_set_standby */
+
 void
 intfd_run(void)
 {
     struct ovsdb_idl_txn *txn;
+    enum ovsdb_idl_txn_status status = TXN_UNCHANGED;
+    int rc;
 
     /* Process a batch of messages from OVSDB. */
     ovsdb_idl_run(idl);
 
-    if (ovsdb_idl_is_lock_contended(idl)) {
-        static struct vlog_rate_limit rl = VLOG_RATE_LIMIT_INIT(1, 1);
+    /* Rates are kept by every process, standby or not. */
+    intfd_rates_run(idl);
 
-        VLOG_ERR_RL(&rl, "Another intfd process is running, "
-                    "disabling this process until it goes away");
+    if (!ovsdb_idl_has_lock(idl)) {
+        if (ovsdb_idl_is_lock_contended(idl)) {
+            static struct vlog_rate_limit rl = VLOG_RATE_LIMIT_INIT(1, 1);
+
+            if (standby_enabled) {
+                VLOG_INFO_RL(&rl, "Another intfd process is running, "
+                             "this process is standing by");
+            } else {
+                VLOG_ERR_RL(&rl, "Another intfd process is running, "
+                            "disabling this process until it goes away");
+            }
+        }
+
+        /* Keep the local state current without writing to the dB. */
+        if (standby_enabled && intfd_system_is_configured()) {
+            standby = true;
+            intfd_reconfigure();
+        }
 
-        return;
-    } else if (!ovsdb_idl_has_lock(idl)) {
         return;
     }
 
@@ -2159,15 +1543,34 @@ intfd_run(void)
         return;
     }
 
+    if (standby) {
+        standby = false;
+        standby_takeover = true;
+    }
+
     /* Update the local configuration and push any changes to the dB. */
     txn = ovsdb_idl_txn_create(idl);
-    if (intfd_reconfigure()) {
+    rc = intfd_reconfigure();
+    if (standby_takeover) {
+        /* Interfaces updated by intfd_reconfigure() above have already
+         * dropped their stashed values. */
+        rc |= standby_reconcile();
+        rc |= intfd_arbiter_run();
+    }
+    if (rc) {
         VLOG_DBG("Commiting changes\n");
         /* Some OVSDB write needs to happen. */
-        ovsdb_idl_txn_commit_block(txn);
+        status = ovsdb_idl_txn_commit_block(txn);
     }
     ovsdb_idl_txn_destroy(txn);
 
+    /* Keep the stash for another attempt if the commit failed. */
+    if (standby_takeover
+        && (status == TXN_SUCCESS || status == TXN_UNCHANGED)) {
+        standby_clear_outputs();
+        standby_takeover = false;
+    }
+
     return;
 } /* intfd_run */
 
@@ -2175,6 +1578,7 @@ void
 intfd_wait(void)
 {
     ovsdb_idl_wait(idl);
+    intfd_rates_wait();
 } /* intfd_wait */
 
 /** @} end of group intfd */
@@ -0,0 +1,307 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup ops-intfd
+ *
+ * @file
+ * Source for the interface rate engine of ops-intfd.
+ *
+ ***************************************************************************/
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dynamic-string.h>
+#include <ovsdb-idl.h>
+#include <poll-loop.h>
+#include <shash.h>
+#include <smap.h>
+#include <timeval.h>
+#include <util.h>
+#include <openvswitch/vlog.h>
+#include <vswitch-idl.h>
+
+#include "intf_sort.h"
+#include "intf_stats.h"
+#include "intfd_rates.h"
+#include "intfd_rates_ring.h"
+
+VLOG_DEFINE_THIS_MODULE(intfd_rates);
+
+/** @ingroup ops-intfd
+ * @{ */
+
+/* How often, at most, the statistics are looked at after the daemon wakes
+ * up.  The statistics column changes every few seconds, so a change is
+ * timestamped within this of its arrival. */
+#define INTFD_RATES_OBSERVE_MSEC    1000
+
+struct intfd_rate_entry {
+    char *name;
+    unsigned int load_interval;             /* In seconds. */
+    unsigned int generation;                /* Last intfd_rates_run() that
+                                             * saw the interface. */
+    long long int next_time;                /* time_msec() of the next
+                                             * sample. */
+
+    /* The counters of the statistics column, and the time_msec() of the
+     * pass that saw them change, 0 before the first one. */
+    uint64_t seen[INTFD_RATE_N_COUNTERS];
+    long long int seen_time;
+
+    struct intfd_rate_ring ring;
+};
+
+/* Rate state of every interface, by name. */
+static struct shash rate_entries = SHASH_INITIALIZER(&rate_entries);
+
+static unsigned int rates_generation;
+
+/* When intfd_rates_run() has to look at the interfaces again. */
+static long long int rates_next_run;
+
+/* When it may look at them again after a wake up, and whether a wake up
+ * came earlier than that. */
+static long long int rates_next_observe;
+static bool rates_observe_pending;
+
+static unsigned int
+rates_load_interval(const struct ovsrec_interface *ifrow)
+{
+    const char *value = smap_get(&ifrow->user_config,
+                                 INTFD_USER_CONFIG_MAP_LOAD_INTERVAL);
+    long interval;
+    char *end;
+
+    if (value) {
+        interval = strtol(value, &end, 10);
+        if (*end == '\0' && interval >= INTFD_LOAD_INTERVAL_MIN
+            && interval <= INTFD_LOAD_INTERVAL_MAX) {
+            return interval;
+        }
+    }
+    return INTFD_LOAD_INTERVAL_DEFAULT;
+} /* rates_load_interval */
+
+/* Notes when the counters of 'ifrow' change.  The statistics column is
+ * written every few seconds: the samples are taken between these changes,
+ * not at the engine's own times, which fall anywhere in between. */
+static void
+rates_observe(struct intfd_rate_entry *entry,
+              const struct ovsrec_interface *ifrow, long long int now)
+{
+    uint64_t counters[INTFD_RATE_N_COUNTERS];
+    struct intf_stats stats;
+
+    intf_stats_from_interface(ifrow, &stats);
+    counters[INTFD_RATE_RX_BYTES] = stats.rx_bytes;
+    counters[INTFD_RATE_RX_PACKETS] = stats.rx_packets;
+    counters[INTFD_RATE_TX_BYTES] = stats.tx_bytes;
+    counters[INTFD_RATE_TX_PACKETS] = stats.tx_packets;
+
+    if (!entry->seen_time || memcmp(counters, entry->seen, sizeof counters)) {
+        memcpy(entry->seen, counters, sizeof entry->seen);
+        entry->seen_time = now;
+    }
+} /* rates_observe */
+
+static void
+rates_sample(struct intfd_rate_entry *entry, long long int now)
+{
+    struct intfd_rate_ring *ring = &entry->ring;
+    long long int time;
+
+    entry->next_time = now + entry->load_interval * 1000LL;
+
+    if (!ring->last_time || entry->seen_time > ring->last_time) {
+        time = entry->seen_time;
+    } else if (now - ring->last_time >= 2 * entry->load_interval * 1000LL) {
+        /* Nothing changed for two load intervals: the interface is idle,
+         * not just between two statistics updates. */
+        time = now;
+    } else {
+        return;
+    }
+
+    if (!intfd_rate_ring_add(ring, entry->seen, time)) {
+        VLOG_DBG("%s: counters went backwards, resetting its rates",
+                 entry->name);
+    }
+} /* rates_sample */
+
+static void
+rates_entry_destroy(struct shash_node *node)
+{
+    struct intfd_rate_entry *entry = node->data;
+
+    shash_delete(&rate_entries, node);
+    free(entry->name);
+    free(entry);
+} /* rates_entry_destroy */
+
+/* Notes the statistics changes and samples the interfaces whose load
+ * interval has elapsed.  The statistics column does not change the IDL
+ * seqno, but its updates still wake the daemon up: each wake up is looked
+ * at within INTFD_RATES_OBSERVE_MSEC. */
+void
+intfd_rates_run(const struct ovsdb_idl *idl)
+{
+    const struct ovsrec_interface *ifrow;
+    struct intfd_rate_entry *entry;
+    struct shash_node *node, *next;
+    long long int now = time_msec();
+    unsigned int interval;
+
+    if (now < rates_next_run && now < rates_next_observe) {
+        rates_observe_pending = true;
+        return;
+    }
+
+    /* Look for new interfaces at least this often. */
+    rates_next_run = now + INTFD_LOAD_INTERVAL_MIN * 1000LL;
+    rates_next_observe = now + INTFD_RATES_OBSERVE_MSEC;
+    rates_observe_pending = false;
+    rates_generation++;
+
+    OVSREC_INTERFACE_FOR_EACH (ifrow, idl) {
+        entry = shash_find_data(&rate_entries, ifrow->name);
+        if (!entry) {
+            entry = xzalloc(sizeof *entry);
+            entry->name = xstrdup(ifrow->name);
+            entry->next_time = now;
+            shash_add(&rate_entries, entry->name, entry);
+        }
+        entry->generation = rates_generation;
+
+        interval = rates_load_interval(ifrow);
+        if (interval != entry->load_interval) {
+            entry->load_interval = interval;
+            if (entry->ring.last_time) {
+                entry->next_time = entry->ring.last_time + interval * 1000LL;
+            }
+        }
+
+        rates_observe(entry, ifrow, now);
+        if (now >= entry->next_time) {
+            rates_sample(entry, now);
+        }
+        rates_next_run = MIN(rates_next_run, entry->next_time);
+    }
+
+    SHASH_FOR_EACH_SAFE (node, next, &rate_entries) {
+        entry = node->data;
+        if (entry->generation != rates_generation) {
+            rates_entry_destroy(node);
+        }
+    }
+} /* intfd_rates_run */
+
+void
+intfd_rates_wait(void)
+{
+    poll_timer_wait_until(rates_observe_pending
+                          ? MIN(rates_next_run, rates_next_observe)
+                          : rates_next_run);
+} /* intfd_rates_wait */
+
+void
+intfd_rates_exit(void)
+{
+    struct shash_node *node, *next;
+
+    SHASH_FOR_EACH_SAFE (node, next, &rate_entries) {
+        rates_entry_destroy(node);
+    }
+} /* intfd_rates_exit */
+
+static void
+rates_dump_entry(struct ds *ds, const struct intfd_rate_entry *entry)
+{
+    const struct intfd_rate_ring *ring = &entry->ring;
+    unsigned int i;
+
+    ds_put_format(ds, "Interface %s\n", entry->name);
+    ds_put_format(ds, " Load interval %u seconds, %u of %d samples\n",
+                  entry->load_interval, ring->n_samples,
+                  INTFD_RATES_RING_SIZE);
+    ds_put_format(ds, " Input rate  %.0f bits/sec, %.0f packets/sec\n",
+                  ring->rate[INTFD_RATE_RX_BYTES] * 8,
+                  ring->rate[INTFD_RATE_RX_PACKETS]);
+    ds_put_format(ds, " Output rate %.0f bits/sec, %.0f packets/sec\n",
+                  ring->rate[INTFD_RATE_TX_BYTES] * 8,
+                  ring->rate[INTFD_RATE_TX_PACKETS]);
+    if (!ring->n_samples) {
+        return;
+    }
+
+    ds_put_format(ds, " %8s %14s %12s %14s %12s\n", "Seconds", "RX bytes",
+                  "RX packets", "TX bytes", "TX packets");
+    for (i = 0; i < ring->n_samples; i++) {
+        const struct intfd_rate_sample *sample;
+
+        sample = intfd_rate_ring_sample(ring, i);
+        ds_put_format(ds, " %8.1f %14"PRIu64" %12"PRIu64" %14"PRIu64
+                      " %12"PRIu64"\n", sample->msec / 1000.0,
+                      sample->delta[INTFD_RATE_RX_BYTES],
+                      sample->delta[INTFD_RATE_RX_PACKETS],
+                      sample->delta[INTFD_RATE_TX_BYTES],
+                      sample->delta[INTFD_RATE_TX_PACKETS]);
+    }
+} /* rates_dump_entry */
+
+bool
+intfd_rates_dump(struct ds *ds, const char *name)
+{
+    const struct intfd_rate_entry *entry;
+    struct intf_sort_key *keys;
+    struct shash_node *node;
+    size_t i, n;
+
+    if (name) {
+        entry = shash_find_data(&rate_entries, name);
+        if (!entry) {
+            return false;
+        }
+        rates_dump_entry(ds, entry);
+        return true;
+    }
+
+    n = 0;
+    keys = xmalloc(shash_count(&rate_entries) * sizeof *keys);
+    SHASH_FOR_EACH (node, &rate_entries) {
+        intf_sort_key_init(&keys[n++], node->name, node->data);
+    }
+    intf_sort_keys(keys, n);
+
+    ds_put_format(ds, "%-16s %8s %14s %12s %14s %12s\n", "Interface",
+                  "Interval", "RX bits/sec", "RX pkts/sec", "TX bits/sec",
+                  "TX pkts/sec");
+    for (i = 0; i < n; i++) {
+        entry = keys[i].data;
+        ds_put_format(ds, "%-16s %7us %14.0f %12.0f %14.0f %12.0f\n",
+                      entry->name, entry->load_interval,
+                      entry->ring.rate[INTFD_RATE_RX_BYTES] * 8,
+                      entry->ring.rate[INTFD_RATE_RX_PACKETS],
+                      entry->ring.rate[INTFD_RATE_TX_BYTES] * 8,
+                      entry->ring.rate[INTFD_RATE_TX_PACKETS]);
+    }
+    free(keys);
+
+    return true;
+} /* intfd_rates_dump */
+
+/** @} end of group ops-intfd */
@@ -0,0 +1,89 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup ops-intfd
+ *
+ * @file
+ * Source for the sample ring and weighted rates of the interface rate
+ * engine.
+ *
+ ***************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "intfd_rates_ring.h"
+
+/** @ingroup ops-intfd
+ * @{ */
+
+bool
+intfd_rate_ring_add(struct intfd_rate_ring *ring,
+                    const uint64_t counters[INTFD_RATE_N_COUNTERS],
+                    long long int time)
+{
+    struct intfd_rate_sample *sample;
+    bool ok = true;
+    int i;
+
+    for (i = 0; i < INTFD_RATE_N_COUNTERS; i++) {
+        if (counters[i] < ring->last[i]) {
+            /* The counters were cleared, e.g. by a restart of the driver:
+             * start over from this sample. */
+            ring->n_samples = 0;
+            ring->last_time = 0;
+            ok = false;
+            break;
+        }
+    }
+
+    if (ring->last_time && time > ring->last_time) {
+        sample = &ring->ring[ring->head];
+        sample->msec = time - ring->last_time;
+        for (i = 0; i < INTFD_RATE_N_COUNTERS; i++) {
+            double rate;
+
+            sample->delta[i] = counters[i] - ring->last[i];
+            rate = sample->delta[i] * 1000.0 / sample->msec;
+            if (ring->n_samples) {
+                ring->rate[i] += INTFD_RATES_ALPHA * (rate - ring->rate[i]);
+            } else {
+                ring->rate[i] = rate;
+            }
+        }
+        ring->head = (ring->head + 1) % INTFD_RATES_RING_SIZE;
+        if (ring->n_samples < INTFD_RATES_RING_SIZE) {
+            ring->n_samples++;
+        }
+    }
+
+    memcpy(ring->last, counters, sizeof ring->last);
+    ring->last_time = time;
+    return ok;
+} /* intfd_rate_ring_add */
+
+const struct intfd_rate_sample *
+intfd_rate_ring_sample(const struct intfd_rate_ring *ring, unsigned int i)
+{
+    unsigned int slot;
+
+    slot = (ring->head + INTFD_RATES_RING_SIZE - ring->n_samples + i)
+           % INTFD_RATES_RING_SIZE;
+    return &ring->ring[slot];
+} /* intfd_rate_ring_sample */
+
+/** @} end of group ops-intfd */
@@ -0,0 +1,197 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup ops-intfd
+ *
+ * @file
+ * Unit test for the sample ring and weighted rates of the interface rate
+ * engine: the first sample, the INTFD_RATES_ALPHA weighting, the
+ * wraparound of the ring and a reset of the counters.
+ *
+ * Run it with "make test" or ctest.
+ *
+ ***************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "intfd_rates_ring.h"
+
+/** @ingroup ops-intfd
+ * @{ */
+
+static int failures;
+
+#define CHECK(COND)                                                     \
+    do {                                                                \
+        if (!(COND)) {                                                  \
+            fprintf(stderr, "%s:%d: %s: check failed: %s\n",            \
+                    __FILE__, __LINE__, __func__, #COND);               \
+            failures++;                                                 \
+        }                                                               \
+    } while (0)
+
+static bool
+near(double a, double b)
+{
+    double d = a > b ? a - b : b - a;
+
+    return d <= 1e-9 * (a > b ? a : b) + 1e-9;
+} /* near */
+
+/* Adds a sample whose counters are all 'value'. */
+static bool
+add(struct intfd_rate_ring *ring, uint64_t value, long long int time)
+{
+    uint64_t counters[INTFD_RATE_N_COUNTERS];
+    int i;
+
+    for (i = 0; i < INTFD_RATE_N_COUNTERS; i++) {
+        counters[i] = value;
+    }
+    return intfd_rate_ring_add(ring, counters, time);
+} /* add */
+
+static void
+test_first_sample(void)
+{
+    struct intfd_rate_ring ring;
+
+    memset(&ring, 0, sizeof ring);
+
+    /* The first sample is only the base of the next one. */
+    CHECK(add(&ring, 1000, 10000));
+    CHECK(ring.n_samples == 0);
+    CHECK(ring.rate[INTFD_RATE_RX_BYTES] == 0);
+
+    /* 5000 in 5 seconds. */
+    CHECK(add(&ring, 6000, 15000));
+    CHECK(ring.n_samples == 1);
+    CHECK(intfd_rate_ring_sample(&ring, 0)->msec == 5000);
+    CHECK(intfd_rate_ring_sample(&ring, 0)->delta[INTFD_RATE_TX_PACKETS]
+          == 5000);
+    CHECK(near(ring.rate[INTFD_RATE_RX_BYTES], 1000.0));
+
+    /* No time has passed: the counters move, no sample is taken. */
+    CHECK(add(&ring, 7000, 15000));
+    CHECK(ring.n_samples == 1);
+} /* test_first_sample */
+
+static void
+test_weighting(void)
+{
+    struct intfd_rate_ring ring;
+    double expected;
+    int i;
+
+    memset(&ring, 0, sizeof ring);
+    add(&ring, 0, 1000);
+    add(&ring, 1000, 2000);
+    CHECK(near(ring.rate[INTFD_RATE_RX_PACKETS], 1000.0));
+
+    /* 3000 per second: the rate moves by INTFD_RATES_ALPHA of the
+     * difference. */
+    add(&ring, 4000, 3000);
+    expected = 1000.0 + INTFD_RATES_ALPHA * (3000.0 - 1000.0);
+    CHECK(near(ring.rate[INTFD_RATE_RX_PACKETS], expected));
+
+    /* The sample period is taken into account: 2000 in 2 seconds. */
+    add(&ring, 6000, 5000);
+    expected += INTFD_RATES_ALPHA * (1000.0 - expected);
+    CHECK(near(ring.rate[INTFD_RATE_RX_PACKETS], expected));
+
+    /* A steady rate is approached and then kept. */
+    for (i = 0; i < 200; i++) {
+        add(&ring, 6000 + (i + 1) * 500ULL, 5000 + (i + 1) * 1000LL);
+    }
+    CHECK(near(ring.rate[INTFD_RATE_TX_BYTES], 500.0));
+} /* test_weighting */
+
+static void
+test_wraparound(void)
+{
+    struct intfd_rate_ring ring;
+    unsigned int i, n = INTFD_RATES_RING_SIZE + 3;
+
+    memset(&ring, 0, sizeof ring);
+    add(&ring, 0, 1000);
+
+    /* Sample i has a delta of i + 1. */
+    for (i = 0; i < n; i++) {
+        uint64_t value = (uint64_t) (i + 1) * (i + 2) / 2;
+
+        add(&ring, value, 1000 + (i + 1) * 1000LL);
+    }
+    CHECK(ring.n_samples == INTFD_RATES_RING_SIZE);
+    CHECK(ring.head == n % INTFD_RATES_RING_SIZE);
+
+    /* The ring holds the last INTFD_RATES_RING_SIZE samples, oldest
+     * first. */
+    for (i = 0; i < INTFD_RATES_RING_SIZE; i++) {
+        const struct intfd_rate_sample *sample;
+
+        sample = intfd_rate_ring_sample(&ring, i);
+        CHECK(sample->delta[INTFD_RATE_RX_BYTES]
+              == n - INTFD_RATES_RING_SIZE + i + 1);
+        CHECK(sample->msec == 1000);
+    }
+} /* test_wraparound */
+
+static void
+test_counter_reset(void)
+{
+    struct intfd_rate_ring ring;
+
+    memset(&ring, 0, sizeof ring);
+    add(&ring, 100000, 1000);
+    add(&ring, 200000, 2000);
+    add(&ring, 300000, 3000);
+    CHECK(ring.n_samples == 2);
+
+    /* The counters went backwards: no sample, the rates start over from
+     * this one. */
+    CHECK(!add(&ring, 50, 4000));
+    CHECK(ring.n_samples == 0);
+    CHECK(ring.last_time == 4000);
+
+    /* The first sample after the reset is taken as is, not weighted with
+     * the rate from before it. */
+    CHECK(add(&ring, 1050, 5000));
+    CHECK(ring.n_samples == 1);
+    CHECK(near(ring.rate[INTFD_RATE_TX_PACKETS], 1000.0));
+    CHECK(intfd_rate_ring_sample(&ring, 0)->delta[INTFD_RATE_RX_BYTES]
+          == 1000);
+} /* test_counter_reset */
+
+int
+main(void)
+{
+    test_first_sample();
+    test_weighting();
+    test_wraparound();
+    test_counter_reset();
+
+    if (failures) {
+        fprintf(stderr, "intfd_rates_test: %d checks failed\n", failures);
+        return 1;
+    }
+    printf("intfd_rates_test: all checks passed\n");
+    return 0;
+} /* main */
+
+/** @} end of group ops-intfd */
@@ -0,0 +1,418 @@
+/*
+ * (c) Copyright 2015 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup intfd
+ *
+ * @file
+ * Source for recording the OVSDB update stream consumed by intfd.
+ *
+ ***************************************************************************/
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <dynamic-string.h>
+#include <ovsdb-idl.h>
+#include <smap.h>
+#include <sset.h>
+#include <svec.h>
+#include <util.h>
+#include <openvswitch/vlog.h>
+#include <vswitch-idl.h>
+#include <openswitch-idl.h>
+
+#include "intfd_record.h"
+
+VLOG_DEFINE_THIS_MODULE(intfd_record);
+
+/** @ingroup intfd
+ * @{ */
+
+#define ROW_CHANGED(row, seqno) (OVSREC_IDL_IS_ROW_INSERTED((row), (seqno)) || \
+                                 OVSREC_IDL_IS_ROW_MODIFIED((row), (seqno)))
+
+static FILE *record_file = NULL;
+
+/* Set until the first batch, which dumps every row, has been written. */
+static bool record_full = false;
+
+static long long int record_start_usec;
+
+/* Names seen in the previous batch, used to detect deleted rows. */
+static struct sset known_interfaces = SSET_INITIALIZER(&known_interfaces);
+static struct sset known_ports = SSET_INITIALIZER(&known_ports);
+static struct sset known_subsystems = SSET_INITIALIZER(&known_subsystems);
+
+static struct ds record_line = DS_EMPTY_INITIALIZER;
+
+static long long int
+record_now_usec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long int) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+} /* record_now_usec */
+
+static void
+put_escaped(struct ds *ds, const char *str)
+{
+    const char *p;
+
+    if (!*str) {
+        ds_put_char(ds, '~');
+        return;
+    }
+
+    for (p = str; *p; p++) {
+        unsigned char c = *p;
+
+        if (!isgraph(c) || c == '%' || c == ',' || c == '='
+            || (p == str && (c == '-' || c == '~'))) {
+            ds_put_format(ds, "%%%02X", c);
+        } else {
+            ds_put_char(ds, c);
+        }
+    }
+} /* put_escaped */
+
+static char *
+get_escaped(const char *str, size_t len)
+{
+    struct ds ds = DS_EMPTY_INITIALIZER;
+    size_t i;
+
+    if (len == 1 && str[0] == '~') {
+        return xstrdup("");
+    }
+
+    for (i = 0; i < len; i++) {
+        bool ok = false;
+
+        if (str[i] == '%' && i + 2 < len) {
+            unsigned int c = hexits_value(&str[i + 1], 2, &ok);
+            if (ok) {
+                ds_put_char(&ds, c);
+                i += 2;
+                continue;
+            }
+        }
+        ds_put_char(&ds, str[i]);
+    }
+
+    return ds_steal_cstr(&ds);
+} /* get_escaped */
+
+void
+intfd_record_put_str(struct ds *ds, const char *str)
+{
+    ds_put_char(ds, ' ');
+    if (!str) {
+        ds_put_char(ds, '-');
+    } else {
+        put_escaped(ds, str);
+    }
+} /* intfd_record_put_str */
+
+void
+intfd_record_put_smap(struct ds *ds, const struct smap *smap)
+{
+    const struct smap_node **nodes;
+    size_t i, n;
+
+    ds_put_char(ds, ' ');
+    n = smap_count(smap);
+    if (!n) {
+        ds_put_char(ds, '-');
+        return;
+    }
+
+    /* Sorted so that identical maps always record identically. */
+    nodes = smap_sort(smap);
+    for (i = 0; i < n; i++) {
+        if (i) {
+            ds_put_char(ds, ',');
+        }
+        put_escaped(ds, nodes[i]->key);
+        ds_put_char(ds, '=');
+        put_escaped(ds, nodes[i]->value);
+    }
+    free(nodes);
+} /* intfd_record_put_smap */
+
+char *
+intfd_record_get_str(const char *field)
+{
+    if (!field || !strcmp(field, "-")) {
+        return NULL;
+    }
+    return get_escaped(field, strlen(field));
+} /* intfd_record_get_str */
+
+void
+intfd_record_get_list(const char *field, struct svec *svec)
+{
+    const char *p;
+
+    if (!field || !strcmp(field, "-")) {
+        return;
+    }
+
+    for (p = field; ; ) {
+        size_t len = strcspn(p, ",");
+
+        svec_add_nocopy(svec, get_escaped(p, len));
+        if (!p[len]) {
+            break;
+        }
+        p += len + 1;
+    }
+} /* intfd_record_get_list */
+
+void
+intfd_record_get_smap(const char *field, struct smap *smap)
+{
+    if (!field || !strcmp(field, "-")) {
+        return;
+    }
+
+    /* Split on the raw separators before unescaping. */
+    while (*field) {
+        size_t len = strcspn(field, ",");
+        size_t klen = strcspn(field, "=");
+
+        if (klen < len) {
+            smap_add_nocopy(smap, get_escaped(field, klen),
+                            get_escaped(field + klen + 1, len - klen - 1));
+        }
+        field += len;
+        if (*field) {
+            field++;
+        }
+    }
+} /* intfd_record_get_smap */
+
+bool
+intfd_record_start(const char *path)
+{
+    FILE *file;
+
+    intfd_record_stop();
+
+    file = fopen(path, "w");
+    if (!file) {
+        VLOG_ERR("Could not open record file %s (%s)",
+                 path, ovs_strerror(errno));
+        return false;
+    }
+
+    fprintf(file, "# ops-intfd record %d\n", INTFD_RECORD_VERSION);
+    record_file = file;
+    record_full = true;
+    record_start_usec = record_now_usec();
+    VLOG_INFO("Recording OVSDB updates to %s", path);
+
+    return true;
+} /* intfd_record_start */
+
+void
+intfd_record_stop(void)
+{
+    if (!record_file) {
+        return;
+    }
+
+    fclose(record_file);
+    record_file = NULL;
+    sset_clear(&known_interfaces);
+    sset_clear(&known_ports);
+    sset_clear(&known_subsystems);
+    VLOG_INFO("Stopped recording OVSDB updates");
+} /* intfd_record_stop */
+
+bool
+intfd_record_is_active(void)
+{
+    return record_file != NULL;
+} /* intfd_record_is_active */
+
+/* Write a deletion line for every name in 'known' that is not in
+ * 'current', then make 'current' the new set of known names. */
+static void
+record_deleted(char tag, struct sset *known, struct sset *current)
+{
+    const char *name;
+
+    SSET_FOR_EACH (name, known) {
+        if (!sset_contains(current, name)) {
+            ds_put_char(&record_line, tag);
+            intfd_record_put_str(&record_line, name);
+            ds_put_char(&record_line, '\n');
+        }
+    }
+
+    sset_swap(known, current);
+    sset_clear(current);
+} /* record_deleted */
+
+/* Record every Interface, Port, Subsystem and System row that changed
+ * since 'idl_seqno', and the rows deleted since the previous batch. */
+void
+intfd_record_updates(struct ovsdb_idl *idl, unsigned int idl_seqno)
+{
+    const struct ovsrec_interface *ifrow = NULL;
+    const struct ovsrec_port *port_row = NULL;
+    const struct ovsrec_subsystem *subrow = NULL;
+    const struct ovsrec_system *sysrow = NULL;
+    struct sset names = SSET_INITIALIZER(&names);
+    size_t i;
+
+    if (!record_file) {
+        return;
+    }
+
+    ds_clear(&record_line);
+    ds_put_format(&record_line, "B %u %lld\n", ovsdb_idl_get_seqno(idl),
+                  record_now_usec() - record_start_usec);
+
+    OVSREC_INTERFACE_FOR_EACH(ifrow, idl) {
+        sset_add(&names, ifrow->name);
+        if (!record_full && !ROW_CHANGED(ifrow, idl_seqno)) {
+            continue;
+        }
+
+        ds_put_char(&record_line, 'I');
+        intfd_record_put_str(&record_line, ifrow->name);
+        intfd_record_put_str(&record_line, ifrow->type);
+        intfd_record_put_str(&record_line, ifrow->split_parent ?
+                             ifrow->split_parent->name : NULL);
+        ds_put_char(&record_line, ' ');
+        if (!ifrow->n_split_children) {
+            ds_put_char(&record_line, '-');
+        }
+        for (i = 0; i < ifrow->n_split_children; i++) {
+            if (i) {
+                ds_put_char(&record_line, ',');
+            }
+            put_escaped(&record_line, ifrow->split_children[i]->name);
+        }
+        intfd_record_put_smap(&record_line, &ifrow->user_config);
+        intfd_record_put_smap(&record_line, &ifrow->hw_intf_info);
+        intfd_record_put_smap(&record_line, &ifrow->pm_info);
+        ds_put_char(&record_line, '\n');
+    }
+    record_deleted('i', &known_interfaces, &names);
+
+    OVSREC_PORT_FOR_EACH(port_row, idl) {
+        sset_add(&names, port_row->name);
+        if (!record_full && !ROW_CHANGED(port_row, idl_seqno)) {
+            continue;
+        }
+
+        ds_put_char(&record_line, 'P');
+        intfd_record_put_str(&record_line, port_row->name);
+        intfd_record_put_str(&record_line, port_row->admin);
+        ds_put_char(&record_line, ' ');
+        if (!port_row->n_interfaces) {
+            ds_put_char(&record_line, '-');
+        }
+        for (i = 0; i < port_row->n_interfaces; i++) {
+            if (i) {
+                ds_put_char(&record_line, ',');
+            }
+            put_escaped(&record_line, port_row->interfaces[i]->name);
+        }
+        ds_put_char(&record_line, '\n');
+    }
+    record_deleted('p', &known_ports, &names);
+
+    OVSREC_SUBSYSTEM_FOR_EACH(subrow, idl) {
+        sset_add(&names, subrow->name);
+        if (!record_full && !ROW_CHANGED(subrow, idl_seqno)) {
+            continue;
+        }
+
+        ds_put_char(&record_line, 'S');
+        intfd_record_put_str(&record_line, subrow->name);
+        intfd_record_put_str(&record_line,
+                             smap_get(&subrow->other_info,
+                                      SUBSYSTEM_OTHER_INFO_MAX_TRANSMISSION_UNIT));
+        ds_put_char(&record_line, ' ');
+        if (!subrow->n_interfaces) {
+            ds_put_char(&record_line, '-');
+        }
+        for (i = 0; i < subrow->n_interfaces; i++) {
+            if (i) {
+                ds_put_char(&record_line, ',');
+            }
+            put_escaped(&record_line, subrow->interfaces[i]->name);
+        }
+        ds_put_char(&record_line, '\n');
+    }
+    record_deleted('s', &known_subsystems, &names);
+
+    sysrow = ovsrec_system_first(idl);
+    if (sysrow && (record_full || ROW_CHANGED(sysrow, idl_seqno))) {
+        ds_put_format(&record_line, "Y %"PRId64"\n", sysrow->cur_cfg);
+    }
+
+    sset_destroy(&names);
+    record_full = false;
+} /* intfd_record_updates */
+
+/* Record the "error" and "hw_intf_config" columns written for interface
+ * 'name' in the current batch. */
+void
+intfd_record_output(const char *name, const char *error,
+                    const struct smap *hw_intf_config)
+{
+    if (!record_file) {
+        return;
+    }
+
+    ds_put_char(&record_line, 'O');
+    intfd_record_put_str(&record_line, name);
+    if (error && !strcmp(error, INTFD_RECORD_ERROR_UNCHANGED)) {
+        ds_put_cstr(&record_line, " " INTFD_RECORD_ERROR_UNCHANGED);
+    } else {
+        intfd_record_put_str(&record_line, error);
+    }
+    intfd_record_put_smap(&record_line, hw_intf_config);
+    ds_put_char(&record_line, '\n');
+} /* intfd_record_output */
+
+/* Close the current batch and write it out. */
+void
+intfd_record_commit(void)
+{
+    if (!record_file || !record_line.length) {
+        return;
+    }
+
+    ds_put_cstr(&record_line, "E\n");
+    if (fputs(ds_cstr(&record_line), record_file) == EOF
+        || fflush(record_file)) {
+        VLOG_ERR("Write to record file failed (%s)", ovs_strerror(errno));
+        intfd_record_stop();
+    }
+    ds_clear(&record_line);
+} /* intfd_record_commit */
+
+/** @} end of group intfd */
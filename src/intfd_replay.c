@@ -0,0 +1,905 @@
+/*
+ * (c) Copyright 2015 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+/************************************************************************//**
+ * @ingroup ops-intfd
+ *
+ * @file
+ * Source for the ops-intfd replay tool (ops-intfd-replay).
+ *
+ * Purpose: Drive the intfd decision logic from a file written by
+ *          "ops-intfd --record" without an ovsdb-server.
+ *
+ *          For every recorded batch of OVSDB updates the tool applies the
+ *          row changes to an in-memory copy of the tables, re-evaluates
+ *          the affected interfaces and compares the resulting "error" and
+ *          "hw_intf_config" columns against what the daemon wrote.  It
+ *          reports throughput, per-update latency and any output that
+ *          differs from the recording.
+ *
+ ***************************************************************************/
+
+#include <errno.h>
+#include <getopt.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <config.h>
+#include <command-line.h>
+#include <dynamic-string.h>
+#include <shash.h>
+#include <smap.h>
+#include <sset.h>
+#include <svec.h>
+#include <util.h>
+#include <openvswitch/vlog.h>
+#include <vswitch-idl.h>
+#include <openswitch-idl.h>
+
+#include "intfd.h"
+#include "intfd_core.h"
+#include "intfd_record.h"
+#include "intfd_utils.h"
+
+VLOG_DEFINE_THIS_MODULE(intfd_replay);
+
+/** @ingroup ops-intfd
+ * @{ */
+
+#define REPLAY_DEFAULT_MAX_DIFFS    20
+#define REPLAY_MAX_FIELDS           8
+
+/* Subsystem owning every interface no Subsystem row lists. */
+#define REPLAY_BASE_SUBSYSTEM       "base"
+
+/* An Interface row and the intfd state derived from it. */
+struct replay_intf {
+    char            *name;
+    char            *split_parent;
+    struct svec     split_children;
+    struct smap     user_config;
+    struct smap     hw_intf_info;
+    struct smap     pm_info;
+
+    struct iface    intf;
+
+    /* Last output produced by the replay. */
+    bool            evaluated;
+    char            *error;
+    struct smap     hw_intf_config;
+};
+
+/* A Port row. */
+struct replay_port {
+    char            *name;
+    char            *admin;
+    struct svec     interfaces;
+};
+
+/* A Subsystem row.  Its max_transmission_unit limits the interfaces it
+ * owns, as in intfd_ovsdb_if.c. */
+struct replay_subsystem {
+    char            *name;
+    int32_t         mtu;
+    struct svec     interfaces;
+};
+
+/* Columns written by the daemon in the current batch. */
+struct replay_output {
+    char            *error;
+    bool            error_written;
+    struct smap     hw_intf_config;
+};
+
+static struct shash interfaces = SHASH_INITIALIZER(&interfaces);
+static struct shash ports = SHASH_INITIALIZER(&ports);
+
+/* Interface name to the Port it belongs to. */
+static struct shash intf_ports = SHASH_INITIALIZER(&intf_ports);
+
+static struct shash subsystems = SHASH_INITIALIZER(&subsystems);
+
+/* Interface name to the Subsystem listing it.  Interfaces missing here
+ * belong to the "base" subsystem. */
+static struct shash intf_subsystems = SHASH_INITIALIZER(&intf_subsystems);
+
+/* Per batch state. */
+static struct sset dirty = SSET_INITIALIZER(&dirty);
+static struct shash outputs = SHASH_INITIALIZER(&outputs);
+
+static struct {
+    size_t          n_batches;
+    size_t          n_deltas;
+    size_t          n_evaluations;
+    size_t          n_writes;
+    size_t          n_matched;
+    size_t          n_mismatched;
+    size_t          n_unrecorded;
+    long long int   total_usec;
+    long long int   *latencies;
+    size_t          n_latencies;
+    size_t          allocated_latencies;
+} stats;
+
+static size_t max_diffs = REPLAY_DEFAULT_MAX_DIFFS;
+static size_t n_diffs_shown = 0;
+
+static void
+usage(void)
+{
+    printf("%s: replay an ops-intfd record file\n"
+           "usage: %s [OPTIONS] FILE\n"
+           "where FILE was written by \"ops-intfd --record\" or\n"
+           "\"ovs-appctl -t ops-intfd ops-intfd/record\".\n",
+           program_name, program_name);
+    vlog_usage();
+    printf("\nOther options:\n"
+           "  --max-diffs=N           print at most N output diffs "
+           "(default: %d)\n"
+           "  -h, --help              display this help message\n",
+           REPLAY_DEFAULT_MAX_DIFFS);
+    exit(EXIT_SUCCESS);
+} /* usage */
+
+static long long int
+replay_now_usec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long int) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+} /* replay_now_usec */
+
+static struct replay_intf *
+replay_intf_create(const char *name)
+{
+    struct replay_intf *ri = xzalloc(sizeof *ri);
+
+    ri->name = xstrdup(name);
+    svec_init(&ri->split_children);
+    smap_init(&ri->user_config);
+    smap_init(&ri->hw_intf_info);
+    smap_init(&ri->pm_info);
+    smap_init(&ri->hw_intf_config);
+    ri->intf.name = ri->name;
+    shash_add(&interfaces, name, ri);
+
+    return ri;
+} /* replay_intf_create */
+
+static void
+replay_intf_destroy(struct replay_intf *ri)
+{
+    free(ri->name);
+    free(ri->split_parent);
+    svec_destroy(&ri->split_children);
+    smap_destroy(&ri->user_config);
+    smap_destroy(&ri->hw_intf_info);
+    smap_destroy(&ri->pm_info);
+    smap_destroy(&ri->hw_intf_config);
+    free(ri->error);
+    free(ri->intf.split_children);
+    free(ri);
+} /* replay_intf_destroy */
+
+static void
+mark_related_dirty(const struct replay_intf *ri)
+{
+    size_t i;
+
+    sset_add(&dirty, ri->name);
+    if (ri->split_parent) {
+        sset_add(&dirty, ri->split_parent);
+    }
+    for (i = 0; i < ri->split_children.n; i++) {
+        sset_add(&dirty, ri->split_children.names[i]);
+    }
+} /* mark_related_dirty */
+
+static void
+apply_interface(char *fields[], int n_fields)
+{
+    struct replay_intf *ri;
+    char *type;
+
+    if (n_fields != 8) {
+        ovs_fatal(0, "malformed Interface record");
+    }
+
+    ri = shash_find_data(&interfaces, fields[1]);
+    if (!ri) {
+        ri = replay_intf_create(fields[1]);
+    } else {
+        /* The old parent/children are affected as well. */
+        mark_related_dirty(ri);
+    }
+
+    type = intfd_record_get_str(fields[2]);
+    ri->intf.type_class = intfd_core_type_class(type);
+    free(type);
+
+    free(ri->split_parent);
+    ri->split_parent = intfd_record_get_str(fields[3]);
+
+    svec_clear(&ri->split_children);
+    intfd_record_get_list(fields[4], &ri->split_children);
+
+    smap_clear(&ri->user_config);
+    intfd_record_get_smap(fields[5], &ri->user_config);
+    smap_clear(&ri->hw_intf_info);
+    intfd_record_get_smap(fields[6], &ri->hw_intf_info);
+    smap_clear(&ri->pm_info);
+    intfd_record_get_smap(fields[7], &ri->pm_info);
+
+    mark_related_dirty(ri);
+} /* apply_interface */
+
+static void
+delete_interface(const char *name)
+{
+    struct shash_node *node = shash_find(&interfaces, name);
+    struct replay_intf *ri;
+
+    if (!node) {
+        return;
+    }
+
+    ri = node->data;
+    mark_related_dirty(ri);
+    sset_find_and_delete(&dirty, name);
+    shash_find_and_delete(&intf_ports, name);
+    shash_delete(&interfaces, node);
+    replay_intf_destroy(ri);
+} /* delete_interface */
+
+static void
+unlink_port_members(struct replay_port *port)
+{
+    size_t i;
+
+    for (i = 0; i < port->interfaces.n; i++) {
+        const char *member = port->interfaces.names[i];
+
+        if (shash_find_data(&intf_ports, member) == port) {
+            shash_find_and_delete(&intf_ports, member);
+        }
+        sset_add(&dirty, member);
+    }
+} /* unlink_port_members */
+
+static void
+apply_port(char *fields[], int n_fields)
+{
+    struct replay_port *port;
+    size_t i;
+
+    if (n_fields != 4) {
+        ovs_fatal(0, "malformed Port record");
+    }
+
+    port = shash_find_data(&ports, fields[1]);
+    if (!port) {
+        port = xzalloc(sizeof *port);
+        port->name = xstrdup(fields[1]);
+        svec_init(&port->interfaces);
+        shash_add(&ports, port->name, port);
+    }
+
+    unlink_port_members(port);
+    svec_clear(&port->interfaces);
+    intfd_record_get_list(fields[3], &port->interfaces);
+
+    free(port->admin);
+    port->admin = intfd_record_get_str(fields[2]);
+
+    for (i = 0; i < port->interfaces.n; i++) {
+        shash_replace(&intf_ports, port->interfaces.names[i], port);
+        sset_add(&dirty, port->interfaces.names[i]);
+    }
+} /* apply_port */
+
+static void
+delete_port(const char *name)
+{
+    struct replay_port *port = shash_find_and_delete(&ports, name);
+
+    if (!port) {
+        return;
+    }
+
+    unlink_port_members(port);
+    svec_destroy(&port->interfaces);
+    free(port->admin);
+    free(port->name);
+    free(port);
+} /* delete_port */
+
+static int32_t
+intf_max_mtu(const char *name)
+{
+    const struct replay_subsystem *subsys;
+
+    subsys = shash_find_data(&intf_subsystems, name);
+    if (!subsys) {
+        subsys = shash_find_data(&subsystems, REPLAY_BASE_SUBSYSTEM);
+    }
+
+    return subsys ? subsys->mtu : 0;
+} /* intf_max_mtu */
+
+/* Marks every interface whose MTU limit comes from 'subsys' dirty. */
+static void
+mark_subsystem_dirty(const struct replay_subsystem *subsys)
+{
+    struct shash_node *node;
+    size_t i;
+
+    for (i = 0; i < subsys->interfaces.n; i++) {
+        const char *name = subsys->interfaces.names[i];
+
+        if (shash_find_data(&intf_subsystems, name) == subsys) {
+            sset_add(&dirty, name);
+        }
+    }
+
+    /* The base subsystem also owns all unlisted interfaces. */
+    if (!strcmp(subsys->name, REPLAY_BASE_SUBSYSTEM)) {
+        SHASH_FOR_EACH (node, &interfaces) {
+            if (!shash_find(&intf_subsystems, node->name)) {
+                sset_add(&dirty, node->name);
+            }
+        }
+    }
+} /* mark_subsystem_dirty */
+
+/* Hands the interfaces owned by 'subsys' and missing from 'keep' (if
+ * nonnull) to the next Subsystem listing them, or back to the base
+ * subsystem. */
+static void
+unlink_subsystem_interfaces(struct replay_subsystem *subsys,
+                            const struct svec *keep)
+{
+    size_t i;
+
+    for (i = 0; i < subsys->interfaces.n; i++) {
+        const char *name = subsys->interfaces.names[i];
+        struct shash_node *node;
+
+        if (shash_find_data(&intf_subsystems, name) != subsys
+            || (keep && svec_contains(keep, name))) {
+            continue;
+        }
+
+        shash_find_and_delete(&intf_subsystems, name);
+        SHASH_FOR_EACH (node, &subsystems) {
+            struct replay_subsystem *other = node->data;
+
+            if (other != subsys && svec_contains(&other->interfaces, name)) {
+                shash_add(&intf_subsystems, name, other);
+                break;
+            }
+        }
+        sset_add(&dirty, name);
+    }
+} /* unlink_subsystem_interfaces */
+
+static void
+apply_subsystem(char *fields[], int n_fields)
+{
+    struct replay_subsystem *subsys;
+    struct svec new_interfaces;
+    bool is_new = false;
+    int32_t new_mtu;
+    char *mtu;
+    size_t i;
+
+    /* Version 1 files carry no interfaces column. */
+    if (n_fields != 3 && n_fields != 4) {
+        ovs_fatal(0, "malformed Subsystem record");
+    }
+
+    subsys = shash_find_data(&subsystems, fields[1]);
+    if (!subsys) {
+        subsys = xzalloc(sizeof *subsys);
+        subsys->name = xstrdup(fields[1]);
+        svec_init(&subsys->interfaces);
+        shash_add(&subsystems, subsys->name, subsys);
+        is_new = true;
+    }
+
+    mtu = intfd_record_get_str(fields[2]);
+    new_mtu = mtu ? atoi(mtu) : 0;
+    free(mtu);
+    if (is_new || new_mtu != subsys->mtu) {
+        subsys->mtu = new_mtu;
+        mark_subsystem_dirty(subsys);
+    }
+
+    svec_init(&new_interfaces);
+    if (n_fields == 4) {
+        intfd_record_get_list(fields[3], &new_interfaces);
+        svec_sort(&new_interfaces);
+    }
+    unlink_subsystem_interfaces(subsys, &new_interfaces);
+    svec_swap(&subsys->interfaces, &new_interfaces);
+    svec_destroy(&new_interfaces);
+
+    /* As in intfd, an interface listed twice stays with its first owner. */
+    for (i = 0; i < subsys->interfaces.n; i++) {
+        const char *name = subsys->interfaces.names[i];
+
+        if (!shash_find(&intf_subsystems, name)) {
+            shash_add(&intf_subsystems, name, subsys);
+            sset_add(&dirty, name);
+        }
+    }
+} /* apply_subsystem */
+
+static void
+delete_subsystem(const char *name)
+{
+    struct replay_subsystem *subsys = shash_find_and_delete(&subsystems,
+                                                            name);
+
+    if (!subsys) {
+        return;
+    }
+
+    /* Everything this subsystem owned loses its MTU limit. */
+    mark_subsystem_dirty(subsys);
+    unlink_subsystem_interfaces(subsys, NULL);
+    svec_destroy(&subsys->interfaces);
+    free(subsys->name);
+    free(subsys);
+} /* delete_subsystem */
+
+static void
+add_output(char *fields[], int n_fields)
+{
+    struct replay_output *out;
+
+    if (n_fields != 4) {
+        ovs_fatal(0, "malformed output record");
+    }
+
+    out = shash_find_data(&outputs, fields[1]);
+    if (!out) {
+        out = xzalloc(sizeof *out);
+        smap_init(&out->hw_intf_config);
+        shash_add(&outputs, fields[1], out);
+    }
+
+    /* The last write of a batch is the one that gets committed. */
+    if (strcmp(fields[2], INTFD_RECORD_ERROR_UNCHANGED)) {
+        free(out->error);
+        out->error = intfd_record_get_str(fields[2]);
+        out->error_written = true;
+    }
+    smap_clear(&out->hw_intf_config);
+    intfd_record_get_smap(fields[3], &out->hw_intf_config);
+} /* add_output */
+
+/* Refresh the parsed state of 'ri' the way intfd does when its row, its
+ * port or its split parent changes. */
+static void
+parse_interface(struct replay_intf *ri)
+{
+    struct replay_intf *parent = NULL;
+    struct replay_port *port;
+    size_t i;
+
+    intfd_parse_hw_info(&ri->intf.hw_info, &ri->hw_intf_info);
+    intfd_parse_user_cfg(&ri->intf.user_cfg, &ri->user_config,
+                         &ri->hw_intf_info, intf_max_mtu(ri->name));
+
+    port = shash_find_data(&intf_ports, ri->name);
+    ri->intf.port_admin = PORT_ADMIN_CONFIG_DOWN;
+    if (port && (!port->admin || !strcmp(port->admin, "up"))) {
+        ri->intf.port_admin = PORT_ADMIN_CONFIG_UP;
+    }
+
+    if (ri->split_parent) {
+        parent = shash_find_data(&interfaces, ri->split_parent);
+    }
+    ri->intf.split_parent = parent ? &parent->intf : NULL;
+
+    if (parent) {
+        intfd_parse_split_pm_info(&ri->intf.pm_info, &parent->pm_info);
+    } else {
+        intfd_parse_pm_info(&ri->intf.hw_info, &ri->intf.pm_info,
+                            &ri->pm_info);
+    }
+
+    free(ri->intf.split_children);
+    ri->intf.split_children = NULL;
+    ri->intf.n_split_children = ri->split_children.n;
+    if (ri->split_children.n) {
+        ri->intf.split_children = xcalloc(ri->split_children.n,
+                                          sizeof *ri->intf.split_children);
+        for (i = 0; i < ri->split_children.n; i++) {
+            struct replay_intf *child;
+
+            child = shash_find_data(&interfaces, ri->split_children.names[i]);
+            ri->intf.split_children[i] = child ? &child->intf : NULL;
+        }
+    }
+} /* parse_interface */
+
+static void
+show_diff(unsigned int seqno, const char *name, const char *what,
+          const struct replay_output *out, const struct replay_intf *ri)
+{
+    struct ds ds = DS_EMPTY_INITIALIZER;
+
+    if (n_diffs_shown++ >= max_diffs) {
+        return;
+    }
+
+    ds_put_format(&ds, "DIFF batch %u interface %s: %s\n", seqno, name, what);
+    if (out) {
+        ds_put_cstr(&ds, "    recorded:");
+        intfd_record_put_str(&ds, out->error_written ? out->error : "*");
+        intfd_record_put_smap(&ds, &out->hw_intf_config);
+        ds_put_char(&ds, '\n');
+    }
+    if (ri) {
+        ds_put_cstr(&ds, "    replayed:");
+        intfd_record_put_str(&ds, ri->error);
+        intfd_record_put_smap(&ds, &ri->hw_intf_config);
+        ds_put_char(&ds, '\n');
+    }
+    fputs(ds_cstr(&ds), stdout);
+    ds_destroy(&ds);
+} /* show_diff */
+
+static bool
+output_matches(const struct replay_output *out, const struct replay_intf *ri)
+{
+    if (out->error_written
+        && !nullable_string_is_equal(out->error, ri->error)) {
+        return false;
+    }
+    return smap_equal(&out->hw_intf_config, &ri->hw_intf_config);
+} /* output_matches */
+
+static void
+record_latency(long long int usec)
+{
+    if (stats.n_latencies >= stats.allocated_latencies) {
+        stats.latencies = x2nrealloc(stats.latencies,
+                                     &stats.allocated_latencies,
+                                     sizeof *stats.latencies);
+    }
+    stats.latencies[stats.n_latencies++] = usec;
+    stats.total_usec += usec;
+} /* record_latency */
+
+/* Re-evaluate every interface touched by the batch and compare the
+ * result with what the daemon wrote. */
+static void
+finish_batch(unsigned int seqno, bool first)
+{
+    struct sset written = SSET_INITIALIZER(&written);
+    struct shash_node *node, *next;
+    const char *name;
+    long long int start;
+
+    start = replay_now_usec();
+
+    /* Split children of a dirty parent depend on its lane_split and
+     * pm_info, so parse every dirty interface before evaluating any. */
+    SSET_FOR_EACH (name, &dirty) {
+        struct replay_intf *ri = shash_find_data(&interfaces, name);
+        if (ri) {
+            parse_interface(ri);
+        }
+    }
+
+    SSET_FOR_EACH (name, &dirty) {
+        struct replay_intf *ri = shash_find_data(&interfaces, name);
+        struct smap hw_intf_config = SMAP_INITIALIZER(&hw_intf_config);
+        const char *error;
+
+        if (!ri) {
+            continue;
+        }
+
+        intfd_core_calc_op_state(&ri->intf);
+        error = intfd_build_hw_intf_config(&ri->intf, &hw_intf_config);
+        stats.n_evaluations++;
+
+        if (!ri->evaluated
+            || !nullable_string_is_equal(error, ri->error)
+            || !smap_equal(&hw_intf_config, &ri->hw_intf_config)) {
+            free(ri->error);
+            ri->error = nullable_xstrdup(error);
+            smap_destroy(&ri->hw_intf_config);
+            smap_clone(&ri->hw_intf_config, &hw_intf_config);
+            ri->evaluated = true;
+            sset_add(&written, name);
+            stats.n_writes++;
+        }
+        smap_destroy(&hw_intf_config);
+    }
+
+    record_latency(replay_now_usec() - start);
+
+    SHASH_FOR_EACH (node, &outputs) {
+        struct replay_output *out = node->data;
+        struct replay_intf *ri = shash_find_data(&interfaces, node->name);
+
+        if (!ri || !ri->evaluated) {
+            stats.n_mismatched++;
+            show_diff(seqno, node->name, "written by intfd, not evaluated",
+                      out, NULL);
+        } else if (output_matches(out, ri)) {
+            stats.n_matched++;
+        } else {
+            stats.n_mismatched++;
+            show_diff(seqno, node->name, "outputs differ", out, ri);
+        }
+        sset_find_and_delete(&written, node->name);
+    }
+
+    /* A recording that starts mid-run begins with a full snapshot for
+     * which the daemon only writes what changed, so ignore it. */
+    if (!first) {
+        SSET_FOR_EACH (name, &written) {
+            stats.n_unrecorded++;
+            show_diff(seqno, name, "changed by replay, not written by intfd",
+                      NULL, shash_find_data(&interfaces, name));
+        }
+    }
+
+    SHASH_FOR_EACH_SAFE (node, next, &outputs) {
+        struct replay_output *out = node->data;
+        free(out->error);
+        smap_destroy(&out->hw_intf_config);
+        free(out);
+        shash_delete(&outputs, node);
+    }
+    sset_destroy(&written);
+    sset_clear(&dirty);
+    stats.n_batches++;
+} /* finish_batch */
+
+static int
+compare_latencies(const void *a_, const void *b_)
+{
+    const long long int *a = a_;
+    const long long int *b = b_;
+
+    return *a < *b ? -1 : *a > *b;
+} /* compare_latencies */
+
+static long long int
+latency_percentile(int pct)
+{
+    size_t idx;
+
+    if (!stats.n_latencies) {
+        return 0;
+    }
+    idx = (stats.n_latencies - 1) * pct / 100;
+    return stats.latencies[idx];
+} /* latency_percentile */
+
+static void
+print_report(const char *file_name)
+{
+    double secs = stats.total_usec / 1e6;
+
+    qsort(stats.latencies, stats.n_latencies, sizeof *stats.latencies,
+          compare_latencies);
+
+    printf("Replayed %s\n", file_name);
+    printf("  updates           : %"PRIuSIZE"\n", stats.n_batches);
+    printf("  row deltas        : %"PRIuSIZE"\n", stats.n_deltas);
+    printf("  evaluations       : %"PRIuSIZE"\n", stats.n_evaluations);
+    printf("  writes            : %"PRIuSIZE"\n", stats.n_writes);
+    printf("  processing time   : %.3f ms\n", stats.total_usec / 1e3);
+    if (secs > 0) {
+        printf("  throughput        : %.0f updates/s, %.0f row deltas/s, "
+               "%.0f evaluations/s\n",
+               stats.n_batches / secs, stats.n_deltas / secs,
+               stats.n_evaluations / secs);
+    }
+    printf("  latency (us)      : min %lld, p50 %lld, p90 %lld, p99 %lld, "
+           "max %lld\n",
+           latency_percentile(0), latency_percentile(50),
+           latency_percentile(90), latency_percentile(99),
+           latency_percentile(100));
+    printf("  outputs           : %"PRIuSIZE" matched, %"PRIuSIZE
+           " differ, %"PRIuSIZE" not written by intfd\n",
+           stats.n_matched, stats.n_mismatched, stats.n_unrecorded);
+} /* print_report */
+
+static void
+replay_file(const char *file_name)
+{
+    struct ds line = DS_EMPTY_INITIALIZER;
+    unsigned int seqno = 0;
+    bool in_batch = false;
+    FILE *file;
+    int line_number = 0;
+
+    file = fopen(file_name, "r");
+    if (!file) {
+        ovs_fatal(errno, "%s: open failed", file_name);
+    }
+
+    while (!ds_get_line(&line, file)) {
+        char *fields[REPLAY_MAX_FIELDS];
+        char *save_ptr = NULL;
+        char *field;
+        int n_fields = 0;
+
+        line_number++;
+        for (field = strtok_r(ds_cstr(&line), " ", &save_ptr); field;
+             field = strtok_r(NULL, " ", &save_ptr)) {
+            if (n_fields >= REPLAY_MAX_FIELDS) {
+                ovs_fatal(0, "%s:%d: too many fields", file_name, line_number);
+            }
+            fields[n_fields++] = field;
+        }
+
+        if (!n_fields || fields[0][0] == '#') {
+            continue;
+        }
+
+        if (fields[0][1] != '\0') {
+            ovs_fatal(0, "%s:%d: unknown record type", file_name, line_number);
+        }
+
+        if (n_fields < 2 && fields[0][0] != 'E') {
+            ovs_fatal(0, "%s:%d: missing fields", file_name, line_number);
+        }
+
+        if (!in_batch && fields[0][0] != 'B') {
+            ovs_fatal(0, "%s:%d: record outside of a batch",
+                      file_name, line_number);
+        }
+
+        switch (fields[0][0]) {
+        case 'B':
+            seqno = strtoul(fields[1], NULL, 10);
+            in_batch = true;
+            break;
+
+        case 'I':
+            apply_interface(fields, n_fields);
+            stats.n_deltas++;
+            break;
+
+        case 'i':
+            delete_interface(fields[1]);
+            stats.n_deltas++;
+            break;
+
+        case 'P':
+            apply_port(fields, n_fields);
+            stats.n_deltas++;
+            break;
+
+        case 'p':
+            delete_port(fields[1]);
+            stats.n_deltas++;
+            break;
+
+        case 'S':
+            apply_subsystem(fields, n_fields);
+            stats.n_deltas++;
+            break;
+
+        case 's':
+            delete_subsystem(fields[1]);
+            stats.n_deltas++;
+            break;
+
+        case 'Y':
+            /* intfd only waits for cur_cfg > 0 before starting. */
+            stats.n_deltas++;
+            break;
+
+        case 'O':
+            add_output(fields, n_fields);
+            break;
+
+        case 'E':
+            finish_batch(seqno, stats.n_batches == 0);
+            in_batch = false;
+            break;
+
+        default:
+            ovs_fatal(0, "%s:%d: unknown record type", file_name, line_number);
+        }
+    }
+
+    /* A trailing batch without 'E' was cut short while being written. */
+    fclose(file);
+    ds_destroy(&line);
+} /* replay_file */
+
+static char *
+parse_options(int argc, char *argv[])
+{
+    enum {
+        OPT_MAX_DIFFS = UCHAR_MAX + 1,
+        VLOG_OPTION_ENUMS,
+    };
+    static const struct option long_options[] = {
+        {"help",        no_argument, NULL, 'h'},
+        {"max-diffs",   required_argument, NULL, OPT_MAX_DIFFS},
+        VLOG_LONG_OPTIONS,
+        {NULL, 0, NULL, 0},
+    };
+    char *short_options = long_options_to_short_options(long_options);
+
+    for (;;) {
+        int c;
+
+        c = getopt_long(argc, argv, short_options, long_options, NULL);
+        if (c == -1) {
+            break;
+        }
+
+        switch (c) {
+        case 'h':
+            usage();
+
+        case OPT_MAX_DIFFS:
+            max_diffs = atoi(optarg);
+            break;
+
+        VLOG_OPTION_HANDLERS
+
+        case '?':
+            exit(EXIT_FAILURE);
+
+        default:
+            abort();
+        }
+    }
+    free(short_options);
+
+    if (argc - optind != 1) {
+        ovs_fatal(0, "exactly one record file is required; "
+                  "use --help for usage");
+    }
+
+    return argv[optind];
+} /* parse_options */
+
+int
+main(int argc, char *argv[])
+{
+    const char *file_name;
+
+    set_program_name(argv[0]);
+
+    /* Missing h/w description warnings would drown the report. */
+    vlog_set_levels(NULL, VLF_ANY_DESTINATION, VLL_ERR);
+
+    file_name = parse_options(argc, argv);
+    replay_file(file_name);
+    print_report(file_name);
+
+    return stats.n_mismatched ? EXIT_FAILURE : EXIT_SUCCESS;
+} /* main */
+/** @} end of group ops-intfd */
@@ -21,12 +21,18 @@
  *
  ***************************************************************************/
 
+#include <stdio.h>
+#include <string.h>
+
 #include <smap.h>
 #include <openvswitch/vlog.h>
 
 #include <openswitch-idl.h>
 #include <vswitch-idl.h>
 
+#include "intfd_core.h"
+#include "intfd_utils.h"
+
 VLOG_DEFINE_THIS_MODULE(intfd_utils);
 
 /** @ingroup intfd
@@ -44,134 +50,136 @@ intfd_print_smap(const char *name, const struct smap *map)
     }
 } /* intfd_print_smap */
 
-const char*
-intfd_get_lane_split_str(enum ovsrec_interface_user_config_lane_split_e ls)
-{
-    switch(ls) {
-    case INTERFACE_USER_CONFIG_LANE_SPLIT_NO_SPLIT:
-        return INTERFACE_USER_CONFIG_MAP_LANE_SPLIT_NO_SPLIT;
-
-    case INTERFACE_USER_CONFIG_LANE_SPLIT_SPLIT:
-        return INTERFACE_USER_CONFIG_MAP_LANE_SPLIT_SPLIT;
-
-    case INTERFACE_USER_CONFIG_LANE_SPLIT_DEFAULT:
-    default:
-        return "unset by user";
-    }
-} /* intfd_get_lane_split_str */
-
-const char*
-intfd_get_error_str(enum ovsrec_interface_error_e reason)
+void
+intfd_parse_hw_info(struct intf_hw_info *hw_info,
+                    const struct smap *ifrow_hw_info)
 {
-    switch(reason) {
-
-    case INTERFACE_ERROR_UNINITIALIZED:
-        return OVSREC_INTERFACE_ERROR_UNINITIALIZED;
-
-    case INTERFACE_ERROR_ADMIN_DOWN:
-        return OVSREC_INTERFACE_ERROR_ADMIN_DOWN;
-
-    case INTERFACE_ERROR_MODULE_MISSING:
-        return OVSREC_INTERFACE_ERROR_MODULE_MISSING;
-
-    case INTERFACE_ERROR_MODULE_UNRECOGNIZED:
-        return OVSREC_INTERFACE_ERROR_MODULE_UNRECOGNIZED;
-
-    case INTERFACE_ERROR_MODULE_UNSUPPORTED:
-        return OVSREC_INTERFACE_ERROR_MODULE_UNSUPPORTED;
-
-    case INTERFACE_ERROR_LANES_SPLIT:
-        return OVSREC_INTERFACE_ERROR_LANES_SPLIT;
-
-    case INTERFACE_ERROR_LANES_NOT_SPLIT:
-        return OVSREC_INTERFACE_ERROR_LANES_NOT_SPLIT;
-
-    case INTERFACE_ERROR_INVALID_MTU:
-        return OVSREC_INTERFACE_ERROR_INVALID_MTU;
+    struct intf_hw_info_raw raw;
 
-    case INTERFACE_ERROR_INVALID_SPEEDS:
-        return OVSREC_INTERFACE_ERROR_INVALID_SPEEDS;
+    raw.pluggable = smap_get(ifrow_hw_info, INTERFACE_HW_INTF_INFO_MAP_PLUGGABLE);
+    raw.connector = smap_get(ifrow_hw_info, INTERFACE_HW_INTF_INFO_MAP_CONNECTOR);
+    raw.speeds = smap_get(ifrow_hw_info, INTERFACE_HW_INTF_INFO_MAP_SPEEDS);
+    raw.max_speed = smap_get(ifrow_hw_info, INTERFACE_HW_INTF_INFO_MAP_MAX_SPEED);
 
-    case INTERFACE_ERROR_AUTONEG_NOT_SUPPORTED:
-        return OVSREC_INTERFACE_ERROR_AUTONEG_NOT_SUPPORTED;
+    intfd_core_parse_hw_info(hw_info, &raw);
 
-    case INTERFACE_ERROR_AUTONEG_REQUIRED:
-        return OVSREC_INTERFACE_ERROR_AUTONEG_REQUIRED;
-
-    case PORT_ERROR_ADMIN_DOWN:
-        return OVSREC_PORT_ERROR_ADMIN_DOWN;
+    if (hw_info->n_speeds == 0) {
+        VLOG_WARN("value for speeds not set in h/w description file");
+    }
 
-    case INTERFACE_ERROR_OK:
-        return OVSREC_INTERFACE_ERROR_OK;
-    default:
-        return "???";
+    if (hw_info->max_speed == 0) {
+        VLOG_WARN("value for max_speed not set in h/w description file");
     }
 
-} /* intfd_get_error_str */
+} /* intfd_parse_hw_info */
 
-const char*
-intfd_get_intf_type_str(enum ovsrec_interface_hw_intf_config_interface_type_e intf_type)
+void
+intfd_parse_user_cfg(struct intf_user_cfg *user_config,
+                     const struct smap *ifrow_config,
+                     const struct smap *ifrow_hw_intf_info,
+                     int32_t max_mtu)
 {
-    switch(intf_type) {
-
-    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_UNKNOWN:
-        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_UNKNOWN;
+    struct intf_user_cfg_raw raw;
 
-    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_BACKPLANE:
-        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_BACKPLANE;
+    VLOG_DBG("Updating user config\n");
+    intfd_print_smap("interface_user_config", ifrow_config);
 
-    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_1GBASE_SX:
-        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_1GBASE_SX;
+    raw.admin = smap_get(ifrow_config, INTERFACE_USER_CONFIG_MAP_ADMIN);
+    raw.autoneg = smap_get(ifrow_config, INTERFACE_USER_CONFIG_MAP_AUTONEG);
+    raw.pause = smap_get(ifrow_config, INTERFACE_USER_CONFIG_MAP_PAUSE);
+    raw.duplex = smap_get(ifrow_config, INTERFACE_USER_CONFIG_MAP_DUPLEX);
+    raw.speeds = smap_get(ifrow_config, INTERFACE_USER_CONFIG_MAP_SPEEDS);
+    raw.mtu = smap_get(ifrow_config, INTERFACE_USER_CONFIG_MAP_MTU);
+    raw.lane_split = smap_get(ifrow_config, INTERFACE_USER_CONFIG_MAP_LANE_SPLIT);
 
-    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_1GBASE_T:
-        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_1GBASE_T;
+    intfd_core_parse_user_cfg(user_config, &raw,
+                              smap_get(ifrow_hw_intf_info,
+                                       INTERFACE_HW_INTF_INFO_MAP_SPEEDS),
+                              max_mtu);
 
-    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_10GBASE_CR:
-        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_10GBASE_CR;
+} /* intfd_parse_user_cfg */
 
-    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_10GBASE_SR:
-        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_10GBASE_SR;
-
-    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_10GBASE_LR:
-        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_10GBASE_LR;
-
-    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_10GBASE_LRM:
-        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_10GBASE_LRM;
-
-    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_10GBASE_ER:
-        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_10GBASE_ER;
+static void
+get_pm_info_raw(struct intf_pm_info_raw *raw, const struct smap *ifrow_pm_info)
+{
+    raw->connector_status = smap_get(ifrow_pm_info,
+                                     INTERFACE_PM_INFO_MAP_CONNECTOR_STATUS);
+    raw->connector = smap_get(ifrow_pm_info, INTERFACE_PM_INFO_MAP_CONNECTOR);
+    raw->supported_speeds = smap_get(ifrow_pm_info, "supported_speeds");
 
-    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_25GBASE_CR:
-        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_25GBASE_CR;
+} /* get_pm_info_raw */
 
-    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_25GBASE_SR:
-        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_25GBASE_SR;
+void
+intfd_parse_pm_info(struct intf_hw_info *hw_info, struct intf_pm_info *pm_info,
+                    const struct smap *ifrow_pm_info)
+{
+    struct intf_pm_info_raw raw;
 
-    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_25GBASE_LR:
-        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_25GBASE_LR;
+    get_pm_info_raw(&raw, ifrow_pm_info);
+    intfd_core_parse_pm_info(hw_info, pm_info, &raw);
 
-    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_40GBASE_CR4:
-        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_40GBASE_CR4;
+} /* intfd_parse_pm_info */
 
-    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_40GBASE_SR4:
-        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_40GBASE_SR4;
+void
+intfd_parse_split_pm_info(struct intf_pm_info *pm_info,
+                          const struct smap *ifrow_pm_info)
+{
+    struct intf_pm_info_raw raw;
 
-    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_40GBASE_LR4:
-        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_40GBASE_LR4;
+    get_pm_info_raw(&raw, ifrow_pm_info);
+    intfd_core_parse_split_pm_info(pm_info, &raw);
 
-    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_100GBASE_CR4:
-        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_100GBASE_CR4;
+} /* intfd_parse_split_pm_info */
 
-    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_100GBASE_SR4:
-        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_100GBASE_SR4;
+/* Build the hw_intf_config map for 'intf' into 'hw_intf_config', which
+ * must be initialized by the caller.  Returns the string to write to the
+ * Interface "error" column, or NULL if the interface is enabled. */
+const char *
+intfd_build_hw_intf_config(const struct iface *intf, struct smap *hw_intf_config)
+{
+    struct intf_hw_config hw_config;
+    const char *error;
+
+    error = intfd_core_get_hw_config(intf, &hw_config);
+
+    smap_add(hw_intf_config, INTERFACE_HW_INTF_CONFIG_MAP_ENABLE,
+             hw_config.enable ? INTERFACE_HW_INTF_CONFIG_MAP_ENABLE_TRUE
+                              : INTERFACE_HW_INTF_CONFIG_MAP_ENABLE_FALSE);
+
+    if (hw_config.link_config) {
+        smap_add(hw_intf_config, INTERFACE_HW_INTF_CONFIG_MAP_AUTONEG,
+                 hw_config.autoneg);
+        smap_add(hw_intf_config, INTERFACE_HW_INTF_CONFIG_MAP_DUPLEX,
+                 hw_config.duplex);
+        smap_add(hw_intf_config, INTERFACE_HW_INTF_CONFIG_MAP_PAUSE,
+                 hw_config.pause);
+
+        if (hw_config.mtu) {
+            smap_add_format(hw_intf_config, INTERFACE_HW_INTF_CONFIG_MAP_MTU,
+                            "%d", hw_config.mtu);
+        }
+
+        if (hw_config.n_speeds > 0) {
+            char speed_string[INTFD_MAX_SPEEDS_ALLOWED*20];
+            int i = 0;
+
+            sprintf(speed_string, "%d", hw_config.speeds[0]);
+            for (i = 1; i < hw_config.n_speeds; i++) {
+                sprintf(speed_string+strlen(speed_string), ",%d",
+                        hw_config.speeds[i]);
+            }
+
+            smap_add(hw_intf_config, INTERFACE_HW_INTF_CONFIG_MAP_SPEEDS,
+                     speed_string);
+        }
+
+        smap_add(hw_intf_config, INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE,
+                 hw_config.interface_type);
+    }
 
-    case INTERFACE_HW_INTF_CONFIG_INTERFACE_TYPE_100GBASE_LR4:
-        return INTERFACE_HW_INTF_CONFIG_MAP_INTERFACE_TYPE_100GBASE_LR4;
+    return error;
 
-    default:
-        return "unknown";
-    }
+} /* intfd_build_hw_intf_config */
 
-} /* intfd_get_intf_type_str */
 
 /** @} end of group intfd */
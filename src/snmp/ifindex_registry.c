@@ -0,0 +1,338 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup ops-intfd
+ *
+ * @file
+ * Source for the ifIndex registry of the IF-MIB and IP-MIB plugins.
+ *
+ ***************************************************************************/
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "dirs.h"
+#include "hash.h"
+#include "hmap.h"
+#include "timeval.h"
+#include "util.h"
+#include "openvswitch/vlog.h"
+#include "ifindex_registry.h"
+
+VLOG_DEFINE_THIS_MODULE(ifindex_registry);
+
+/* Longest name the file may hold. */
+#define IFINDEX_REGISTRY_NAME_MAX   64
+
+/* How often a lookup of an unknown ifIndex may look for a new file. */
+#define IFINDEX_REGISTRY_CHECK_MSEC 1000
+
+struct ifindex_entry {
+    struct hmap_node name_node;     /* In 'by_name'. */
+    struct hmap_node index_node;    /* In 'by_index'. */
+    char *name;
+    long ifindex;
+};
+
+static struct hmap by_name = HMAP_INITIALIZER(&by_name);
+static struct hmap by_index = HMAP_INITIALIZER(&by_index);
+
+/* The index the next dynamic name gets, unless it is taken. */
+static long next_dynamic = IFINDEX_REGISTRY_DYNAMIC_MIN;
+
+static char *registry_file;
+
+/* The version of the file the map last read or wrote.  A save replaces the
+ * file, so a new inode means that the other plugin saved it. */
+static bool file_seen;
+static dev_t file_dev;
+static ino_t file_ino;
+
+/* Whether the map has names the file does not have yet. */
+static bool dirty;
+
+/* time_msec() before which a lookup trusts the last check of the file. */
+static long long int next_check;
+
+static struct ifindex_entry *
+registry_find_name(const char *name)
+{
+    struct ifindex_entry *entry;
+
+    HMAP_FOR_EACH_WITH_HASH (entry, name_node, hash_string(name, 0),
+                             &by_name) {
+        if (!strcmp(entry->name, name)) {
+            return entry;
+        }
+    }
+    return NULL;
+} /* registry_find_name */
+
+static struct ifindex_entry *
+registry_find_index(long ifindex)
+{
+    struct ifindex_entry *entry;
+
+    HMAP_FOR_EACH_WITH_HASH (entry, index_node, hash_int(ifindex, 0),
+                             &by_index) {
+        if (entry->ifindex == ifindex) {
+            return entry;
+        }
+    }
+    return NULL;
+} /* registry_find_index */
+
+static struct ifindex_entry *
+registry_add(const char *name, long ifindex)
+{
+    struct ifindex_entry *entry = xmalloc(sizeof *entry);
+
+    entry->name = xstrdup(name);
+    entry->ifindex = ifindex;
+    hmap_insert(&by_name, &entry->name_node, hash_string(name, 0));
+    hmap_insert(&by_index, &entry->index_node, hash_int(ifindex, 0));
+    if (ifindex >= next_dynamic && ifindex < IFINDEX_REGISTRY_MAX) {
+        next_dynamic = ifindex + 1;
+    }
+    return entry;
+} /* registry_add */
+
+static const char *
+registry_file_name(void)
+{
+    if (!registry_file) {
+        registry_file = xasprintf("%s/%s", ovs_dbdir(),
+                                  IFINDEX_REGISTRY_FILE);
+    }
+    return registry_file;
+} /* registry_file_name */
+
+static void
+registry_file_seen(const struct stat *st)
+{
+    file_seen = true;
+    file_dev = st->st_dev;
+    file_ino = st->st_ino;
+} /* registry_file_seen */
+
+/* Adds the names the file has and the map does not.  Entries are never
+ * changed once saved, so there is nothing else to read.  Unless 'force',
+ * only looks for a new file once per IFINDEX_REGISTRY_CHECK_MSEC. */
+static void
+registry_read(bool force)
+{
+    const char *file_name = registry_file_name();
+    char name[IFINDEX_REGISTRY_NAME_MAX + 1];
+    long long int now = time_msec();
+    struct stat st;
+    long ifindex;
+    FILE *file;
+
+    if (!force && now < next_check) {
+        return;
+    }
+    next_check = now + IFINDEX_REGISTRY_CHECK_MSEC;
+
+    if (stat(file_name, &st)) {
+        return;
+    }
+    if (file_seen && st.st_dev == file_dev && st.st_ino == file_ino) {
+        return;
+    }
+
+    file = fopen(file_name, "r");
+    if (!file) {
+        VLOG_WARN("%s: open failed (%s)", file_name, ovs_strerror(errno));
+        return;
+    }
+    while (fscanf(file, "%ld %64s", &ifindex, name) == 2) {
+        if (ifindex <= 0 || registry_find_name(name)
+            || registry_find_index(ifindex)) {
+            continue;
+        }
+        registry_add(name, ifindex);
+    }
+    fclose(file);
+    registry_file_seen(&st);
+} /* registry_read */
+
+/* Replaces the file with the whole map, about 100 kB for 8192 names, so
+ * ifindex_registry_flush() only does it once for all the names added
+ * since the last time.  Returns false if the file was not replaced. */
+static bool
+registry_write(void)
+{
+    static struct vlog_rate_limit rl = VLOG_RATE_LIMIT_INIT(1, 5);
+    const char *file_name = registry_file_name();
+    const struct ifindex_entry *entry;
+    char *tmp_name;
+    struct stat st;
+    FILE *file;
+    bool ok;
+
+    tmp_name = xasprintf("%s.tmp", file_name);
+    file = fopen(tmp_name, "w");
+    if (!file) {
+        VLOG_WARN_RL(&rl, "%s: create failed (%s)", tmp_name,
+                     ovs_strerror(errno));
+        free(tmp_name);
+        return false;
+    }
+    HMAP_FOR_EACH (entry, index_node, &by_index) {
+        fprintf(file, "%ld %s\n", entry->ifindex, entry->name);
+    }
+    /* On disk before the rename, so a crash leaves the old or the new
+     * map, not an empty file. */
+    ok = !fflush(file) && !ferror(file) && !fsync(fileno(file));
+    ok = !fclose(file) && ok;
+
+    if (!ok || rename(tmp_name, file_name)) {
+        VLOG_WARN_RL(&rl, "%s: save failed (%s)", file_name,
+                     ovs_strerror(errno));
+        unlink(tmp_name);
+        ok = false;
+    } else if (!stat(file_name, &st)) {
+        registry_file_seen(&st);
+    }
+    free(tmp_name);
+    return ok;
+} /* registry_write */
+
+/* Returns the number 'name' stands for if it is made of digits only and
+ * below IFINDEX_REGISTRY_DYNAMIC_MIN, otherwise 0. */
+static long
+registry_static_index(const char *name)
+{
+    long ifindex = 0;
+    const char *p;
+
+    for (p = name; *p; p++) {
+        if (*p < '0' || *p > '9') {
+            return 0;
+        }
+        ifindex = ifindex * 10 + (*p - '0');
+        if (ifindex >= IFINDEX_REGISTRY_DYNAMIC_MIN) {
+            return 0;
+        }
+    }
+    return ifindex;
+} /* registry_static_index */
+
+static long
+registry_allocate(const char *name)
+{
+    long ifindex = registry_static_index(name);
+
+    if (ifindex && !registry_find_index(ifindex)) {
+        return ifindex;
+    }
+    for (ifindex = next_dynamic; ifindex < IFINDEX_REGISTRY_MAX; ifindex++) {
+        if (!registry_find_index(ifindex)) {
+            return ifindex;
+        }
+    }
+    return 0;
+} /* registry_allocate */
+
+long
+ifindex_registry_get(const char *name)
+{
+    static struct vlog_rate_limit rl = VLOG_RATE_LIMIT_INIT(1, 5);
+    struct ifindex_entry *entry;
+    long ifindex;
+
+    entry = registry_find_name(name);
+    if (entry) {
+        return entry->ifindex;
+    }
+
+    /* The other plugin may have given 'name' an index already, or taken
+     * the one it would get, so this check is not rate limited.  It is only
+     * made once per new name. */
+    registry_read(true);
+    entry = registry_find_name(name);
+    if (entry) {
+        return entry->ifindex;
+    }
+
+    if (strlen(name) > IFINDEX_REGISTRY_NAME_MAX) {
+        VLOG_WARN_RL(&rl, "%s: name too long for an ifIndex", name);
+        return 0;
+    }
+    ifindex = registry_allocate(name);
+    if (!ifindex) {
+        VLOG_WARN_RL(&rl, "%s: no ifIndex left", name);
+        return 0;
+    }
+    registry_add(name, ifindex);
+    dirty = true;
+    return ifindex;
+} /* ifindex_registry_get */
+
+const char *
+ifindex_registry_name(long ifindex)
+{
+    const struct ifindex_entry *entry;
+
+    entry = registry_find_index(ifindex);
+    if (!entry) {
+        registry_read(false);
+        entry = registry_find_index(ifindex);
+    }
+    return entry ? entry->name : NULL;
+} /* ifindex_registry_name */
+
+void
+ifindex_registry_flush(void)
+{
+    if (!dirty) {
+        return;
+    }
+    /* Keep what the other plugin saved since. */
+    registry_read(true);
+    if (registry_write()) {
+        dirty = false;
+    }
+} /* ifindex_registry_flush */
+
+void
+ifindex_registry_destroy(void)
+{
+    struct ifindex_entry *entry, *next;
+
+    ifindex_registry_flush();
+    HMAP_FOR_EACH_SAFE (entry, next, index_node, &by_index) {
+        hmap_remove(&by_index, &entry->index_node);
+        hmap_remove(&by_name, &entry->name_node);
+        free(entry->name);
+        free(entry);
+    }
+    hmap_destroy(&by_index);
+    hmap_destroy(&by_name);
+    hmap_init(&by_index);
+    hmap_init(&by_name);
+    next_dynamic = IFINDEX_REGISTRY_DYNAMIC_MIN;
+    file_seen = false;
+    dirty = false;
+    next_check = 0;
+    free(registry_file);
+    registry_file = NULL;
+} /* ifindex_registry_destroy */
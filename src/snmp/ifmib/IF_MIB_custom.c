@@ -2,8 +2,16 @@
 #include "ovsdb-idl.h"
 #include "vswitch-idl.h"
 #include "openvswitch/vlog.h"
+#include "smap.h"
+#include "util.h"
 #include "IF_MIB_custom.h"
+#include "intf_stats.h"
+#include "ifindex_registry.h"
+#include "IF_MIB_notifications.h"
+#include "ifTable_enums.h"
+#include "ifXTable_enums.h"
 #include "IF_MIB_scalars_ovsdb_get.h"
+#include "IF_MIB_txn.h"
 #include <netinet/ether.h>
 #include <net-snmp/net-snmp-config.h>
 #include <net-snmp/net-snmp-features.h>
@@ -11,46 +19,45 @@
 #include <net-snmp/agent/net-snmp-agent-includes.h>
 
 VLOG_DEFINE_THIS_MODULE (ifmib_custom_snmp);
-static char *interface_statistics_keys [] = {
-        "rx_packets",
-        "rx_bytes",
-        "tx_packets",
-        "tx_bytes",
-        "rx_dropped",
-        "rx_frame_err",
-        "rx_over_err",
-        "rx_crc_err",
-        "rx_errors",
-        "tx_dropped",
-        "collisions",
-        "tx_errors"
-};
+
+/* Every counter column of a row is read through its own custom function,
+ * one row after the other.  Decode the statistics column once per row and
+ * IDL change instead of once per column. */
+static const struct intf_stats *
+ifmib_interface_stats(const struct ovsdb_idl *idl,
+                      const struct ovsrec_interface *interface_row)
+{
+    static const struct ovsrec_interface *cached_row;
+    static unsigned int cached_seqno;
+    static struct intf_stats cached_stats;
+    unsigned int seqno = ovsdb_idl_get_seqno(idl);
+
+    if (interface_row != cached_row || seqno != cached_seqno) {
+        intf_stats_from_interface(interface_row, &cached_stats);
+        cached_row = interface_row;
+        cached_seqno = seqno;
+    }
+    return &cached_stats;
+}
 
 int ifTable_skip_function(const struct ovsdb_idl *idl,
                           const struct ovsrec_interface *interface_row) {
-    if(strchr(interface_row->name, '-') != NULL)
-        return 1;
-    if (atoi(interface_row->name) == 0)
-        return 1;
-    return 0;
+    /* Every other interface, split, subinterface or loopback alike, gets
+     * an ifIndex from the registry. */
+    return !strcmp(interface_row->name, IF_MIB_BRIDGE_NORMAL);
 }
 
 
 int ifXTable_skip_function(const struct ovsdb_idl *idl,
                            const struct ovsrec_interface *interface_row) {
-    if(strchr(interface_row->name, '-') != NULL)
-        return 1;
-    if (atoi(interface_row->name) == 0)
-        return 1;
-    return 0;
+    return !strcmp(interface_row->name, IF_MIB_BRIDGE_NORMAL);
 }
 
 
 void ifTableifIndex_custom_function(const struct ovsdb_idl *idl,
                                     const struct ovsrec_interface *interface_row,
                                     long *ifIndex_val_ptr) {
-    char * temp = interface_row->name;
-    *ifIndex_val_ptr = atoi(temp);
+    *ifIndex_val_ptr = ifindex_registry_get(interface_row->name);
 }
 
 
@@ -110,6 +117,12 @@ void ifOperStatus_custom_function(const struct ovsdb_idl *idl,
     }
 }
 
+void ifLastChange_custom_function(const struct ovsdb_idl *idl,
+                                  const struct ovsrec_interface *interface_row,
+                                  long *ifLastChange_val_ptr) {
+    *ifLastChange_val_ptr = if_mib_link_last_change(interface_row);
+}
+
 void ifSpeed_custom_function(const struct ovsdb_idl *idl,
                              const struct ovsrec_interface *interface_row,
                              u_long *ifSpeed_val_ptr) {
@@ -171,40 +184,13 @@ void ifPhysAddress_custom_function(const struct ovsdb_idl *idl,
 void ifInOctets_custom_function(const struct ovsdb_idl *idl,
                                 const struct ovsrec_interface *interface_row,
                                 unsigned long *ifInOctets_val_ptr){
-    const struct ovsdb_datum *datum;
-    union ovsdb_atom atom;
-    unsigned int index;
-
-    datum = ovsrec_interface_get_statistics(interface_row,
-                OVSDB_TYPE_STRING, OVSDB_TYPE_INTEGER);
-    if (NULL==datum)
-        *ifInOctets_val_ptr = 0;
-    else {
-        atom.string = interface_statistics_keys[1];
-        index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-        *ifInOctets_val_ptr = (index == UINT_MAX)? 0 :
-                               datum->values[index].integer;
-    }
+    *ifInOctets_val_ptr = ifmib_interface_stats(idl, interface_row)->rx_bytes;
 }
 
 void ifInUcastPkts_custom_function(const struct ovsdb_idl *idl,
                                    const struct ovsrec_interface *interface_row,
                                    unsigned long *ifInUcastPkts_val_ptr){
-    const struct ovsdb_datum *datum;
-    union ovsdb_atom atom;
-    unsigned int index;
-
-    datum = ovsrec_interface_get_statistics(interface_row,
-                 OVSDB_TYPE_STRING, OVSDB_TYPE_INTEGER);
-    if (NULL==datum)
-        *ifInUcastPkts_val_ptr = 0;
-    else {
-        atom.string = interface_statistics_keys[0];
-        index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-        *ifInUcastPkts_val_ptr = (index == UINT_MAX)? 0 :
-                                  datum->values[index].integer;
-    }
-
+    *ifInUcastPkts_val_ptr = ifmib_interface_stats(idl, interface_row)->rx_packets;
 }
 
 void ifInNUcastPkts_custom_function(const struct ovsdb_idl *idl,
@@ -216,43 +202,13 @@ void ifInNUcastPkts_custom_function(const struct ovsdb_idl *idl,
 void ifInDiscards_custom_function(const struct ovsdb_idl *idl,
                                   const struct ovsrec_interface *interface_row,
                                   unsigned long *ifInDiscards_val_ptr){
-    const struct ovsdb_datum *datum;
-    union ovsdb_atom atom;
-    unsigned int index;
-
-    datum = ovsrec_interface_get_statistics(interface_row,
-                OVSDB_TYPE_STRING, OVSDB_TYPE_INTEGER);
-    if (NULL==datum)
-        *ifInDiscards_val_ptr = 0;
-    else {
-        atom.string = interface_statistics_keys[4];
-        index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-        *ifInDiscards_val_ptr = (index == UINT_MAX)? 0 :
-                                 datum->values[index].integer;
-    }
-
-
+    *ifInDiscards_val_ptr = ifmib_interface_stats(idl, interface_row)->rx_dropped;
 }
 
 void ifInErrors_custom_function(const struct ovsdb_idl *idl,
                                 const struct ovsrec_interface *interface_row,
                                 unsigned long *ifInErrors_val_ptr){
-    const struct ovsdb_datum *datum;
-    union ovsdb_atom atom;
-    unsigned int index;
-
-    datum = ovsrec_interface_get_statistics(interface_row,
-                OVSDB_TYPE_STRING, OVSDB_TYPE_INTEGER);
-    if (NULL==datum)
-        *ifInErrors_val_ptr = 0;
-    else {
-        atom.string = interface_statistics_keys[8];
-        index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-        *ifInErrors_val_ptr = (index == UINT_MAX)? 0 :
-                               datum->values[index].integer;
-    }
-
-
+    *ifInErrors_val_ptr = ifmib_interface_stats(idl, interface_row)->rx_errors;
 }
 
 void ifInUnknownProtos_custom_function(
@@ -265,45 +221,13 @@ void ifInUnknownProtos_custom_function(
 void ifOutOctets_custom_function(const struct ovsdb_idl *idl,
                                  const struct ovsrec_interface *interface_row,
                                  unsigned long *ifOutOctets_val_ptr){
-    const struct ovsdb_datum *datum;
-    union ovsdb_atom atom;
-    unsigned int index;
-
-    datum = ovsrec_interface_get_statistics(interface_row,
-                OVSDB_TYPE_STRING, OVSDB_TYPE_INTEGER);
-    if (NULL==datum)
-        *ifOutOctets_val_ptr = 0;
-    else {
-        atom.string = interface_statistics_keys[3];
-        index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-        *ifOutOctets_val_ptr = (index == UINT_MAX)? 0 :
-                                datum->values[index].integer;
-    }
-
-
-
+    *ifOutOctets_val_ptr = ifmib_interface_stats(idl, interface_row)->tx_bytes;
 }
 
 void ifOutUcastPkts_custom_function(const struct ovsdb_idl *idl,
                                     const struct ovsrec_interface *interface_row,
                                     unsigned long *ifOutUcastPkts_val_ptr){
-    const struct ovsdb_datum *datum;
-    union ovsdb_atom atom;
-    unsigned int index;
-
-    datum = ovsrec_interface_get_statistics(interface_row,
-                OVSDB_TYPE_STRING, OVSDB_TYPE_INTEGER);
-    if (NULL==datum)
-        *ifOutUcastPkts_val_ptr = 0;
-    else {
-        atom.string = interface_statistics_keys[2];
-        index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-        *ifOutUcastPkts_val_ptr = (index == UINT_MAX)? 0 :
-                                   datum->values[index].integer;
-    }
-
-
-
+    *ifOutUcastPkts_val_ptr = ifmib_interface_stats(idl, interface_row)->tx_packets;
 }
 
 void ifOutNUcastPkts_custom_function(const struct ovsdb_idl *idl,
@@ -315,42 +239,13 @@ void ifOutNUcastPkts_custom_function(const struct ovsdb_idl *idl,
 void ifOutDiscards_custom_function(const struct ovsdb_idl *idl,
                                    const struct ovsrec_interface *interface_row,
                                    unsigned long *ifOutDiscards_val_ptr){
-    const struct ovsdb_datum *datum;
-    union ovsdb_atom atom;
-    unsigned int index;
-
-    datum = ovsrec_interface_get_statistics(interface_row,
-                OVSDB_TYPE_STRING,
-                OVSDB_TYPE_INTEGER);
-    if (NULL==datum)
-        *ifOutDiscards_val_ptr = 0;
-    else {
-        atom.string = interface_statistics_keys[9];
-        index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-        *ifOutDiscards_val_ptr = (index == UINT_MAX)? 0 :
-                                  datum->values[index].integer;
-    }
-
-
+    *ifOutDiscards_val_ptr = ifmib_interface_stats(idl, interface_row)->tx_dropped;
 }
 
 void ifOutErrors_custom_function(const struct ovsdb_idl *idl,
                                  const struct ovsrec_interface *interface_row,
                                  unsigned long *ifOutErrors_val_ptr){
-    const struct ovsdb_datum *datum;
-    union ovsdb_atom atom;
-    unsigned int index;
-
-    datum = ovsrec_interface_get_statistics(interface_row,
-                OVSDB_TYPE_STRING, OVSDB_TYPE_INTEGER);
-    if (NULL==datum)
-        *ifOutErrors_val_ptr = 0;
-    else {
-        atom.string = interface_statistics_keys[11];
-        index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-        *ifOutErrors_val_ptr = (index == UINT_MAX)? 0 :
-                                datum->values[index].integer;
-    }
+    *ifOutErrors_val_ptr = ifmib_interface_stats(idl, interface_row)->tx_errors;
 }
 
 
@@ -383,48 +278,20 @@ void ifHCInOctets_custom_function(
     const struct ovsdb_idl *idl,
     const struct ovsrec_interface *interface_row,
     U64 *ifHCInOctets_val_ptr){
-    const struct ovsdb_datum *datum;
-    union ovsdb_atom atom;
-    unsigned int index;
-    datum = ovsrec_interface_get_statistics(interface_row,
-                OVSDB_TYPE_STRING, OVSDB_TYPE_INTEGER);
-    if (NULL==datum){
-        ifHCInOctets_val_ptr->high = 0;
-        ifHCInOctets_val_ptr->low = 0;
-    }
-    else {
-        atom.string = interface_statistics_keys[1];
-        index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-        ifHCInOctets_val_ptr->high = (index == UINT_MAX)? 0 :
-                                ((datum->values[index].integer & 0xffffffff00000000)>>32);
-        ifHCInOctets_val_ptr->low = (index == UINT_MAX)? 0 :
-                                (datum->values[index].integer & 0x00000000ffffffff);
-    }
+    uint64_t value = ifmib_interface_stats(idl, interface_row)->rx_bytes;
 
+    ifHCInOctets_val_ptr->high = value >> 32;
+    ifHCInOctets_val_ptr->low = value & 0xffffffff;
 }
 
 void ifHCInUcastPkts_custom_function(
     const struct ovsdb_idl *idl,
     const struct ovsrec_interface *interface_row,
     U64 *ifHCInUcastPkts_val_ptr){
-    const struct ovsdb_datum *datum;
-    union ovsdb_atom atom;
-    unsigned int index;
-
-    datum = ovsrec_interface_get_statistics(interface_row, OVSDB_TYPE_STRING,
-                                            OVSDB_TYPE_INTEGER);
-    if (NULL==datum){
-         ifHCInUcastPkts_val_ptr->high = 0;
-         ifHCInUcastPkts_val_ptr->low = 0;
-    }
-    else {
-        atom.string = interface_statistics_keys[0];
-        index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-        ifHCInUcastPkts_val_ptr->high = (index == UINT_MAX)? 0 :
-                                ((datum->values[index].integer & 0xffffffff00000000)>>32);
-        ifHCInUcastPkts_val_ptr->low = (index == UINT_MAX)? 0 :
-                                (datum->values[index].integer & 0x00000000ffffffff);
-    }
+    uint64_t value = ifmib_interface_stats(idl, interface_row)->rx_packets;
+
+    ifHCInUcastPkts_val_ptr->high = value >> 32;
+    ifHCInUcastPkts_val_ptr->low = value & 0xffffffff;
 }
 
 void ifHCInMulticastPkts_custom_function(
@@ -447,48 +314,20 @@ void ifHCOutOctets_custom_function(
     const struct ovsdb_idl *idl,
     const struct ovsrec_interface *interface_row,
     U64 *ifHCOutOctets_val_ptr){
-    const struct ovsdb_datum *datum;
-    union ovsdb_atom atom;
-    unsigned int index;
-
-    datum = ovsrec_interface_get_statistics(interface_row,
-                OVSDB_TYPE_STRING, OVSDB_TYPE_INTEGER);
-    if (NULL==datum){
-        ifHCOutOctets_val_ptr->high = 0;
-        ifHCOutOctets_val_ptr->low = 0;
-    }
-    else {
-        atom.string = interface_statistics_keys[3];
-        index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-        ifHCOutOctets_val_ptr->high = (index == UINT_MAX)? 0 :
-                                ((datum->values[index].integer & 0xffffffff00000000)>>32);
-        ifHCOutOctets_val_ptr->low = (index == UINT_MAX)? 0 :
-                                (datum->values[index].integer & 0x00000000ffffffff);
-    }
+    uint64_t value = ifmib_interface_stats(idl, interface_row)->tx_bytes;
+
+    ifHCOutOctets_val_ptr->high = value >> 32;
+    ifHCOutOctets_val_ptr->low = value & 0xffffffff;
 }
 
 void ifHCOutUcastPkts_custom_function(
     const struct ovsdb_idl *idl,
     const struct ovsrec_interface *interface_row,
     U64 *ifHCOutUcastPkts_val_ptr){
-    const struct ovsdb_datum *datum;
-    union ovsdb_atom atom;
-    unsigned int index;
-
-    datum = ovsrec_interface_get_statistics(interface_row,
-                OVSDB_TYPE_STRING, OVSDB_TYPE_INTEGER);
-    if (NULL==datum){
-        ifHCOutUcastPkts_val_ptr->high = 0;
-        ifHCOutUcastPkts_val_ptr->low = 0;
-    }
-    else {
-        atom.string = interface_statistics_keys[2];
-        index = ovsdb_datum_find_key(datum, &atom, OVSDB_TYPE_STRING);
-        ifHCOutUcastPkts_val_ptr->high = (index == UINT_MAX)? 0 :
-                                ((datum->values[index].integer & 0xffffffff00000000)>>32);
-        ifHCOutUcastPkts_val_ptr->low = (index == UINT_MAX)? 0 :
-                                (datum->values[index].integer & 0x00000000ffffffff);
-    }
+    uint64_t value = ifmib_interface_stats(idl, interface_row)->tx_packets;
+
+    ifHCOutUcastPkts_val_ptr->high = value >> 32;
+    ifHCOutUcastPkts_val_ptr->low = value & 0xffffffff;
 }
 
 void ifHCOutMulticastPkts_custom_function(
@@ -530,7 +369,12 @@ void ifLinkUpDownTrapEnable_custom_function(
     const struct ovsdb_idl *idl,
     const struct ovsrec_interface *interface_row,
     long *ifLinkUpDownTrapEnable_val_ptr){
-    *ifLinkUpDownTrapEnable_val_ptr = 0;
+    /* RFC 2863 default: disabled on the interfaces that run on top of
+     * another one, here the subinterfaces. */
+    if (strchr(interface_row->name, '.') != NULL)
+        *ifLinkUpDownTrapEnable_val_ptr = IFLINKUPDOWNTRAPENABLE_DISABLED;
+    else
+        *ifLinkUpDownTrapEnable_val_ptr = IFLINKUPDOWNTRAPENABLE_ENABLED;
 }
 
 void ifConnectorPresent_custom_function(
@@ -542,3 +386,62 @@ void ifConnectorPresent_custom_function(
     else
         *ifConnectorPresent_val_ptr = 2;
 }
+
+void ifAlias_custom_function(const struct ovsdb_idl *idl,
+                             const struct ovsrec_interface *interface_row,
+                             char *ifAlias_val_ptr,
+                             size_t *ifAlias_val_ptr_len) {
+    const char *alias = smap_get(&interface_row->user_config,
+                                 IF_MIB_USER_CONFIG_MAP_DESCRIPTION);
+
+    *ifAlias_val_ptr_len = 0;
+    if (alias != NULL) {
+        *ifAlias_val_ptr_len = MIN(strlen(alias), IF_MIB_ALIAS_MAX_LENGTH);
+        memcpy(ifAlias_val_ptr, alias, *ifAlias_val_ptr_len);
+    }
+}
+
+/* The set functions write into the transaction of the SET request, see
+ * IF_MIB_txn.h. */
+
+void ifAdminStatus_custom_set(const struct ovsdb_idl *idl,
+                              const struct ovsrec_interface *interface_row,
+                              long ifAdminStatus_val) {
+    const struct ovsrec_port *port_row;
+    struct smap user_config;
+    int up = ifAdminStatus_val == IFADMINSTATUS_UP;
+
+    /* What "[no] shutdown" does. */
+    smap_clone(&user_config, &interface_row->user_config);
+    smap_replace(&user_config, INTERFACE_USER_CONFIG_MAP_ADMIN,
+                 up ? OVSREC_INTERFACE_USER_CONFIG_ADMIN_UP
+                    : OVSREC_INTERFACE_USER_CONFIG_ADMIN_DOWN);
+    ovsrec_interface_set_user_config(interface_row, &user_config);
+    smap_destroy(&user_config);
+
+    port_row = if_mib_txn_port_find(interface_row->name);
+    if (port_row != NULL) {
+        ovsrec_port_set_admin(port_row,
+                              up ? OVSREC_INTERFACE_ADMIN_STATE_UP
+                                 : OVSREC_INTERFACE_ADMIN_STATE_DOWN);
+    }
+}
+
+void ifAlias_custom_set(const struct ovsdb_idl *idl,
+                        const struct ovsrec_interface *interface_row,
+                        const char *ifAlias_val_ptr,
+                        size_t ifAlias_val_ptr_len) {
+    struct smap user_config;
+    char *alias;
+
+    smap_clone(&user_config, &interface_row->user_config);
+    if (ifAlias_val_ptr_len == 0) {
+        smap_remove(&user_config, IF_MIB_USER_CONFIG_MAP_DESCRIPTION);
+    } else {
+        alias = xmemdup0(ifAlias_val_ptr, ifAlias_val_ptr_len);
+        smap_replace(&user_config, IF_MIB_USER_CONFIG_MAP_DESCRIPTION, alias);
+        free(alias);
+    }
+    ovsrec_interface_set_user_config(interface_row, &user_config);
+    smap_destroy(&user_config);
+}
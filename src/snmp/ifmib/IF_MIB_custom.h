@@ -8,6 +8,13 @@
 #define MAX_ADMIN_STATE_LENGTH 8
 #define MAX_LINK_STATE_LENGTH 8
 #define MAC_ADDRESS_OCTATES 6
+
+/* The internal interface of the default bridge, which has no ifIndex. */
+#define IF_MIB_BRIDGE_NORMAL "bridge_normal"
+
+/* The user_config key ifAlias is kept in, and its longest value. */
+#define IF_MIB_USER_CONFIG_MAP_DESCRIPTION "description"
+#define IF_MIB_ALIAS_MAX_LENGTH 64
 int ifTable_skip_function(const struct ovsdb_idl *idl,
                           const struct ovsrec_interface *interface_row);
 
@@ -190,3 +197,12 @@ void ifAlias_custom_function(
 void ifCounterDiscontinuityTime_custom_function(
     const struct ovsdb_idl *idl, const struct ovsrec_interface *interface_row,
     long *ifCounterDiscontinuityTime_val_ptr);
+
+void ifAdminStatus_custom_set(const struct ovsdb_idl *idl,
+                              const struct ovsrec_interface *interface_row,
+                              long ifAdminStatus_val);
+
+void ifAlias_custom_set(const struct ovsdb_idl *idl,
+                        const struct ovsrec_interface *interface_row,
+                        const char *ifAlias_val_ptr,
+                        size_t ifAlias_val_ptr_len);
@@ -0,0 +1,238 @@
+#include <net-snmp/net-snmp-config.h>
+#include <net-snmp/net-snmp-features.h>
+#include <net-snmp/net-snmp-includes.h>
+#include <net-snmp/agent/net-snmp-agent-includes.h>
+#include "IF_MIB_custom.h"
+#include "IF_MIB_notifications.h"
+#include "ifTable.h"
+#include "ifTable_data_access.h"
+#include "ifXTable_enums.h"
+#include "ifindex_registry.h"
+#include "hash.h"
+#include "hmap.h"
+#include "util.h"
+#include "uuid.h"
+
+/* What the last change of an Interface row left in the IF-MIB. */
+struct if_link_entry {
+    struct hmap_node node;          /* In if_link_entries, by uuid. */
+    struct uuid uuid;
+    long ifAdminStatus;
+    long ifOperStatus;
+    u_long ifLastChange;            /* sysUpTime, 0 since snmpd started. */
+    unsigned int generation;        /* Last pass that saw the row. */
+};
+
+static struct hmap if_link_entries = HMAP_INITIALIZER(&if_link_entries);
+
+static unsigned int if_link_seqno;
+static unsigned int if_link_generation;
+
+/* Whether a pass saw any row.  The rows the first one finds have been in
+ * their state since before snmpd started, later ones were just added. */
+static bool if_link_loaded;
+
+static const oid linkDown_oid[] = { 1, 3, 6, 1, 6, 3, 1, 1, 5, 3 };
+static const oid linkUp_oid[] = { 1, 3, 6, 1, 6, 3, 1, 1, 5, 4 };
+
+static int send_link_trap(const oid *trap_oid, size_t trap_oid_len,
+                          long ifIndex, long ifAdminStatus,
+                          long ifOperStatus) {
+    netsnmp_variable_list *var_list = NULL;
+    oid ifIndex_oid[] = { 1, 3, 6, 1, 2, 1, 2, 2, 1, 1, 0 };
+    oid ifAdminStatus_oid[] = { 1, 3, 6, 1, 2, 1, 2, 2, 1, 7, 0 };
+    oid ifOperStatus_oid[] = { 1, 3, 6, 1, 2, 1, 2, 2, 1, 8, 0 };
+
+    ifIndex_oid[OID_LENGTH(ifIndex_oid) - 1] = ifIndex;
+    ifAdminStatus_oid[OID_LENGTH(ifAdminStatus_oid) - 1] = ifIndex;
+    ifOperStatus_oid[OID_LENGTH(ifOperStatus_oid) - 1] = ifIndex;
+
+    snmp_varlist_add_variable(&var_list, snmptrap_oid, snmptrap_oid_len,
+                              ASN_OBJECT_ID, trap_oid,
+                              trap_oid_len * sizeof(oid));
+    snmp_varlist_add_variable(&var_list, ifIndex_oid,
+                              OID_LENGTH(ifIndex_oid), ASN_INTEGER,
+                              &ifIndex, sizeof(ifIndex));
+    snmp_varlist_add_variable(&var_list, ifAdminStatus_oid,
+                              OID_LENGTH(ifAdminStatus_oid), ASN_INTEGER,
+                              &ifAdminStatus, sizeof(ifAdminStatus));
+    snmp_varlist_add_variable(&var_list, ifOperStatus_oid,
+                              OID_LENGTH(ifOperStatus_oid), ASN_INTEGER,
+                              &ifOperStatus, sizeof(ifOperStatus));
+
+    send_v2trap(var_list);
+    snmp_free_varbind(var_list);
+    return SNMP_ERR_NOERROR;
+}
+
+int send_linkDown_trap(long ifIndex, long ifAdminStatus, long ifOperStatus) {
+    DEBUGMSGTL(("IF-MIB:notifications", "linkDown for ifIndex %ld\n",
+                ifIndex));
+    return send_link_trap(linkDown_oid, OID_LENGTH(linkDown_oid), ifIndex,
+                          ifAdminStatus, ifOperStatus);
+}
+
+int send_linkUp_trap(long ifIndex, long ifAdminStatus, long ifOperStatus) {
+    DEBUGMSGTL(("IF-MIB:notifications", "linkUp for ifIndex %ld\n",
+                ifIndex));
+    return send_link_trap(linkUp_oid, OID_LENGTH(linkUp_oid), ifIndex,
+                          ifAdminStatus, ifOperStatus);
+}
+
+static struct if_link_entry *if_link_entry_find(const struct uuid *uuid) {
+    struct if_link_entry *entry;
+
+    HMAP_FOR_EACH_WITH_HASH(entry, node, uuid_hash(uuid), &if_link_entries) {
+        if (uuid_equals(&entry->uuid, uuid)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void if_link_status_get(const struct ovsrec_interface *interface_row,
+                               long *ifAdminStatus, long *ifOperStatus) {
+    *ifAdminStatus = IFADMINSTATUS_DOWN;
+    *ifOperStatus = IFOPERSTATUS_DOWN;
+    if (interface_row->admin_state != NULL) {
+        ifAdminStatus_custom_function(idl, interface_row, ifAdminStatus);
+    }
+    ifOperStatus_custom_function(idl, interface_row, ifOperStatus);
+}
+
+/* Writes the new status into the ifTable row, so it is served before the
+ * next counters refresh. */
+static void if_link_row_update(const struct if_link_entry *entry,
+                               long ifIndex) {
+    ifTable_mib_index mib_idx;
+    ifTable_rowreq_ctx *rowreq_ctx;
+
+    mib_idx.ifIndex = ifIndex;
+    rowreq_ctx = ifTable_row_find_by_mib_index(&mib_idx);
+    if (rowreq_ctx != NULL && uuid_equals(&rowreq_ctx->uuid, &entry->uuid)) {
+        rowreq_ctx->data.ifAdminStatus = entry->ifAdminStatus;
+        rowreq_ctx->data.ifOperStatus = entry->ifOperStatus;
+        rowreq_ctx->data.ifLastChange = entry->ifLastChange;
+    }
+}
+
+static void if_link_entry_update(struct if_link_entry *entry,
+                                 const struct ovsrec_interface *interface_row,
+                                 u_long now) {
+    long ifAdminStatus, ifOperStatus, old_ifOperStatus, trap_enable, ifIndex;
+
+    if_link_status_get(interface_row, &ifAdminStatus, &ifOperStatus);
+    if (ifAdminStatus == entry->ifAdminStatus &&
+        ifOperStatus == entry->ifOperStatus) {
+        return;
+    }
+
+    old_ifOperStatus = entry->ifOperStatus;
+    entry->ifAdminStatus = ifAdminStatus;
+    if (ifOperStatus != old_ifOperStatus) {
+        entry->ifOperStatus = ifOperStatus;
+        entry->ifLastChange = now;
+    }
+
+    ifIndex = ifindex_registry_get(interface_row->name);
+    if (ifIndex == 0) {
+        return;
+    }
+    if_link_row_update(entry, ifIndex);
+    if (ifOperStatus == old_ifOperStatus) {
+        return;
+    }
+
+    ifLinkUpDownTrapEnable_custom_function(idl, interface_row, &trap_enable);
+    if (trap_enable != IFLINKUPDOWNTRAPENABLE_ENABLED) {
+        return;
+    }
+    /* RFC 2863: not for the transitions from or to notPresent. */
+    if (ifOperStatus == IFOPERSTATUS_DOWN &&
+        old_ifOperStatus != IFOPERSTATUS_NOTPRESENT) {
+        send_linkDown_trap(ifIndex, ifAdminStatus, ifOperStatus);
+    } else if (old_ifOperStatus == IFOPERSTATUS_DOWN &&
+               ifOperStatus != IFOPERSTATUS_NOTPRESENT) {
+        send_linkUp_trap(ifIndex, ifAdminStatus, ifOperStatus);
+    }
+}
+
+void if_mib_link_run(void) {
+    const struct ovsrec_interface *interface_row;
+    struct if_link_entry *entry, *next;
+    unsigned int seqno = ovsdb_idl_get_seqno(idl);
+    bool seen = false;
+    u_long now;
+
+    if (seqno == if_link_seqno) {
+        return;
+    }
+
+    /* Most changes are statistics updates, every few seconds: only look at
+     * the rows when a row or one of the two columns changed. */
+    interface_row = ovsrec_interface_first(idl);
+    if (if_link_loaded && interface_row != NULL &&
+        !OVSREC_IDL_ANY_TABLE_ROWS_INSERTED(interface_row, if_link_seqno) &&
+        !OVSREC_IDL_ANY_TABLE_ROWS_DELETED(interface_row, if_link_seqno) &&
+        !OVSREC_IDL_IS_COLUMN_MODIFIED(ovsrec_interface_col_link_state,
+                                       if_link_seqno) &&
+        !OVSREC_IDL_IS_COLUMN_MODIFIED(ovsrec_interface_col_admin_state,
+                                       if_link_seqno)) {
+        if_link_seqno = seqno;
+        return;
+    }
+
+    now = netsnmp_get_agent_uptime();
+    if_link_generation++;
+    OVSREC_INTERFACE_FOR_EACH(interface_row, idl) {
+        if (ifTable_skip_function(idl, interface_row)) {
+            continue;
+        }
+        entry = if_link_entry_find(&interface_row->header_.uuid);
+        if (entry == NULL) {
+            entry = xzalloc(sizeof *entry);
+            entry->uuid = interface_row->header_.uuid;
+            if_link_status_get(interface_row, &entry->ifAdminStatus,
+                               &entry->ifOperStatus);
+            entry->ifLastChange = if_link_loaded ? now : 0;
+            hmap_insert(&if_link_entries, &entry->node,
+                        uuid_hash(&entry->uuid));
+        } else if (OVSREC_IDL_IS_ROW_MODIFIED(interface_row, if_link_seqno)) {
+            if_link_entry_update(entry, interface_row, now);
+        }
+        entry->generation = if_link_generation;
+        seen = true;
+    }
+
+    HMAP_FOR_EACH_SAFE(entry, next, node, &if_link_entries) {
+        if (entry->generation != if_link_generation) {
+            hmap_remove(&if_link_entries, &entry->node);
+            free(entry);
+        }
+    }
+
+    if (seen) {
+        if_link_loaded = true;
+    }
+    if_link_seqno = seqno;
+}
+
+u_long if_mib_link_last_change(const struct ovsrec_interface *interface_row) {
+    const struct if_link_entry *entry;
+
+    entry = if_link_entry_find(&interface_row->header_.uuid);
+    return entry != NULL ? entry->ifLastChange : 0;
+}
+
+void if_mib_link_destroy(void) {
+    struct if_link_entry *entry, *next;
+
+    HMAP_FOR_EACH_SAFE(entry, next, node, &if_link_entries) {
+        hmap_remove(&if_link_entries, &entry->node);
+        free(entry);
+    }
+    hmap_destroy(&if_link_entries);
+    hmap_init(&if_link_entries);
+    if_link_loaded = false;
+    if_link_seqno = 0;
+}
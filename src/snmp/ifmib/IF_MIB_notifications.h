@@ -0,0 +1,20 @@
+#ifndef IF_MIB_NOTIFICATIONS_H
+#define IF_MIB_NOTIFICATIONS_H
+
+#include "vswitch-idl.h"
+#include "ovsdb-idl.h"
+
+/* Follows the link_state and admin_state columns of the Interface rows
+ * from one IDL change to the next, records ifLastChange and sends linkUp
+ * and linkDown.  Called from ops_snmp_run() after each run of the IDL. */
+void if_mib_link_run(void);
+void if_mib_link_destroy(void);
+
+/* Returns the sysUpTime at which 'interface_row' entered its current
+ * ifOperStatus, or 0 if it has not changed since snmpd started. */
+u_long if_mib_link_last_change(const struct ovsrec_interface *interface_row);
+
+int send_linkDown_trap(long ifIndex, long ifAdminStatus, long ifOperStatus);
+int send_linkUp_trap(long ifIndex, long ifAdminStatus, long ifOperStatus);
+
+#endif
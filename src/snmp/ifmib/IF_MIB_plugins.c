@@ -3,19 +3,105 @@
 #include <net-snmp/net-snmp-includes.h>
 #include <net-snmp/agent/net-snmp-agent-includes.h>
 #include "IF_MIB_plugins.h"
+#include "IF_MIB_notifications.h"
 #include "IF_MIB_scalars.h"
 #include "ifTable.h"
 #include "ifXTable.h"
+#include "mib_refresh.h"
+#include "ifindex_registry.h"
+
+#include "compiler.h"
+#include "dynamic-string.h"
+#include "unixctl.h"
+
+/* "if-mib/refresh": the age of the snapshots served by the tables and the
+ * cost of building them. */
+static void if_mib_unixctl_refresh(struct unixctl_conn *conn,
+                                   int argc OVS_UNUSED,
+                                   const char *argv[] OVS_UNUSED,
+                                   void *aux OVS_UNUSED) {
+    struct ds ds = DS_EMPTY_INITIALIZER;
+
+    mib_refresh_format_header(&ds);
+    mib_refresh_format(&ifTable_refresh, &ds);
+    mib_refresh_format(&ifTable_counters_refresh, &ds);
+    mib_refresh_format(&ifXTable_refresh, &ds);
+    mib_refresh_format(&ifXTable_counters_refresh, &ds);
+    unixctl_command_reply(conn, ds_cstr(&ds));
+    ds_destroy(&ds);
+}
+
+/* snmpd.conf tokens for the intervals of the refreshes of both tables:
+ * "ifMibStaticTimeout SECONDS" for the rows and their static columns and
+ * "ifMibCountersTimeout SECONDS" for the counter columns. */
+static void if_mib_parse_timeout(const char *token, char *line) {
+    int counters = !strcmp(token, "ifMibCountersTimeout");
+    long seconds;
+    char *end;
+
+    seconds = strtol(line, &end, 10);
+    if (end == line || *end != '\0' ||
+        !mib_refresh_set_interval(counters ? &ifTable_counters_refresh
+                                           : &ifTable_refresh, seconds) ||
+        !mib_refresh_set_interval(counters ? &ifXTable_counters_refresh
+                                           : &ifXTable_refresh, seconds)) {
+        config_perror("the timeout must be from 1 to 3600 seconds");
+    }
+}
+
+/* "ifMibColumnarCounters yes|no": serve the counter columns of both tables
+ * from columnar snapshots, see mib_columns.h. */
+static void if_mib_parse_columnar(const char *token, char *line) {
+    bool enable;
+
+    if (!strcmp(line, "yes")) {
+        enable = true;
+    } else if (!strcmp(line, "no")) {
+        enable = false;
+    } else {
+        config_perror("expected yes or no");
+        return;
+    }
+    ifTable_columns_enable(enable);
+    ifXTable_columns_enable(enable);
+}
 
 void ops_snmp_init(void) {
+    init_IF_MIB_scalars();
+    init_ifTable();
+    init_ifXTable();
+    unixctl_command_register("if-mib/refresh", "", 0, 0,
+                             if_mib_unixctl_refresh, NULL);
+    register_app_config_handler("ifMibStaticTimeout", if_mib_parse_timeout,
+                                NULL, "SECONDS");
+    register_app_config_handler("ifMibCountersTimeout", if_mib_parse_timeout,
+                                NULL, "SECONDS");
+    register_app_config_handler("ifMibColumnarCounters",
+                                if_mib_parse_columnar, NULL, "yes|no");
+}
+
+/* Sends the linkUp and linkDown of the last IDL changes, then builds the
+ * next snapshot of the tables a slice at a time, so requests are served
+ * from a ready one, and saves the ifIndex values given out meanwhile. */
+void ops_snmp_run(void) {
+    if_mib_link_run();
+    mib_refresh_run(&ifTable_refresh);
+    mib_refresh_run(&ifTable_counters_refresh);
+    mib_refresh_run(&ifXTable_refresh);
+    mib_refresh_run(&ifXTable_counters_refresh);
+    ifindex_registry_flush();
+}
 
-init_ifTable();
-init_ifXTable();
+void ops_snmp_wait(void) {
+    mib_refresh_wait(&ifTable_refresh);
+    mib_refresh_wait(&ifTable_counters_refresh);
+    mib_refresh_wait(&ifXTable_refresh);
+    mib_refresh_wait(&ifXTable_counters_refresh);
 }
 
-void ops_snmp_run(void){}
-void ops_snmp_wait(void){}
-void ops_snmp_destroy(void){
-shutdown_ifTable();
-shutdown_ifXTable();
+void ops_snmp_destroy(void) {
+    shutdown_ifTable();
+    shutdown_ifXTable();
+    if_mib_link_destroy();
+    ifindex_registry_destroy();
 }
@@ -6,3 +6,38 @@
 #include "IF_MIB_scalars_ovsdb_get.h"
 #include "ovsdb-idl.h"
 #include "vswitch-idl.h"
+
+/* sysUpTime of the last creation or deletion of an ifTable row, 0 if
+ * there was none since snmpd started. */
+static u_long ifTableLastChange;
+
+void ifTableLastChange_update(void) {
+    ifTableLastChange = netsnmp_get_agent_uptime();
+}
+
+int handler_ifTableLastChange(netsnmp_mib_handler *handler,
+                              netsnmp_handler_registration *reginfo,
+                              netsnmp_agent_request_info *reqinfo,
+                              netsnmp_request_info *requests) {
+    switch (reqinfo->mode) {
+    case MODE_GET:
+        snmp_set_var_typed_value(requests->requestvb, ASN_TIMETICKS,
+                                 &ifTableLastChange,
+                                 sizeof(ifTableLastChange));
+        break;
+    default:
+        snmp_log(LOG_ERR,
+                 "unknown mode (%d) in handler_ifTableLastChange\n",
+                 reqinfo->mode);
+        return SNMP_ERR_GENERR;
+    }
+    return SNMP_ERR_NOERROR;
+}
+
+void init_IF_MIB_scalars(void) {
+    const oid ifTableLastChange_oid[] = { 1, 3, 6, 1, 2, 1, 31, 1, 5 };
+
+    netsnmp_register_scalar(netsnmp_create_handler_registration(
+        "ifTableLastChange", handler_ifTableLastChange, ifTableLastChange_oid,
+        OID_LENGTH(ifTableLastChange_oid), HANDLER_CAN_RONLY));
+}
@@ -1,3 +1,11 @@
 #ifndef IF_MIB_H
 #define IF_MIB_H
-#endif
\ No newline at end of file
+
+void init_IF_MIB_scalars(void);
+
+/* Sets ifTableLastChange to the current sysUpTime. */
+void ifTableLastChange_update(void);
+
+Netsnmp_Node_Handler handler_ifTableLastChange;
+
+#endif
@@ -0,0 +1,88 @@
+#include <net-snmp/net-snmp-config.h>
+#include <net-snmp/net-snmp-features.h>
+#include <net-snmp/net-snmp-includes.h>
+#include <net-snmp/agent/net-snmp-agent-includes.h>
+#include <net-snmp/agent/mfd.h>
+#include "IF_MIB_txn.h"
+#include "IF_MIB_scalars_ovsdb_get.h"
+#include "shash.h"
+#include "vswitch-idl.h"
+
+static struct ovsdb_idl_txn *if_mib_txn;
+
+/* Port rows by name, built by if_mib_txn_port_find() and dropped with the
+ * transaction, since the rows may go away once the IDL runs again. */
+static struct shash if_mib_txn_ports = SHASH_INITIALIZER(&if_mib_txn_ports);
+static bool if_mib_txn_ports_built;
+
+static void if_mib_txn_ports_clear(void) {
+    shash_clear(&if_mib_txn_ports);
+    if_mib_txn_ports_built = false;
+}
+
+/* Rows of the request that have not been through the irreversible commit
+ * step yet. */
+static int if_mib_txn_rows;
+
+void if_mib_txn_begin(void) {
+    if_mib_txn_abort();
+    if_mib_txn_rows = 0;
+}
+
+void if_mib_txn_row_add(void) {
+    if_mib_txn_rows++;
+}
+
+struct ovsdb_idl_txn *if_mib_txn_get(void) {
+    if (if_mib_txn == NULL) {
+        if_mib_txn = ovsdb_idl_txn_create(idl);
+        if (if_mib_txn == NULL) {
+            snmp_log(LOG_ERR, "could not create an OVSDB transaction\n");
+        }
+    }
+    return if_mib_txn;
+}
+
+int if_mib_txn_row_commit(void) {
+    enum ovsdb_idl_txn_status status;
+    int rc = MFD_SUCCESS;
+
+    if (--if_mib_txn_rows > 0) {
+        return MFD_SUCCESS;
+    }
+    if_mib_txn_rows = 0;
+    if (if_mib_txn == NULL) {
+        return MFD_ERROR;
+    }
+
+    status = ovsdb_idl_txn_commit_block(if_mib_txn);
+    if (status != TXN_SUCCESS && status != TXN_UNCHANGED) {
+        snmp_log(LOG_ERR, "OVSDB transaction failed: %s\n",
+                 ovsdb_idl_txn_status_to_string(status));
+        rc = MFD_ERROR;
+    }
+    ovsdb_idl_txn_destroy(if_mib_txn);
+    if_mib_txn = NULL;
+    if_mib_txn_ports_clear();
+    return rc;
+}
+
+void if_mib_txn_abort(void) {
+    if (if_mib_txn != NULL) {
+        ovsdb_idl_txn_destroy(if_mib_txn);
+        if_mib_txn = NULL;
+    }
+    if_mib_txn_ports_clear();
+}
+
+const struct ovsrec_port *if_mib_txn_port_find(const char *name) {
+    const struct ovsrec_port *port_row;
+
+    if (!if_mib_txn_ports_built) {
+        OVSREC_PORT_FOR_EACH(port_row, idl) {
+            shash_add_once(&if_mib_txn_ports, port_row->name, port_row);
+        }
+        if_mib_txn_ports_built = true;
+    }
+    return shash_find_data(&if_mib_txn_ports, name);
+}
@@ -0,0 +1,42 @@
+#ifndef IF_MIB_TXN_H
+#define IF_MIB_TXN_H
+
+#include "ovsdb-idl.h"
+
+/* One OVSDB transaction per SET request, for every row of ifTable and
+ * ifXTable it writes.
+ *
+ * net-snmp runs the MFD steps one table registration at a time, so the
+ * commit and irreversible commit steps of ifTable both run before the
+ * commit step of ifXTable.  The transaction therefore cannot be committed
+ * from the first irreversible commit.  Instead every row of the request
+ * is counted in its undo setup step, which runs for all registrations
+ * before any commit step, and the irreversible commit step of the last
+ * counted row commits the transaction once.  Until then, and if any
+ * varbind fails, the undo commit step drops the transaction and OVSDB is
+ * never written. */
+
+/* Called from the pre_request of both tables. */
+void if_mib_txn_begin(void);
+
+/* Counts a row of the request; called from the undo setup step. */
+void if_mib_txn_row_add(void);
+
+/* Returns the transaction of the request, or NULL if it cannot be
+ * created. */
+struct ovsdb_idl_txn *if_mib_txn_get(void);
+
+/* Called from the irreversible commit step of each counted row.  Commits
+ * the transaction once the last row of the request gets here, and returns
+ * MFD_SUCCESS before that; otherwise MFD_SUCCESS if the commit succeeded
+ * and MFD_ERROR if not. */
+int if_mib_txn_row_commit(void);
+
+void if_mib_txn_abort(void);
+
+/* Returns the Port named 'name', or NULL.  The ports are indexed by name
+ * on the first lookup of a request, so a request that sets ifAdminStatus
+ * on many rows scans the Port table once. */
+const struct ovsrec_port *if_mib_txn_port_find(const char *name);
+
+#endif
@@ -9,6 +9,7 @@
 #include "ifTable.h"
 #include "ifTable_interface.h"
 #include "ifTable_ovsdb_get.h"
+#include "IF_MIB_txn.h"
 
 const oid ifTable_oid[] = {IFTABLE_OID};
 const int ifTable_oid_size = OID_LENGTH(ifTable_oid);
@@ -51,6 +52,7 @@ void ifTable_rowreq_ctx_cleanup(ifTable_rowreq_ctx *rowreq_ctx) {
 
 int ifTable_pre_request(ifTable_registration *user_context) {
     DEBUGMSGTL(("verbose:ifTable:ifTable_pre_request", "called\n"));
+    if_mib_txn_begin();
     return MFD_SUCCESS;
 }
 
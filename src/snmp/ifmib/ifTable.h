@@ -3,6 +3,7 @@
 #include <net-snmp/library/asn1.h>
 #include "ifTable_oids.h"
 #include "ifTable_enums.h"
+#include "uuid.h"
 
 void init_ifTable(void);
 void shutdown_ifTable(void);
@@ -45,6 +46,13 @@ typedef struct ifTable_rowreq_ctx_s {
     ifTable_data data;
     u_int rowreq_flags;
     netsnmp_data_list *ifTable_data_list;
+    u_int load_generation;  /* Last snapshot that saw the row. */
+    struct uuid uuid;       /* Of the Interface row. */
+    char mac_in_use[18];    /* That ifPhysAddress was parsed from. */
+    ifTable_data *undo;          /* The data before a SET. */
+    u_int column_set_flags; /* Columns a SET wrote. */
+    u_int counters_generation;  /* Of the columnar snapshot that has it. */
+    size_t counters_ordinal;    /* Its row in that snapshot. */
 } ifTable_rowreq_ctx;
 
 typedef struct ifTable_ref_rowreq_ctx_s {
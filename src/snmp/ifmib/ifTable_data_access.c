@@ -6,12 +6,43 @@
 #include "ifTable.h"
 #include "ifTable_data_access.h"
 #include "ifTable_ovsdb_get.h"
+#include "IF_MIB_scalars.h"
+#include "mib_columns.h"
+#include "mib_refresh.h"
+#include "ifindex_registry.h"
 
 #include "openswitch-idl.h"
 #include "ovsdb-idl.h"
 #include "vswitch-idl.h"
+#include "uuid.h"
 #include "openvswitch/vlog.h"
 
+/* With ifMibColumnarCounters, the counters refresh builds the next
+ * columnar snapshot in ifTable_columns_back and swaps it with the served
+ * one, instead of copying the counter columns into the rows. */
+static bool ifTable_columnar;
+static bool ifTable_columns_building;
+static struct mib_columns ifTable_columns =
+    MIB_COLUMNS_INITIALIZER(IFTABLE_N_COUNTERS);
+static struct mib_columns ifTable_columns_back =
+    MIB_COLUMNS_INITIALIZER(IFTABLE_N_COUNTERS);
+
+static void ifTable_columns_free(void) {
+    mib_columns_destroy(&ifTable_columns);
+    mib_columns_destroy(&ifTable_columns_back);
+}
+
+void ifTable_columns_enable(bool enable) {
+    ifTable_columnar = enable;
+}
+
+bool ifTable_counter_lookup(const ifTable_rowreq_ctx *rowreq_ctx,
+                            enum ifTable_counter counter, uint64_t *value) {
+    return ifTable_columnar &&
+           mib_columns_get(&ifTable_columns, rowreq_ctx->counters_generation,
+                           rowreq_ctx->counters_ordinal, counter, value);
+}
+
 int ifTable_init_data(ifTable_registration *ifTable_reg) {
     DEBUGMSGTL(("verbose:ifTable:ifTable_init_data", "called\n"));
     return MFD_SUCCESS;
@@ -29,7 +60,7 @@ void ifTable_container_init(netsnmp_container **container_ptr_ptr,
         snmp_log(LOG_ERR, "bad cache param to ifTable_container_init\n");
         return;
     }
-    cache->timeout = IFTABLE_CACHE_TIMEOUT;
+    cache->timeout = IFTABLE_COUNTERS_TIMEOUT;
 }
 
 void ifTable_container_shutdown(netsnmp_container *container_ptr) {
@@ -38,122 +69,470 @@ void ifTable_container_shutdown(netsnmp_container *container_ptr) {
         snmp_log(LOG_ERR, "bad params to ifTable_container_shutdown\n");
         return;
     }
+    ifTable_columns_free();
 }
 
-int ifTable_container_load(netsnmp_container *container) {
-    DEBUGMSGTL(("verbose:ifTable:ifTable_container_load", "called\n"));
+/* The container outlives each snapshot: the cache is created with
+ * NETSNMP_CACHE_DONT_FREE_BEFORE_LOAD, so publishing a snapshot only
+ * updates the rows in place.  Two refreshes with their own intervals share
+ * it:
+ *
+ * - ifTable_refresh inserts the rows of new interfaces, removes those of
+ *   deleted ones and re-derives the static columns of the rows whose source
+ *   columns changed.  ifTable_load_seqno is the IDL seqno when its previous
+ *   snapshot was begun and tells which rows changed since then.
+ *
+ * - ifTable_counters_refresh only re-reads the counter, speed and status
+ *   columns of the rows already in the container, so it can run every
+ *   second without parsing a MAC address. */
+static unsigned int ifTable_load_seqno;
+static unsigned int ifTable_load_generation;
+
+/* A back buffer, filled a slice at a time while the requests are served
+ * from the container. */
+struct ifTable_snapshot_row {
+    struct uuid uuid;
+    enum mib_refresh_row_state state;
+    ifTable_mib_index mib_idx;
+    ifTable_data data;
+    char mac_in_use[18];
+};
+
+struct ifTable_snapshot {
+    struct ifTable_snapshot_row *rows;
+    size_t n;
+    size_t allocated;
+};
+
+static struct ifTable_snapshot ifTable_static_snapshot;
+static struct ifTable_snapshot ifTable_counters_snapshot;
+static unsigned int ifTable_snapshot_seqno;
+static int ifTable_static_modified;
+
+static struct ifTable_snapshot_row *
+ifTable_snapshot_add(struct ifTable_snapshot *snapshot) {
+    if (snapshot->n == snapshot->allocated) {
+        size_t allocated = snapshot->allocated * 2 + 16;
+        struct ifTable_snapshot_row *rows;
+
+        rows = realloc(snapshot->rows, allocated * sizeof(*rows));
+        if (rows == NULL) {
+            snmp_log(LOG_ERR, "memory allocation failed");
+            return NULL;
+        }
+        snapshot->rows = rows;
+        snapshot->allocated = allocated;
+    }
+    return &snapshot->rows[snapshot->n++];
+}
+
+/* Columns that only change with the mtu and mac_in_use columns. */
+static void ifTable_static_columns_get(
+    const struct ovsrec_interface *interface_row, ifTable_data *data) {
+    ovsdb_get_ifDescr(idl, interface_row, data->ifDescr, &data->ifDescr_len);
+    ovsdb_get_ifType(idl, interface_row, &data->ifType);
+    ovsdb_get_ifMtu(idl, interface_row, &data->ifMtu);
+    ovsdb_get_ifPhysAddress(idl, interface_row, data->ifPhysAddress,
+                            &data->ifPhysAddress_len);
+    ovsdb_get_ifSpecific(idl, interface_row, data->ifSpecific,
+                         &data->ifSpecific_len);
+    data->ifSpecific_len *= sizeof(data->ifSpecific[0]);
+}
+
+/* Whether the mtu or mac_in_use of 'interface_row' differ from the values
+ * the static columns of 'rowreq_ctx' were derived from.  Only compares, so
+ * a statistics update does not parse the MAC address of every row. */
+static bool ifTable_static_source_changed(
+    const ifTable_rowreq_ctx *rowreq_ctx,
+    const struct ovsrec_interface *interface_row) {
+    const char *mac = interface_row->mac_in_use;
+    long mtu;
+
+    ovsdb_get_ifMtu(idl, interface_row, &mtu);
+    return mtu != rowreq_ctx->data.ifMtu ||
+           strlen(mac ? mac : "") >= sizeof(rowreq_ctx->mac_in_use) ||
+           strcmp(mac ? mac : "", rowreq_ctx->mac_in_use) != 0;
+}
+
+static void ifTable_static_columns_copy(ifTable_data *dst,
+                                        const ifTable_data *src) {
+    memcpy(dst->ifDescr, src->ifDescr, src->ifDescr_len);
+    dst->ifDescr_len = src->ifDescr_len;
+    dst->ifType = src->ifType;
+    dst->ifMtu = src->ifMtu;
+    memcpy(dst->ifPhysAddress, src->ifPhysAddress, src->ifPhysAddress_len);
+    dst->ifPhysAddress_len = src->ifPhysAddress_len;
+    memcpy(dst->ifSpecific, src->ifSpecific, src->ifSpecific_len);
+    dst->ifSpecific_len = src->ifSpecific_len;
+}
+
+static void ifTable_counter_columns_get(
+    const struct ovsrec_interface *interface_row, ifTable_data *data) {
+    ovsdb_get_ifSpeed(idl, interface_row, &data->ifSpeed);
+    ovsdb_get_ifInOctets(idl, interface_row, &data->ifInOctets);
+    ovsdb_get_ifInUcastPkts(idl, interface_row, &data->ifInUcastPkts);
+    ovsdb_get_ifInNUcastPkts(idl, interface_row, &data->ifInNUcastPkts);
+    ovsdb_get_ifInDiscards(idl, interface_row, &data->ifInDiscards);
+    ovsdb_get_ifInErrors(idl, interface_row, &data->ifInErrors);
+    ovsdb_get_ifInUnknownProtos(idl, interface_row, &data->ifInUnknownProtos);
+    ovsdb_get_ifOutOctets(idl, interface_row, &data->ifOutOctets);
+    ovsdb_get_ifOutUcastPkts(idl, interface_row, &data->ifOutUcastPkts);
+    ovsdb_get_ifOutNUcastPkts(idl, interface_row, &data->ifOutNUcastPkts);
+    ovsdb_get_ifOutDiscards(idl, interface_row, &data->ifOutDiscards);
+    ovsdb_get_ifOutErrors(idl, interface_row, &data->ifOutErrors);
+    ovsdb_get_ifOutQLen(idl, interface_row, &data->ifOutQLen);
+}
+
+static void ifTable_counter_columns_copy(ifTable_data *dst,
+                                         const ifTable_data *src) {
+    dst->ifSpeed = src->ifSpeed;
+    dst->ifInOctets = src->ifInOctets;
+    dst->ifInUcastPkts = src->ifInUcastPkts;
+    dst->ifInNUcastPkts = src->ifInNUcastPkts;
+    dst->ifInDiscards = src->ifInDiscards;
+    dst->ifInErrors = src->ifInErrors;
+    dst->ifInUnknownProtos = src->ifInUnknownProtos;
+    dst->ifOutOctets = src->ifOutOctets;
+    dst->ifOutUcastPkts = src->ifOutUcastPkts;
+    dst->ifOutNUcastPkts = src->ifOutNUcastPkts;
+    dst->ifOutDiscards = src->ifOutDiscards;
+    dst->ifOutErrors = src->ifOutErrors;
+    dst->ifOutQLen = src->ifOutQLen;
+}
+
+/* A row given to another interface must not serve the counters of the
+ * previous one until the next counters refresh reads them. */
+static void ifTable_counter_columns_clear(ifTable_rowreq_ctx *rowreq_ctx) {
+    ifTable_data zero;
+
+    memset(&zero, 0, sizeof(zero));
+    ifTable_counter_columns_copy(&rowreq_ctx->data, &zero);
+    rowreq_ctx->counters_generation = 0;
+}
+
+static void ifTable_counter_columns_store(struct mib_columns *cols,
+                                          size_t row,
+                                          const ifTable_data *data) {
+    mib_columns_set(cols, IFTABLE_COUNTER_IFSPEED, row, data->ifSpeed);
+    mib_columns_set(cols, IFTABLE_COUNTER_IFINOCTETS, row, data->ifInOctets);
+    mib_columns_set(cols, IFTABLE_COUNTER_IFINUCASTPKTS, row,
+                    data->ifInUcastPkts);
+    mib_columns_set(cols, IFTABLE_COUNTER_IFINNUCASTPKTS, row,
+                    data->ifInNUcastPkts);
+    mib_columns_set(cols, IFTABLE_COUNTER_IFINDISCARDS, row,
+                    data->ifInDiscards);
+    mib_columns_set(cols, IFTABLE_COUNTER_IFINERRORS, row, data->ifInErrors);
+    mib_columns_set(cols, IFTABLE_COUNTER_IFINUNKNOWNPROTOS, row,
+                    data->ifInUnknownProtos);
+    mib_columns_set(cols, IFTABLE_COUNTER_IFOUTOCTETS, row,
+                    data->ifOutOctets);
+    mib_columns_set(cols, IFTABLE_COUNTER_IFOUTUCASTPKTS, row,
+                    data->ifOutUcastPkts);
+    mib_columns_set(cols, IFTABLE_COUNTER_IFOUTNUCASTPKTS, row,
+                    data->ifOutNUcastPkts);
+    mib_columns_set(cols, IFTABLE_COUNTER_IFOUTDISCARDS, row,
+                    data->ifOutDiscards);
+    mib_columns_set(cols, IFTABLE_COUNTER_IFOUTERRORS, row,
+                    data->ifOutErrors);
+    mib_columns_set(cols, IFTABLE_COUNTER_IFOUTQLEN, row, data->ifOutQLen);
+}
+
+/* Read when a row is created or given to another interface.  After that
+ * only if_link_row_update() writes them, as soon as the IDL shows the
+ * change, so neither snapshot may carry them. */
+static void ifTable_status_columns_get(
+    const struct ovsrec_interface *interface_row, ifTable_data *data) {
+    ovsdb_get_ifAdminStatus(idl, interface_row, &data->ifAdminStatus);
+    ovsdb_get_ifOperStatus(idl, interface_row, &data->ifOperStatus);
+    ovsdb_get_ifLastChange(idl, interface_row, &data->ifLastChange);
+}
+
+static void ifTable_status_columns_copy(ifTable_data *dst,
+                                        const ifTable_data *src) {
+    dst->ifAdminStatus = src->ifAdminStatus;
+    dst->ifOperStatus = src->ifOperStatus;
+    dst->ifLastChange = src->ifLastChange;
+}
+
+/* Removes the rows the last snapshot did not see.  Returns how many. */
+static size_t ifTable_container_prune(netsnmp_container *container) {
+    netsnmp_iterator *it;
     ifTable_rowreq_ctx *rowreq_ctx;
-    size_t count = 0;
+    ifTable_rowreq_ctx **stale;
+    size_t n_stale = 0, i;
+
+    stale = malloc(CONTAINER_SIZE(container) * sizeof(*stale));
+    if (stale == NULL) {
+        snmp_log(LOG_ERR, "memory allocation failed");
+        return 0;
+    }
 
+    it = CONTAINER_ITERATOR(container);
+    if (it == NULL) {
+        free(stale);
+        return 0;
+    }
+    for (rowreq_ctx = ITERATOR_FIRST(it); rowreq_ctx != NULL;
+         rowreq_ctx = ITERATOR_NEXT(it)) {
+        if (rowreq_ctx->load_generation != ifTable_load_generation) {
+            stale[n_stale++] = rowreq_ctx;
+        }
+    }
+    ITERATOR_RELEASE(it);
+
+    for (i = 0; i < n_stale; i++) {
+        CONTAINER_REMOVE(container, stale[i]);
+        ifTable_release_rowreq_ctx(stale[i]);
+    }
+    free(stale);
+    return n_stale;
+}
+
+static size_t ifTable_refresh_begin(void) {
     const struct ovsrec_interface *interface_row = NULL;
+    struct ifTable_snapshot_row *snap;
 
-    long ifIndex;
-
-    char ifDescr[255];
-    size_t ifDescr_len;
-    long ifType;
-    long ifMtu;
-    u_long ifSpeed;
-    char ifPhysAddress[255];
-    size_t ifPhysAddress_len;
-    long ifAdminStatus;
-    long ifOperStatus;
-    long ifLastChange;
-    u_long ifInOctets;
-    u_long ifInUcastPkts;
-    u_long ifInNUcastPkts;
-    u_long ifInDiscards;
-    u_long ifInErrors;
-    u_long ifInUnknownProtos;
-    u_long ifOutOctets;
-    u_long ifOutUcastPkts;
-    u_long ifOutNUcastPkts;
-    u_long ifOutDiscards;
-    u_long ifOutErrors;
-    u_long ifOutQLen;
-    oid ifSpecific[MAX_OID_LEN];
-    size_t ifSpecific_len;
-
-    interface_row = ovsrec_interface_first(idl);
-    if (!interface_row) {
-        snmp_log(LOG_ERR, "not able to fetch interface row");
-        return -1;
+    ifTable_static_snapshot.n = 0;
+    if (ifTable_container_get() == NULL) {
+        return 0;
     }
 
+    /* Table wide: when set, each row still compares its own mtu and
+     * mac_in_use in ifTable_refresh_step(). */
+    ifTable_static_modified =
+        OVSREC_IDL_IS_COLUMN_MODIFIED(ovsrec_interface_col_mtu,
+                                      ifTable_load_seqno) ||
+        OVSREC_IDL_IS_COLUMN_MODIFIED(ovsrec_interface_col_mac_in_use,
+                                      ifTable_load_seqno);
+    ifTable_snapshot_seqno = ovsdb_idl_get_seqno(idl);
+
     OVSREC_INTERFACE_FOR_EACH(interface_row, idl) {
         if (ifTable_skip_function(idl, interface_row)) {
             continue;
         }
-        ovsdb_get_ifIndex(idl, interface_row, &ifIndex);
-
-        ovsdb_get_ifDescr(idl, interface_row, ifDescr, &ifDescr_len);
-        ovsdb_get_ifType(idl, interface_row, &ifType);
-        ovsdb_get_ifMtu(idl, interface_row, &ifMtu);
-        ovsdb_get_ifSpeed(idl, interface_row, &ifSpeed);
-        ovsdb_get_ifPhysAddress(idl, interface_row, ifPhysAddress,
-                                &ifPhysAddress_len);
-        ovsdb_get_ifAdminStatus(idl, interface_row, &ifAdminStatus);
-        ovsdb_get_ifOperStatus(idl, interface_row, &ifOperStatus);
-        ovsdb_get_ifLastChange(idl, interface_row, &ifLastChange);
-        ovsdb_get_ifInOctets(idl, interface_row, &ifInOctets);
-        ovsdb_get_ifInUcastPkts(idl, interface_row, &ifInUcastPkts);
-        ovsdb_get_ifInNUcastPkts(idl, interface_row, &ifInNUcastPkts);
-        ovsdb_get_ifInDiscards(idl, interface_row, &ifInDiscards);
-        ovsdb_get_ifInErrors(idl, interface_row, &ifInErrors);
-        ovsdb_get_ifInUnknownProtos(idl, interface_row, &ifInUnknownProtos);
-        ovsdb_get_ifOutOctets(idl, interface_row, &ifOutOctets);
-        ovsdb_get_ifOutUcastPkts(idl, interface_row, &ifOutUcastPkts);
-        ovsdb_get_ifOutNUcastPkts(idl, interface_row, &ifOutNUcastPkts);
-        ovsdb_get_ifOutDiscards(idl, interface_row, &ifOutDiscards);
-        ovsdb_get_ifOutErrors(idl, interface_row, &ifOutErrors);
-        ovsdb_get_ifOutQLen(idl, interface_row, &ifOutQLen);
-        ovsdb_get_ifSpecific(idl, interface_row, ifSpecific, &ifSpecific_len);
-
-        rowreq_ctx = ifTable_allocate_rowreq_ctx(NULL);
+        snap = ifTable_snapshot_add(&ifTable_static_snapshot);
+        if (snap == NULL) {
+            break;
+        }
+        snap->uuid = interface_row->header_.uuid;
+    }
+    return ifTable_static_snapshot.n;
+}
+
+static void ifTable_refresh_step(size_t i) {
+    struct ifTable_snapshot_row *snap = &ifTable_static_snapshot.rows[i];
+    const struct ovsrec_interface *interface_row;
+    ifTable_rowreq_ctx *rowreq_ctx;
+
+    /* The interface may have been deleted since ifTable_refresh_begin(). */
+    interface_row = ovsrec_interface_get_for_uuid(idl, &snap->uuid);
+    if (interface_row == NULL) {
+        snap->state = MIB_REFRESH_ROW_GONE;
+        return;
+    }
+    ovsdb_get_ifIndex(idl, interface_row, &snap->mib_idx.ifIndex);
+    if (snap->mib_idx.ifIndex == 0) {
+        /* The registry has no ifIndex left for it. */
+        snap->state = MIB_REFRESH_ROW_GONE;
+        return;
+    }
+
+    rowreq_ctx = ifTable_row_find_by_mib_index(&snap->mib_idx);
+    if (rowreq_ctx == NULL) {
+        snap->state = MIB_REFRESH_ROW_NEW;
+        ifTable_static_columns_get(interface_row, &snap->data);
+        ifTable_status_columns_get(interface_row, &snap->data);
+        ifTable_counter_columns_get(interface_row, &snap->data);
+    } else if (!uuid_equals(&rowreq_ctx->uuid, &snap->uuid) ||
+               OVSREC_IDL_IS_ROW_INSERTED(interface_row, ifTable_load_seqno) ||
+               (ifTable_static_modified &&
+                ifTable_static_source_changed(rowreq_ctx, interface_row))) {
+        snap->state = MIB_REFRESH_ROW_UPDATE;
+        ifTable_static_columns_get(interface_row, &snap->data);
+        ifTable_status_columns_get(interface_row, &snap->data);
+    } else {
+        snap->state = MIB_REFRESH_ROW_KEEP;
+        return;
+    }
+    snprintf(snap->mac_in_use, sizeof(snap->mac_in_use), "%s",
+             interface_row->mac_in_use ? interface_row->mac_in_use : "");
+}
+
+static void ifTable_refresh_publish(void) {
+    netsnmp_container *container = ifTable_container_get();
+    ifTable_rowreq_ctx *rowreq_ctx;
+    size_t count = 0, inserted = 0, removed = 0, i;
+
+    if (container == NULL) {
+        return;
+    }
+    ifTable_load_generation++;
+
+    for (i = 0; i < ifTable_static_snapshot.n; i++) {
+        struct ifTable_snapshot_row *snap = &ifTable_static_snapshot.rows[i];
+
+        if (snap->state == MIB_REFRESH_ROW_GONE) {
+            continue;
+        }
+        rowreq_ctx = ifTable_row_find_by_mib_index(&snap->mib_idx);
         if (rowreq_ctx == NULL) {
-            snmp_log(LOG_ERR, "memory allocation failed");
-            return MFD_RESOURCE_UNAVAILABLE;
+            if (snap->state != MIB_REFRESH_ROW_NEW) {
+                continue;
+            }
+            rowreq_ctx = ifTable_allocate_rowreq_ctx(NULL);
+            if (rowreq_ctx == NULL) {
+                snmp_log(LOG_ERR, "memory allocation failed");
+                return;
+            }
+            if (MFD_SUCCESS !=
+                ifTable_indexes_set(rowreq_ctx, snap->mib_idx.ifIndex)) {
+                snmp_log(LOG_ERR, "error setting indexes while loading");
+                ifTable_release_rowreq_ctx(rowreq_ctx);
+                continue;
+            }
+            if (CONTAINER_INSERT(container, rowreq_ctx) != 0) {
+                ifTable_release_rowreq_ctx(rowreq_ctx);
+                continue;
+            }
+            rowreq_ctx->data = snap->data;
+            memcpy(rowreq_ctx->mac_in_use, snap->mac_in_use,
+                   sizeof(rowreq_ctx->mac_in_use));
+            inserted++;
+        } else if (rowreq_ctx->load_generation == ifTable_load_generation) {
+            /* Another interface already has this ifIndex. */
+            continue;
+        } else if (snap->state != MIB_REFRESH_ROW_KEEP) {
+            ifTable_static_columns_copy(&rowreq_ctx->data, &snap->data);
+            memcpy(rowreq_ctx->mac_in_use, snap->mac_in_use,
+                   sizeof(rowreq_ctx->mac_in_use));
+            if (!uuid_equals(&rowreq_ctx->uuid, &snap->uuid)) {
+                ifTable_status_columns_copy(&rowreq_ctx->data, &snap->data);
+                ifTable_counter_columns_clear(rowreq_ctx);
+            }
+        }
+        rowreq_ctx->uuid = snap->uuid;
+        rowreq_ctx->load_generation = ifTable_load_generation;
+        ++count;
+    }
+
+    if (count != CONTAINER_SIZE(container)) {
+        removed = ifTable_container_prune(container);
+    }
+    ifTable_load_seqno = ifTable_snapshot_seqno;
+
+    /* The first snapshot only loads the rows snmpd started with. */
+    if ((inserted || removed) && ifTable_refresh.published) {
+        ifTableLastChange_update();
+    }
+
+    DEBUGMSGTL(("verbose:ifTable:ifTable_refresh_publish",
+                "published %d records, %d new\n", (int)count, (int)inserted));
+}
+
+struct mib_refresh ifTable_refresh =
+    MIB_REFRESH_INITIALIZER("ifTable", IFTABLE_CACHE_TIMEOUT,
+                            ifTable_refresh_begin, ifTable_refresh_step,
+                            ifTable_refresh_publish);
+
+static size_t ifTable_counters_refresh_begin(void) {
+    netsnmp_container *container = ifTable_container_get();
+    struct ifTable_snapshot_row *snap;
+    ifTable_rowreq_ctx *rowreq_ctx;
+    netsnmp_iterator *it;
+
+    ifTable_counters_snapshot.n = 0;
+    if (container == NULL) {
+        return 0;
+    }
+
+    it = CONTAINER_ITERATOR(container);
+    if (it == NULL) {
+        return 0;
+    }
+    for (rowreq_ctx = ITERATOR_FIRST(it); rowreq_ctx != NULL;
+         rowreq_ctx = ITERATOR_NEXT(it)) {
+        snap = ifTable_snapshot_add(&ifTable_counters_snapshot);
+        if (snap == NULL) {
+            break;
         }
-        if (MFD_SUCCESS != ifTable_indexes_set(rowreq_ctx, ifIndex)) {
-            snmp_log(LOG_ERR, "error setting indexes while loading");
-            ifTable_release_rowreq_ctx(rowreq_ctx);
+        snap->uuid = rowreq_ctx->uuid;
+        snap->mib_idx = rowreq_ctx->tbl_idx;
+    }
+    ITERATOR_RELEASE(it);
+
+    if (ifTable_columnar) {
+        ifTable_columns_building =
+            mib_columns_reset(&ifTable_columns_back,
+                              ifTable_counters_snapshot.n);
+    } else {
+        ifTable_columns_building = false;
+        ifTable_columns_free();
+    }
+    return ifTable_counters_snapshot.n;
+}
+
+static void ifTable_counters_refresh_step(size_t i) {
+    struct ifTable_snapshot_row *snap = &ifTable_counters_snapshot.rows[i];
+    const struct ovsrec_interface *interface_row;
+
+    interface_row = ovsrec_interface_get_for_uuid(idl, &snap->uuid);
+    if (interface_row == NULL) {
+        snap->state = MIB_REFRESH_ROW_GONE;
+        return;
+    }
+    snap->state = MIB_REFRESH_ROW_UPDATE;
+    ifTable_counter_columns_get(interface_row, &snap->data);
+    if (ifTable_columns_building) {
+        ifTable_counter_columns_store(&ifTable_columns_back, i, &snap->data);
+    }
+}
+
+static void ifTable_counters_refresh_publish(void) {
+    ifTable_rowreq_ctx *rowreq_ctx;
+    size_t i;
+
+    if (ifTable_columns_building) {
+        mib_columns_swap(&ifTable_columns, &ifTable_columns_back);
+    }
+    for (i = 0; i < ifTable_counters_snapshot.n; i++) {
+        struct ifTable_snapshot_row *snap = &ifTable_counters_snapshot.rows[i];
+
+        if (snap->state == MIB_REFRESH_ROW_GONE) {
             continue;
         }
+        /* ifTable_refresh may have removed or reassigned the row since. */
+        rowreq_ctx = ifTable_row_find_by_mib_index(&snap->mib_idx);
+        if (rowreq_ctx == NULL ||
+            !uuid_equals(&rowreq_ctx->uuid, &snap->uuid)) {
+            continue;
+        }
+        if (ifTable_columns_building) {
+            rowreq_ctx->counters_generation = ifTable_columns.generation;
+            rowreq_ctx->counters_ordinal = i;
+        } else {
+            ifTable_counter_columns_copy(&rowreq_ctx->data, &snap->data);
+        }
+    }
+}
 
-        rowreq_ctx->data.ifDescr_len = ifDescr_len * sizeof(ifDescr[0]);
-        memcpy(rowreq_ctx->data.ifDescr, ifDescr,
-               ifDescr_len * sizeof(ifDescr[0]));
-        rowreq_ctx->data.ifType = ifType;
-        rowreq_ctx->data.ifMtu = ifMtu;
-        rowreq_ctx->data.ifSpeed = ifSpeed;
-        rowreq_ctx->data.ifPhysAddress_len =
-            ifPhysAddress_len * sizeof(ifPhysAddress[0]);
-        memcpy(rowreq_ctx->data.ifPhysAddress, ifPhysAddress,
-               ifPhysAddress_len * sizeof(ifPhysAddress[0]));
-        rowreq_ctx->data.ifAdminStatus = ifAdminStatus;
-        rowreq_ctx->data.ifOperStatus = ifOperStatus;
-        rowreq_ctx->data.ifLastChange = ifLastChange;
-        rowreq_ctx->data.ifInOctets = ifInOctets;
-        rowreq_ctx->data.ifInUcastPkts = ifInUcastPkts;
-        rowreq_ctx->data.ifInNUcastPkts = ifInNUcastPkts;
-        rowreq_ctx->data.ifInDiscards = ifInDiscards;
-        rowreq_ctx->data.ifInErrors = ifInErrors;
-        rowreq_ctx->data.ifInUnknownProtos = ifInUnknownProtos;
-        rowreq_ctx->data.ifOutOctets = ifOutOctets;
-        rowreq_ctx->data.ifOutUcastPkts = ifOutUcastPkts;
-        rowreq_ctx->data.ifOutNUcastPkts = ifOutNUcastPkts;
-        rowreq_ctx->data.ifOutDiscards = ifOutDiscards;
-        rowreq_ctx->data.ifOutErrors = ifOutErrors;
-        rowreq_ctx->data.ifOutQLen = ifOutQLen;
-        rowreq_ctx->data.ifSpecific_len =
-            ifSpecific_len * sizeof(ifSpecific[0]);
-        memcpy(rowreq_ctx->data.ifSpecific, ifSpecific,
-               ifSpecific_len * sizeof(ifSpecific[0]));
-        CONTAINER_INSERT(container, rowreq_ctx);
-        ++count;
+struct mib_refresh ifTable_counters_refresh =
+    MIB_REFRESH_INITIALIZER("ifTable counters", IFTABLE_COUNTERS_TIMEOUT,
+                            ifTable_counters_refresh_begin,
+                            ifTable_counters_refresh_step,
+                            ifTable_counters_refresh_publish);
+
+int ifTable_container_load(netsnmp_container *container) {
+    DEBUGMSGTL(("verbose:ifTable:ifTable_container_load", "called\n"));
+
+    /* ops_snmp_run() normally keeps the snapshots fresh. */
+    if (!mib_refresh_ready(&ifTable_refresh)) {
+        mib_refresh_sync(&ifTable_refresh);
+    }
+    if (!mib_refresh_ready(&ifTable_counters_refresh)) {
+        mib_refresh_sync(&ifTable_counters_refresh);
     }
-    DEBUGMSGTL(("verbose:ifTable:ifTable_container_load",
-                "inserted %d records\n", (int)count));
+    /* A snapshot built here may have added names. */
+    ifindex_registry_flush();
     return MFD_SUCCESS;
 }
 
@@ -1,10 +1,49 @@
 #ifndef IFTABLE_DATA_ACCESS_H
 #define IFTABLE_DATA_ACCESS_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
 extern struct ovsdb_idl *idl;
 
+/* Build the snapshots of the ifTable container, see mib_refresh.h: the rows
+ * and their static columns, and the counter columns of the rows. */
+extern struct mib_refresh ifTable_refresh;
+extern struct mib_refresh ifTable_counters_refresh;
+
 int ifTable_init_data(ifTable_registration *ifTable_reg);
+/* Default intervals of the two refreshes, in seconds. */
 #define IFTABLE_CACHE_TIMEOUT 30
+#define IFTABLE_COUNTERS_TIMEOUT 5
+
+/* The columns of the columnar counter snapshot, see mib_columns.h.  The
+ * status columns stay in the rows, where the link notifications update
+ * them. */
+enum ifTable_counter {
+    IFTABLE_COUNTER_IFSPEED,
+    IFTABLE_COUNTER_IFINOCTETS,
+    IFTABLE_COUNTER_IFINUCASTPKTS,
+    IFTABLE_COUNTER_IFINNUCASTPKTS,
+    IFTABLE_COUNTER_IFINDISCARDS,
+    IFTABLE_COUNTER_IFINERRORS,
+    IFTABLE_COUNTER_IFINUNKNOWNPROTOS,
+    IFTABLE_COUNTER_IFOUTOCTETS,
+    IFTABLE_COUNTER_IFOUTUCASTPKTS,
+    IFTABLE_COUNTER_IFOUTNUCASTPKTS,
+    IFTABLE_COUNTER_IFOUTDISCARDS,
+    IFTABLE_COUNTER_IFOUTERRORS,
+    IFTABLE_COUNTER_IFOUTQLEN,
+    IFTABLE_N_COUNTERS
+};
+
+/* Serves the counter columns from a columnar snapshot instead of the rows,
+ * from the next counters refresh on. */
+void ifTable_columns_enable(bool enable);
+
+/* Returns true and the value of 'counter' for the row if the columnar
+ * snapshot has it, false to read it from the row. */
+bool ifTable_counter_lookup(const ifTable_rowreq_ctx *rowreq_ctx,
+                            enum ifTable_counter counter, uint64_t *value);
 void ifTable_container_init(netsnmp_container **container_ptr_ptr,
                             netsnmp_cache *cache);
 void ifTable_container_shutdown(netsnmp_container *container_ptr);
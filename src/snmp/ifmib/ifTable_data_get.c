@@ -69,11 +69,17 @@ int ifMtu_get(ifTable_rowreq_ctx *rowreq_ctx, long *ifMtu_val_ptr) {
 }
 
 int ifSpeed_get(ifTable_rowreq_ctx *rowreq_ctx, u_long *ifSpeed_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifSpeed_val_ptr);
     DEBUGMSGTL(("verbose:ifTable:ifSpeed_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifSpeed_val_ptr) = rowreq_ctx->data.ifSpeed;
+    if (ifTable_counter_lookup(rowreq_ctx, IFTABLE_COUNTER_IFSPEED, &value)) {
+        (*ifSpeed_val_ptr) = value;
+    } else {
+        (*ifSpeed_val_ptr) = rowreq_ctx->data.ifSpeed;
+    }
     return MFD_SUCCESS;
 }
 
@@ -140,119 +146,203 @@ int ifLastChange_get(ifTable_rowreq_ctx *rowreq_ctx,
 }
 
 int ifInOctets_get(ifTable_rowreq_ctx *rowreq_ctx, u_long *ifInOctets_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifInOctets_val_ptr);
     DEBUGMSGTL(("verbose:ifTable:ifInOctets_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifInOctets_val_ptr) = rowreq_ctx->data.ifInOctets;
+    if (ifTable_counter_lookup(rowreq_ctx, IFTABLE_COUNTER_IFINOCTETS,
+                               &value)) {
+        (*ifInOctets_val_ptr) = value;
+    } else {
+        (*ifInOctets_val_ptr) = rowreq_ctx->data.ifInOctets;
+    }
     return MFD_SUCCESS;
 }
 
 int ifInUcastPkts_get(ifTable_rowreq_ctx *rowreq_ctx,
                       u_long *ifInUcastPkts_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifInUcastPkts_val_ptr);
     DEBUGMSGTL(("verbose:ifTable:ifInUcastPkts_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifInUcastPkts_val_ptr) = rowreq_ctx->data.ifInUcastPkts;
+    if (ifTable_counter_lookup(rowreq_ctx, IFTABLE_COUNTER_IFINUCASTPKTS,
+                               &value)) {
+        (*ifInUcastPkts_val_ptr) = value;
+    } else {
+        (*ifInUcastPkts_val_ptr) = rowreq_ctx->data.ifInUcastPkts;
+    }
     return MFD_SUCCESS;
 }
 
 int ifInNUcastPkts_get(ifTable_rowreq_ctx *rowreq_ctx,
                        u_long *ifInNUcastPkts_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifInNUcastPkts_val_ptr);
     DEBUGMSGTL(("verbose:ifTable:ifInNUcastPkts_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifInNUcastPkts_val_ptr) = rowreq_ctx->data.ifInNUcastPkts;
+    if (ifTable_counter_lookup(rowreq_ctx, IFTABLE_COUNTER_IFINNUCASTPKTS,
+                               &value)) {
+        (*ifInNUcastPkts_val_ptr) = value;
+    } else {
+        (*ifInNUcastPkts_val_ptr) = rowreq_ctx->data.ifInNUcastPkts;
+    }
     return MFD_SUCCESS;
 }
 
 int ifInDiscards_get(ifTable_rowreq_ctx *rowreq_ctx,
                      u_long *ifInDiscards_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifInDiscards_val_ptr);
     DEBUGMSGTL(("verbose:ifTable:ifInDiscards_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifInDiscards_val_ptr) = rowreq_ctx->data.ifInDiscards;
+    if (ifTable_counter_lookup(rowreq_ctx, IFTABLE_COUNTER_IFINDISCARDS,
+                               &value)) {
+        (*ifInDiscards_val_ptr) = value;
+    } else {
+        (*ifInDiscards_val_ptr) = rowreq_ctx->data.ifInDiscards;
+    }
     return MFD_SUCCESS;
 }
 
 int ifInErrors_get(ifTable_rowreq_ctx *rowreq_ctx, u_long *ifInErrors_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifInErrors_val_ptr);
     DEBUGMSGTL(("verbose:ifTable:ifInErrors_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifInErrors_val_ptr) = rowreq_ctx->data.ifInErrors;
+    if (ifTable_counter_lookup(rowreq_ctx, IFTABLE_COUNTER_IFINERRORS,
+                               &value)) {
+        (*ifInErrors_val_ptr) = value;
+    } else {
+        (*ifInErrors_val_ptr) = rowreq_ctx->data.ifInErrors;
+    }
     return MFD_SUCCESS;
 }
 
 int ifInUnknownProtos_get(ifTable_rowreq_ctx *rowreq_ctx,
                           u_long *ifInUnknownProtos_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifInUnknownProtos_val_ptr);
     DEBUGMSGTL(("verbose:ifTable:ifInUnknownProtos_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifInUnknownProtos_val_ptr) = rowreq_ctx->data.ifInUnknownProtos;
+    if (ifTable_counter_lookup(rowreq_ctx, IFTABLE_COUNTER_IFINUNKNOWNPROTOS,
+                               &value)) {
+        (*ifInUnknownProtos_val_ptr) = value;
+    } else {
+        (*ifInUnknownProtos_val_ptr) = rowreq_ctx->data.ifInUnknownProtos;
+    }
     return MFD_SUCCESS;
 }
 
 int ifOutOctets_get(ifTable_rowreq_ctx *rowreq_ctx,
                     u_long *ifOutOctets_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifOutOctets_val_ptr);
     DEBUGMSGTL(("verbose:ifTable:ifOutOctets_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifOutOctets_val_ptr) = rowreq_ctx->data.ifOutOctets;
+    if (ifTable_counter_lookup(rowreq_ctx, IFTABLE_COUNTER_IFOUTOCTETS,
+                               &value)) {
+        (*ifOutOctets_val_ptr) = value;
+    } else {
+        (*ifOutOctets_val_ptr) = rowreq_ctx->data.ifOutOctets;
+    }
     return MFD_SUCCESS;
 }
 
 int ifOutUcastPkts_get(ifTable_rowreq_ctx *rowreq_ctx,
                        u_long *ifOutUcastPkts_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifOutUcastPkts_val_ptr);
     DEBUGMSGTL(("verbose:ifTable:ifOutUcastPkts_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifOutUcastPkts_val_ptr) = rowreq_ctx->data.ifOutUcastPkts;
+    if (ifTable_counter_lookup(rowreq_ctx, IFTABLE_COUNTER_IFOUTUCASTPKTS,
+                               &value)) {
+        (*ifOutUcastPkts_val_ptr) = value;
+    } else {
+        (*ifOutUcastPkts_val_ptr) = rowreq_ctx->data.ifOutUcastPkts;
+    }
     return MFD_SUCCESS;
 }
 
 int ifOutNUcastPkts_get(ifTable_rowreq_ctx *rowreq_ctx,
                         u_long *ifOutNUcastPkts_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifOutNUcastPkts_val_ptr);
     DEBUGMSGTL(("verbose:ifTable:ifOutNUcastPkts_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifOutNUcastPkts_val_ptr) = rowreq_ctx->data.ifOutNUcastPkts;
+    if (ifTable_counter_lookup(rowreq_ctx, IFTABLE_COUNTER_IFOUTNUCASTPKTS,
+                               &value)) {
+        (*ifOutNUcastPkts_val_ptr) = value;
+    } else {
+        (*ifOutNUcastPkts_val_ptr) = rowreq_ctx->data.ifOutNUcastPkts;
+    }
     return MFD_SUCCESS;
 }
 
 int ifOutDiscards_get(ifTable_rowreq_ctx *rowreq_ctx,
                       u_long *ifOutDiscards_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifOutDiscards_val_ptr);
     DEBUGMSGTL(("verbose:ifTable:ifOutDiscards_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifOutDiscards_val_ptr) = rowreq_ctx->data.ifOutDiscards;
+    if (ifTable_counter_lookup(rowreq_ctx, IFTABLE_COUNTER_IFOUTDISCARDS,
+                               &value)) {
+        (*ifOutDiscards_val_ptr) = value;
+    } else {
+        (*ifOutDiscards_val_ptr) = rowreq_ctx->data.ifOutDiscards;
+    }
     return MFD_SUCCESS;
 }
 
 int ifOutErrors_get(ifTable_rowreq_ctx *rowreq_ctx,
                     u_long *ifOutErrors_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifOutErrors_val_ptr);
     DEBUGMSGTL(("verbose:ifTable:ifOutErrors_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifOutErrors_val_ptr) = rowreq_ctx->data.ifOutErrors;
+    if (ifTable_counter_lookup(rowreq_ctx, IFTABLE_COUNTER_IFOUTERRORS,
+                               &value)) {
+        (*ifOutErrors_val_ptr) = value;
+    } else {
+        (*ifOutErrors_val_ptr) = rowreq_ctx->data.ifOutErrors;
+    }
     return MFD_SUCCESS;
 }
 
 int ifOutQLen_get(ifTable_rowreq_ctx *rowreq_ctx, u_long *ifOutQLen_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifOutQLen_val_ptr);
     DEBUGMSGTL(("verbose:ifTable:ifOutQLen_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifOutQLen_val_ptr) = rowreq_ctx->data.ifOutQLen;
+    if (ifTable_counter_lookup(rowreq_ctx, IFTABLE_COUNTER_IFOUTQLEN,
+                               &value)) {
+        (*ifOutQLen_val_ptr) = value;
+    } else {
+        (*ifOutQLen_val_ptr) = rowreq_ctx->data.ifOutQLen;
+    }
     return MFD_SUCCESS;
 }
 
@@ -2,4 +2,96 @@
 #include <net-snmp/net-snmp-features.h>
 #include <net-snmp/net-snmp-includes.h>
 #include <net-snmp/agent/net-snmp-agent-includes.h>
+#include "IF_MIB_custom.h"
+#include "IF_MIB_txn.h"
 #include "ifTable.h"
+
+int ifTable_undo_setup(ifTable_rowreq_ctx *rowreq_ctx) {
+    DEBUGMSGTL(("verbose:ifTable:ifTable_undo_setup", "called\n"));
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    memcpy(rowreq_ctx->undo, &rowreq_ctx->data, sizeof(ifTable_data));
+    if_mib_txn_row_add();
+    return MFD_SUCCESS;
+}
+
+int ifTable_undo(ifTable_rowreq_ctx *rowreq_ctx) {
+    DEBUGMSGTL(("verbose:ifTable:ifTable_undo", "called\n"));
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    if (rowreq_ctx->column_set_flags & COLUMN_IFADMINSTATUS_FLAG) {
+        rowreq_ctx->data.ifAdminStatus = rowreq_ctx->undo->ifAdminStatus;
+    }
+    return MFD_SUCCESS;
+}
+
+/* Adds the new values of the row to the transaction of the request, which
+ * the irreversible commit step of its last row commits. */
+int ifTable_commit(ifTable_rowreq_ctx *rowreq_ctx) {
+    const struct ovsrec_interface *interface_row;
+
+    DEBUGMSGTL(("verbose:ifTable:ifTable_commit", "called\n"));
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    interface_row = ovsrec_interface_get_for_uuid(idl, &rowreq_ctx->uuid);
+    if (NULL == interface_row) {
+        snmp_log(LOG_ERR, "ifTable: no Interface row for ifIndex %ld\n",
+                 rowreq_ctx->tbl_idx.ifIndex);
+        return MFD_ERROR;
+    }
+    if (NULL == if_mib_txn_get()) {
+        return MFD_ERROR;
+    }
+
+    if (rowreq_ctx->column_set_flags & COLUMN_IFADMINSTATUS_FLAG) {
+        ifAdminStatus_custom_set(idl, interface_row,
+                                 rowreq_ctx->data.ifAdminStatus);
+    }
+    rowreq_ctx->rowreq_flags |= MFD_ROW_DIRTY;
+    return MFD_SUCCESS;
+}
+
+int ifTable_undo_commit(ifTable_rowreq_ctx *rowreq_ctx) {
+    DEBUGMSGTL(("verbose:ifTable:ifTable_undo_commit", "called\n"));
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    if_mib_txn_abort();
+    rowreq_ctx->rowreq_flags &= ~MFD_ROW_DIRTY;
+    return MFD_SUCCESS;
+}
+
+int ifTable_irreversible_commit(ifTable_rowreq_ctx *rowreq_ctx) {
+    DEBUGMSGTL(("verbose:ifTable:ifTable_irreversible_commit", "called\n"));
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    if (!(rowreq_ctx->rowreq_flags & MFD_ROW_DIRTY)) {
+        return MFD_SUCCESS;
+    }
+    rowreq_ctx->rowreq_flags &= ~MFD_ROW_DIRTY;
+
+    if (MFD_SUCCESS != if_mib_txn_row_commit()) {
+        ifTable_undo(rowreq_ctx);
+        return MFD_ERROR;
+    }
+    return MFD_SUCCESS;
+}
+
+int ifAdminStatus_check_value(ifTable_rowreq_ctx *rowreq_ctx,
+                              long ifAdminStatus_val) {
+    DEBUGMSGTL(("verbose:ifTable:ifAdminStatus_check_value", "called\n"));
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    /* There is no test mode to put an interface in. */
+    if (ifAdminStatus_val == IFADMINSTATUS_TESTING) {
+        return MFD_NOT_VALID_EVER;
+    }
+    return MFD_SUCCESS;
+}
+
+int ifAdminStatus_set(ifTable_rowreq_ctx *rowreq_ctx, long ifAdminStatus_val) {
+    DEBUGMSGTL(("verbose:ifTable:ifAdminStatus_set", "called\n"));
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    rowreq_ctx->data.ifAdminStatus = ifAdminStatus_val;
+    return MFD_SUCCESS;
+}
@@ -1,3 +1,12 @@
 #ifndef IFTABLE_DATA_SET_H
 #define IFTABLE_DATA_SET_H
+int ifTable_undo_setup(ifTable_rowreq_ctx *rowreq_ctx);
+int ifTable_undo(ifTable_rowreq_ctx *rowreq_ctx);
+int ifTable_commit(ifTable_rowreq_ctx *rowreq_ctx);
+int ifTable_undo_commit(ifTable_rowreq_ctx *rowreq_ctx);
+int ifTable_irreversible_commit(ifTable_rowreq_ctx *rowreq_ctx);
+
+int ifAdminStatus_check_value(ifTable_rowreq_ctx *rowreq_ctx,
+                              long ifAdminStatus_val);
+int ifAdminStatus_set(ifTable_rowreq_ctx *rowreq_ctx, long ifAdminStatus_val);
 #endif
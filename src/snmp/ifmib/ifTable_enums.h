@@ -1,3 +1,18 @@
 #ifndef IFTABLE_ENUMS_H
 #define IFTABLE_ENUMS_H
+
+/* ifAdminStatus */
+#define IFADMINSTATUS_UP                1
+#define IFADMINSTATUS_DOWN              2
+#define IFADMINSTATUS_TESTING           3
+
+/* ifOperStatus */
+#define IFOPERSTATUS_UP                 1
+#define IFOPERSTATUS_DOWN               2
+#define IFOPERSTATUS_TESTING            3
+#define IFOPERSTATUS_UNKNOWN            4
+#define IFOPERSTATUS_DORMANT            5
+#define IFOPERSTATUS_NOTPRESENT         6
+#define IFOPERSTATUS_LOWERLAYERDOWN     7
+
 #endif
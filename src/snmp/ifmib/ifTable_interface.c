@@ -44,6 +44,14 @@ static Netsnmp_Node_Handler _mfd_ifTable_pre_request;
 static Netsnmp_Node_Handler _mfd_ifTable_post_request;
 static Netsnmp_Node_Handler _mfd_ifTable_object_lookup;
 static Netsnmp_Node_Handler _mfd_ifTable_get_values;
+static Netsnmp_Node_Handler _mfd_ifTable_check_objects;
+static Netsnmp_Node_Handler _mfd_ifTable_undo_setup;
+static Netsnmp_Node_Handler _mfd_ifTable_set_values;
+static Netsnmp_Node_Handler _mfd_ifTable_undo_cleanup;
+static Netsnmp_Node_Handler _mfd_ifTable_undo_values;
+static Netsnmp_Node_Handler _mfd_ifTable_commit;
+static Netsnmp_Node_Handler _mfd_ifTable_undo_commit;
+static Netsnmp_Node_Handler _mfd_ifTable_irreversible_commit;
 
 void _ifTable_initialize_interface(ifTable_registration *reg_ptr,
                                    u_long flags) {
@@ -71,6 +79,15 @@ void _ifTable_initialize_interface(ifTable_registration *reg_ptr,
     access_multiplexer->object_lookup = _mfd_ifTable_object_lookup;
     access_multiplexer->get_values = _mfd_ifTable_get_values;
 
+    access_multiplexer->object_syntax_checks = _mfd_ifTable_check_objects;
+    access_multiplexer->undo_setup = _mfd_ifTable_undo_setup;
+    access_multiplexer->undo_cleanup = _mfd_ifTable_undo_cleanup;
+    access_multiplexer->set_values = _mfd_ifTable_set_values;
+    access_multiplexer->undo_sets = _mfd_ifTable_undo_values;
+    access_multiplexer->commit = _mfd_ifTable_commit;
+    access_multiplexer->undo_commit = _mfd_ifTable_undo_commit;
+    access_multiplexer->irreversible_commit = _mfd_ifTable_irreversible_commit;
+
     access_multiplexer->pre_request = _mfd_ifTable_pre_request;
     access_multiplexer->post_request = _mfd_ifTable_post_request;
 
@@ -80,7 +97,7 @@ void _ifTable_initialize_interface(ifTable_registration *reg_ptr,
     handler = netsnmp_baby_steps_access_multiplexer_get(access_multiplexer);
     reginfo = netsnmp_handler_registration_create(
         "ifTable", handler, ifTable_oid, ifTable_oid_size,
-        HANDLER_CAN_BABY_STEP | HANDLER_CAN_RONLY);
+        HANDLER_CAN_BABY_STEP | HANDLER_CAN_RWRITE);
 
     if (NULL == reginfo) {
         snmp_log(LOG_ERR, "error registering table ifTable\n");
@@ -95,6 +112,22 @@ void _ifTable_initialize_interface(ifTable_registration *reg_ptr,
         mfd_modes |= BABY_STEP_PRE_REQUEST;
     if (access_multiplexer->post_request)
         mfd_modes |= BABY_STEP_POST_REQUEST;
+    if (access_multiplexer->object_syntax_checks)
+        mfd_modes |= BABY_STEP_CHECK_OBJECT;
+    if (access_multiplexer->undo_setup)
+        mfd_modes |= BABY_STEP_UNDO_SETUP;
+    if (access_multiplexer->undo_cleanup)
+        mfd_modes |= BABY_STEP_UNDO_CLEANUP;
+    if (access_multiplexer->set_values)
+        mfd_modes |= BABY_STEP_SET_VALUES;
+    if (access_multiplexer->undo_sets)
+        mfd_modes |= BABY_STEP_UNDO_SETS;
+    if (access_multiplexer->commit)
+        mfd_modes |= BABY_STEP_COMMIT;
+    if (access_multiplexer->undo_commit)
+        mfd_modes |= BABY_STEP_UNDO_COMMIT;
+    if (access_multiplexer->irreversible_commit)
+        mfd_modes |= BABY_STEP_IRREVERSIBLE_COMMIT;
 
     handler = netsnmp_baby_steps_handler_get(mfd_modes);
     netsnmp_inject_handler(reginfo, handler);
@@ -192,6 +225,7 @@ void ifTable_release_rowreq_ctx(ifTable_rowreq_ctx *rowreq_ctx) {
     netsnmp_assert(NULL != rowreq_ctx);
 
     ifTable_rowreq_ctx_cleanup(rowreq_ctx);
+    SNMP_FREE(rowreq_ctx->undo);
     if (rowreq_ctx->oid_idx.oids != rowreq_ctx->oid_tmp) {
         free(rowreq_ctx->oid_idx.oids);
     }
@@ -459,6 +493,255 @@ int _mfd_ifTable_get_values(netsnmp_mib_handler *handler,
     return SNMP_ERR_NOERROR;
 }
 
+NETSNMP_STATIC_INLINE int _ifTable_check_column(ifTable_rowreq_ctx *rowreq_ctx,
+                                                netsnmp_variable_list *var,
+                                                int column) {
+    int rc = SNMPERR_SUCCESS;
+
+    DEBUGMSGTL(("internal:ifTable:_ifTable_check_column", "called for %d\n",
+                column));
+
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    switch (column) {
+    case COLUMN_IFADMINSTATUS:
+        rc = netsnmp_check_vb_type(var, ASN_INTEGER);
+        if ((SNMPERR_SUCCESS == rc) &&
+            (*var->val.integer != IFADMINSTATUS_UP) &&
+            (*var->val.integer != IFADMINSTATUS_DOWN) &&
+            (*var->val.integer != IFADMINSTATUS_TESTING)) {
+            rc = SNMP_ERR_WRONGVALUE;
+        }
+        if (SNMPERR_SUCCESS == rc) {
+            rc = ifAdminStatus_check_value(rowreq_ctx, *var->val.integer);
+        }
+        break;
+    default:
+        rc = SNMP_ERR_NOTWRITABLE;
+        break;
+    }
+
+    return rc;
+}
+
+int _mfd_ifTable_check_objects(netsnmp_mib_handler *handler,
+                               netsnmp_handler_registration *reginfo,
+                               netsnmp_agent_request_info *agtreq_info,
+                               netsnmp_request_info *requests) {
+    ifTable_rowreq_ctx *rowreq_ctx =
+        (ifTable_rowreq_ctx *)netsnmp_container_table_row_extract(requests);
+    netsnmp_table_request_info *tri;
+    int rc;
+
+    DEBUGMSGTL(("internal:ifTable:_mfd_ifTable_check_objects", "called\n"));
+
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    for (; requests; requests = requests->next) {
+        tri = netsnmp_extract_table_info(requests);
+        if (NULL == tri) {
+            continue;
+        }
+        rc = _ifTable_check_column(rowreq_ctx, requests->requestvb,
+                                   tri->colnum);
+        if (rc) {
+            netsnmp_request_set_error(requests, SNMP_VALIDATE_ERR(rc));
+            break;
+        }
+    }
+
+    return SNMP_ERR_NOERROR;
+}
+
+static int _mfd_ifTable_undo_setup(netsnmp_mib_handler *handler,
+                                   netsnmp_handler_registration *reginfo,
+                                   netsnmp_agent_request_info *agtreq_info,
+                                   netsnmp_request_info *requests) {
+    ifTable_rowreq_ctx *rowreq_ctx =
+        (ifTable_rowreq_ctx *)netsnmp_container_table_row_extract(requests);
+    int rc;
+
+    DEBUGMSGTL(("internal:ifTable:_mfd_ifTable_undo_setup", "called\n"));
+
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    rowreq_ctx->column_set_flags = 0;
+    rowreq_ctx->undo = SNMP_MALLOC_TYPEDEF(ifTable_data);
+    if (NULL == rowreq_ctx->undo) {
+        netsnmp_request_set_error_all(requests,
+                                      SNMP_ERR_RESOURCEUNAVAILABLE);
+        return SNMP_ERR_NOERROR;
+    }
+
+    rc = ifTable_undo_setup(rowreq_ctx);
+    if (MFD_SUCCESS != rc) {
+        DEBUGMSGTL(("ifTable:mfd", "error %d from ifTable_undo_setup\n", rc));
+        netsnmp_request_set_error_all(requests, SNMP_VALIDATE_ERR(rc));
+    }
+
+    return SNMP_ERR_NOERROR;
+}
+
+static int _mfd_ifTable_undo_cleanup(netsnmp_mib_handler *handler,
+                                     netsnmp_handler_registration *reginfo,
+                                     netsnmp_agent_request_info *agtreq_info,
+                                     netsnmp_request_info *requests) {
+    ifTable_rowreq_ctx *rowreq_ctx =
+        (ifTable_rowreq_ctx *)netsnmp_container_table_row_extract(requests);
+
+    DEBUGMSGTL(("internal:ifTable:_mfd_ifTable_undo_cleanup", "called\n"));
+
+    if (NULL == rowreq_ctx) {
+        return SNMP_ERR_NOERROR;
+    }
+
+    SNMP_FREE(rowreq_ctx->undo);
+    rowreq_ctx->column_set_flags = 0;
+    return SNMP_ERR_NOERROR;
+}
+
+NETSNMP_STATIC_INLINE int _ifTable_set_column(ifTable_rowreq_ctx *rowreq_ctx,
+                                              netsnmp_variable_list *var,
+                                              int column) {
+    int rc = SNMPERR_SUCCESS;
+
+    DEBUGMSGTL(("internal:ifTable:_ifTable_set_column",
+                "called for %d\n", column));
+
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    switch (column) {
+    case COLUMN_IFADMINSTATUS:
+        rowreq_ctx->column_set_flags |= COLUMN_IFADMINSTATUS_FLAG;
+        rc = ifAdminStatus_set(rowreq_ctx, *var->val.integer);
+        break;
+    default:
+        snmp_log(LOG_ERR, "unknown column %d in _ifTable_set_column\n", column);
+        rc = SNMP_ERR_GENERR;
+        break;
+    }
+
+    return rc;
+}
+
+int _mfd_ifTable_set_values(netsnmp_mib_handler *handler,
+                            netsnmp_handler_registration *reginfo,
+                            netsnmp_agent_request_info *agtreq_info,
+                            netsnmp_request_info *requests) {
+    ifTable_rowreq_ctx *rowreq_ctx =
+        (ifTable_rowreq_ctx *)netsnmp_container_table_row_extract(requests);
+    netsnmp_table_request_info *tri;
+    int rc = SNMP_ERR_NOERROR;
+
+    DEBUGMSGTL(("internal:ifTable:_mfd_ifTable_set_values", "called\n"));
+
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    for (; requests; requests = requests->next) {
+        tri = netsnmp_extract_table_info(requests);
+        if (NULL == tri) {
+            continue;
+        }
+        rc = _ifTable_set_column(rowreq_ctx, requests->requestvb, tri->colnum);
+        if (MFD_SUCCESS != rc) {
+            DEBUGMSGTL(("ifTable:mfd",
+                        "error %d from ifTable_set_column\n", rc));
+            netsnmp_request_set_error(requests, SNMP_VALIDATE_ERR(rc));
+        }
+    }
+
+    return SNMP_ERR_NOERROR;
+}
+
+static int _mfd_ifTable_undo_values(netsnmp_mib_handler *handler,
+                                    netsnmp_handler_registration *reginfo,
+                                    netsnmp_agent_request_info *agtreq_info,
+                                    netsnmp_request_info *requests) {
+    ifTable_rowreq_ctx *rowreq_ctx =
+        (ifTable_rowreq_ctx *)netsnmp_container_table_row_extract(requests);
+    int rc;
+
+    DEBUGMSGTL(("internal:ifTable:_mfd_ifTable_undo_values", "called\n"));
+
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    if (NULL == rowreq_ctx->undo) {
+        return SNMP_ERR_NOERROR;
+    }
+    rc = ifTable_undo(rowreq_ctx);
+    if (MFD_SUCCESS != rc) {
+        DEBUGMSGTL(("ifTable:mfd", "error %d from ifTable_undo\n", rc));
+    }
+
+    return SNMP_ERR_NOERROR;
+}
+
+static int _mfd_ifTable_commit(netsnmp_mib_handler *handler,
+                               netsnmp_handler_registration *reginfo,
+                               netsnmp_agent_request_info *agtreq_info,
+                               netsnmp_request_info *requests) {
+    ifTable_rowreq_ctx *rowreq_ctx =
+        (ifTable_rowreq_ctx *)netsnmp_container_table_row_extract(requests);
+    int rc;
+
+    DEBUGMSGTL(("internal:ifTable:_mfd_ifTable_commit", "called\n"));
+
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    rc = ifTable_commit(rowreq_ctx);
+    if (MFD_SUCCESS != rc) {
+        DEBUGMSGTL(("ifTable:mfd", "error %d from ifTable_commit\n", rc));
+        netsnmp_request_set_error_all(requests, SNMP_VALIDATE_ERR(rc));
+    }
+
+    return SNMP_ERR_NOERROR;
+}
+
+static int _mfd_ifTable_undo_commit(netsnmp_mib_handler *handler,
+                                    netsnmp_handler_registration *reginfo,
+                                    netsnmp_agent_request_info *agtreq_info,
+                                    netsnmp_request_info *requests) {
+    ifTable_rowreq_ctx *rowreq_ctx =
+        (ifTable_rowreq_ctx *)netsnmp_container_table_row_extract(requests);
+    int rc;
+
+    DEBUGMSGTL(("internal:ifTable:_mfd_ifTable_undo_commit", "called\n"));
+
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    rc = ifTable_undo_commit(rowreq_ctx);
+    if (MFD_SUCCESS != rc) {
+        DEBUGMSGTL(("ifTable:mfd", "error %d from ifTable_undo_commit\n", rc));
+        netsnmp_request_set_error_all(requests, SNMP_VALIDATE_ERR(rc));
+    }
+
+    return SNMP_ERR_NOERROR;
+}
+
+static int
+_mfd_ifTable_irreversible_commit(netsnmp_mib_handler *handler,
+                                 netsnmp_handler_registration *reginfo,
+                                 netsnmp_agent_request_info *agtreq_info,
+                                 netsnmp_request_info *requests) {
+    ifTable_rowreq_ctx *rowreq_ctx =
+        (ifTable_rowreq_ctx *)netsnmp_container_table_row_extract(requests);
+    int rc;
+
+    DEBUGMSGTL(("internal:ifTable:_mfd_ifTable_irreversible_commit",
+                "called\n"));
+
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    rc = ifTable_irreversible_commit(rowreq_ctx);
+    if (MFD_SUCCESS != rc) {
+        DEBUGMSGTL(("ifTable:mfd",
+                    "error %d from ifTable_irreversible_commit\n", rc));
+        netsnmp_request_set_error_all(requests, SNMP_ERR_COMMITFAILED);
+    }
+
+    return SNMP_ERR_NOERROR;
+}
+
 static void _container_free(netsnmp_container *container);
 
 static int _cache_load(netsnmp_cache *cache, void *vmagic) {
@@ -520,7 +803,10 @@ void _ifTable_container_init(ifTable_interface_ctx *if_ctx) {
         return;
     }
 
-    if_ctx->cache->flags = NETSNMP_CACHE_DONT_INVALIDATE_ON_SET;
+    /* Rows are updated in place by ifTable_container_load(), keep them. */
+    if_ctx->cache->flags = NETSNMP_CACHE_DONT_INVALIDATE_ON_SET |
+                           NETSNMP_CACHE_DONT_FREE_BEFORE_LOAD |
+                           NETSNMP_CACHE_DONT_FREE_EXPIRED;
     ifTable_container_init(&if_ctx->container, if_ctx->cache);
     if (NULL == if_ctx->container) {
         if_ctx->container = netsnmp_container_find("ifTable:table_container");
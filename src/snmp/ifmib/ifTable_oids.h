@@ -10,6 +10,7 @@
 #define COLUMN_IFSPEED 5
 #define COLUMN_IFPHYSADDRESS 6
 #define COLUMN_IFADMINSTATUS 7
+#define COLUMN_IFADMINSTATUS_FLAG (0x1 << 6)
 #define COLUMN_IFOPERSTATUS 8
 #define COLUMN_IFLASTCHANGE 9
 #define COLUMN_IFINOCTETS 10
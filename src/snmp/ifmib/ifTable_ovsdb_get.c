@@ -16,6 +16,9 @@ void ifTable_ovsdb_idl_init(struct ovsdb_idl *idl) {
     ovsdb_idl_add_column(idl, &ovsrec_interface_col_user_config);
     ovsdb_idl_add_column(idl, &ovsrec_interface_col_mtu);
     ovsdb_idl_add_column(idl, &ovsrec_interface_col_name);
+    /* Written by a SET of ifAdminStatus, like "shutdown" does. */
+    ovsdb_idl_add_column(idl, &ovsrec_port_col_name);
+    ovsdb_idl_add_column(idl, &ovsrec_port_col_admin);
 }
 
 void ovsdb_get_ifIndex(struct ovsdb_idl *idl,
@@ -80,7 +83,7 @@ void ovsdb_get_ifOperStatus(struct ovsdb_idl *idl,
 void ovsdb_get_ifLastChange(struct ovsdb_idl *idl,
                             const struct ovsrec_interface *interface_row,
                             long *ifLastChange_val_ptr) {
-    *ifLastChange_val_ptr = (long)NULL;
+    ifLastChange_custom_function(idl, interface_row, ifLastChange_val_ptr);
 }
 
 void ovsdb_get_ifInOctets(struct ovsdb_idl *idl,
@@ -9,6 +9,7 @@
 #include "ifXTable.h"
 #include "ifXTable_interface.h"
 #include "ifXTable_ovsdb_get.h"
+#include "IF_MIB_txn.h"
 
 const oid ifXTable_oid[] = {IFXTABLE_OID};
 const int ifXTable_oid_size = OID_LENGTH(ifXTable_oid);
@@ -51,6 +52,7 @@ void ifXTable_rowreq_ctx_cleanup(ifXTable_rowreq_ctx *rowreq_ctx) {
 
 int ifXTable_pre_request(ifXTable_registration *user_context) {
     DEBUGMSGTL(("verbose:ifXTable:ifXTable_pre_request", "called\n"));
+    if_mib_txn_begin();
     return MFD_SUCCESS;
 }
 
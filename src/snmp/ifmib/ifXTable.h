@@ -3,6 +3,7 @@
 #include <net-snmp/library/asn1.h>
 #include "ifXTable_oids.h"
 #include "ifXTable_enums.h"
+#include "uuid.h"
 
 void init_ifXTable(void);
 void shutdown_ifXTable(void);
@@ -42,6 +43,12 @@ typedef struct ifXTable_rowreq_ctx_s {
     ifXTable_data data;
     u_int rowreq_flags;
     netsnmp_data_list *ifXTable_data_list;
+    u_int load_generation;  /* Last snapshot that saw the row. */
+    struct uuid uuid;       /* Of the Interface row. */
+    ifXTable_data *undo;          /* The data before a SET. */
+    u_int column_set_flags; /* Columns a SET wrote. */
+    u_int counters_generation;  /* Of the columnar snapshot that has it. */
+    size_t counters_ordinal;    /* Its row in that snapshot. */
 } ifXTable_rowreq_ctx;
 
 typedef struct ifXTable_ref_rowreq_ctx_s {
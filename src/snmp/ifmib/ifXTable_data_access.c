@@ -6,12 +6,42 @@
 #include "ifXTable.h"
 #include "ifXTable_data_access.h"
 #include "ifXTable_ovsdb_get.h"
+#include "mib_columns.h"
+#include "mib_refresh.h"
+#include "ifindex_registry.h"
 
 #include "openswitch-idl.h"
 #include "ovsdb-idl.h"
 #include "vswitch-idl.h"
+#include "uuid.h"
 #include "openvswitch/vlog.h"
 
+/* With ifMibColumnarCounters, the counters refresh builds the next
+ * columnar snapshot in ifXTable_columns_back and swaps it with the served
+ * one, instead of copying the counter columns into the rows. */
+static bool ifXTable_columnar;
+static bool ifXTable_columns_building;
+static struct mib_columns ifXTable_columns =
+    MIB_COLUMNS_INITIALIZER(IFXTABLE_N_COUNTERS);
+static struct mib_columns ifXTable_columns_back =
+    MIB_COLUMNS_INITIALIZER(IFXTABLE_N_COUNTERS);
+
+static void ifXTable_columns_free(void) {
+    mib_columns_destroy(&ifXTable_columns);
+    mib_columns_destroy(&ifXTable_columns_back);
+}
+
+void ifXTable_columns_enable(bool enable) {
+    ifXTable_columnar = enable;
+}
+
+bool ifXTable_counter_lookup(const ifXTable_rowreq_ctx *rowreq_ctx,
+                             enum ifXTable_counter counter, uint64_t *value) {
+    return ifXTable_columnar &&
+           mib_columns_get(&ifXTable_columns, rowreq_ctx->counters_generation,
+                           rowreq_ctx->counters_ordinal, counter, value);
+}
+
 int ifXTable_init_data(ifXTable_registration *ifXTable_reg) {
     DEBUGMSGTL(("verbose:ifXTable:ifXTable_init_data", "called\n"));
     return MFD_SUCCESS;
@@ -29,7 +59,7 @@ void ifXTable_container_init(netsnmp_container **container_ptr_ptr,
         snmp_log(LOG_ERR, "bad cache param to ifXTable_container_init\n");
         return;
     }
-    cache->timeout = IFXTABLE_CACHE_TIMEOUT;
+    cache->timeout = IFXTABLE_COUNTERS_TIMEOUT;
 }
 
 void ifXTable_container_shutdown(netsnmp_container *container_ptr) {
@@ -38,114 +68,446 @@ void ifXTable_container_shutdown(netsnmp_container *container_ptr) {
         snmp_log(LOG_ERR, "bad params to ifXTable_container_shutdown\n");
         return;
     }
+    ifXTable_columns_free();
 }
 
-int ifXTable_container_load(netsnmp_container *container) {
-    DEBUGMSGTL(("verbose:ifXTable:ifXTable_container_load", "called\n"));
+/* Rows are kept across snapshots, and refreshed by a static and a counter
+ * refresh, see ifTable_data_access.c. */
+static unsigned int ifXTable_load_seqno;
+static unsigned int ifXTable_load_generation;
+
+/* A back buffer, filled a slice at a time while the requests are served
+ * from the container. */
+struct ifXTable_snapshot_row {
+    struct uuid uuid;
+    enum mib_refresh_row_state state;
+    ifXTable_mib_index mib_idx;
+    ifXTable_data data;
+};
+
+struct ifXTable_snapshot {
+    struct ifXTable_snapshot_row *rows;
+    size_t n;
+    size_t allocated;
+};
+
+static struct ifXTable_snapshot ifXTable_static_snapshot;
+static struct ifXTable_snapshot ifXTable_counters_snapshot;
+static unsigned int ifXTable_snapshot_seqno;
+static int ifXTable_static_modified;
+
+static struct ifXTable_snapshot_row *
+ifXTable_snapshot_add(struct ifXTable_snapshot *snapshot) {
+    if (snapshot->n == snapshot->allocated) {
+        size_t allocated = snapshot->allocated * 2 + 16;
+        struct ifXTable_snapshot_row *rows;
+
+        rows = realloc(snapshot->rows, allocated * sizeof(*rows));
+        if (rows == NULL) {
+            snmp_log(LOG_ERR, "memory allocation failed");
+            return NULL;
+        }
+        snapshot->rows = rows;
+        snapshot->allocated = allocated;
+    }
+    return &snapshot->rows[snapshot->n++];
+}
+
+/* Columns that only change with the pm_info and user_config columns.  The
+ * name of a row never changes. */
+static void ifXTable_static_columns_get(
+    const struct ovsrec_interface *interface_row, ifXTable_data *data) {
+    ovsdb_get_ifName(idl, interface_row, data->ifName, &data->ifName_len);
+    ovsdb_get_ifLinkUpDownTrapEnable(idl, interface_row,
+                                     &data->ifLinkUpDownTrapEnable);
+    ovsdb_get_ifPromiscuousMode(idl, interface_row, &data->ifPromiscuousMode);
+    ovsdb_get_ifConnectorPresent(idl, interface_row,
+                                 &data->ifConnectorPresent);
+    ovsdb_get_ifAlias(idl, interface_row, data->ifAlias, &data->ifAlias_len);
+}
+
+/* Whether the connector in pm_info or the description in user_config of
+ * 'interface_row' differ from the ones in 'rowreq_ctx'.  Both are single
+ * map lookups, so a statistics update only compares them. */
+static bool ifXTable_static_source_changed(
+    const ifXTable_rowreq_ctx *rowreq_ctx,
+    const struct ovsrec_interface *interface_row) {
+    char alias[sizeof(rowreq_ctx->data.ifAlias)];
+    size_t alias_len;
+    long connector;
+
+    ovsdb_get_ifConnectorPresent(idl, interface_row, &connector);
+    ovsdb_get_ifAlias(idl, interface_row, alias, &alias_len);
+    return connector != rowreq_ctx->data.ifConnectorPresent ||
+           alias_len != rowreq_ctx->data.ifAlias_len ||
+           memcmp(alias, rowreq_ctx->data.ifAlias, alias_len) != 0;
+}
+
+static void ifXTable_static_columns_copy(ifXTable_data *dst,
+                                         const ifXTable_data *src) {
+    memcpy(dst->ifName, src->ifName, src->ifName_len);
+    dst->ifName_len = src->ifName_len;
+    dst->ifLinkUpDownTrapEnable = src->ifLinkUpDownTrapEnable;
+    dst->ifPromiscuousMode = src->ifPromiscuousMode;
+    dst->ifConnectorPresent = src->ifConnectorPresent;
+    memcpy(dst->ifAlias, src->ifAlias, src->ifAlias_len);
+    dst->ifAlias_len = src->ifAlias_len;
+}
+
+static void ifXTable_counter_columns_get(
+    const struct ovsrec_interface *interface_row, ifXTable_data *data) {
+    ovsdb_get_ifInMulticastPkts(idl, interface_row, &data->ifInMulticastPkts);
+    ovsdb_get_ifInBroadcastPkts(idl, interface_row, &data->ifInBroadcastPkts);
+    ovsdb_get_ifOutMulticastPkts(idl, interface_row,
+                                 &data->ifOutMulticastPkts);
+    ovsdb_get_ifOutBroadcastPkts(idl, interface_row,
+                                 &data->ifOutBroadcastPkts);
+    ovsdb_get_ifHCInOctets(idl, interface_row, &data->ifHCInOctets);
+    ovsdb_get_ifHCInUcastPkts(idl, interface_row, &data->ifHCInUcastPkts);
+    ovsdb_get_ifHCInMulticastPkts(idl, interface_row,
+                                  &data->ifHCInMulticastPkts);
+    ovsdb_get_ifHCInBroadcastPkts(idl, interface_row,
+                                  &data->ifHCInBroadcastPkts);
+    ovsdb_get_ifHCOutOctets(idl, interface_row, &data->ifHCOutOctets);
+    ovsdb_get_ifHCOutUcastPkts(idl, interface_row, &data->ifHCOutUcastPkts);
+    ovsdb_get_ifHCOutMulticastPkts(idl, interface_row,
+                                   &data->ifHCOutMulticastPkts);
+    ovsdb_get_ifHCOutBroadcastPkts(idl, interface_row,
+                                   &data->ifHCOutBroadcastPkts);
+    ovsdb_get_ifHighSpeed(idl, interface_row, &data->ifHighSpeed);
+    ovsdb_get_ifCounterDiscontinuityTime(idl, interface_row,
+                                         &data->ifCounterDiscontinuityTime);
+}
+
+static void ifXTable_counter_columns_copy(ifXTable_data *dst,
+                                          const ifXTable_data *src) {
+    dst->ifInMulticastPkts = src->ifInMulticastPkts;
+    dst->ifInBroadcastPkts = src->ifInBroadcastPkts;
+    dst->ifOutMulticastPkts = src->ifOutMulticastPkts;
+    dst->ifOutBroadcastPkts = src->ifOutBroadcastPkts;
+    dst->ifHCInOctets = src->ifHCInOctets;
+    dst->ifHCInUcastPkts = src->ifHCInUcastPkts;
+    dst->ifHCInMulticastPkts = src->ifHCInMulticastPkts;
+    dst->ifHCInBroadcastPkts = src->ifHCInBroadcastPkts;
+    dst->ifHCOutOctets = src->ifHCOutOctets;
+    dst->ifHCOutUcastPkts = src->ifHCOutUcastPkts;
+    dst->ifHCOutMulticastPkts = src->ifHCOutMulticastPkts;
+    dst->ifHCOutBroadcastPkts = src->ifHCOutBroadcastPkts;
+    dst->ifHighSpeed = src->ifHighSpeed;
+    dst->ifCounterDiscontinuityTime = src->ifCounterDiscontinuityTime;
+}
+
+/* A row given to another interface must not serve the counters of the
+ * previous one until the next counters refresh reads them. */
+static void ifXTable_counter_columns_clear(ifXTable_rowreq_ctx *rowreq_ctx) {
+    ifXTable_data zero;
+
+    memset(&zero, 0, sizeof(zero));
+    ifXTable_counter_columns_copy(&rowreq_ctx->data, &zero);
+    rowreq_ctx->counters_generation = 0;
+}
+
+static uint64_t ifXTable_u64(const U64 *value) {
+    return ((uint64_t)value->high << 32) | (value->low & 0xffffffff);
+}
+
+static void ifXTable_counter_columns_store(struct mib_columns *cols,
+                                           size_t row,
+                                           const ifXTable_data *data) {
+    mib_columns_set(cols, IFXTABLE_COUNTER_IFINMULTICASTPKTS, row,
+                    data->ifInMulticastPkts);
+    mib_columns_set(cols, IFXTABLE_COUNTER_IFINBROADCASTPKTS, row,
+                    data->ifInBroadcastPkts);
+    mib_columns_set(cols, IFXTABLE_COUNTER_IFOUTMULTICASTPKTS, row,
+                    data->ifOutMulticastPkts);
+    mib_columns_set(cols, IFXTABLE_COUNTER_IFOUTBROADCASTPKTS, row,
+                    data->ifOutBroadcastPkts);
+    mib_columns_set(cols, IFXTABLE_COUNTER_IFHCINOCTETS, row,
+                    ifXTable_u64(&data->ifHCInOctets));
+    mib_columns_set(cols, IFXTABLE_COUNTER_IFHCINUCASTPKTS, row,
+                    ifXTable_u64(&data->ifHCInUcastPkts));
+    mib_columns_set(cols, IFXTABLE_COUNTER_IFHCINMULTICASTPKTS, row,
+                    ifXTable_u64(&data->ifHCInMulticastPkts));
+    mib_columns_set(cols, IFXTABLE_COUNTER_IFHCINBROADCASTPKTS, row,
+                    ifXTable_u64(&data->ifHCInBroadcastPkts));
+    mib_columns_set(cols, IFXTABLE_COUNTER_IFHCOUTOCTETS, row,
+                    ifXTable_u64(&data->ifHCOutOctets));
+    mib_columns_set(cols, IFXTABLE_COUNTER_IFHCOUTUCASTPKTS, row,
+                    ifXTable_u64(&data->ifHCOutUcastPkts));
+    mib_columns_set(cols, IFXTABLE_COUNTER_IFHCOUTMULTICASTPKTS, row,
+                    ifXTable_u64(&data->ifHCOutMulticastPkts));
+    mib_columns_set(cols, IFXTABLE_COUNTER_IFHCOUTBROADCASTPKTS, row,
+                    ifXTable_u64(&data->ifHCOutBroadcastPkts));
+    mib_columns_set(cols, IFXTABLE_COUNTER_IFHIGHSPEED, row,
+                    data->ifHighSpeed);
+    mib_columns_set(cols, IFXTABLE_COUNTER_IFCOUNTERDISCONTINUITYTIME, row,
+                    data->ifCounterDiscontinuityTime);
+}
+
+/* Removes the rows the last snapshot did not see. */
+static void ifXTable_container_prune(netsnmp_container *container) {
+    netsnmp_iterator *it;
     ifXTable_rowreq_ctx *rowreq_ctx;
-    size_t count = 0;
+    ifXTable_rowreq_ctx **stale;
+    size_t n_stale = 0, i;
+
+    stale = malloc(CONTAINER_SIZE(container) * sizeof(*stale));
+    if (stale == NULL) {
+        snmp_log(LOG_ERR, "memory allocation failed");
+        return;
+    }
+
+    it = CONTAINER_ITERATOR(container);
+    if (it == NULL) {
+        free(stale);
+        return;
+    }
+    for (rowreq_ctx = ITERATOR_FIRST(it); rowreq_ctx != NULL;
+         rowreq_ctx = ITERATOR_NEXT(it)) {
+        if (rowreq_ctx->load_generation != ifXTable_load_generation) {
+            stale[n_stale++] = rowreq_ctx;
+        }
+    }
+    ITERATOR_RELEASE(it);
 
+    for (i = 0; i < n_stale; i++) {
+        CONTAINER_REMOVE(container, stale[i]);
+        ifXTable_release_rowreq_ctx(stale[i]);
+    }
+    free(stale);
+}
+
+static size_t ifXTable_refresh_begin(void) {
     const struct ovsrec_interface *interface_row = NULL;
+    struct ifXTable_snapshot_row *snap;
 
-    long ifIndex;
-
-    char ifName[255];
-    size_t ifName_len;
-    u_long ifInMulticastPkts;
-    u_long ifInBroadcastPkts;
-    u_long ifOutMulticastPkts;
-    u_long ifOutBroadcastPkts;
-    U64 ifHCInOctets;
-    U64 ifHCInUcastPkts;
-    U64 ifHCInMulticastPkts;
-    U64 ifHCInBroadcastPkts;
-    U64 ifHCOutOctets;
-    U64 ifHCOutUcastPkts;
-    U64 ifHCOutMulticastPkts;
-    U64 ifHCOutBroadcastPkts;
-    long ifLinkUpDownTrapEnable;
-    u_long ifHighSpeed;
-    long ifPromiscuousMode;
-    long ifConnectorPresent;
-    char ifAlias[64];
-    size_t ifAlias_len;
-    long ifCounterDiscontinuityTime;
-
-    interface_row = ovsrec_interface_first(idl);
-    if (!interface_row) {
-        snmp_log(LOG_ERR, "not able to fetch interface row");
-        return -1;
+    ifXTable_static_snapshot.n = 0;
+    if (ifXTable_container_get() == NULL) {
+        return 0;
     }
 
+    /* Table wide: when set, each row still compares its own connector and
+     * description in ifXTable_refresh_step(). */
+    ifXTable_static_modified =
+        OVSREC_IDL_IS_COLUMN_MODIFIED(ovsrec_interface_col_pm_info,
+                                      ifXTable_load_seqno) ||
+        OVSREC_IDL_IS_COLUMN_MODIFIED(ovsrec_interface_col_user_config,
+                                      ifXTable_load_seqno);
+    ifXTable_snapshot_seqno = ovsdb_idl_get_seqno(idl);
+
     OVSREC_INTERFACE_FOR_EACH(interface_row, idl) {
         if (ifXTable_skip_function(idl, interface_row)) {
             continue;
         }
-        ovsdb_get_ifIndex(idl, interface_row, &ifIndex);
-
-        ovsdb_get_ifName(idl, interface_row, ifName, &ifName_len);
-        ovsdb_get_ifInMulticastPkts(idl, interface_row, &ifInMulticastPkts);
-        ovsdb_get_ifInBroadcastPkts(idl, interface_row, &ifInBroadcastPkts);
-        ovsdb_get_ifOutMulticastPkts(idl, interface_row, &ifOutMulticastPkts);
-        ovsdb_get_ifOutBroadcastPkts(idl, interface_row, &ifOutBroadcastPkts);
-        ovsdb_get_ifHCInOctets(idl, interface_row, &ifHCInOctets);
-        ovsdb_get_ifHCInUcastPkts(idl, interface_row, &ifHCInUcastPkts);
-        ovsdb_get_ifHCInMulticastPkts(idl, interface_row, &ifHCInMulticastPkts);
-        ovsdb_get_ifHCInBroadcastPkts(idl, interface_row, &ifHCInBroadcastPkts);
-        ovsdb_get_ifHCOutOctets(idl, interface_row, &ifHCOutOctets);
-        ovsdb_get_ifHCOutUcastPkts(idl, interface_row, &ifHCOutUcastPkts);
-        ovsdb_get_ifHCOutMulticastPkts(idl, interface_row,
-                                       &ifHCOutMulticastPkts);
-        ovsdb_get_ifHCOutBroadcastPkts(idl, interface_row,
-                                       &ifHCOutBroadcastPkts);
-        ovsdb_get_ifLinkUpDownTrapEnable(idl, interface_row,
-                                         &ifLinkUpDownTrapEnable);
-        ovsdb_get_ifHighSpeed(idl, interface_row, &ifHighSpeed);
-        ovsdb_get_ifPromiscuousMode(idl, interface_row, &ifPromiscuousMode);
-        ovsdb_get_ifConnectorPresent(idl, interface_row, &ifConnectorPresent);
-        ovsdb_get_ifAlias(idl, interface_row, ifAlias, &ifAlias_len);
-        ovsdb_get_ifCounterDiscontinuityTime(idl, interface_row,
-                                             &ifCounterDiscontinuityTime);
-
-        rowreq_ctx = ifXTable_allocate_rowreq_ctx(NULL);
+        snap = ifXTable_snapshot_add(&ifXTable_static_snapshot);
+        if (snap == NULL) {
+            break;
+        }
+        snap->uuid = interface_row->header_.uuid;
+    }
+    return ifXTable_static_snapshot.n;
+}
+
+static void ifXTable_refresh_step(size_t i) {
+    struct ifXTable_snapshot_row *snap = &ifXTable_static_snapshot.rows[i];
+    const struct ovsrec_interface *interface_row;
+    ifXTable_rowreq_ctx *rowreq_ctx;
+
+    /* The interface may have been deleted since ifXTable_refresh_begin(). */
+    interface_row = ovsrec_interface_get_for_uuid(idl, &snap->uuid);
+    if (interface_row == NULL) {
+        snap->state = MIB_REFRESH_ROW_GONE;
+        return;
+    }
+    ovsdb_get_ifIndex(idl, interface_row, &snap->mib_idx.ifIndex);
+    if (snap->mib_idx.ifIndex == 0) {
+        /* The registry has no ifIndex left for it. */
+        snap->state = MIB_REFRESH_ROW_GONE;
+        return;
+    }
+
+    rowreq_ctx = ifXTable_row_find_by_mib_index(&snap->mib_idx);
+    if (rowreq_ctx == NULL) {
+        snap->state = MIB_REFRESH_ROW_NEW;
+        ifXTable_static_columns_get(interface_row, &snap->data);
+        ifXTable_counter_columns_get(interface_row, &snap->data);
+    } else if (!uuid_equals(&rowreq_ctx->uuid, &snap->uuid) ||
+               OVSREC_IDL_IS_ROW_INSERTED(interface_row, ifXTable_load_seqno) ||
+               (ifXTable_static_modified &&
+                ifXTable_static_source_changed(rowreq_ctx, interface_row))) {
+        snap->state = MIB_REFRESH_ROW_UPDATE;
+        ifXTable_static_columns_get(interface_row, &snap->data);
+    } else {
+        snap->state = MIB_REFRESH_ROW_KEEP;
+    }
+}
+
+static void ifXTable_refresh_publish(void) {
+    netsnmp_container *container = ifXTable_container_get();
+    ifXTable_rowreq_ctx *rowreq_ctx;
+    size_t count = 0, inserted = 0, i;
+
+    if (container == NULL) {
+        return;
+    }
+    ifXTable_load_generation++;
+
+    for (i = 0; i < ifXTable_static_snapshot.n; i++) {
+        struct ifXTable_snapshot_row *snap = &ifXTable_static_snapshot.rows[i];
+
+        if (snap->state == MIB_REFRESH_ROW_GONE) {
+            continue;
+        }
+        rowreq_ctx = ifXTable_row_find_by_mib_index(&snap->mib_idx);
         if (rowreq_ctx == NULL) {
-            snmp_log(LOG_ERR, "memory allocation failed");
-            return MFD_RESOURCE_UNAVAILABLE;
+            if (snap->state != MIB_REFRESH_ROW_NEW) {
+                continue;
+            }
+            rowreq_ctx = ifXTable_allocate_rowreq_ctx(NULL);
+            if (rowreq_ctx == NULL) {
+                snmp_log(LOG_ERR, "memory allocation failed");
+                return;
+            }
+            if (MFD_SUCCESS !=
+                ifXTable_indexes_set(rowreq_ctx, snap->mib_idx.ifIndex)) {
+                snmp_log(LOG_ERR, "error setting indexes while loading");
+                ifXTable_release_rowreq_ctx(rowreq_ctx);
+                continue;
+            }
+            if (CONTAINER_INSERT(container, rowreq_ctx) != 0) {
+                ifXTable_release_rowreq_ctx(rowreq_ctx);
+                continue;
+            }
+            rowreq_ctx->data = snap->data;
+            inserted++;
+        } else if (rowreq_ctx->load_generation == ifXTable_load_generation) {
+            /* Another interface already has this ifIndex. */
+            continue;
+        } else if (snap->state != MIB_REFRESH_ROW_KEEP) {
+            ifXTable_static_columns_copy(&rowreq_ctx->data, &snap->data);
+            if (!uuid_equals(&rowreq_ctx->uuid, &snap->uuid)) {
+                ifXTable_counter_columns_clear(rowreq_ctx);
+            }
+        }
+        rowreq_ctx->uuid = snap->uuid;
+        rowreq_ctx->load_generation = ifXTable_load_generation;
+        ++count;
+    }
+
+    if (count != CONTAINER_SIZE(container)) {
+        ifXTable_container_prune(container);
+    }
+    ifXTable_load_seqno = ifXTable_snapshot_seqno;
+
+    DEBUGMSGTL(("verbose:ifXTable:ifXTable_refresh_publish",
+                "published %d records, %d new\n", (int)count, (int)inserted));
+}
+
+struct mib_refresh ifXTable_refresh =
+    MIB_REFRESH_INITIALIZER("ifXTable", IFXTABLE_CACHE_TIMEOUT,
+                            ifXTable_refresh_begin, ifXTable_refresh_step,
+                            ifXTable_refresh_publish);
+
+static size_t ifXTable_counters_refresh_begin(void) {
+    netsnmp_container *container = ifXTable_container_get();
+    struct ifXTable_snapshot_row *snap;
+    ifXTable_rowreq_ctx *rowreq_ctx;
+    netsnmp_iterator *it;
+
+    ifXTable_counters_snapshot.n = 0;
+    if (container == NULL) {
+        return 0;
+    }
+
+    it = CONTAINER_ITERATOR(container);
+    if (it == NULL) {
+        return 0;
+    }
+    for (rowreq_ctx = ITERATOR_FIRST(it); rowreq_ctx != NULL;
+         rowreq_ctx = ITERATOR_NEXT(it)) {
+        snap = ifXTable_snapshot_add(&ifXTable_counters_snapshot);
+        if (snap == NULL) {
+            break;
+        }
+        snap->uuid = rowreq_ctx->uuid;
+        snap->mib_idx = rowreq_ctx->tbl_idx;
+    }
+    ITERATOR_RELEASE(it);
+
+    if (ifXTable_columnar) {
+        ifXTable_columns_building =
+            mib_columns_reset(&ifXTable_columns_back,
+                              ifXTable_counters_snapshot.n);
+    } else {
+        ifXTable_columns_building = false;
+        ifXTable_columns_free();
+    }
+    return ifXTable_counters_snapshot.n;
+}
+
+static void ifXTable_counters_refresh_step(size_t i) {
+    struct ifXTable_snapshot_row *snap = &ifXTable_counters_snapshot.rows[i];
+    const struct ovsrec_interface *interface_row;
+
+    interface_row = ovsrec_interface_get_for_uuid(idl, &snap->uuid);
+    if (interface_row == NULL) {
+        snap->state = MIB_REFRESH_ROW_GONE;
+        return;
+    }
+    snap->state = MIB_REFRESH_ROW_UPDATE;
+    ifXTable_counter_columns_get(interface_row, &snap->data);
+    if (ifXTable_columns_building) {
+        ifXTable_counter_columns_store(&ifXTable_columns_back, i, &snap->data);
+    }
+}
+
+static void ifXTable_counters_refresh_publish(void) {
+    ifXTable_rowreq_ctx *rowreq_ctx;
+    size_t i;
+
+    if (ifXTable_columns_building) {
+        mib_columns_swap(&ifXTable_columns, &ifXTable_columns_back);
+    }
+    for (i = 0; i < ifXTable_counters_snapshot.n; i++) {
+        struct ifXTable_snapshot_row *snap =
+            &ifXTable_counters_snapshot.rows[i];
+
+        if (snap->state == MIB_REFRESH_ROW_GONE) {
+            continue;
         }
-        if (MFD_SUCCESS != ifXTable_indexes_set(rowreq_ctx, ifIndex)) {
-            snmp_log(LOG_ERR, "error setting indexes while loading");
-            ifXTable_release_rowreq_ctx(rowreq_ctx);
+        /* ifXTable_refresh may have removed or reassigned the row since. */
+        rowreq_ctx = ifXTable_row_find_by_mib_index(&snap->mib_idx);
+        if (rowreq_ctx == NULL ||
+            !uuid_equals(&rowreq_ctx->uuid, &snap->uuid)) {
             continue;
         }
+        if (ifXTable_columns_building) {
+            rowreq_ctx->counters_generation = ifXTable_columns.generation;
+            rowreq_ctx->counters_ordinal = i;
+        } else {
+            ifXTable_counter_columns_copy(&rowreq_ctx->data, &snap->data);
+        }
+    }
+}
 
-        rowreq_ctx->data.ifName_len = ifName_len * sizeof(ifName[0]);
-        memcpy(rowreq_ctx->data.ifName, ifName, ifName_len * sizeof(ifName[0]));
-        rowreq_ctx->data.ifInMulticastPkts = ifInMulticastPkts;
-        rowreq_ctx->data.ifInBroadcastPkts = ifInBroadcastPkts;
-        rowreq_ctx->data.ifOutMulticastPkts = ifOutMulticastPkts;
-        rowreq_ctx->data.ifOutBroadcastPkts = ifOutBroadcastPkts;
-        rowreq_ctx->data.ifHCInOctets = ifHCInOctets;
-        rowreq_ctx->data.ifHCInUcastPkts = ifHCInUcastPkts;
-        rowreq_ctx->data.ifHCInMulticastPkts = ifHCInMulticastPkts;
-        rowreq_ctx->data.ifHCInBroadcastPkts = ifHCInBroadcastPkts;
-        rowreq_ctx->data.ifHCOutOctets = ifHCOutOctets;
-        rowreq_ctx->data.ifHCOutUcastPkts = ifHCOutUcastPkts;
-        rowreq_ctx->data.ifHCOutMulticastPkts = ifHCOutMulticastPkts;
-        rowreq_ctx->data.ifHCOutBroadcastPkts = ifHCOutBroadcastPkts;
-        rowreq_ctx->data.ifLinkUpDownTrapEnable = ifLinkUpDownTrapEnable;
-        rowreq_ctx->data.ifHighSpeed = ifHighSpeed;
-        rowreq_ctx->data.ifPromiscuousMode = ifPromiscuousMode;
-        rowreq_ctx->data.ifConnectorPresent = ifConnectorPresent;
-        rowreq_ctx->data.ifAlias_len = ifAlias_len * sizeof(ifAlias[0]);
-        memcpy(rowreq_ctx->data.ifAlias, ifAlias,
-               ifAlias_len * sizeof(ifAlias[0]));
-        rowreq_ctx->data.ifCounterDiscontinuityTime =
-            ifCounterDiscontinuityTime;
-        CONTAINER_INSERT(container, rowreq_ctx);
-        ++count;
+struct mib_refresh ifXTable_counters_refresh =
+    MIB_REFRESH_INITIALIZER("ifXTable counters", IFXTABLE_COUNTERS_TIMEOUT,
+                            ifXTable_counters_refresh_begin,
+                            ifXTable_counters_refresh_step,
+                            ifXTable_counters_refresh_publish);
+
+int ifXTable_container_load(netsnmp_container *container) {
+    DEBUGMSGTL(("verbose:ifXTable:ifXTable_container_load", "called\n"));
+
+    /* ops_snmp_run() normally keeps the snapshots fresh. */
+    if (!mib_refresh_ready(&ifXTable_refresh)) {
+        mib_refresh_sync(&ifXTable_refresh);
+    }
+    if (!mib_refresh_ready(&ifXTable_counters_refresh)) {
+        mib_refresh_sync(&ifXTable_counters_refresh);
     }
-    DEBUGMSGTL(("verbose:ifXTable:ifXTable_container_load",
-                "inserted %d records\n", (int)count));
+    /* A snapshot built here may have added names. */
+    ifindex_registry_flush();
     return MFD_SUCCESS;
 }
 
@@ -1,10 +1,48 @@
 #ifndef IFXTABLE_DATA_ACCESS_H
 #define IFXTABLE_DATA_ACCESS_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
 extern struct ovsdb_idl *idl;
 
+/* Build the snapshots of the ifXTable container, see mib_refresh.h: the rows
+ * and their static columns, and the counter columns of the rows. */
+extern struct mib_refresh ifXTable_refresh;
+extern struct mib_refresh ifXTable_counters_refresh;
+
 int ifXTable_init_data(ifXTable_registration *ifXTable_reg);
+/* Default intervals of the two refreshes, in seconds. */
 #define IFXTABLE_CACHE_TIMEOUT 30
+#define IFXTABLE_COUNTERS_TIMEOUT 5
+
+/* The columns of the columnar counter snapshot, see mib_columns.h. */
+enum ifXTable_counter {
+    IFXTABLE_COUNTER_IFINMULTICASTPKTS,
+    IFXTABLE_COUNTER_IFINBROADCASTPKTS,
+    IFXTABLE_COUNTER_IFOUTMULTICASTPKTS,
+    IFXTABLE_COUNTER_IFOUTBROADCASTPKTS,
+    IFXTABLE_COUNTER_IFHCINOCTETS,
+    IFXTABLE_COUNTER_IFHCINUCASTPKTS,
+    IFXTABLE_COUNTER_IFHCINMULTICASTPKTS,
+    IFXTABLE_COUNTER_IFHCINBROADCASTPKTS,
+    IFXTABLE_COUNTER_IFHCOUTOCTETS,
+    IFXTABLE_COUNTER_IFHCOUTUCASTPKTS,
+    IFXTABLE_COUNTER_IFHCOUTMULTICASTPKTS,
+    IFXTABLE_COUNTER_IFHCOUTBROADCASTPKTS,
+    IFXTABLE_COUNTER_IFHIGHSPEED,
+    IFXTABLE_COUNTER_IFCOUNTERDISCONTINUITYTIME,
+    IFXTABLE_N_COUNTERS
+};
+
+/* Serves the counter columns from a columnar snapshot instead of the rows,
+ * from the next counters refresh on. */
+void ifXTable_columns_enable(bool enable);
+
+/* Returns true and the value of 'counter' for the row if the columnar
+ * snapshot has it, false to read it from the row. */
+bool ifXTable_counter_lookup(const ifXTable_rowreq_ctx *rowreq_ctx,
+                             enum ifXTable_counter counter, uint64_t *value);
 void ifXTable_container_init(netsnmp_container **container_ptr_ptr,
                              netsnmp_cache *cache);
 void ifXTable_container_shutdown(netsnmp_container *container_ptr);
@@ -54,121 +54,215 @@ int ifName_get(ifXTable_rowreq_ctx *rowreq_ctx, char **ifName_val_ptr_ptr,
 
 int ifInMulticastPkts_get(ifXTable_rowreq_ctx *rowreq_ctx,
                           u_long *ifInMulticastPkts_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifInMulticastPkts_val_ptr);
     DEBUGMSGTL(("verbose:ifXTable:ifInMulticastPkts_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifInMulticastPkts_val_ptr) = rowreq_ctx->data.ifInMulticastPkts;
+    if (ifXTable_counter_lookup(rowreq_ctx, IFXTABLE_COUNTER_IFINMULTICASTPKTS,
+                                &value)) {
+        (*ifInMulticastPkts_val_ptr) = value;
+    } else {
+        (*ifInMulticastPkts_val_ptr) = rowreq_ctx->data.ifInMulticastPkts;
+    }
     return MFD_SUCCESS;
 }
 
 int ifInBroadcastPkts_get(ifXTable_rowreq_ctx *rowreq_ctx,
                           u_long *ifInBroadcastPkts_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifInBroadcastPkts_val_ptr);
     DEBUGMSGTL(("verbose:ifXTable:ifInBroadcastPkts_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifInBroadcastPkts_val_ptr) = rowreq_ctx->data.ifInBroadcastPkts;
+    if (ifXTable_counter_lookup(rowreq_ctx, IFXTABLE_COUNTER_IFINBROADCASTPKTS,
+                                &value)) {
+        (*ifInBroadcastPkts_val_ptr) = value;
+    } else {
+        (*ifInBroadcastPkts_val_ptr) = rowreq_ctx->data.ifInBroadcastPkts;
+    }
     return MFD_SUCCESS;
 }
 
 int ifOutMulticastPkts_get(ifXTable_rowreq_ctx *rowreq_ctx,
                            u_long *ifOutMulticastPkts_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifOutMulticastPkts_val_ptr);
     DEBUGMSGTL(("verbose:ifXTable:ifOutMulticastPkts_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifOutMulticastPkts_val_ptr) = rowreq_ctx->data.ifOutMulticastPkts;
+    if (ifXTable_counter_lookup(rowreq_ctx,
+                                IFXTABLE_COUNTER_IFOUTMULTICASTPKTS, &value)) {
+        (*ifOutMulticastPkts_val_ptr) = value;
+    } else {
+        (*ifOutMulticastPkts_val_ptr) = rowreq_ctx->data.ifOutMulticastPkts;
+    }
     return MFD_SUCCESS;
 }
 
 int ifOutBroadcastPkts_get(ifXTable_rowreq_ctx *rowreq_ctx,
                            u_long *ifOutBroadcastPkts_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifOutBroadcastPkts_val_ptr);
     DEBUGMSGTL(("verbose:ifXTable:ifOutBroadcastPkts_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifOutBroadcastPkts_val_ptr) = rowreq_ctx->data.ifOutBroadcastPkts;
+    if (ifXTable_counter_lookup(rowreq_ctx,
+                                IFXTABLE_COUNTER_IFOUTBROADCASTPKTS, &value)) {
+        (*ifOutBroadcastPkts_val_ptr) = value;
+    } else {
+        (*ifOutBroadcastPkts_val_ptr) = rowreq_ctx->data.ifOutBroadcastPkts;
+    }
     return MFD_SUCCESS;
 }
 
 int ifHCInOctets_get(ifXTable_rowreq_ctx *rowreq_ctx,
                      U64 *ifHCInOctets_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifHCInOctets_val_ptr);
     DEBUGMSGTL(("verbose:ifXTable:ifHCInOctets_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifHCInOctets_val_ptr) = rowreq_ctx->data.ifHCInOctets;
+    if (ifXTable_counter_lookup(rowreq_ctx, IFXTABLE_COUNTER_IFHCINOCTETS,
+                                &value)) {
+        ifHCInOctets_val_ptr->high = value >> 32;
+        ifHCInOctets_val_ptr->low = value & 0xffffffff;
+    } else {
+        (*ifHCInOctets_val_ptr) = rowreq_ctx->data.ifHCInOctets;
+    }
     return MFD_SUCCESS;
 }
 
 int ifHCInUcastPkts_get(ifXTable_rowreq_ctx *rowreq_ctx,
                         U64 *ifHCInUcastPkts_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifHCInUcastPkts_val_ptr);
     DEBUGMSGTL(("verbose:ifXTable:ifHCInUcastPkts_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifHCInUcastPkts_val_ptr) = rowreq_ctx->data.ifHCInUcastPkts;
+    if (ifXTable_counter_lookup(rowreq_ctx, IFXTABLE_COUNTER_IFHCINUCASTPKTS,
+                                &value)) {
+        ifHCInUcastPkts_val_ptr->high = value >> 32;
+        ifHCInUcastPkts_val_ptr->low = value & 0xffffffff;
+    } else {
+        (*ifHCInUcastPkts_val_ptr) = rowreq_ctx->data.ifHCInUcastPkts;
+    }
     return MFD_SUCCESS;
 }
 
 int ifHCInMulticastPkts_get(ifXTable_rowreq_ctx *rowreq_ctx,
                             U64 *ifHCInMulticastPkts_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifHCInMulticastPkts_val_ptr);
     DEBUGMSGTL(("verbose:ifXTable:ifHCInMulticastPkts_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifHCInMulticastPkts_val_ptr) = rowreq_ctx->data.ifHCInMulticastPkts;
+    if (ifXTable_counter_lookup(
+            rowreq_ctx, IFXTABLE_COUNTER_IFHCINMULTICASTPKTS, &value)) {
+        ifHCInMulticastPkts_val_ptr->high = value >> 32;
+        ifHCInMulticastPkts_val_ptr->low = value & 0xffffffff;
+    } else {
+        (*ifHCInMulticastPkts_val_ptr) = rowreq_ctx->data.ifHCInMulticastPkts;
+    }
     return MFD_SUCCESS;
 }
 
 int ifHCInBroadcastPkts_get(ifXTable_rowreq_ctx *rowreq_ctx,
                             U64 *ifHCInBroadcastPkts_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifHCInBroadcastPkts_val_ptr);
     DEBUGMSGTL(("verbose:ifXTable:ifHCInBroadcastPkts_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifHCInBroadcastPkts_val_ptr) = rowreq_ctx->data.ifHCInBroadcastPkts;
+    if (ifXTable_counter_lookup(
+            rowreq_ctx, IFXTABLE_COUNTER_IFHCINBROADCASTPKTS, &value)) {
+        ifHCInBroadcastPkts_val_ptr->high = value >> 32;
+        ifHCInBroadcastPkts_val_ptr->low = value & 0xffffffff;
+    } else {
+        (*ifHCInBroadcastPkts_val_ptr) = rowreq_ctx->data.ifHCInBroadcastPkts;
+    }
     return MFD_SUCCESS;
 }
 
 int ifHCOutOctets_get(ifXTable_rowreq_ctx *rowreq_ctx,
                       U64 *ifHCOutOctets_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifHCOutOctets_val_ptr);
     DEBUGMSGTL(("verbose:ifXTable:ifHCOutOctets_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifHCOutOctets_val_ptr) = rowreq_ctx->data.ifHCOutOctets;
+    if (ifXTable_counter_lookup(rowreq_ctx, IFXTABLE_COUNTER_IFHCOUTOCTETS,
+                                &value)) {
+        ifHCOutOctets_val_ptr->high = value >> 32;
+        ifHCOutOctets_val_ptr->low = value & 0xffffffff;
+    } else {
+        (*ifHCOutOctets_val_ptr) = rowreq_ctx->data.ifHCOutOctets;
+    }
     return MFD_SUCCESS;
 }
 
 int ifHCOutUcastPkts_get(ifXTable_rowreq_ctx *rowreq_ctx,
                          U64 *ifHCOutUcastPkts_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifHCOutUcastPkts_val_ptr);
     DEBUGMSGTL(("verbose:ifXTable:ifHCOutUcastPkts_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifHCOutUcastPkts_val_ptr) = rowreq_ctx->data.ifHCOutUcastPkts;
+    if (ifXTable_counter_lookup(rowreq_ctx, IFXTABLE_COUNTER_IFHCOUTUCASTPKTS,
+                                &value)) {
+        ifHCOutUcastPkts_val_ptr->high = value >> 32;
+        ifHCOutUcastPkts_val_ptr->low = value & 0xffffffff;
+    } else {
+        (*ifHCOutUcastPkts_val_ptr) = rowreq_ctx->data.ifHCOutUcastPkts;
+    }
     return MFD_SUCCESS;
 }
 
 int ifHCOutMulticastPkts_get(ifXTable_rowreq_ctx *rowreq_ctx,
                              U64 *ifHCOutMulticastPkts_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifHCOutMulticastPkts_val_ptr);
     DEBUGMSGTL(("verbose:ifXTable:ifHCOutMulticastPkts_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifHCOutMulticastPkts_val_ptr) = rowreq_ctx->data.ifHCOutMulticastPkts;
+    if (ifXTable_counter_lookup(
+            rowreq_ctx, IFXTABLE_COUNTER_IFHCOUTMULTICASTPKTS, &value)) {
+        ifHCOutMulticastPkts_val_ptr->high = value >> 32;
+        ifHCOutMulticastPkts_val_ptr->low = value & 0xffffffff;
+    } else {
+        (*ifHCOutMulticastPkts_val_ptr) =
+            rowreq_ctx->data.ifHCOutMulticastPkts;
+    }
     return MFD_SUCCESS;
 }
 
 int ifHCOutBroadcastPkts_get(ifXTable_rowreq_ctx *rowreq_ctx,
                              U64 *ifHCOutBroadcastPkts_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifHCOutBroadcastPkts_val_ptr);
     DEBUGMSGTL(("verbose:ifXTable:ifHCOutBroadcastPkts_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifHCOutBroadcastPkts_val_ptr) = rowreq_ctx->data.ifHCOutBroadcastPkts;
+    if (ifXTable_counter_lookup(
+            rowreq_ctx, IFXTABLE_COUNTER_IFHCOUTBROADCASTPKTS, &value)) {
+        ifHCOutBroadcastPkts_val_ptr->high = value >> 32;
+        ifHCOutBroadcastPkts_val_ptr->low = value & 0xffffffff;
+    } else {
+        (*ifHCOutBroadcastPkts_val_ptr) =
+            rowreq_ctx->data.ifHCOutBroadcastPkts;
+    }
     return MFD_SUCCESS;
 }
 
@@ -184,11 +278,18 @@ int ifLinkUpDownTrapEnable_get(ifXTable_rowreq_ctx *rowreq_ctx,
 
 int ifHighSpeed_get(ifXTable_rowreq_ctx *rowreq_ctx,
                     u_long *ifHighSpeed_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifHighSpeed_val_ptr);
     DEBUGMSGTL(("verbose:ifXTable:ifHighSpeed_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifHighSpeed_val_ptr) = rowreq_ctx->data.ifHighSpeed;
+    if (ifXTable_counter_lookup(rowreq_ctx, IFXTABLE_COUNTER_IFHIGHSPEED,
+                                &value)) {
+        (*ifHighSpeed_val_ptr) = value;
+    } else {
+        (*ifHighSpeed_val_ptr) = rowreq_ctx->data.ifHighSpeed;
+    }
     return MFD_SUCCESS;
 }
 
@@ -240,11 +341,18 @@ int ifAlias_get(ifXTable_rowreq_ctx *rowreq_ctx, char **ifAlias_val_ptr_ptr,
 
 int ifCounterDiscontinuityTime_get(ifXTable_rowreq_ctx *rowreq_ctx,
                                    long *ifCounterDiscontinuityTime_val_ptr) {
+    uint64_t value;
+
     netsnmp_assert(NULL != ifCounterDiscontinuityTime_val_ptr);
     DEBUGMSGTL(("verbose:ifXTable:ifCounterDiscontinuityTime_get", "called\n"));
     netsnmp_assert(NULL != rowreq_ctx);
 
-    (*ifCounterDiscontinuityTime_val_ptr) =
-        rowreq_ctx->data.ifCounterDiscontinuityTime;
+    if (ifXTable_counter_lookup(
+            rowreq_ctx, IFXTABLE_COUNTER_IFCOUNTERDISCONTINUITYTIME, &value)) {
+        (*ifCounterDiscontinuityTime_val_ptr) = value;
+    } else {
+        (*ifCounterDiscontinuityTime_val_ptr) =
+            rowreq_ctx->data.ifCounterDiscontinuityTime;
+    }
     return MFD_SUCCESS;
 }
@@ -2,4 +2,99 @@
 #include <net-snmp/net-snmp-features.h>
 #include <net-snmp/net-snmp-includes.h>
 #include <net-snmp/agent/net-snmp-agent-includes.h>
+#include "IF_MIB_custom.h"
+#include "IF_MIB_txn.h"
 #include "ifXTable.h"
+
+int ifXTable_undo_setup(ifXTable_rowreq_ctx *rowreq_ctx) {
+    DEBUGMSGTL(("verbose:ifXTable:ifXTable_undo_setup", "called\n"));
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    memcpy(rowreq_ctx->undo, &rowreq_ctx->data, sizeof(ifXTable_data));
+    if_mib_txn_row_add();
+    return MFD_SUCCESS;
+}
+
+int ifXTable_undo(ifXTable_rowreq_ctx *rowreq_ctx) {
+    DEBUGMSGTL(("verbose:ifXTable:ifXTable_undo", "called\n"));
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    if (rowreq_ctx->column_set_flags & COLUMN_IFALIAS_FLAG) {
+        memcpy(rowreq_ctx->data.ifAlias, rowreq_ctx->undo->ifAlias,
+               rowreq_ctx->undo->ifAlias_len);
+        rowreq_ctx->data.ifAlias_len = rowreq_ctx->undo->ifAlias_len;
+    }
+    return MFD_SUCCESS;
+}
+
+/* Like ifTable_commit(): the transaction is shared by both tables. */
+int ifXTable_commit(ifXTable_rowreq_ctx *rowreq_ctx) {
+    const struct ovsrec_interface *interface_row;
+
+    DEBUGMSGTL(("verbose:ifXTable:ifXTable_commit", "called\n"));
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    interface_row = ovsrec_interface_get_for_uuid(idl, &rowreq_ctx->uuid);
+    if (NULL == interface_row) {
+        snmp_log(LOG_ERR, "ifXTable: no Interface row for ifIndex %ld\n",
+                 rowreq_ctx->tbl_idx.ifIndex);
+        return MFD_ERROR;
+    }
+    if (NULL == if_mib_txn_get()) {
+        return MFD_ERROR;
+    }
+
+    if (rowreq_ctx->column_set_flags & COLUMN_IFALIAS_FLAG) {
+        ifAlias_custom_set(idl, interface_row, rowreq_ctx->data.ifAlias,
+                           rowreq_ctx->data.ifAlias_len);
+    }
+    rowreq_ctx->rowreq_flags |= MFD_ROW_DIRTY;
+    return MFD_SUCCESS;
+}
+
+int ifXTable_undo_commit(ifXTable_rowreq_ctx *rowreq_ctx) {
+    DEBUGMSGTL(("verbose:ifXTable:ifXTable_undo_commit", "called\n"));
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    if_mib_txn_abort();
+    rowreq_ctx->rowreq_flags &= ~MFD_ROW_DIRTY;
+    return MFD_SUCCESS;
+}
+
+int ifXTable_irreversible_commit(ifXTable_rowreq_ctx *rowreq_ctx) {
+    DEBUGMSGTL(("verbose:ifXTable:ifXTable_irreversible_commit", "called\n"));
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    if (!(rowreq_ctx->rowreq_flags & MFD_ROW_DIRTY)) {
+        return MFD_SUCCESS;
+    }
+    rowreq_ctx->rowreq_flags &= ~MFD_ROW_DIRTY;
+
+    if (MFD_SUCCESS != if_mib_txn_row_commit()) {
+        ifXTable_undo(rowreq_ctx);
+        return MFD_ERROR;
+    }
+    return MFD_SUCCESS;
+}
+
+int ifAlias_check_value(ifXTable_rowreq_ctx *rowreq_ctx, char *ifAlias_val_ptr,
+                        size_t ifAlias_val_ptr_len) {
+    DEBUGMSGTL(("verbose:ifXTable:ifAlias_check_value", "called\n"));
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    /* The description ends up in an OVSDB string. */
+    if (memchr(ifAlias_val_ptr, '\0', ifAlias_val_ptr_len) != NULL) {
+        return MFD_NOT_VALID_EVER;
+    }
+    return MFD_SUCCESS;
+}
+
+int ifAlias_set(ifXTable_rowreq_ctx *rowreq_ctx, char *ifAlias_val_ptr,
+                size_t ifAlias_val_ptr_len) {
+    DEBUGMSGTL(("verbose:ifXTable:ifAlias_set", "called\n"));
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    memcpy(rowreq_ctx->data.ifAlias, ifAlias_val_ptr, ifAlias_val_ptr_len);
+    rowreq_ctx->data.ifAlias_len = ifAlias_val_ptr_len;
+    return MFD_SUCCESS;
+}
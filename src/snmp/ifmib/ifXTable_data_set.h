@@ -1,3 +1,13 @@
 #ifndef IFXTABLE_DATA_SET_H
 #define IFXTABLE_DATA_SET_H
+int ifXTable_undo_setup(ifXTable_rowreq_ctx *rowreq_ctx);
+int ifXTable_undo(ifXTable_rowreq_ctx *rowreq_ctx);
+int ifXTable_commit(ifXTable_rowreq_ctx *rowreq_ctx);
+int ifXTable_undo_commit(ifXTable_rowreq_ctx *rowreq_ctx);
+int ifXTable_irreversible_commit(ifXTable_rowreq_ctx *rowreq_ctx);
+
+int ifAlias_check_value(ifXTable_rowreq_ctx *rowreq_ctx, char *ifAlias_val_ptr,
+                        size_t ifAlias_val_ptr_len);
+int ifAlias_set(ifXTable_rowreq_ctx *rowreq_ctx, char *ifAlias_val_ptr,
+                size_t ifAlias_val_ptr_len);
 #endif
@@ -1,3 +1,8 @@
 #ifndef IFXTABLE_ENUMS_H
 #define IFXTABLE_ENUMS_H
+
+/* ifLinkUpDownTrapEnable */
+#define IFLINKUPDOWNTRAPENABLE_ENABLED  1
+#define IFLINKUPDOWNTRAPENABLE_DISABLED 2
+
 #endif
@@ -45,6 +45,14 @@ static Netsnmp_Node_Handler _mfd_ifXTable_pre_request;
 static Netsnmp_Node_Handler _mfd_ifXTable_post_request;
 static Netsnmp_Node_Handler _mfd_ifXTable_object_lookup;
 static Netsnmp_Node_Handler _mfd_ifXTable_get_values;
+static Netsnmp_Node_Handler _mfd_ifXTable_check_objects;
+static Netsnmp_Node_Handler _mfd_ifXTable_undo_setup;
+static Netsnmp_Node_Handler _mfd_ifXTable_set_values;
+static Netsnmp_Node_Handler _mfd_ifXTable_undo_cleanup;
+static Netsnmp_Node_Handler _mfd_ifXTable_undo_values;
+static Netsnmp_Node_Handler _mfd_ifXTable_commit;
+static Netsnmp_Node_Handler _mfd_ifXTable_undo_commit;
+static Netsnmp_Node_Handler _mfd_ifXTable_irreversible_commit;
 
 void _ifXTable_initialize_interface(ifXTable_registration *reg_ptr,
                                     u_long flags) {
@@ -73,6 +81,15 @@ void _ifXTable_initialize_interface(ifXTable_registration *reg_ptr,
     access_multiplexer->object_lookup = _mfd_ifXTable_object_lookup;
     access_multiplexer->get_values = _mfd_ifXTable_get_values;
 
+    access_multiplexer->object_syntax_checks = _mfd_ifXTable_check_objects;
+    access_multiplexer->undo_setup = _mfd_ifXTable_undo_setup;
+    access_multiplexer->undo_cleanup = _mfd_ifXTable_undo_cleanup;
+    access_multiplexer->set_values = _mfd_ifXTable_set_values;
+    access_multiplexer->undo_sets = _mfd_ifXTable_undo_values;
+    access_multiplexer->commit = _mfd_ifXTable_commit;
+    access_multiplexer->undo_commit = _mfd_ifXTable_undo_commit;
+    access_multiplexer->irreversible_commit = _mfd_ifXTable_irreversible_commit;
+
     access_multiplexer->pre_request = _mfd_ifXTable_pre_request;
     access_multiplexer->post_request = _mfd_ifXTable_post_request;
 
@@ -82,7 +99,7 @@ void _ifXTable_initialize_interface(ifXTable_registration *reg_ptr,
     handler = netsnmp_baby_steps_access_multiplexer_get(access_multiplexer);
     reginfo = netsnmp_handler_registration_create(
         "ifXTable", handler, ifXTable_oid, ifXTable_oid_size,
-        HANDLER_CAN_BABY_STEP | HANDLER_CAN_RONLY);
+        HANDLER_CAN_BABY_STEP | HANDLER_CAN_RWRITE);
 
     if (NULL == reginfo) {
         snmp_log(LOG_ERR, "error registering table ifXTable\n");
@@ -97,6 +114,22 @@ void _ifXTable_initialize_interface(ifXTable_registration *reg_ptr,
         mfd_modes |= BABY_STEP_PRE_REQUEST;
     if (access_multiplexer->post_request)
         mfd_modes |= BABY_STEP_POST_REQUEST;
+    if (access_multiplexer->object_syntax_checks)
+        mfd_modes |= BABY_STEP_CHECK_OBJECT;
+    if (access_multiplexer->undo_setup)
+        mfd_modes |= BABY_STEP_UNDO_SETUP;
+    if (access_multiplexer->undo_cleanup)
+        mfd_modes |= BABY_STEP_UNDO_CLEANUP;
+    if (access_multiplexer->set_values)
+        mfd_modes |= BABY_STEP_SET_VALUES;
+    if (access_multiplexer->undo_sets)
+        mfd_modes |= BABY_STEP_UNDO_SETS;
+    if (access_multiplexer->commit)
+        mfd_modes |= BABY_STEP_COMMIT;
+    if (access_multiplexer->undo_commit)
+        mfd_modes |= BABY_STEP_UNDO_COMMIT;
+    if (access_multiplexer->irreversible_commit)
+        mfd_modes |= BABY_STEP_IRREVERSIBLE_COMMIT;
 
     handler = netsnmp_baby_steps_handler_get(mfd_modes);
     netsnmp_inject_handler(reginfo, handler);
@@ -195,6 +228,7 @@ void ifXTable_release_rowreq_ctx(ifXTable_rowreq_ctx *rowreq_ctx) {
     netsnmp_assert(NULL != rowreq_ctx);
 
     ifXTable_rowreq_ctx_cleanup(rowreq_ctx);
+    SNMP_FREE(rowreq_ctx->undo);
     if (rowreq_ctx->oid_idx.oids != rowreq_ctx->oid_tmp) {
         free(rowreq_ctx->oid_idx.oids);
     }
@@ -452,6 +486,254 @@ int _mfd_ifXTable_get_values(netsnmp_mib_handler *handler,
     return SNMP_ERR_NOERROR;
 }
 
+NETSNMP_STATIC_INLINE int
+_ifXTable_check_column(ifXTable_rowreq_ctx *rowreq_ctx,
+                       netsnmp_variable_list *var,
+                       int column) {
+    int rc = SNMPERR_SUCCESS;
+
+    DEBUGMSGTL(("internal:ifXTable:_ifXTable_check_column", "called for %d\n",
+                column));
+
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    switch (column) {
+    case COLUMN_IFALIAS:
+        rc = netsnmp_check_vb_type_and_max_size(
+            var, ASN_OCTET_STR, sizeof(rowreq_ctx->data.ifAlias));
+        if (SNMPERR_SUCCESS == rc) {
+            rc = ifAlias_check_value(rowreq_ctx, (char *)var->val.string,
+                                     var->val_len);
+        }
+        break;
+    default:
+        rc = SNMP_ERR_NOTWRITABLE;
+        break;
+    }
+
+    return rc;
+}
+
+int _mfd_ifXTable_check_objects(netsnmp_mib_handler *handler,
+                                netsnmp_handler_registration *reginfo,
+                                netsnmp_agent_request_info *agtreq_info,
+                                netsnmp_request_info *requests) {
+    ifXTable_rowreq_ctx *rowreq_ctx =
+        (ifXTable_rowreq_ctx *)netsnmp_container_table_row_extract(requests);
+    netsnmp_table_request_info *tri;
+    int rc;
+
+    DEBUGMSGTL(("internal:ifXTable:_mfd_ifXTable_check_objects", "called\n"));
+
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    for (; requests; requests = requests->next) {
+        tri = netsnmp_extract_table_info(requests);
+        if (NULL == tri) {
+            continue;
+        }
+        rc = _ifXTable_check_column(rowreq_ctx, requests->requestvb,
+                                    tri->colnum);
+        if (rc) {
+            netsnmp_request_set_error(requests, SNMP_VALIDATE_ERR(rc));
+            break;
+        }
+    }
+
+    return SNMP_ERR_NOERROR;
+}
+
+static int _mfd_ifXTable_undo_setup(netsnmp_mib_handler *handler,
+                                    netsnmp_handler_registration *reginfo,
+                                    netsnmp_agent_request_info *agtreq_info,
+                                    netsnmp_request_info *requests) {
+    ifXTable_rowreq_ctx *rowreq_ctx =
+        (ifXTable_rowreq_ctx *)netsnmp_container_table_row_extract(requests);
+    int rc;
+
+    DEBUGMSGTL(("internal:ifXTable:_mfd_ifXTable_undo_setup", "called\n"));
+
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    rowreq_ctx->column_set_flags = 0;
+    rowreq_ctx->undo = SNMP_MALLOC_TYPEDEF(ifXTable_data);
+    if (NULL == rowreq_ctx->undo) {
+        netsnmp_request_set_error_all(requests,
+                                      SNMP_ERR_RESOURCEUNAVAILABLE);
+        return SNMP_ERR_NOERROR;
+    }
+
+    rc = ifXTable_undo_setup(rowreq_ctx);
+    if (MFD_SUCCESS != rc) {
+        DEBUGMSGTL(("ifXTable:mfd", "error %d from ifXTable_undo_setup\n", rc));
+        netsnmp_request_set_error_all(requests, SNMP_VALIDATE_ERR(rc));
+    }
+
+    return SNMP_ERR_NOERROR;
+}
+
+static int _mfd_ifXTable_undo_cleanup(netsnmp_mib_handler *handler,
+                                      netsnmp_handler_registration *reginfo,
+                                      netsnmp_agent_request_info *agtreq_info,
+                                      netsnmp_request_info *requests) {
+    ifXTable_rowreq_ctx *rowreq_ctx =
+        (ifXTable_rowreq_ctx *)netsnmp_container_table_row_extract(requests);
+
+    DEBUGMSGTL(("internal:ifXTable:_mfd_ifXTable_undo_cleanup", "called\n"));
+
+    if (NULL == rowreq_ctx) {
+        return SNMP_ERR_NOERROR;
+    }
+
+    SNMP_FREE(rowreq_ctx->undo);
+    rowreq_ctx->column_set_flags = 0;
+    return SNMP_ERR_NOERROR;
+}
+
+NETSNMP_STATIC_INLINE int _ifXTable_set_column(ifXTable_rowreq_ctx *rowreq_ctx,
+                                               netsnmp_variable_list *var,
+                                               int column) {
+    int rc = SNMPERR_SUCCESS;
+
+    DEBUGMSGTL(("internal:ifXTable:_ifXTable_set_column",
+                "called for %d\n", column));
+
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    switch (column) {
+    case COLUMN_IFALIAS:
+        rowreq_ctx->column_set_flags |= COLUMN_IFALIAS_FLAG;
+        rc = ifAlias_set(rowreq_ctx, (char *)var->val.string, var->val_len);
+        break;
+    default:
+        snmp_log(LOG_ERR, "unknown column %d in _ifXTable_set_column\n",
+                 column);
+        rc = SNMP_ERR_GENERR;
+        break;
+    }
+
+    return rc;
+}
+
+int _mfd_ifXTable_set_values(netsnmp_mib_handler *handler,
+                             netsnmp_handler_registration *reginfo,
+                             netsnmp_agent_request_info *agtreq_info,
+                             netsnmp_request_info *requests) {
+    ifXTable_rowreq_ctx *rowreq_ctx =
+        (ifXTable_rowreq_ctx *)netsnmp_container_table_row_extract(requests);
+    netsnmp_table_request_info *tri;
+    int rc = SNMP_ERR_NOERROR;
+
+    DEBUGMSGTL(("internal:ifXTable:_mfd_ifXTable_set_values", "called\n"));
+
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    for (; requests; requests = requests->next) {
+        tri = netsnmp_extract_table_info(requests);
+        if (NULL == tri) {
+            continue;
+        }
+        rc = _ifXTable_set_column(rowreq_ctx, requests->requestvb, tri->colnum);
+        if (MFD_SUCCESS != rc) {
+            DEBUGMSGTL(("ifXTable:mfd",
+                        "error %d from ifXTable_set_column\n", rc));
+            netsnmp_request_set_error(requests, SNMP_VALIDATE_ERR(rc));
+        }
+    }
+
+    return SNMP_ERR_NOERROR;
+}
+
+static int _mfd_ifXTable_undo_values(netsnmp_mib_handler *handler,
+                                     netsnmp_handler_registration *reginfo,
+                                     netsnmp_agent_request_info *agtreq_info,
+                                     netsnmp_request_info *requests) {
+    ifXTable_rowreq_ctx *rowreq_ctx =
+        (ifXTable_rowreq_ctx *)netsnmp_container_table_row_extract(requests);
+    int rc;
+
+    DEBUGMSGTL(("internal:ifXTable:_mfd_ifXTable_undo_values", "called\n"));
+
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    if (NULL == rowreq_ctx->undo) {
+        return SNMP_ERR_NOERROR;
+    }
+    rc = ifXTable_undo(rowreq_ctx);
+    if (MFD_SUCCESS != rc) {
+        DEBUGMSGTL(("ifXTable:mfd", "error %d from ifXTable_undo\n", rc));
+    }
+
+    return SNMP_ERR_NOERROR;
+}
+
+static int _mfd_ifXTable_commit(netsnmp_mib_handler *handler,
+                                netsnmp_handler_registration *reginfo,
+                                netsnmp_agent_request_info *agtreq_info,
+                                netsnmp_request_info *requests) {
+    ifXTable_rowreq_ctx *rowreq_ctx =
+        (ifXTable_rowreq_ctx *)netsnmp_container_table_row_extract(requests);
+    int rc;
+
+    DEBUGMSGTL(("internal:ifXTable:_mfd_ifXTable_commit", "called\n"));
+
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    rc = ifXTable_commit(rowreq_ctx);
+    if (MFD_SUCCESS != rc) {
+        DEBUGMSGTL(("ifXTable:mfd", "error %d from ifXTable_commit\n", rc));
+        netsnmp_request_set_error_all(requests, SNMP_VALIDATE_ERR(rc));
+    }
+
+    return SNMP_ERR_NOERROR;
+}
+
+static int _mfd_ifXTable_undo_commit(netsnmp_mib_handler *handler,
+                                     netsnmp_handler_registration *reginfo,
+                                     netsnmp_agent_request_info *agtreq_info,
+                                     netsnmp_request_info *requests) {
+    ifXTable_rowreq_ctx *rowreq_ctx =
+        (ifXTable_rowreq_ctx *)netsnmp_container_table_row_extract(requests);
+    int rc;
+
+    DEBUGMSGTL(("internal:ifXTable:_mfd_ifXTable_undo_commit", "called\n"));
+
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    rc = ifXTable_undo_commit(rowreq_ctx);
+    if (MFD_SUCCESS != rc) {
+        DEBUGMSGTL(("ifXTable:mfd",
+                    "error %d from ifXTable_undo_commit\n", rc));
+        netsnmp_request_set_error_all(requests, SNMP_VALIDATE_ERR(rc));
+    }
+
+    return SNMP_ERR_NOERROR;
+}
+
+static int
+_mfd_ifXTable_irreversible_commit(netsnmp_mib_handler *handler,
+                                  netsnmp_handler_registration *reginfo,
+                                  netsnmp_agent_request_info *agtreq_info,
+                                  netsnmp_request_info *requests) {
+    ifXTable_rowreq_ctx *rowreq_ctx =
+        (ifXTable_rowreq_ctx *)netsnmp_container_table_row_extract(requests);
+    int rc;
+
+    DEBUGMSGTL(("internal:ifXTable:_mfd_ifXTable_irreversible_commit",
+                "called\n"));
+
+    netsnmp_assert(NULL != rowreq_ctx);
+
+    rc = ifXTable_irreversible_commit(rowreq_ctx);
+    if (MFD_SUCCESS != rc) {
+        DEBUGMSGTL(("ifXTable:mfd",
+                    "error %d from ifXTable_irreversible_commit\n", rc));
+        netsnmp_request_set_error_all(requests, SNMP_ERR_COMMITFAILED);
+    }
+
+    return SNMP_ERR_NOERROR;
+}
+
 static void _container_free(netsnmp_container *container);
 
 static int _cache_load(netsnmp_cache *cache, void *vmagic) {
@@ -513,7 +795,10 @@ void _ifXTable_container_init(ifXTable_interface_ctx *if_ctx) {
         return;
     }
 
-    if_ctx->cache->flags = NETSNMP_CACHE_DONT_INVALIDATE_ON_SET;
+    /* Rows are updated in place by ifXTable_container_load(), keep them. */
+    if_ctx->cache->flags = NETSNMP_CACHE_DONT_INVALIDATE_ON_SET |
+                           NETSNMP_CACHE_DONT_FREE_BEFORE_LOAD |
+                           NETSNMP_CACHE_DONT_FREE_EXPIRED;
     ifXTable_container_init(&if_ctx->container, if_ctx->cache);
     if (NULL == if_ctx->container) {
         if_ctx->container = netsnmp_container_find("ifXTable:table_container");
@@ -21,6 +21,7 @@
 #define COLUMN_IFPROMISCUOUSMODE 16
 #define COLUMN_IFCONNECTORPRESENT 17
 #define COLUMN_IFALIAS 18
+#define COLUMN_IFALIAS_FLAG (0x1 << 17)
 #define COLUMN_IFCOUNTERDISCONTINUITYTIME 19
 
 #define IFXTABLE_MIN_COL COLUMN_IFNAME
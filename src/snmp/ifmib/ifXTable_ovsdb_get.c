@@ -11,6 +11,7 @@ void ifXTable_ovsdb_idl_init(struct ovsdb_idl *idl) {
     ovsdb_idl_add_column(idl, &ovsrec_interface_col_statistics);
     ovsdb_idl_add_column(idl, &ovsrec_interface_col_pm_info);
     ovsdb_idl_add_column(idl, &ovsrec_interface_col_name);
+    ovsdb_idl_add_column(idl, &ovsrec_interface_col_user_config);
 }
 
 void ovsdb_get_ifName(struct ovsdb_idl *idl,
@@ -106,7 +107,8 @@ void ovsdb_get_ifHCOutBroadcastPkts(
 void ovsdb_get_ifLinkUpDownTrapEnable(
     struct ovsdb_idl *idl, const struct ovsrec_interface *interface_row,
     long *ifLinkUpDownTrapEnable_val_ptr) {
-    *ifLinkUpDownTrapEnable_val_ptr = (long)NULL;
+    ifLinkUpDownTrapEnable_custom_function(idl, interface_row,
+                                           ifLinkUpDownTrapEnable_val_ptr);
 }
 
 void ovsdb_get_ifHighSpeed(struct ovsdb_idl *idl,
@@ -131,8 +133,8 @@ void ovsdb_get_ifConnectorPresent(struct ovsdb_idl *idl,
 void ovsdb_get_ifAlias(struct ovsdb_idl *idl,
                        const struct ovsrec_interface *interface_row,
                        char *ifAlias_val_ptr, size_t *ifAlias_val_ptr_len) {
-    *ifAlias_val_ptr = '\0';
-    *ifAlias_val_ptr_len = 0;
+    ifAlias_custom_function(idl, interface_row, ifAlias_val_ptr,
+                            ifAlias_val_ptr_len);
 }
 
 void ovsdb_get_ifCounterDiscontinuityTime(
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <net-snmp/net-snmp-config.h>
 #include <net-snmp/net-snmp-includes.h>
@@ -7,330 +8,111 @@
 #include <net-snmp/agent/net-snmp-agent-includes.h>
 #include "vswitch-idl.h"
 #include "IP_MIB_custom.h"
+#include "intf_stats.h"
+#include "ifindex_registry.h"
 
 
 int portTable_skip_function(const struct ovsdb_idl *idl,
                           const struct ovsrec_port *port_row) {
-    if (atoi(port_row->name) == 0)
-        return 1;
+    /* Whether a port has an ifIndex is up to portTable_inetv4() and
+     * portTable_inetv6(). */
     return 0;
 }
 
 
-int portTable_inetv4(struct ovsdb_idl *idl, const struct ovsrec_port *port_row,
-                     long *ifIndex){
-    int ret = 0;
-    if(ifIndex != NULL){
-        *ifIndex = 0;
-    }
+/* ipIfStatsTable shares its ifIndex values with ifTable, so it only lists
+ * the ports that have an ifTable row: those with an Interface of the same
+ * name, like "1", "49-1", "1.10" or "vlan10".  A LAG has none, its members
+ * are the Interface rows. */
+static int portTable_has_ifTable_row(const struct ovsrec_port *port_row) {
+    size_t i;
 
-    int temp = atoi(port_row->name);
-    if(temp != 0){
-        if(port_row->ip4_address != NULL ||
-           port_row->n_ip4_address_secondary > 0){
-            if(*port_row->ip4_address != '\0'){
-                if(ifIndex != NULL){
-                    *ifIndex = temp;
-                }
-                ret = 1;
-            }
+    for (i = 0; i < port_row->n_interfaces; i++) {
+        if (strcmp(port_row->interfaces[i]->name, port_row->name) == 0) {
+            return 1;
         }
     }
-
-    return ret;
+    return 0;
 }
 
-int portTable_inetv6(struct ovsdb_idl *idl,
-                     const struct ovsrec_port *port_row, long *ifIndex){
-    int ret = 0;
+/* Only a port with an address takes up an ifIndex. */
+static int portTable_inet(const struct ovsrec_port *port_row,
+                          const char *address, size_t n_secondary,
+                          long *ifIndex) {
+    long temp;
+
     if(ifIndex != NULL){
         *ifIndex = 0;
     }
 
-    int temp = atoi(port_row->name);
-    if(temp != 0){
-        if(port_row->ip6_address != NULL ||
-           port_row->n_ip6_address_secondary > 0){
-            if(*port_row->ip6_address != '\0'){
-                if(ifIndex != NULL){
-                    *ifIndex = temp;
-                }
-                ret = 1;
-            }
-        }
-    }
-
-    return ret;
-}
-
-unsigned long long ipIfStatsInReceives_custom_function_v4(
-    const struct ovsrec_interface *interface_row){
-    unsigned long long ret = 0;
-
-    int i = 0;
-    for(i = 0;i < interface_row->n_statistics;i++){
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv4_uc_rx_packets") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv4_mc_rx_packets") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-    }
-
-    return ret;
-}
-
-unsigned long long ipIfStatsInOctets_custom_function_v4(
-    const struct ovsrec_interface *interface_row){
-    unsigned long long ret = 0;
-
-    int i = 0;
-    for(i = 0;i < interface_row->n_statistics;i++){
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv4_uc_rx_bytes") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv4_mc_rx_bytes") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-    }
-
-    return ret;
-}
-
-unsigned long long ipIfStatsOutTransmits_custom_function_v4(
-    const struct ovsrec_interface *interface_row){
-    unsigned long long ret = 0;
-
-    int i = 0;
-    for(i = 0;i < interface_row->n_statistics;i++){
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv4_uc_tx_packets") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv4_mc_tx_packets") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
+    if((address == NULL || *address == '\0') && n_secondary == 0){
+        return 0;
     }
-
-    return ret;
-}
-
-unsigned long long ipIfStatsOutOctets_custom_function_v4(
-    const struct ovsrec_interface *interface_row){
-    unsigned long long ret = 0;
-
-    int i = 0;
-    for(i = 0;i < interface_row->n_statistics;i++){
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv4_uc_tx_bytes") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv4_mc_tx_bytes") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
+    if(!portTable_has_ifTable_row(port_row)){
+        return 0;
     }
 
-    return ret;
-}
-
-unsigned long long ipIfStatsInMcastPkts_custom_function_v4(
-    const struct ovsrec_interface *interface_row){
-    unsigned long long ret = 0;
-
-    int i = 0;
-    for(i = 0;i < interface_row->n_statistics;i++){
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv4_mc_rx_packets") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
+    temp = ifindex_registry_get(port_row->name);
+    if(temp == 0){
+        return 0;
     }
-
-    return ret;
-}
-
-unsigned long long ipIfStatsInMcastOctets_custom_function_v4(
-    const struct ovsrec_interface *interface_row){
-    unsigned long long ret = 0;
-
-    int i = 0;
-    for(i = 0;i < interface_row->n_statistics;i++){
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv4_mc_rx_bytes") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
+    if(ifIndex != NULL){
+        *ifIndex = temp;
     }
-
-    return ret;
+    return 1;
 }
 
-unsigned long long ipIfStatsOutMcastPkts_custom_function_v4(
-    const struct ovsrec_interface *interface_row){
-    unsigned long long ret = 0;
-
-    int i = 0;
-    for(i = 0;i < interface_row->n_statistics;i++){
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv4_mc_tx_packets") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-    }
-
-    return ret;
+int portTable_inetv4(struct ovsdb_idl *idl, const struct ovsrec_port *port_row,
+                     long *ifIndex){
+    return portTable_inet(port_row, port_row->ip4_address,
+                          port_row->n_ip4_address_secondary, ifIndex);
 }
 
-unsigned long long ipIfStatsOutMcastOctets_custom_function_v4(
-    const struct ovsrec_interface *interface_row){
-    unsigned long long ret = 0;
-
-    int i = 0;
-    for(i = 0;i < interface_row->n_statistics;i++){
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv4_mc_tx_bytes") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-    }
-
-    return ret;
+int portTable_inetv6(struct ovsdb_idl *idl,
+                     const struct ovsrec_port *port_row, long *ifIndex){
+    return portTable_inet(port_row, port_row->ip6_address,
+                          port_row->n_ip6_address_secondary, ifIndex);
 }
 
-unsigned long long ipIfStatsInReceives_custom_function_v6(
-    const struct ovsrec_interface *interface_row){
-    unsigned long long ret = 0;
-
-    int i = 0;
-    for(i = 0;i < interface_row->n_statistics;i++){
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv6_uc_rx_packets") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv6_mc_rx_packets") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-    }
+/* The ipIfStats custom functions take the counters of one address family,
+ * decoded once per Interface row with intf_stats_from_interface(). */
 
-    return ret;
+unsigned long long ipIfStatsInReceives_custom_function(
+    const struct intf_ip_stats *stats){
+    return stats->uc_rx_packets + stats->mc_rx_packets;
 }
 
-unsigned long long ipIfStatsInOctets_custom_function_v6(
-    const struct ovsrec_interface *interface_row){
-    unsigned long long ret = 0;
-
-    int i = 0;
-    for(i = 0;i < interface_row->n_statistics;i++){
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv6_uc_rx_bytes") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv6_mc_rx_bytes") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-    }
-
-    return ret;
+unsigned long long ipIfStatsInOctets_custom_function(
+    const struct intf_ip_stats *stats){
+    return stats->uc_rx_bytes + stats->mc_rx_bytes;
 }
 
-unsigned long long ipIfStatsOutTransmits_custom_function_v6(
-    const struct ovsrec_interface *interface_row){
-    unsigned long long ret = 0;
-
-    int i = 0;
-    for(i = 0;i < interface_row->n_statistics;i++){
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv6_uc_tx_packets") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv6_mc_tx_packets") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-    }
-
-    return ret;
+unsigned long long ipIfStatsOutTransmits_custom_function(
+    const struct intf_ip_stats *stats){
+    return stats->uc_tx_packets + stats->mc_tx_packets;
 }
 
-unsigned long long ipIfStatsOutOctets_custom_function_v6(
-    const struct ovsrec_interface *interface_row){
-    unsigned long long ret = 0;
-
-    int i = 0;
-    for(i = 0;i < interface_row->n_statistics;i++){
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv6_uc_tx_packets") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv6_mc_tx_packets") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-    }
-
-    return ret;
+unsigned long long ipIfStatsOutOctets_custom_function(
+    const struct intf_ip_stats *stats){
+    return stats->uc_tx_bytes + stats->mc_tx_bytes;
 }
 
-unsigned long long ipIfStatsInMcastPkts_custom_function_v6(
-    const struct ovsrec_interface *interface_row){
-    unsigned long long ret = 0;
-
-    int i = 0;
-    for(i = 0;i < interface_row->n_statistics;i++){
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv6_mc_rx_packets") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-    }
-
-    return ret;
+unsigned long long ipIfStatsInMcastPkts_custom_function(
+    const struct intf_ip_stats *stats){
+    return stats->mc_rx_packets;
 }
 
-unsigned long long ipIfStatsInMcastOctets_custom_function_v6(
-    const struct ovsrec_interface *interface_row){
-    unsigned long long ret = 0;
-
-    int i = 0;
-    for(i = 0;i < interface_row->n_statistics;i++){
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv6_mc_rx_bytes") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-    }
-
-    return ret;
+unsigned long long ipIfStatsInMcastOctets_custom_function(
+    const struct intf_ip_stats *stats){
+    return stats->mc_rx_bytes;
 }
 
-unsigned long long ipIfStatsOutMcastPkts_custom_function_v6(
-    const struct ovsrec_interface *interface_row){
-    unsigned long long ret = 0;
-
-    int i = 0;
-    for(i = 0;i < interface_row->n_statistics;i++){
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv6_mc_tx_packets") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-    }
-
-    return ret;
+unsigned long long ipIfStatsOutMcastPkts_custom_function(
+    const struct intf_ip_stats *stats){
+    return stats->mc_tx_packets;
 }
 
-unsigned long long ipIfStatsOutMcastOctets_custom_function_v6(
-    const struct ovsrec_interface *interface_row){
-    unsigned long long ret = 0;
-
-    int i = 0;
-    for(i = 0;i < interface_row->n_statistics;i++){
-        if(strcmp(*(interface_row->key_statistics + i),
-                  "ipv6_mc_tx_bytes") == 0){
-            ret += *(interface_row->value_statistics + i);
-        }
-    }
-
-    return ret;
+unsigned long long ipIfStatsOutMcastOctets_custom_function(
+    const struct intf_ip_stats *stats){
+    return stats->mc_tx_bytes;
 }
@@ -17,53 +17,31 @@ int portTable_inetv4(struct ovsdb_idl *idl, const struct ovsrec_port *port_row,
 int portTable_inetv6(struct ovsdb_idl *idl, const struct ovsrec_port *port_row,
                      long *ifIndex);
 
-unsigned long long ipIfStatsInReceives_custom_function_v4(
-    const struct ovsrec_interface *int_row);
+struct intf_ip_stats;
 
-unsigned long long ipIfStatsInOctets_custom_function_v4(
-    const struct ovsrec_interface *int_row);
+unsigned long long ipIfStatsInReceives_custom_function(
+    const struct intf_ip_stats *stats);
 
-unsigned long long ipIfStatsOutTransmits_custom_function_v4(
-    const struct ovsrec_interface *int_row);
+unsigned long long ipIfStatsInOctets_custom_function(
+    const struct intf_ip_stats *stats);
 
-unsigned long long ipIfStatsOutOctets_custom_function_v4(
-    const struct ovsrec_interface *int_row);
+unsigned long long ipIfStatsOutTransmits_custom_function(
+    const struct intf_ip_stats *stats);
 
-unsigned long long ipIfStatsInMcastPkts_custom_function_v4(
-    const struct ovsrec_interface *int_row);
+unsigned long long ipIfStatsOutOctets_custom_function(
+    const struct intf_ip_stats *stats);
 
-unsigned long long ipIfStatsInMcastOctets_custom_function_v4(
-    const struct ovsrec_interface *int_row);
+unsigned long long ipIfStatsInMcastPkts_custom_function(
+    const struct intf_ip_stats *stats);
 
-unsigned long long ipIfStatsOutMcastPkts_custom_function_v4(
-    const struct ovsrec_interface *int_row);
+unsigned long long ipIfStatsInMcastOctets_custom_function(
+    const struct intf_ip_stats *stats);
 
-unsigned long long ipIfStatsOutMcastOctets_custom_function_v4(
-    const struct ovsrec_interface *int_row);
+unsigned long long ipIfStatsOutMcastPkts_custom_function(
+    const struct intf_ip_stats *stats);
 
-unsigned long long ipIfStatsInReceives_custom_function_v6(
-    const struct ovsrec_interface *int_row);
-
-unsigned long long ipIfStatsInOctets_custom_function_v6(
-    const struct ovsrec_interface *int_row);
-
-unsigned long long ipIfStatsOutTransmits_custom_function_v6(
-    const struct ovsrec_interface *int_row);
-
-unsigned long long ipIfStatsOutOctets_custom_function_v6(
-    const struct ovsrec_interface *int_row);
-
-unsigned long long ipIfStatsInMcastPkts_custom_function_v6(
-    const struct ovsrec_interface *int_row);
-
-unsigned long long ipIfStatsInMcastOctets_custom_function_v6(
-    const struct ovsrec_interface *int_row);
-
-unsigned long long ipIfStatsOutMcastPkts_custom_function_v6(
-    const struct ovsrec_interface *int_row);
-
-unsigned long long ipIfStatsOutMcastOctets_custom_function_v6(
-    const struct ovsrec_interface *int_row);
+unsigned long long ipIfStatsOutMcastOctets_custom_function(
+    const struct intf_ip_stats *stats);
 
 
 #endif
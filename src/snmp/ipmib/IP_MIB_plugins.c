@@ -6,16 +6,49 @@
 #include "IP_MIB_scalars.h"
 #include "ipSystemStatsTable.h"
 #include "ipIfStatsTable.h"
+#include "mib_refresh.h"
+#include "ifindex_registry.h"
+
+#include "compiler.h"
+#include "dynamic-string.h"
+#include "unixctl.h"
+
+/* "ip-mib/refresh": the age of the snapshots served by the tables and the
+ * cost of building them.  ipSystemStatsTable is updated with
+ * ipIfStatsTable. */
+static void ip_mib_unixctl_refresh(struct unixctl_conn *conn,
+                                   int argc OVS_UNUSED,
+                                   const char *argv[] OVS_UNUSED,
+                                   void *aux OVS_UNUSED) {
+    struct ds ds = DS_EMPTY_INITIALIZER;
+
+    mib_refresh_format_header(&ds);
+    mib_refresh_format(&ipIfStatsTable_refresh, &ds);
+    unixctl_command_reply(conn, ds_cstr(&ds));
+    ds_destroy(&ds);
+}
 
 void ops_snmp_init(void) {
 
     init_ipSystemStatsTable();
     init_ipIfStatsTable();
+    unixctl_command_register("ip-mib/refresh", "", 0, 0,
+                             ip_mib_unixctl_refresh, NULL);
+}
+
+/* Builds the next snapshot of the tables a slice at a time, so requests
+ * are served from a ready one, and saves the ifIndex values it gave out. */
+void ops_snmp_run(void) {
+    mib_refresh_run(&ipIfStatsTable_refresh);
+    ifindex_registry_flush();
+}
+
+void ops_snmp_wait(void) {
+    mib_refresh_wait(&ipIfStatsTable_refresh);
 }
 
-void ops_snmp_run(void) {}
-void ops_snmp_wait(void) {}
 void ops_snmp_destroy(void) {
     shutdown_ipSystemStatsTable();
     shutdown_ipIfStatsTable();
+    ifindex_registry_destroy();
 }
@@ -3,6 +3,7 @@
 #include <net-snmp/library/asn1.h>
 #include "ipIfStatsTable_oids.h"
 #include "ipIfStatsTable_enums.h"
+#include "intf_stats.h"
 
 void init_ipIfStatsTable(void);
 void shutdown_ipIfStatsTable(void);
@@ -68,6 +69,8 @@ typedef struct ipIfStatsTable_rowreq_ctx_s {
     ipIfStatsTable_data data;
     u_int rowreq_flags;
     netsnmp_data_list *ipIfStatsTable_data_list;
+    u_int load_generation;  /* Last snapshot that saw the row. */
+    struct intf_ip_stats stats;  /* The columns are derived from. */
 } ipIfStatsTable_rowreq_ctx;
 
 typedef struct ipIfStatsTable_ref_rowreq_ctx_s {
@@ -3,8 +3,12 @@
 #include <net-snmp/net-snmp-includes.h>
 #include <net-snmp/agent/net-snmp-agent-includes.h>
 #include "IP_MIB_custom.h"
+#include "intf_stats.h"
 #include "ipIfStatsTable.h"
 #include "ipIfStatsTable_data_access.h"
+#include "ipSystemStatsTable.h"
+#include "mib_refresh.h"
+#include "ifindex_registry.h"
 
 #include "openswitch-idl.h"
 #include "ovsdb-idl.h"
@@ -42,263 +46,238 @@ void ipIfStatsTable_container_shutdown(netsnmp_container *container_ptr) {
     }
 }
 
-int ipIfStatsTable_container_load(netsnmp_container *container) {
-    DEBUGMSGTL(
-        ("verbose:ipIfStatsTable:ipIfStatsTable_container_load", "called\n"));
-    ipIfStatsTable_rowreq_ctx *rowreq_ctx;
-    size_t count = 0;
+/* The container outlives each snapshot, see ifTable_data_access.c.  A port
+ * has a row per address family it has addresses of. */
+static unsigned int ipIfStatsTable_load_generation;
 
-    const struct ovsrec_port *port_row = NULL;
+struct ipIfStatsTable_snapshot_row {
+    struct uuid uuid;
+    long ifIndex;
+    int inet[2];    /* IPv4 and IPv6 rows, in ipIfStatsIPVersion order. */
+    struct intf_ip_stats stats[2];
+    ipIfStatsTable_data data[2];
+};
+static struct ipIfStatsTable_snapshot_row *ipIfStatsTable_snapshot;
+static size_t ipIfStatsTable_snapshot_n, ipIfStatsTable_snapshot_allocated;
 
-    long ipIfStatsIPVersion;
-    long ipIfStatsIfIndex;
-
-    u_long ipIfStatsInReceives = 0;
-    unsigned long long ipIfStatsHCInReceives = 0;
-    u_long ipIfStatsInOctets = 0;
-    unsigned long long ipIfStatsHCInOctets = 0;
-    u_long ipIfStatsInHdrErrors = 0;
-    u_long ipIfStatsInNoRoutes = 0;
-    u_long ipIfStatsInAddrErrors = 0;
-    u_long ipIfStatsInUnknownProtos = 0;
-    u_long ipIfStatsInTruncatedPkts = 0;
-    u_long ipIfStatsInForwDatagrams = 0;
-    unsigned long long ipIfStatsHCInForwDatagrams = 0;
-    u_long ipIfStatsReasmReqds = 0;
-    u_long ipIfStatsReasmOKs = 0;
-    u_long ipIfStatsReasmFails = 0;
-    u_long ipIfStatsInDiscards = 0;
-    u_long ipIfStatsInDelivers = 0;
-    unsigned long long ipIfStatsHCInDelivers = 0;
-    u_long ipIfStatsOutRequests = 0;
-    unsigned long long ipIfStatsHCOutRequests = 0;
-    u_long ipIfStatsOutForwDatagrams = 0;
-    unsigned long long ipIfStatsHCOutForwDatagrams = 0;
-    u_long ipIfStatsOutDiscards = 0;
-    u_long ipIfStatsOutFragReqds = 0;
-    u_long ipIfStatsOutFragOKs = 0;
-    u_long ipIfStatsOutFragFails = 0;
-    u_long ipIfStatsOutFragCreates = 0;
-    u_long ipIfStatsOutTransmits = 0;
-    unsigned long long ipIfStatsHCOutTransmits = 0;
-    u_long ipIfStatsOutOctets = 0;
-    unsigned long long ipIfStatsHCOutOctets = 0;
-    u_long ipIfStatsInMcastPkts = 0;
-    unsigned long long ipIfStatsHCInMcastPkts = 0;
-    u_long ipIfStatsInMcastOctets = 0;
-    unsigned long long ipIfStatsHCInMcastOctets = 0;
-    u_long ipIfStatsOutMcastPkts = 0;
-    unsigned long long ipIfStatsHCOutMcastPkts = 0;
-    u_long ipIfStatsOutMcastOctets = 0;
-    unsigned long long ipIfStatsHCOutMcastOctets = 0;
-    u_long ipIfStatsInBcastPkts = 0;
-    unsigned long long ipIfStatsHCInBcastPkts = 0;
-    u_long ipIfStatsOutBcastPkts = 0;
-    unsigned long long ipIfStatsHCOutBcastPkts = 0;
-    long ipIfStatsDiscontinuityTime = 0;
-    u_long ipIfStatsRefreshRate = 0;
-
-    port_row = ovsrec_port_first(idl);
-    if (!port_row) {
-        snmp_log(LOG_ERR, "not able to fetch port row");
-        return -1;
-    }
+/* Fills the columns there are counters for, the others read 0. */
+static void ipIfStatsTable_columns_get(const struct intf_ip_stats *stats,
+                                       ipIfStatsTable_data *data) {
+    memset(data, 0, sizeof(*data));
 
-    OVSREC_PORT_FOR_EACH(port_row, idl) {
-        if(port_row->interfaces == NULL || portTable_skip_function(idl, port_row)) {
-            continue;
-        }
+    data->ipIfStatsHCInReceives = ipIfStatsInReceives_custom_function(stats);
+    data->ipIfStatsInReceives = data->ipIfStatsHCInReceives;
+
+    data->ipIfStatsHCInOctets = ipIfStatsInOctets_custom_function(stats);
+    data->ipIfStatsInOctets = data->ipIfStatsHCInOctets;
+
+    data->ipIfStatsHCOutTransmits =
+        ipIfStatsOutTransmits_custom_function(stats);
+    data->ipIfStatsOutTransmits = data->ipIfStatsHCOutTransmits;
+
+    data->ipIfStatsHCOutOctets = ipIfStatsOutOctets_custom_function(stats);
+    data->ipIfStatsOutOctets = data->ipIfStatsHCOutOctets;
 
-        if(portTable_inetv4(idl, port_row, &ipIfStatsIfIndex)){
-            ipIfStatsIPVersion = 1;
+    data->ipIfStatsHCInMcastPkts = ipIfStatsInMcastPkts_custom_function(stats);
+    data->ipIfStatsInMcastPkts = data->ipIfStatsHCInMcastPkts;
 
-            const struct ovsrec_interface *interface_row = *port_row->interfaces;
+    data->ipIfStatsHCInMcastOctets =
+        ipIfStatsInMcastOctets_custom_function(stats);
+    data->ipIfStatsInMcastOctets = data->ipIfStatsHCInMcastOctets;
 
-            ipIfStatsInReceives = ipIfStatsInReceives_custom_function_v4(interface_row);
-            ipIfStatsHCInReceives = ipIfStatsInReceives_custom_function_v4(interface_row);
+    data->ipIfStatsHCOutMcastPkts =
+        ipIfStatsOutMcastPkts_custom_function(stats);
+    data->ipIfStatsOutMcastPkts = data->ipIfStatsHCOutMcastPkts;
 
-            ipIfStatsInOctets = ipIfStatsInOctets_custom_function_v4(interface_row);
-            ipIfStatsHCInOctets = ipIfStatsInOctets_custom_function_v4(interface_row);
+    data->ipIfStatsHCOutMcastOctets =
+        ipIfStatsOutMcastOctets_custom_function(stats);
+    data->ipIfStatsOutMcastOctets = data->ipIfStatsHCOutMcastOctets;
+}
+
+/* Removes the rows the last snapshot did not see. */
+static void ipIfStatsTable_container_prune(netsnmp_container *container) {
+    netsnmp_iterator *it;
+    ipIfStatsTable_rowreq_ctx *rowreq_ctx;
+    ipIfStatsTable_rowreq_ctx **stale;
+    size_t n_stale = 0, i;
 
-            ipIfStatsOutTransmits = ipIfStatsOutTransmits_custom_function_v4(interface_row);
-            ipIfStatsHCOutTransmits = ipIfStatsOutTransmits_custom_function_v4(interface_row);
+    stale = malloc(CONTAINER_SIZE(container) * sizeof(*stale));
+    if (stale == NULL) {
+        snmp_log(LOG_ERR, "memory allocation failed");
+        return;
+    }
 
-            ipIfStatsOutOctets = ipIfStatsOutOctets_custom_function_v4(interface_row);
-            ipIfStatsHCOutOctets = ipIfStatsOutOctets_custom_function_v4(interface_row);
+    it = CONTAINER_ITERATOR(container);
+    if (it == NULL) {
+        free(stale);
+        return;
+    }
+    for (rowreq_ctx = ITERATOR_FIRST(it); rowreq_ctx != NULL;
+         rowreq_ctx = ITERATOR_NEXT(it)) {
+        if (rowreq_ctx->load_generation != ipIfStatsTable_load_generation) {
+            stale[n_stale++] = rowreq_ctx;
+        }
+    }
+    ITERATOR_RELEASE(it);
 
-            ipIfStatsInMcastPkts = ipIfStatsInMcastPkts_custom_function_v4(interface_row);
-            ipIfStatsHCInMcastPkts = ipIfStatsInMcastPkts_custom_function_v4(interface_row);
+    for (i = 0; i < n_stale; i++) {
+        CONTAINER_REMOVE(container, stale[i]);
+        ipIfStatsTable_release_rowreq_ctx(stale[i]);
+    }
+    free(stale);
+}
 
-            ipIfStatsInMcastOctets = ipIfStatsInMcastOctets_custom_function_v4(interface_row);
-            ipIfStatsHCInMcastOctets = ipIfStatsInMcastOctets_custom_function_v4(interface_row);
+static size_t ipIfStatsTable_refresh_begin(void) {
+    const struct ovsrec_port *port_row = NULL;
+    struct ipIfStatsTable_snapshot_row *snapshot;
 
-            ipIfStatsOutMcastPkts = ipIfStatsOutMcastPkts_custom_function_v4(interface_row);
-            ipIfStatsHCOutMcastPkts = ipIfStatsOutMcastPkts_custom_function_v4(interface_row);
+    ipIfStatsTable_snapshot_n = 0;
+    if (ipIfStatsTable_container_get() == NULL) {
+        return 0;
+    }
 
-            ipIfStatsOutMcastOctets = ipIfStatsOutMcastOctets_custom_function_v4(interface_row);
-            ipIfStatsHCOutMcastOctets = ipIfStatsOutMcastOctets_custom_function_v4(interface_row);
+    OVSREC_PORT_FOR_EACH(port_row, idl) {
+        if (port_row->interfaces == NULL ||
+            portTable_skip_function(idl, port_row)) {
+            continue;
+        }
+        if (ipIfStatsTable_snapshot_n == ipIfStatsTable_snapshot_allocated) {
+            size_t allocated = ipIfStatsTable_snapshot_allocated * 2 + 16;
 
-            rowreq_ctx = ipIfStatsTable_allocate_rowreq_ctx(NULL);
-            if (rowreq_ctx == NULL) {
+            snapshot = realloc(ipIfStatsTable_snapshot,
+                               allocated * sizeof(*snapshot));
+            if (snapshot == NULL) {
                 snmp_log(LOG_ERR, "memory allocation failed");
-                return MFD_RESOURCE_UNAVAILABLE;
-            }
-            if (MFD_SUCCESS != ipIfStatsTable_indexes_set(rowreq_ctx,
-                                                        ipIfStatsIPVersion,
-                                                        ipIfStatsIfIndex)) {
-                snmp_log(LOG_ERR, "error setting indexes while loading");
-                ipIfStatsTable_release_rowreq_ctx(rowreq_ctx);
-                continue;
+                break;
             }
-
-            rowreq_ctx->data.ipIfStatsInReceives = ipIfStatsInReceives;
-            rowreq_ctx->data.ipIfStatsHCInReceives = ipIfStatsHCInReceives;
-            rowreq_ctx->data.ipIfStatsInOctets = ipIfStatsInOctets;
-            rowreq_ctx->data.ipIfStatsHCInOctets = ipIfStatsHCInOctets;
-            rowreq_ctx->data.ipIfStatsInHdrErrors = ipIfStatsInHdrErrors;
-            rowreq_ctx->data.ipIfStatsInNoRoutes = ipIfStatsInNoRoutes;
-            rowreq_ctx->data.ipIfStatsInAddrErrors = ipIfStatsInAddrErrors;
-            rowreq_ctx->data.ipIfStatsInUnknownProtos = ipIfStatsInUnknownProtos;
-            rowreq_ctx->data.ipIfStatsInTruncatedPkts = ipIfStatsInTruncatedPkts;
-            rowreq_ctx->data.ipIfStatsInForwDatagrams = ipIfStatsInForwDatagrams;
-            rowreq_ctx->data.ipIfStatsHCInForwDatagrams =
-                ipIfStatsHCInForwDatagrams;
-            rowreq_ctx->data.ipIfStatsReasmReqds = ipIfStatsReasmReqds;
-            rowreq_ctx->data.ipIfStatsReasmOKs = ipIfStatsReasmOKs;
-            rowreq_ctx->data.ipIfStatsReasmFails = ipIfStatsReasmFails;
-            rowreq_ctx->data.ipIfStatsInDiscards = ipIfStatsInDiscards;
-            rowreq_ctx->data.ipIfStatsInDelivers = ipIfStatsInDelivers;
-            rowreq_ctx->data.ipIfStatsHCInDelivers = ipIfStatsHCInDelivers;
-            rowreq_ctx->data.ipIfStatsOutRequests = ipIfStatsOutRequests;
-            rowreq_ctx->data.ipIfStatsHCOutRequests = ipIfStatsHCOutRequests;
-            rowreq_ctx->data.ipIfStatsOutForwDatagrams = ipIfStatsOutForwDatagrams;
-            rowreq_ctx->data.ipIfStatsHCOutForwDatagrams =
-                ipIfStatsHCOutForwDatagrams;
-            rowreq_ctx->data.ipIfStatsOutDiscards = ipIfStatsOutDiscards;
-            rowreq_ctx->data.ipIfStatsOutFragReqds = ipIfStatsOutFragReqds;
-            rowreq_ctx->data.ipIfStatsOutFragOKs = ipIfStatsOutFragOKs;
-            rowreq_ctx->data.ipIfStatsOutFragFails = ipIfStatsOutFragFails;
-            rowreq_ctx->data.ipIfStatsOutFragCreates = ipIfStatsOutFragCreates;
-            rowreq_ctx->data.ipIfStatsOutTransmits = ipIfStatsOutTransmits;
-            rowreq_ctx->data.ipIfStatsHCOutTransmits = ipIfStatsHCOutTransmits;
-            rowreq_ctx->data.ipIfStatsOutOctets = ipIfStatsOutOctets;
-            rowreq_ctx->data.ipIfStatsHCOutOctets = ipIfStatsHCOutOctets;
-            rowreq_ctx->data.ipIfStatsInMcastPkts = ipIfStatsInMcastPkts;
-            rowreq_ctx->data.ipIfStatsHCInMcastPkts = ipIfStatsHCInMcastPkts;
-            rowreq_ctx->data.ipIfStatsInMcastOctets = ipIfStatsInMcastOctets;
-            rowreq_ctx->data.ipIfStatsHCInMcastOctets = ipIfStatsHCInMcastOctets;
-            rowreq_ctx->data.ipIfStatsOutMcastPkts = ipIfStatsOutMcastPkts;
-            rowreq_ctx->data.ipIfStatsHCOutMcastPkts = ipIfStatsHCOutMcastPkts;
-            rowreq_ctx->data.ipIfStatsOutMcastOctets = ipIfStatsOutMcastOctets;
-            rowreq_ctx->data.ipIfStatsHCOutMcastOctets = ipIfStatsHCOutMcastOctets;
-            rowreq_ctx->data.ipIfStatsInBcastPkts = ipIfStatsInBcastPkts;
-            rowreq_ctx->data.ipIfStatsHCInBcastPkts = ipIfStatsHCInBcastPkts;
-            rowreq_ctx->data.ipIfStatsOutBcastPkts = ipIfStatsOutBcastPkts;
-            rowreq_ctx->data.ipIfStatsHCOutBcastPkts = ipIfStatsHCOutBcastPkts;
-            rowreq_ctx->data.ipIfStatsDiscontinuityTime =
-                ipIfStatsDiscontinuityTime;
-            rowreq_ctx->data.ipIfStatsRefreshRate = ipIfStatsRefreshRate;
-            CONTAINER_INSERT(container, rowreq_ctx);
-            ++count;
+            ipIfStatsTable_snapshot = snapshot;
+            ipIfStatsTable_snapshot_allocated = allocated;
         }
-        if(portTable_inetv6(idl, port_row, &ipIfStatsIfIndex)){
-            ipIfStatsIPVersion = 2;
+        ipIfStatsTable_snapshot[ipIfStatsTable_snapshot_n++].uuid =
+            port_row->header_.uuid;
+    }
+    return ipIfStatsTable_snapshot_n;
+}
 
-            const struct ovsrec_interface *interface_row = *port_row->interfaces;
+static void ipIfStatsTable_refresh_step(size_t i) {
+    struct ipIfStatsTable_snapshot_row *snap = &ipIfStatsTable_snapshot[i];
+    const struct ovsrec_port *port_row;
+    struct intf_stats stats, member_stats;
+    long ifIndex_v6;
+    size_t j;
 
-            ipIfStatsInReceives = ipIfStatsInReceives_custom_function_v6(interface_row);
-            ipIfStatsHCInReceives = ipIfStatsInReceives_custom_function_v6(interface_row);
+    snap->inet[0] = snap->inet[1] = 0;
 
-            ipIfStatsInOctets = ipIfStatsInOctets_custom_function_v6(interface_row);
-            ipIfStatsHCInOctets = ipIfStatsInOctets_custom_function_v6(interface_row);
+    /* The port may have been deleted since ipIfStatsTable_refresh_begin(). */
+    port_row = ovsrec_port_get_for_uuid(idl, &snap->uuid);
+    if (port_row == NULL || port_row->n_interfaces == 0) {
+        return;
+    }
 
-            ipIfStatsOutTransmits = ipIfStatsOutTransmits_custom_function_v6(interface_row);
-            ipIfStatsHCOutTransmits = ipIfStatsOutTransmits_custom_function_v6(interface_row);
+    /* A dual-stack port has a row for each address family. */
+    snap->inet[0] = portTable_inetv4(idl, port_row, &snap->ifIndex);
+    snap->inet[1] = portTable_inetv6(idl, port_row, &ifIndex_v6);
+    if (snap->inet[1]) {
+        snap->ifIndex = ifIndex_v6;
+    } else if (!snap->inet[0]) {
+        return;
+    }
 
-            ipIfStatsOutOctets = ipIfStatsOutOctets_custom_function_v6(interface_row);
-            ipIfStatsHCOutOctets = ipIfStatsOutOctets_custom_function_v6(interface_row);
+    /* Decode the statistics of each interface of the port once and add
+     * them up.  Every column of both rows comes from the totals. */
+    intf_stats_from_interface(port_row->interfaces[0], &stats);
+    for (j = 1; j < port_row->n_interfaces; j++) {
+        intf_stats_from_interface(port_row->interfaces[j], &member_stats);
+        intf_stats_add(&stats, &member_stats);
+    }
+    snap->stats[0] = stats.ipv4;
+    snap->stats[1] = stats.ipv6;
+    if (snap->inet[0]) {
+        ipIfStatsTable_columns_get(&snap->stats[0], &snap->data[0]);
+    }
+    if (snap->inet[1]) {
+        ipIfStatsTable_columns_get(&snap->stats[1], &snap->data[1]);
+    }
+}
 
-            ipIfStatsInMcastPkts = ipIfStatsInMcastPkts_custom_function_v6(interface_row);
-            ipIfStatsHCInMcastPkts = ipIfStatsInMcastPkts_custom_function_v6(interface_row);
+static void ipIfStatsTable_refresh_publish(void) {
+    netsnmp_container *container = ipIfStatsTable_container_get();
+    ipIfStatsTable_rowreq_ctx *rowreq_ctx;
+    ipIfStatsTable_mib_index mib_idx;
+    size_t count = 0, inserted = 0, i;
+    int v;
 
-            ipIfStatsInMcastOctets = ipIfStatsInMcastOctets_custom_function_v6(interface_row);
-            ipIfStatsHCInMcastOctets = ipIfStatsInMcastOctets_custom_function_v6(interface_row);
+    if (container == NULL) {
+        return;
+    }
+    ipIfStatsTable_load_generation++;
 
-            ipIfStatsOutMcastPkts = ipIfStatsOutMcastPkts_custom_function_v6(interface_row);
-            ipIfStatsHCOutMcastPkts = ipIfStatsOutMcastPkts_custom_function_v6(interface_row);
+    for (i = 0; i < ipIfStatsTable_snapshot_n; i++) {
+        struct ipIfStatsTable_snapshot_row *snap = &ipIfStatsTable_snapshot[i];
 
-            ipIfStatsOutMcastOctets = ipIfStatsOutMcastOctets_custom_function_v6(interface_row);
-            ipIfStatsHCOutMcastOctets = ipIfStatsOutMcastOctets_custom_function_v6(interface_row);
+        for (v = 0; v < 2; v++) {
+            if (!snap->inet[v]) {
+                continue;
+            }
+            mib_idx.ipIfStatsIPVersion = v + 1;
+            mib_idx.ipIfStatsIfIndex = snap->ifIndex;
 
-            rowreq_ctx = ipIfStatsTable_allocate_rowreq_ctx(NULL);
+            rowreq_ctx = ipIfStatsTable_row_find_by_mib_index(&mib_idx);
             if (rowreq_ctx == NULL) {
-                snmp_log(LOG_ERR, "memory allocation failed");
-                return MFD_RESOURCE_UNAVAILABLE;
-            }
-            if (MFD_SUCCESS != ipIfStatsTable_indexes_set(rowreq_ctx,
-                                                        ipIfStatsIPVersion,
-                                                        ipIfStatsIfIndex)) {
-                snmp_log(LOG_ERR, "error setting indexes while loading");
-                ipIfStatsTable_release_rowreq_ctx(rowreq_ctx);
+                rowreq_ctx = ipIfStatsTable_allocate_rowreq_ctx(NULL);
+                if (rowreq_ctx == NULL) {
+                    snmp_log(LOG_ERR, "memory allocation failed");
+                    return;
+                }
+                if (MFD_SUCCESS != ipIfStatsTable_indexes_set(
+                                       rowreq_ctx, mib_idx.ipIfStatsIPVersion,
+                                       mib_idx.ipIfStatsIfIndex)) {
+                    snmp_log(LOG_ERR, "error setting indexes while loading");
+                    ipIfStatsTable_release_rowreq_ctx(rowreq_ctx);
+                    continue;
+                }
+                if (CONTAINER_INSERT(container, rowreq_ctx) != 0) {
+                    ipIfStatsTable_release_rowreq_ctx(rowreq_ctx);
+                    continue;
+                }
+                inserted++;
+            } else if (rowreq_ctx->load_generation ==
+                       ipIfStatsTable_load_generation) {
+                /* Another port already has this ifIndex. */
                 continue;
             }
-
-            rowreq_ctx->data.ipIfStatsInReceives = ipIfStatsInReceives;
-            rowreq_ctx->data.ipIfStatsHCInReceives = ipIfStatsHCInReceives;
-            rowreq_ctx->data.ipIfStatsInOctets = ipIfStatsInOctets;
-            rowreq_ctx->data.ipIfStatsHCInOctets = ipIfStatsHCInOctets;
-            rowreq_ctx->data.ipIfStatsInHdrErrors = ipIfStatsInHdrErrors;
-            rowreq_ctx->data.ipIfStatsInNoRoutes = ipIfStatsInNoRoutes;
-            rowreq_ctx->data.ipIfStatsInAddrErrors = ipIfStatsInAddrErrors;
-            rowreq_ctx->data.ipIfStatsInUnknownProtos = ipIfStatsInUnknownProtos;
-            rowreq_ctx->data.ipIfStatsInTruncatedPkts = ipIfStatsInTruncatedPkts;
-            rowreq_ctx->data.ipIfStatsInForwDatagrams = ipIfStatsInForwDatagrams;
-            rowreq_ctx->data.ipIfStatsHCInForwDatagrams =
-                ipIfStatsHCInForwDatagrams;
-            rowreq_ctx->data.ipIfStatsReasmReqds = ipIfStatsReasmReqds;
-            rowreq_ctx->data.ipIfStatsReasmOKs = ipIfStatsReasmOKs;
-            rowreq_ctx->data.ipIfStatsReasmFails = ipIfStatsReasmFails;
-            rowreq_ctx->data.ipIfStatsInDiscards = ipIfStatsInDiscards;
-            rowreq_ctx->data.ipIfStatsInDelivers = ipIfStatsInDelivers;
-            rowreq_ctx->data.ipIfStatsHCInDelivers = ipIfStatsHCInDelivers;
-            rowreq_ctx->data.ipIfStatsOutRequests = ipIfStatsOutRequests;
-            rowreq_ctx->data.ipIfStatsHCOutRequests = ipIfStatsHCOutRequests;
-            rowreq_ctx->data.ipIfStatsOutForwDatagrams = ipIfStatsOutForwDatagrams;
-            rowreq_ctx->data.ipIfStatsHCOutForwDatagrams =
-                ipIfStatsHCOutForwDatagrams;
-            rowreq_ctx->data.ipIfStatsOutDiscards = ipIfStatsOutDiscards;
-            rowreq_ctx->data.ipIfStatsOutFragReqds = ipIfStatsOutFragReqds;
-            rowreq_ctx->data.ipIfStatsOutFragOKs = ipIfStatsOutFragOKs;
-            rowreq_ctx->data.ipIfStatsOutFragFails = ipIfStatsOutFragFails;
-            rowreq_ctx->data.ipIfStatsOutFragCreates = ipIfStatsOutFragCreates;
-            rowreq_ctx->data.ipIfStatsOutTransmits = ipIfStatsOutTransmits;
-            rowreq_ctx->data.ipIfStatsHCOutTransmits = ipIfStatsHCOutTransmits;
-            rowreq_ctx->data.ipIfStatsOutOctets = ipIfStatsOutOctets;
-            rowreq_ctx->data.ipIfStatsHCOutOctets = ipIfStatsHCOutOctets;
-            rowreq_ctx->data.ipIfStatsInMcastPkts = ipIfStatsInMcastPkts;
-            rowreq_ctx->data.ipIfStatsHCInMcastPkts = ipIfStatsHCInMcastPkts;
-            rowreq_ctx->data.ipIfStatsInMcastOctets = ipIfStatsInMcastOctets;
-            rowreq_ctx->data.ipIfStatsHCInMcastOctets = ipIfStatsHCInMcastOctets;
-            rowreq_ctx->data.ipIfStatsOutMcastPkts = ipIfStatsOutMcastPkts;
-            rowreq_ctx->data.ipIfStatsHCOutMcastPkts = ipIfStatsHCOutMcastPkts;
-            rowreq_ctx->data.ipIfStatsOutMcastOctets = ipIfStatsOutMcastOctets;
-            rowreq_ctx->data.ipIfStatsHCOutMcastOctets = ipIfStatsHCOutMcastOctets;
-            rowreq_ctx->data.ipIfStatsInBcastPkts = ipIfStatsInBcastPkts;
-            rowreq_ctx->data.ipIfStatsHCInBcastPkts = ipIfStatsHCInBcastPkts;
-            rowreq_ctx->data.ipIfStatsOutBcastPkts = ipIfStatsOutBcastPkts;
-            rowreq_ctx->data.ipIfStatsHCOutBcastPkts = ipIfStatsHCOutBcastPkts;
-            rowreq_ctx->data.ipIfStatsDiscontinuityTime =
-                ipIfStatsDiscontinuityTime;
-            rowreq_ctx->data.ipIfStatsRefreshRate = ipIfStatsRefreshRate;
-            CONTAINER_INSERT(container, rowreq_ctx);
+            rowreq_ctx->stats = snap->stats[v];
+            rowreq_ctx->data = snap->data[v];
+            rowreq_ctx->load_generation = ipIfStatsTable_load_generation;
             ++count;
         }
-        else{
-            continue;
-        }
     }
-    DEBUGMSGTL(("verbose:ipIfStatsTable:ipIfStatsTable_container_load",
-                "inserted %d records\n", (int)count));
+
+    if (count != CONTAINER_SIZE(container)) {
+        ipIfStatsTable_container_prune(container);
+    }
+    ipSystemStatsTable_totals_publish();
+
+    DEBUGMSGTL(("verbose:ipIfStatsTable:ipIfStatsTable_refresh_publish",
+                "published %d records, %d new\n", (int)count, (int)inserted));
+}
+
+struct mib_refresh ipIfStatsTable_refresh =
+    MIB_REFRESH_INITIALIZER("ipIfStatsTable", IPIFSTATSTABLE_CACHE_TIMEOUT,
+                            ipIfStatsTable_refresh_begin,
+                            ipIfStatsTable_refresh_step,
+                            ipIfStatsTable_refresh_publish);
+
+int ipIfStatsTable_container_load(netsnmp_container *container) {
+    DEBUGMSGTL(
+        ("verbose:ipIfStatsTable:ipIfStatsTable_container_load", "called\n"));
+
+    /* ops_snmp_run() normally keeps the snapshot fresh. */
+    if (!mib_refresh_ready(&ipIfStatsTable_refresh)) {
+        mib_refresh_sync(&ipIfStatsTable_refresh);
+    }
+    /* A snapshot built here may have added names. */
+    ifindex_registry_flush();
     return MFD_SUCCESS;
 }
 
@@ -3,6 +3,9 @@
 
 extern struct ovsdb_idl *idl;
 
+/* Builds the snapshots of the ipIfStatsTable container, see mib_refresh.h. */
+extern struct mib_refresh ipIfStatsTable_refresh;
+
 int ipIfStatsTable_init_data(ipIfStatsTable_registration *ipIfStatsTable_reg);
 #define IPIFSTATSTABLE_CACHE_TIMEOUT 30
 void ipIfStatsTable_container_init(netsnmp_container **container_ptr_ptr,
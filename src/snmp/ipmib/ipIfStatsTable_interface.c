@@ -700,7 +700,10 @@ void _ipIfStatsTable_container_init(ipIfStatsTable_interface_ctx *if_ctx) {
         return;
     }
 
-    if_ctx->cache->flags = NETSNMP_CACHE_DONT_INVALIDATE_ON_SET;
+    /* Rows are updated in place by ipIfStatsTable_refresh, keep them. */
+    if_ctx->cache->flags = NETSNMP_CACHE_DONT_INVALIDATE_ON_SET |
+                           NETSNMP_CACHE_DONT_FREE_BEFORE_LOAD |
+                           NETSNMP_CACHE_DONT_FREE_EXPIRED;
     ipIfStatsTable_container_init(&if_ctx->container, if_ctx->cache);
     if (NULL == if_ctx->container) {
         if_ctx->container =
@@ -3,8 +3,12 @@
 #include <net-snmp/net-snmp-includes.h>
 #include <net-snmp/agent/net-snmp-agent-includes.h>
 #include "IP_MIB_custom.h"
+#include "intf_stats.h"
+#include "ipIfStatsTable.h"
 #include "ipSystemStatsTable.h"
 #include "ipSystemStatsTable_data_access.h"
+#include "mib_refresh.h"
+#include "ifindex_registry.h"
 
 #include "openswitch-idl.h"
 #include "ovsdb-idl.h"
@@ -47,333 +51,131 @@ void ipSystemStatsTable_container_shutdown(netsnmp_container *container_ptr) {
     }
 }
 
-int ipSystemStatsTable_container_load(netsnmp_container *container) {
-    DEBUGMSGTL(("verbose:ipSystemStatsTable:ipSystemStatsTable_container_load",
-                "called\n"));
-    ipSystemStatsTable_rowreq_ctx *rowreq_ctx;
-    size_t count = 0;
-
-    const struct ovsrec_port *port_row = NULL;
-
-    long ipSystemStatsIPVersion;
-
-    u_long ipSystemStatsInReceivesv4 = 0;
-    unsigned long long ipSystemStatsHCInReceivesv4 = 0;
-    u_long ipSystemStatsInOctetsv4 = 0;
-    unsigned long long ipSystemStatsHCInOctetsv4 = 0;
-    u_long ipSystemStatsInHdrErrorsv4 = 0;
-    u_long ipSystemStatsInNoRoutesv4 = 0;
-    u_long ipSystemStatsInAddrErrorsv4 = 0;
-    u_long ipSystemStatsInUnknownProtosv4 = 0;
-    u_long ipSystemStatsInTruncatedPktsv4 = 0;
-    u_long ipSystemStatsInForwDatagramsv4 = 0;
-    unsigned long long ipSystemStatsHCInForwDatagramsv4 = 0;
-    u_long ipSystemStatsReasmReqdsv4 = 0;
-    u_long ipSystemStatsReasmOKsv4 = 0;
-    u_long ipSystemStatsReasmFailsv4 = 0;
-    u_long ipSystemStatsInDiscardsv4 = 0;
-    u_long ipSystemStatsInDeliversv4 = 0;
-    unsigned long long ipSystemStatsHCInDeliversv4 = 0;
-    u_long ipSystemStatsOutRequestsv4 = 0;
-    unsigned long long ipSystemStatsHCOutRequestsv4 = 0;
-    u_long ipSystemStatsOutNoRoutesv4 = 0;
-    u_long ipSystemStatsOutForwDatagramsv4 = 0;
-    unsigned long long ipSystemStatsHCOutForwDatagramsv4 = 0;
-    u_long ipSystemStatsOutDiscardsv4 = 0;
-    u_long ipSystemStatsOutFragReqdsv4 = 0;
-    u_long ipSystemStatsOutFragOKsv4 = 0;
-    u_long ipSystemStatsOutFragFailsv4 = 0;
-    u_long ipSystemStatsOutFragCreatesv4 = 0;
-    u_long ipSystemStatsOutTransmitsv4 = 0;
-    unsigned long long ipSystemStatsHCOutTransmitsv4 = 0;
-    u_long ipSystemStatsOutOctetsv4 = 0;
-    unsigned long long ipSystemStatsHCOutOctetsv4 = 0;
-    u_long ipSystemStatsInMcastPktsv4 = 0;
-    unsigned long long ipSystemStatsHCInMcastPktsv4 = 0;
-    u_long ipSystemStatsInMcastOctetsv4 = 0;
-    unsigned long long ipSystemStatsHCInMcastOctetsv4 = 0;
-    u_long ipSystemStatsOutMcastPktsv4 = 0;
-    unsigned long long ipSystemStatsHCOutMcastPktsv4 = 0;
-    u_long ipSystemStatsOutMcastOctetsv4 = 0;
-    unsigned long long ipSystemStatsHCOutMcastOctetsv4 = 0;
-    u_long ipSystemStatsInBcastPktsv4 = 0;
-    unsigned long long ipSystemStatsHCInBcastPktsv4 = 0;
-    u_long ipSystemStatsOutBcastPktsv4 = 0;
-    unsigned long long ipSystemStatsHCOutBcastPktsv4 = 0;
-    long ipSystemStatsDiscontinuityTimev4 = 0;
-    u_long ipSystemStatsRefreshRatev4 = 0;
-
-    u_long ipSystemStatsInReceivesv6 = 0;
-    unsigned long long ipSystemStatsHCInReceivesv6 = 0;
-    u_long ipSystemStatsInOctetsv6 = 0;
-    unsigned long long ipSystemStatsHCInOctetsv6 = 0;
-    u_long ipSystemStatsInHdrErrorsv6 = 0;
-    u_long ipSystemStatsInNoRoutesv6 = 0;
-    u_long ipSystemStatsInAddrErrorsv6 = 0;
-    u_long ipSystemStatsInUnknownProtosv6 = 0;
-    u_long ipSystemStatsInTruncatedPktsv6 = 0;
-    u_long ipSystemStatsInForwDatagramsv6 = 0;
-    unsigned long long ipSystemStatsHCInForwDatagramsv6 = 0;
-    u_long ipSystemStatsReasmReqdsv6 = 0;
-    u_long ipSystemStatsReasmOKsv6 = 0;
-    u_long ipSystemStatsReasmFailsv6 = 0;
-    u_long ipSystemStatsInDiscardsv6 = 0;
-    u_long ipSystemStatsInDeliversv6 = 0;
-    unsigned long long ipSystemStatsHCInDeliversv6 = 0;
-    u_long ipSystemStatsOutRequestsv6 = 0;
-    unsigned long long ipSystemStatsHCOutRequestsv6 = 0;
-    u_long ipSystemStatsOutNoRoutesv6 = 0;
-    u_long ipSystemStatsOutForwDatagramsv6 = 0;
-    unsigned long long ipSystemStatsHCOutForwDatagramsv6 = 0;
-    u_long ipSystemStatsOutDiscardsv6 = 0;
-    u_long ipSystemStatsOutFragReqdsv6 = 0;
-    u_long ipSystemStatsOutFragOKsv6 = 0;
-    u_long ipSystemStatsOutFragFailsv6 = 0;
-    u_long ipSystemStatsOutFragCreatesv6 = 0;
-    u_long ipSystemStatsOutTransmitsv6 = 0;
-    unsigned long long ipSystemStatsHCOutTransmitsv6 = 0;
-    u_long ipSystemStatsOutOctetsv6 = 0;
-    unsigned long long ipSystemStatsHCOutOctetsv6 = 0;
-    u_long ipSystemStatsInMcastPktsv6 = 0;
-    unsigned long long ipSystemStatsHCInMcastPktsv6 = 0;
-    u_long ipSystemStatsInMcastOctetsv6 = 0;
-    unsigned long long ipSystemStatsHCInMcastOctetsv6 = 0;
-    u_long ipSystemStatsOutMcastPktsv6 = 0;
-    unsigned long long ipSystemStatsHCOutMcastPktsv6 = 0;
-    u_long ipSystemStatsOutMcastOctetsv6 = 0;
-    unsigned long long ipSystemStatsHCOutMcastOctetsv6 = 0;
-    u_long ipSystemStatsInBcastPktsv6 = 0;
-    unsigned long long ipSystemStatsHCInBcastPktsv6 = 0;
-    u_long ipSystemStatsOutBcastPktsv6 = 0;
-    unsigned long long ipSystemStatsHCOutBcastPktsv6 = 0;
-    long ipSystemStatsDiscontinuityTimev6 = 0;
-    u_long ipSystemStatsRefreshRatev6 = 0;
+/* The two rows, one per address family, hold the totals of the
+ * ipIfStatsTable rows.  They are created by the first snapshot of
+ * ipIfStatsTable_refresh and updated in place as it publishes the next
+ * ones, so this table has no refresh of its own. */
 
-    port_row = ovsrec_port_first(idl);
-    if (!port_row) {
-        snmp_log(LOG_ERR, "not able to fetch port row");
-        return -1;
-    }
-
-    OVSREC_PORT_FOR_EACH(port_row, idl) {
-        const struct ovsrec_interface *interface_row = NULL;
-
-        if(portTable_inetv4(idl, port_row, NULL)){
-            interface_row = *port_row->interfaces;
-
-            ipSystemStatsInReceivesv4 += ipIfStatsInReceives_custom_function_v4(interface_row);
-            ipSystemStatsHCInReceivesv4 += ipIfStatsInReceives_custom_function_v4(interface_row);
-
-            ipSystemStatsInOctetsv4 += ipIfStatsInOctets_custom_function_v4(interface_row);
-            ipSystemStatsHCInOctetsv4 += ipIfStatsInOctets_custom_function_v4(interface_row);
+/* Fills the columns there are counters for, the others read 0. */
+static void ipSystemStatsTable_columns_get(const struct intf_ip_stats *stats,
+                                           ipSystemStatsTable_data *data) {
+    memset(data, 0, sizeof(*data));
 
-            ipSystemStatsOutTransmitsv4 += ipIfStatsOutTransmits_custom_function_v4(interface_row);
-            ipSystemStatsHCOutTransmitsv4 += ipIfStatsOutTransmits_custom_function_v4(interface_row);
+    data->ipSystemStatsHCInReceives =
+        ipIfStatsInReceives_custom_function(stats);
+    data->ipSystemStatsInReceives = data->ipSystemStatsHCInReceives;
 
-            ipSystemStatsOutOctetsv4 += ipIfStatsOutOctets_custom_function_v4(interface_row);
-            ipSystemStatsHCOutOctetsv4 += ipIfStatsOutOctets_custom_function_v4(interface_row);
+    data->ipSystemStatsHCInOctets = ipIfStatsInOctets_custom_function(stats);
+    data->ipSystemStatsInOctets = data->ipSystemStatsHCInOctets;
 
-            ipSystemStatsInMcastPktsv4 += ipIfStatsInMcastPkts_custom_function_v4(interface_row);
-            ipSystemStatsHCInMcastPktsv4 += ipIfStatsInMcastPkts_custom_function_v4(interface_row);
-
-            ipSystemStatsInMcastOctetsv4 += ipIfStatsInMcastOctets_custom_function_v4(interface_row);
-            ipSystemStatsHCInMcastOctetsv4 += ipIfStatsInMcastOctets_custom_function_v4(interface_row);
-
-            ipSystemStatsOutMcastPktsv4 += ipIfStatsOutMcastPkts_custom_function_v4(interface_row);
-            ipSystemStatsHCOutMcastPktsv4 += ipIfStatsOutMcastPkts_custom_function_v4(interface_row);
-
-            ipSystemStatsOutMcastOctetsv4 += ipIfStatsOutMcastOctets_custom_function_v4(interface_row);
-            ipSystemStatsHCOutMcastOctetsv4 += ipIfStatsOutMcastOctets_custom_function_v4(interface_row);
-        }
-        else if (portTable_inetv6(idl, port_row, NULL)){
-            interface_row = *port_row->interfaces;
+    data->ipSystemStatsHCOutTransmits =
+        ipIfStatsOutTransmits_custom_function(stats);
+    data->ipSystemStatsOutTransmits = data->ipSystemStatsHCOutTransmits;
 
-            ipSystemStatsInReceivesv6 += ipIfStatsInReceives_custom_function_v6(interface_row);
-            ipSystemStatsHCInReceivesv6 += ipIfStatsInReceives_custom_function_v6(interface_row);
+    data->ipSystemStatsHCOutOctets = ipIfStatsOutOctets_custom_function(stats);
+    data->ipSystemStatsOutOctets = data->ipSystemStatsHCOutOctets;
 
-            ipSystemStatsInOctetsv6 += ipIfStatsInOctets_custom_function_v6(interface_row);
-            ipSystemStatsHCInOctetsv6 += ipIfStatsInOctets_custom_function_v6(interface_row);
+    data->ipSystemStatsHCInMcastPkts =
+        ipIfStatsInMcastPkts_custom_function(stats);
+    data->ipSystemStatsInMcastPkts = data->ipSystemStatsHCInMcastPkts;
 
-            ipSystemStatsOutTransmitsv6 += ipIfStatsOutTransmits_custom_function_v6(interface_row);
-            ipSystemStatsHCOutTransmitsv6 += ipIfStatsOutTransmits_custom_function_v6(interface_row);
+    data->ipSystemStatsHCInMcastOctets =
+        ipIfStatsInMcastOctets_custom_function(stats);
+    data->ipSystemStatsInMcastOctets = data->ipSystemStatsHCInMcastOctets;
 
-            ipSystemStatsOutOctetsv6 += ipIfStatsOutOctets_custom_function_v6(interface_row);
-            ipSystemStatsHCOutOctetsv6 += ipIfStatsOutOctets_custom_function_v6(interface_row);
+    data->ipSystemStatsHCOutMcastPkts =
+        ipIfStatsOutMcastPkts_custom_function(stats);
+    data->ipSystemStatsOutMcastPkts = data->ipSystemStatsHCOutMcastPkts;
 
-            ipSystemStatsInMcastPktsv6 += ipIfStatsInMcastPkts_custom_function_v6(interface_row);
-            ipSystemStatsHCInMcastPktsv6 += ipIfStatsInMcastPkts_custom_function_v6(interface_row);
+    data->ipSystemStatsHCOutMcastOctets =
+        ipIfStatsOutMcastOctets_custom_function(stats);
+    data->ipSystemStatsOutMcastOctets = data->ipSystemStatsHCOutMcastOctets;
+}
 
-            ipSystemStatsInMcastOctetsv6 += ipIfStatsInMcastOctets_custom_function_v6(interface_row);
-            ipSystemStatsHCInMcastOctetsv6 += ipIfStatsInMcastOctets_custom_function_v6(interface_row);
+static void ipSystemStatsTable_ip_stats_add(struct intf_ip_stats *sum,
+                                            const struct intf_ip_stats *stats) {
+    sum->uc_rx_packets += stats->uc_rx_packets;
+    sum->uc_rx_bytes += stats->uc_rx_bytes;
+    sum->mc_rx_packets += stats->mc_rx_packets;
+    sum->mc_rx_bytes += stats->mc_rx_bytes;
+    sum->uc_tx_packets += stats->uc_tx_packets;
+    sum->uc_tx_bytes += stats->uc_tx_bytes;
+    sum->mc_tx_packets += stats->mc_tx_packets;
+    sum->mc_tx_bytes += stats->mc_tx_bytes;
+}
 
-            ipSystemStatsOutMcastPktsv6 += ipIfStatsOutMcastPkts_custom_function_v6(interface_row);
-            ipSystemStatsHCOutMcastPktsv6 += ipIfStatsOutMcastPkts_custom_function_v6(interface_row);
+void ipSystemStatsTable_totals_publish(void) {
+    netsnmp_container *container = ipSystemStatsTable_container_get();
+    netsnmp_container *if_container = ipIfStatsTable_container_get();
+    ipSystemStatsTable_rowreq_ctx *rowreq_ctx;
+    ipSystemStatsTable_mib_index mib_idx;
+    ipIfStatsTable_rowreq_ctx *if_rowreq_ctx;
+    struct intf_ip_stats sums[2];
+    netsnmp_iterator *it;
+    size_t count = 0;
+    int v;
 
-            ipSystemStatsOutMcastOctetsv6 += ipIfStatsOutMcastOctets_custom_function_v6(interface_row);
-            ipSystemStatsHCOutMcastOctetsv6 += ipIfStatsOutMcastOctets_custom_function_v6(interface_row);
-        }
+    if (container == NULL || if_container == NULL) {
+        return;
     }
 
-    ipSystemStatsIPVersion = 1;
-    rowreq_ctx = ipSystemStatsTable_allocate_rowreq_ctx(NULL);
-    if (rowreq_ctx == NULL) {
-        snmp_log(LOG_ERR, "memory allocation failed");
-        return MFD_RESOURCE_UNAVAILABLE;
-    }
-    if (MFD_SUCCESS != ipSystemStatsTable_indexes_set(
-                            rowreq_ctx, ipSystemStatsIPVersion)) {
-        snmp_log(LOG_ERR, "error setting indexes while loading");
-        ipSystemStatsTable_release_rowreq_ctx(rowreq_ctx);
-        return MFD_RESOURCE_UNAVAILABLE;
+    /* Sum the counters the ipIfStatsTable rows were derived from, instead
+     * of decoding the statistics of every port again. */
+    memset(sums, 0, sizeof(sums));
+    it = CONTAINER_ITERATOR(if_container);
+    if (it == NULL) {
+        return;
     }
-
-    rowreq_ctx->data.ipSystemStatsInReceives = ipSystemStatsInReceivesv4;
-    rowreq_ctx->data.ipSystemStatsHCInReceives = ipSystemStatsHCInReceivesv4;
-    rowreq_ctx->data.ipSystemStatsInOctets = ipSystemStatsInOctetsv4;
-    rowreq_ctx->data.ipSystemStatsHCInOctets = ipSystemStatsHCInOctetsv4;
-    rowreq_ctx->data.ipSystemStatsInHdrErrors = ipSystemStatsInHdrErrorsv4;
-    rowreq_ctx->data.ipSystemStatsInNoRoutes = ipSystemStatsInNoRoutesv4;
-    rowreq_ctx->data.ipSystemStatsInAddrErrors = ipSystemStatsInAddrErrorsv4;
-    rowreq_ctx->data.ipSystemStatsInUnknownProtos =
-        ipSystemStatsInUnknownProtosv4;
-    rowreq_ctx->data.ipSystemStatsInTruncatedPkts =
-        ipSystemStatsInTruncatedPktsv4;
-    rowreq_ctx->data.ipSystemStatsInForwDatagrams =
-        ipSystemStatsInForwDatagramsv4;
-    rowreq_ctx->data.ipSystemStatsHCInForwDatagrams =
-        ipSystemStatsHCInForwDatagramsv4;
-    rowreq_ctx->data.ipSystemStatsReasmReqds = ipSystemStatsReasmReqdsv4;
-    rowreq_ctx->data.ipSystemStatsReasmOKs = ipSystemStatsReasmOKsv4;
-    rowreq_ctx->data.ipSystemStatsReasmFails = ipSystemStatsReasmFailsv4;
-    rowreq_ctx->data.ipSystemStatsInDiscards = ipSystemStatsInDiscardsv4;
-    rowreq_ctx->data.ipSystemStatsInDelivers = ipSystemStatsInDeliversv4;
-    rowreq_ctx->data.ipSystemStatsHCInDelivers = ipSystemStatsHCInDeliversv4;
-    rowreq_ctx->data.ipSystemStatsOutRequests = ipSystemStatsOutRequestsv4;
-    rowreq_ctx->data.ipSystemStatsHCOutRequests =
-        ipSystemStatsHCOutRequestsv4;
-    rowreq_ctx->data.ipSystemStatsOutNoRoutes = ipSystemStatsOutNoRoutesv4;
-    rowreq_ctx->data.ipSystemStatsOutForwDatagrams =
-        ipSystemStatsOutForwDatagramsv4;
-    rowreq_ctx->data.ipSystemStatsHCOutForwDatagrams =
-        ipSystemStatsHCOutForwDatagramsv4;
-    rowreq_ctx->data.ipSystemStatsOutDiscards = ipSystemStatsOutDiscardsv4;
-    rowreq_ctx->data.ipSystemStatsOutFragReqds = ipSystemStatsOutFragReqdsv4;
-    rowreq_ctx->data.ipSystemStatsOutFragOKs = ipSystemStatsOutFragOKsv4;
-    rowreq_ctx->data.ipSystemStatsOutFragFails = ipSystemStatsOutFragFailsv4;
-    rowreq_ctx->data.ipSystemStatsOutFragCreates =
-        ipSystemStatsOutFragCreatesv4;
-    rowreq_ctx->data.ipSystemStatsOutTransmits = ipSystemStatsOutTransmitsv4;
-    rowreq_ctx->data.ipSystemStatsHCOutTransmits =
-        ipSystemStatsHCOutTransmitsv4;
-    rowreq_ctx->data.ipSystemStatsOutOctets = ipSystemStatsOutOctetsv4;
-    rowreq_ctx->data.ipSystemStatsHCOutOctets = ipSystemStatsHCOutOctetsv4;
-    rowreq_ctx->data.ipSystemStatsInMcastPkts = ipSystemStatsInMcastPktsv4;
-    rowreq_ctx->data.ipSystemStatsHCInMcastPkts =
-        ipSystemStatsHCInMcastPktsv4;
-    rowreq_ctx->data.ipSystemStatsInMcastOctets =
-        ipSystemStatsInMcastOctetsv4;
-    rowreq_ctx->data.ipSystemStatsHCInMcastOctets =
-        ipSystemStatsHCInMcastOctetsv4;
-    rowreq_ctx->data.ipSystemStatsOutMcastPkts = ipSystemStatsOutMcastPktsv4;
-    rowreq_ctx->data.ipSystemStatsHCOutMcastPkts =
-        ipSystemStatsHCOutMcastPktsv4;
-    rowreq_ctx->data.ipSystemStatsOutMcastOctets =
-        ipSystemStatsOutMcastOctetsv4;
-    rowreq_ctx->data.ipSystemStatsHCOutMcastOctets =
-        ipSystemStatsHCOutMcastOctetsv4;
-    rowreq_ctx->data.ipSystemStatsInBcastPkts = ipSystemStatsInBcastPktsv4;
-    rowreq_ctx->data.ipSystemStatsHCInBcastPkts =
-        ipSystemStatsHCInBcastPktsv4;
-    rowreq_ctx->data.ipSystemStatsOutBcastPkts = ipSystemStatsOutBcastPktsv4;
-    rowreq_ctx->data.ipSystemStatsHCOutBcastPkts =
-        ipSystemStatsHCOutBcastPktsv4;
-    rowreq_ctx->data.ipSystemStatsDiscontinuityTime =
-        ipSystemStatsDiscontinuityTimev4;
-    rowreq_ctx->data.ipSystemStatsRefreshRate = ipSystemStatsRefreshRatev4;
-    CONTAINER_INSERT(container, rowreq_ctx);
-    ++count;
-
-    ipSystemStatsIPVersion = 2;
-    rowreq_ctx = ipSystemStatsTable_allocate_rowreq_ctx(NULL);
-    if (rowreq_ctx == NULL) {
-        snmp_log(LOG_ERR, "memory allocation failed");
-        return MFD_RESOURCE_UNAVAILABLE;
+    for (if_rowreq_ctx = ITERATOR_FIRST(it); if_rowreq_ctx != NULL;
+         if_rowreq_ctx = ITERATOR_NEXT(it)) {
+        v = if_rowreq_ctx->tbl_idx.ipIfStatsIPVersion - 1;
+        if (v == 0 || v == 1) {
+            ipSystemStatsTable_ip_stats_add(&sums[v], &if_rowreq_ctx->stats);
+            count++;
+        }
     }
-    if (MFD_SUCCESS != ipSystemStatsTable_indexes_set(
-                            rowreq_ctx, ipSystemStatsIPVersion)) {
-        snmp_log(LOG_ERR, "error setting indexes while loading");
-        ipSystemStatsTable_release_rowreq_ctx(rowreq_ctx);
-        return MFD_RESOURCE_UNAVAILABLE;
+    ITERATOR_RELEASE(it);
+
+    for (v = 0; v < 2; v++) {
+        mib_idx.ipSystemStatsIPVersion = v + 1;
+
+        rowreq_ctx = ipSystemStatsTable_row_find_by_mib_index(&mib_idx);
+        if (rowreq_ctx == NULL) {
+            rowreq_ctx = ipSystemStatsTable_allocate_rowreq_ctx(NULL);
+            if (rowreq_ctx == NULL) {
+                snmp_log(LOG_ERR, "memory allocation failed");
+                return;
+            }
+            if (MFD_SUCCESS !=
+                ipSystemStatsTable_indexes_set(
+                    rowreq_ctx, mib_idx.ipSystemStatsIPVersion)) {
+                snmp_log(LOG_ERR, "error setting indexes while loading");
+                ipSystemStatsTable_release_rowreq_ctx(rowreq_ctx);
+                continue;
+            }
+            if (CONTAINER_INSERT(container, rowreq_ctx) != 0) {
+                ipSystemStatsTable_release_rowreq_ctx(rowreq_ctx);
+                continue;
+            }
+        }
+        ipSystemStatsTable_columns_get(&sums[v], &rowreq_ctx->data);
     }
 
-    rowreq_ctx->data.ipSystemStatsInReceives = ipSystemStatsInReceivesv6;
-    rowreq_ctx->data.ipSystemStatsHCInReceives = ipSystemStatsHCInReceivesv6;
-    rowreq_ctx->data.ipSystemStatsInOctets = ipSystemStatsInOctetsv6;
-    rowreq_ctx->data.ipSystemStatsHCInOctets = ipSystemStatsHCInOctetsv6;
-    rowreq_ctx->data.ipSystemStatsInHdrErrors = ipSystemStatsInHdrErrorsv6;
-    rowreq_ctx->data.ipSystemStatsInNoRoutes = ipSystemStatsInNoRoutesv6;
-    rowreq_ctx->data.ipSystemStatsInAddrErrors = ipSystemStatsInAddrErrorsv6;
-    rowreq_ctx->data.ipSystemStatsInUnknownProtos =
-        ipSystemStatsInUnknownProtosv6;
-    rowreq_ctx->data.ipSystemStatsInTruncatedPkts =
-        ipSystemStatsInTruncatedPktsv6;
-    rowreq_ctx->data.ipSystemStatsInForwDatagrams =
-        ipSystemStatsInForwDatagramsv6;
-    rowreq_ctx->data.ipSystemStatsHCInForwDatagrams =
-        ipSystemStatsHCInForwDatagramsv6;
-    rowreq_ctx->data.ipSystemStatsReasmReqds = ipSystemStatsReasmReqdsv6;
-    rowreq_ctx->data.ipSystemStatsReasmOKs = ipSystemStatsReasmOKsv6;
-    rowreq_ctx->data.ipSystemStatsReasmFails = ipSystemStatsReasmFailsv6;
-    rowreq_ctx->data.ipSystemStatsInDiscards = ipSystemStatsInDiscardsv6;
-    rowreq_ctx->data.ipSystemStatsInDelivers = ipSystemStatsInDeliversv6;
-    rowreq_ctx->data.ipSystemStatsHCInDelivers = ipSystemStatsHCInDeliversv6;
-    rowreq_ctx->data.ipSystemStatsOutRequests = ipSystemStatsOutRequestsv6;
-    rowreq_ctx->data.ipSystemStatsHCOutRequests =
-        ipSystemStatsHCOutRequestsv6;
-    rowreq_ctx->data.ipSystemStatsOutNoRoutes = ipSystemStatsOutNoRoutesv6;
-    rowreq_ctx->data.ipSystemStatsOutForwDatagrams =
-        ipSystemStatsOutForwDatagramsv6;
-    rowreq_ctx->data.ipSystemStatsHCOutForwDatagrams =
-        ipSystemStatsHCOutForwDatagramsv6;
-    rowreq_ctx->data.ipSystemStatsOutDiscards = ipSystemStatsOutDiscardsv6;
-    rowreq_ctx->data.ipSystemStatsOutFragReqds = ipSystemStatsOutFragReqdsv6;
-    rowreq_ctx->data.ipSystemStatsOutFragOKs = ipSystemStatsOutFragOKsv6;
-    rowreq_ctx->data.ipSystemStatsOutFragFails = ipSystemStatsOutFragFailsv6;
-    rowreq_ctx->data.ipSystemStatsOutFragCreates =
-        ipSystemStatsOutFragCreatesv6;
-    rowreq_ctx->data.ipSystemStatsOutTransmits = ipSystemStatsOutTransmitsv6;
-    rowreq_ctx->data.ipSystemStatsHCOutTransmits =
-        ipSystemStatsHCOutTransmitsv6;
-    rowreq_ctx->data.ipSystemStatsOutOctets = ipSystemStatsOutOctetsv6;
-    rowreq_ctx->data.ipSystemStatsHCOutOctets = ipSystemStatsHCOutOctetsv6;
-    rowreq_ctx->data.ipSystemStatsInMcastPkts = ipSystemStatsInMcastPktsv6;
-    rowreq_ctx->data.ipSystemStatsHCInMcastPkts =
-        ipSystemStatsHCInMcastPktsv6;
-    rowreq_ctx->data.ipSystemStatsInMcastOctets =
-        ipSystemStatsInMcastOctetsv6;
-    rowreq_ctx->data.ipSystemStatsHCInMcastOctets =
-        ipSystemStatsHCInMcastOctetsv6;
-    rowreq_ctx->data.ipSystemStatsOutMcastPkts = ipSystemStatsOutMcastPktsv6;
-    rowreq_ctx->data.ipSystemStatsHCOutMcastPkts =
-        ipSystemStatsHCOutMcastPktsv6;
-    rowreq_ctx->data.ipSystemStatsOutMcastOctets =
-        ipSystemStatsOutMcastOctetsv6;
-    rowreq_ctx->data.ipSystemStatsHCOutMcastOctets =
-        ipSystemStatsHCOutMcastOctetsv6;
-    rowreq_ctx->data.ipSystemStatsInBcastPkts = ipSystemStatsInBcastPktsv6;
-    rowreq_ctx->data.ipSystemStatsHCInBcastPkts =
-        ipSystemStatsHCInBcastPktsv6;
-    rowreq_ctx->data.ipSystemStatsOutBcastPkts = ipSystemStatsOutBcastPktsv6;
-    rowreq_ctx->data.ipSystemStatsHCOutBcastPkts =
-        ipSystemStatsHCOutBcastPktsv6;
-    rowreq_ctx->data.ipSystemStatsDiscontinuityTime =
-        ipSystemStatsDiscontinuityTimev6;
-    rowreq_ctx->data.ipSystemStatsRefreshRate = ipSystemStatsRefreshRatev6;
-    CONTAINER_INSERT(container, rowreq_ctx);
-    ++count;
+    DEBUGMSGTL(("verbose:ipSystemStatsTable:ipSystemStatsTable_totals_publish",
+                "published the totals of %d ipIfStatsTable rows\n",
+                (int)count));
+}
 
+int ipSystemStatsTable_container_load(netsnmp_container *container) {
     DEBUGMSGTL(("verbose:ipSystemStatsTable:ipSystemStatsTable_container_load",
-                "inserted %d records\n", (int)count));
+                "called\n"));
+
+    /* ops_snmp_run() normally keeps the snapshot fresh. */
+    if (!mib_refresh_ready(&ipIfStatsTable_refresh)) {
+        mib_refresh_sync(&ipIfStatsTable_refresh);
+    }
+    /* A snapshot built here may have added names. */
+    ifindex_registry_flush();
     return MFD_SUCCESS;
 }
 
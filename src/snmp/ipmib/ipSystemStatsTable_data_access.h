@@ -3,6 +3,9 @@
 
 extern struct ovsdb_idl *idl;
 
+/* Updates the two rows from the ipIfStatsTable rows. */
+void ipSystemStatsTable_totals_publish(void);
+
 int ipSystemStatsTable_init_data(
     ipSystemStatsTable_registration *ipSystemStatsTable_reg);
 #define IPSYSTEMSTATSTABLE_CACHE_TIMEOUT 30
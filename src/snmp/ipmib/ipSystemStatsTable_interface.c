@@ -726,7 +726,11 @@ void _ipSystemStatsTable_container_init(
         return;
     }
 
-    if_ctx->cache->flags = NETSNMP_CACHE_DONT_INVALIDATE_ON_SET;
+    /* The rows are updated in place with the ipIfStatsTable ones, keep
+     * them. */
+    if_ctx->cache->flags = NETSNMP_CACHE_DONT_INVALIDATE_ON_SET |
+                           NETSNMP_CACHE_DONT_FREE_BEFORE_LOAD |
+                           NETSNMP_CACHE_DONT_FREE_EXPIRED;
     ipSystemStatsTable_container_init(&if_ctx->container, if_ctx->cache);
     if (NULL == if_ctx->container) {
         if_ctx->container =
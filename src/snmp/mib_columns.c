@@ -0,0 +1,73 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup ops-intfd
+ *
+ * @file
+ * Source for the columnar counter snapshots of the IF-MIB tables.
+ *
+ ***************************************************************************/
+
+#include <stdlib.h>
+
+#include "util.h"
+#include "openvswitch/vlog.h"
+#include "mib_columns.h"
+
+VLOG_DEFINE_THIS_MODULE(mib_columns);
+
+bool
+mib_columns_reset(struct mib_columns *cols, size_t n_rows)
+{
+    if (n_rows > cols->allocated) {
+        size_t allocated = n_rows * 2;
+        uint64_t *values;
+
+        values = malloc(allocated * cols->n_columns * sizeof *values);
+        if (!values) {
+            VLOG_ERR("out of memory for %"PRIuSIZE" rows", n_rows);
+            cols->n_rows = 0;
+            return false;
+        }
+        free(cols->values);
+        cols->values = values;
+        cols->allocated = allocated;
+    }
+    cols->n_rows = n_rows;
+    return true;
+} /* mib_columns_reset */
+
+void
+mib_columns_swap(struct mib_columns *front, struct mib_columns *back)
+{
+    struct mib_columns tmp = *front;
+    unsigned int generation = front->generation + 1;
+
+    *front = *back;
+    *back = tmp;
+    /* 0 is the generation of the rows no snapshot has seen yet. */
+    front->generation = generation ? generation : 1;
+} /* mib_columns_swap */
+
+void
+mib_columns_destroy(struct mib_columns *cols)
+{
+    free(cols->values);
+    cols->values = NULL;
+    cols->n_rows = 0;
+    cols->allocated = 0;
+    cols->generation = 0;
+} /* mib_columns_destroy */
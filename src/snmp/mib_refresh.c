@@ -0,0 +1,148 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup ops-intfd
+ *
+ * @file
+ * Source for the background refresh of the IF-MIB and IP-MIB tables.
+ *
+ ***************************************************************************/
+
+#include "dynamic-string.h"
+#include "poll-loop.h"
+#include "timeval.h"
+#include "mib_refresh.h"
+
+static void
+refresh_begin(struct mib_refresh *r, long long int now)
+{
+    r->building = true;
+    r->started = now;
+    r->busy = 0;
+    r->n_slices = 0;
+    r->next_item = 0;
+    r->n_items = r->begin();
+} /* refresh_begin */
+
+static void
+refresh_publish(struct mib_refresh *r)
+{
+    r->publish();
+
+    r->building = false;
+    r->published = time_msec();
+    r->last_duration = r->published - r->started;
+    r->last_busy = r->busy;
+    r->last_slices = r->n_slices;
+    r->last_items = r->n_items;
+    r->n_snapshots++;
+} /* refresh_publish */
+
+void
+mib_refresh_run(struct mib_refresh *r)
+{
+    long long int now = time_msec();
+    long long int deadline = now + MIB_REFRESH_SLICE_MSEC;
+    size_t n;
+
+    if (!r->building) {
+        if (r->published && now < r->started + r->interval) {
+            return;
+        }
+        refresh_begin(r, now);
+    }
+
+    for (n = 0; n < MIB_REFRESH_SLICE_ROWS && r->next_item < r->n_items;
+         n++) {
+        r->step(r->next_item++);
+        if (time_msec() >= deadline) {
+            break;
+        }
+    }
+    r->busy += time_msec() - now;
+    r->n_slices++;
+
+    if (r->next_item >= r->n_items) {
+        refresh_publish(r);
+    }
+} /* mib_refresh_run */
+
+void
+mib_refresh_wait(const struct mib_refresh *r)
+{
+    if (r->building || !r->published) {
+        poll_immediate_wake();
+    } else {
+        poll_timer_wait_until(r->started + r->interval);
+    }
+} /* mib_refresh_wait */
+
+bool
+mib_refresh_set_interval(struct mib_refresh *r, long int seconds)
+{
+    if (seconds < MIB_REFRESH_INTERVAL_MIN
+        || seconds > MIB_REFRESH_INTERVAL_MAX) {
+        return false;
+    }
+    r->interval = seconds * 1000LL;
+    return true;
+} /* mib_refresh_set_interval */
+
+bool
+mib_refresh_ready(const struct mib_refresh *r)
+{
+    return r->published && time_msec() - r->published < 2 * r->interval;
+} /* mib_refresh_ready */
+
+void
+mib_refresh_sync(struct mib_refresh *r)
+{
+    long long int now = time_msec();
+
+    if (!r->building) {
+        refresh_begin(r, now);
+    }
+    while (r->next_item < r->n_items) {
+        r->step(r->next_item++);
+    }
+    r->busy += time_msec() - now;
+    r->n_slices++;
+    r->n_sync++;
+
+    refresh_publish(r);
+} /* mib_refresh_sync */
+
+void
+mib_refresh_format_header(struct ds *ds)
+{
+    ds_put_format(ds, "%-20s %8s %6s %9s %10s %8s %6s %10s %6s\n", "Table",
+                  "Every(s)", "Items", "Age(ms)", "Build(ms)", "Busy(ms)",
+                  "Slices", "Snapshots", "Sync");
+} /* mib_refresh_format_header */
+
+void
+mib_refresh_format(const struct mib_refresh *r, struct ds *ds)
+{
+    if (!r->published) {
+        ds_put_format(ds, "%-20s %8lld no snapshot yet\n", r->name,
+                      r->interval / 1000);
+        return;
+    }
+    ds_put_format(ds, "%-20s %8lld %6zu %9lld %10lld %8lld %6u %10llu"
+                  " %6llu\n", r->name, r->interval / 1000, r->last_items,
+                  time_msec() - r->published, r->last_duration, r->last_busy,
+                  r->last_slices, r->n_snapshots, r->n_sync);
+} /* mib_refresh_format */
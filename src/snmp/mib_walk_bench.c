@@ -0,0 +1,588 @@
+/*
+ * (c) Copyright 2016 Hewlett Packard Enterprise Development LP
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+/************************************************************************//**
+ * @ingroup ops-intfd
+ *
+ * @file
+ * Benchmark for the tables of the IF-MIB and IP-MIB plugins.
+ *
+ * It connects to an OVSDB server that already holds the rows, loads the
+ * plugins with dlopen() and ops_snmp_init() like ops-snmpd does, and
+ * provides the 'idl' they share.  Two phases are timed for ifTable,
+ * ifXTable, ipIfStatsTable and ipSystemStatsTable:
+ *
+ *      load    mib_refresh_sync() of the refreshes of the table, i.e. what
+ *              container_load() does when no snapshot is ready.  The first
+ *              one fills empty containers, the next ones find every row in
+ *              place, which is the cost of each periodic refresh.
+ *
+ *      walk    The whole table with GETNEXT, or GETBULK with -r, sent to
+ *              the agent through its internal callback transport: each
+ *              request goes through the handler chain of the table, but
+ *              not through a socket nor the BER encoder.
+ *
+ * ipSystemStatsTable is derived when ipIfStatsTable is published, so it
+ * has no load of its own.  Each -c passes a line of snmpd.conf to the
+ * plugins, e.g. -c "ifMibColumnarCounters yes".
+ *
+ * Usage: mib_walk_bench [-w WALKS] [-r MAX_REPETITIONS] [-c LINE]... [-j]
+ *                       DATABASE PLUGIN...
+ *
+ * The plugins save the ifIndex registry in ovs_dbdir(): point OVS_DBDIR at
+ * a scratch directory.  tools/scale/snmp_walk_scale.py creates databases
+ * of 64 to 8192 interfaces and runs it on each; "make bench-snmp-walk"
+ * runs that.
+ *
+ ***************************************************************************/
+
+#include <dlfcn.h>
+#include <getopt.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <net-snmp/net-snmp-config.h>
+#include <net-snmp/net-snmp-includes.h>
+#include <net-snmp/agent/net-snmp-agent-includes.h>
+#include <net-snmp/library/snmpCallbackDomain.h>
+
+#include "ovsdb-idl.h"
+#include "poll-loop.h"
+#include "timeval.h"
+#include "vswitch-idl.h"
+#include "mib_refresh.h"
+
+/** @ingroup ops-intfd
+ * @{ */
+
+#define BENCH_NAME                  "mib_walk_bench"
+#define BENCH_DEFAULT_WALKS         20
+#define BENCH_MAX_PLUGINS           4
+#define BENCH_MAX_CONFIGS           8
+#define BENCH_SYNC_TIMEOUT_MSEC     30000
+
+/* The IDL of the plugins, which ops-snmpd provides otherwise. */
+struct ovsdb_idl *idl;
+
+/* Set by init_agent(): the agent end of the callback transport. */
+extern int callback_master_num;
+
+struct bench_plugin {
+    const char      *file_name;
+    void            *handle;
+    void            (*destroy)(void);
+};
+
+static struct bench_plugin bench_plugins[BENCH_MAX_PLUGINS];
+static size_t n_bench_plugins;
+
+struct bench_table {
+    const char      *name;
+    oid             root[MAX_OID_LEN];
+    size_t          root_len;
+    const char      *refreshes[2];  /* Symbols of its struct mib_refresh. */
+};
+
+static const struct bench_table bench_tables[] = {
+    { "ifTable", { 1, 3, 6, 1, 2, 1, 2, 2 }, 8,
+      { "ifTable_refresh", "ifTable_counters_refresh" } },
+    { "ifXTable", { 1, 3, 6, 1, 2, 1, 31, 1, 1 }, 9,
+      { "ifXTable_refresh", "ifXTable_counters_refresh" } },
+    { "ipIfStatsTable", { 1, 3, 6, 1, 2, 1, 4, 31, 3 }, 9,
+      { "ipIfStatsTable_refresh", NULL } },
+    { "ipSystemStatsTable", { 1, 3, 6, 1, 2, 1, 4, 31, 1 }, 9,
+      { NULL, NULL } },
+};
+
+#define N_BENCH_TABLES (sizeof(bench_tables) / sizeof(bench_tables[0]))
+
+/* What one walk saw. */
+struct bench_walk {
+    uint64_t        n_requests;
+    uint64_t        n_varbinds;
+    uint64_t        n_rows;         /* Varbinds of the first column. */
+};
+
+struct bench_result {
+    const struct bench_table    *table;
+    bool                        has_load;
+    uint64_t                    load_cold_ns;
+    uint64_t                    load_ns;        /* Mean of the reloads. */
+    struct bench_walk           walk;           /* Of the last walk. */
+    uint64_t                    *walk_ns;       /* One per walk, sorted. */
+    uint64_t                    walk_total_ns;
+};
+
+static uint64_t
+bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+
+} /* bench_now_ns */
+
+static void
+bench_fail(const char *message)
+{
+    fprintf(stderr, "%s: %s\n", BENCH_NAME, message);
+    exit(EXIT_FAILURE);
+
+} /* bench_fail */
+
+static void
+bench_plugin_load(const char *file_name)
+{
+    struct bench_plugin *plugin;
+    void (*init)(void);
+
+    if (n_bench_plugins >= BENCH_MAX_PLUGINS) {
+        bench_fail("too many plugins");
+    }
+    plugin = &bench_plugins[n_bench_plugins++];
+    plugin->file_name = file_name;
+
+    /* Local, like ops-snmpd: every plugin has its own copy of
+     * mib_refresh.c and of the ifIndex registry. */
+    plugin->handle = dlopen(file_name, RTLD_NOW | RTLD_LOCAL);
+    if (!plugin->handle) {
+        bench_fail(dlerror());
+    }
+    init = (void (*)(void)) dlsym(plugin->handle, "ops_snmp_init");
+    plugin->destroy = (void (*)(void)) dlsym(plugin->handle,
+                                             "ops_snmp_destroy");
+    if (!init || !plugin->destroy) {
+        fprintf(stderr, "%s: %s is not an SNMP plugin\n", BENCH_NAME,
+                file_name);
+        exit(EXIT_FAILURE);
+    }
+    init();
+
+} /* bench_plugin_load */
+
+/* Returns the refresh called 'name' in whichever plugin has it, and the
+ * mib_refresh_sync() of that plugin in '*sync'. */
+static struct mib_refresh *
+bench_refresh_find(const char *name, void (**sync)(struct mib_refresh *))
+{
+    struct mib_refresh *refresh;
+    size_t i;
+
+    for (i = 0; i < n_bench_plugins; i++) {
+        refresh = dlsym(bench_plugins[i].handle, name);
+        if (refresh) {
+            *sync = (void (*)(struct mib_refresh *))
+                    dlsym(bench_plugins[i].handle, "mib_refresh_sync");
+            if (*sync) {
+                return refresh;
+            }
+        }
+    }
+    return NULL;
+
+} /* bench_refresh_find */
+
+/* Waits until the IDL holds the contents of the database. */
+static void
+bench_idl_sync(void)
+{
+    long long int deadline = time_msec() + BENCH_SYNC_TIMEOUT_MSEC;
+
+    for (;;) {
+        ovsdb_idl_run(idl);
+        if (ovsdb_idl_has_ever_connected(idl)) {
+            return;
+        }
+        if (time_msec() >= deadline) {
+            bench_fail("timed out reading the database");
+        }
+        ovsdb_idl_wait(idl);
+        poll_timer_wait_until(deadline);
+        poll_block();
+    }
+
+} /* bench_idl_sync */
+
+/* Builds the snapshots of 'table' at once.  Returns false if it has no
+ * refresh of its own. */
+static bool
+bench_load(const struct bench_table *table, uint64_t *elapsed_ns)
+{
+    void (*sync[2])(struct mib_refresh *);
+    struct mib_refresh *refresh[2];
+    size_t i, n = 0;
+    uint64_t start;
+
+    for (i = 0; i < 2 && table->refreshes[i]; i++) {
+        refresh[n] = bench_refresh_find(table->refreshes[i], &sync[n]);
+        if (!refresh[n]) {
+            fprintf(stderr, "%s: no plugin has %s\n", BENCH_NAME,
+                    table->refreshes[i]);
+            exit(EXIT_FAILURE);
+        }
+        n++;
+    }
+    if (!n) {
+        return false;
+    }
+
+    start = bench_now_ns();
+    for (i = 0; i < n; i++) {
+        sync[i](refresh[i]);
+    }
+    *elapsed_ns = bench_now_ns() - start;
+    return true;
+
+} /* bench_load */
+
+static netsnmp_session *
+bench_session_open(void)
+{
+    netsnmp_session *ss;
+
+    ss = netsnmp_callback_open(callback_master_num, NULL, NULL, NULL);
+    if (!ss) {
+        bench_fail("cannot open a session to the agent");
+    }
+    ss->version = SNMP_VERSION_2c;
+    ss->securityModel = SNMP_SEC_MODEL_SNMPv2c;
+    return ss;
+
+} /* bench_session_open */
+
+/* Walks 'table' from its root to the first OID past it. */
+static void
+bench_walk(netsnmp_session *ss, const struct bench_table *table,
+           long max_repetitions, struct bench_walk *walk)
+{
+    oid name[MAX_OID_LEN];
+    size_t name_len = table->root_len;
+    oid first_column = 0;
+    bool done = false;
+
+    memset(walk, 0, sizeof *walk);
+    memcpy(name, table->root, table->root_len * sizeof(oid));
+
+    while (!done) {
+        netsnmp_variable_list *var;
+        netsnmp_pdu *pdu, *response = NULL;
+        int status;
+
+        if (max_repetitions) {
+            pdu = snmp_pdu_create(SNMP_MSG_GETBULK);
+            pdu->non_repeaters = 0;
+            pdu->max_repetitions = max_repetitions;
+        } else {
+            pdu = snmp_pdu_create(SNMP_MSG_GETNEXT);
+        }
+        snmp_add_null_var(pdu, name, name_len);
+
+        status = snmp_synch_response(ss, pdu, &response);
+        if (status != STAT_SUCCESS || !response
+            || response->errstat != SNMP_ERR_NOERROR) {
+            fprintf(stderr, "%s: %s: request failed (%s)\n", BENCH_NAME,
+                    table->name, response
+                    ? snmp_errstring(response->errstat)
+                    : snmp_api_errstring(ss->s_snmp_errno));
+            exit(EXIT_FAILURE);
+        }
+        walk->n_requests++;
+
+        for (var = response->variables; var; var = var->next_variable) {
+            if (var->type == SNMP_ENDOFMIBVIEW
+                || var->type == SNMP_NOSUCHOBJECT
+                || var->type == SNMP_NOSUCHINSTANCE
+                || var->name_length <= table->root_len + 2
+                || snmp_oid_compare(var->name, table->root_len, table->root,
+                                    table->root_len)) {
+                done = true;
+                break;
+            }
+            /* root.1.column.index */
+            if (!first_column) {
+                first_column = var->name[table->root_len + 1];
+            }
+            if (var->name[table->root_len + 1] == first_column) {
+                walk->n_rows++;
+            }
+            walk->n_varbinds++;
+            memcpy(name, var->name, var->name_length * sizeof(oid));
+            name_len = var->name_length;
+        }
+        snmp_free_pdu(response);
+    }
+
+} /* bench_walk */
+
+static int
+bench_compare_ns(const void *a_, const void *b_)
+{
+    uint64_t a = *(const uint64_t *) a_;
+    uint64_t b = *(const uint64_t *) b_;
+
+    return a < b ? -1 : a > b;
+
+} /* bench_compare_ns */
+
+static void
+bench_run_table(netsnmp_session *ss, const struct bench_table *table,
+                long walks, long max_repetitions, struct bench_result *res)
+{
+    uint64_t start, elapsed, total = 0;
+    long i;
+
+    memset(res, 0, sizeof *res);
+    res->table = table;
+    res->walk_ns = calloc(walks, sizeof *res->walk_ns);
+    if (!res->walk_ns) {
+        bench_fail("out of memory");
+    }
+
+    res->has_load = bench_load(table, &res->load_cold_ns);
+    if (res->has_load) {
+        for (i = 0; i < walks; i++) {
+            bench_load(table, &elapsed);
+            total += elapsed;
+        }
+        res->load_ns = total / walks;
+    }
+
+    /* One walk to warm up the caches. */
+    bench_walk(ss, table, max_repetitions, &res->walk);
+    for (i = 0; i < walks; i++) {
+        start = bench_now_ns();
+        bench_walk(ss, table, max_repetitions, &res->walk);
+        res->walk_ns[i] = bench_now_ns() - start;
+        res->walk_total_ns += res->walk_ns[i];
+    }
+    qsort(res->walk_ns, walks, sizeof *res->walk_ns, bench_compare_ns);
+
+} /* bench_run_table */
+
+static double
+bench_ms(uint64_t ns)
+{
+    return ns / 1e6;
+
+} /* bench_ms */
+
+static double
+bench_per_sec(uint64_t n, uint64_t ns)
+{
+    return ns ? n * 1e9 / ns : 0;
+
+} /* bench_per_sec */
+
+static void
+bench_report_text(const struct bench_result *results, long walks)
+{
+    size_t i;
+
+    printf("%-20s %7s %9s %9s %9s %9s %8s %12s %12s\n", "table", "rows",
+           "cold(ms)", "load(ms)", "p50(ms)", "p99(ms)", "requests",
+           "rows/sec", "varbinds/sec");
+    for (i = 0; i < N_BENCH_TABLES; i++) {
+        const struct bench_result *res = &results[i];
+
+        printf("%-20s %7llu", res->table->name,
+               (unsigned long long) res->walk.n_rows);
+        if (res->has_load) {
+            printf(" %9.3f %9.3f", bench_ms(res->load_cold_ns),
+                   bench_ms(res->load_ns));
+        } else {
+            printf(" %9s %9s", "-", "-");
+        }
+        printf(" %9.3f %9.3f %8llu %12.0f %12.0f\n",
+               bench_ms(res->walk_ns[walks / 2]),
+               bench_ms(res->walk_ns[(walks * 99) / 100]),
+               (unsigned long long) res->walk.n_requests,
+               bench_per_sec(res->walk.n_rows * walks, res->walk_total_ns),
+               bench_per_sec(res->walk.n_varbinds * walks,
+                             res->walk_total_ns));
+    }
+
+} /* bench_report_text */
+
+static void
+bench_report_json(const struct bench_result *results, long walks,
+                  long max_repetitions)
+{
+    size_t i;
+
+    printf("{\"walks\": %ld, \"max_repetitions\": %ld, \"tables\": {",
+           walks, max_repetitions);
+    for (i = 0; i < N_BENCH_TABLES; i++) {
+        const struct bench_result *res = &results[i];
+
+        printf("%s\"%s\": {\"rows\": %llu, \"varbinds\": %llu, "
+               "\"requests\": %llu, ", i ? ", " : "", res->table->name,
+               (unsigned long long) res->walk.n_rows,
+               (unsigned long long) res->walk.n_varbinds,
+               (unsigned long long) res->walk.n_requests);
+        if (res->has_load) {
+            printf("\"load_cold_ms\": %.3f, \"load_ms\": %.3f, ",
+                   bench_ms(res->load_cold_ns), bench_ms(res->load_ns));
+        }
+        printf("\"walk_min_ms\": %.3f, \"walk_p50_ms\": %.3f, "
+               "\"walk_p99_ms\": %.3f, \"walk_max_ms\": %.3f, "
+               "\"walk_mean_ms\": %.3f, \"rows_per_sec\": %.0f, "
+               "\"varbinds_per_sec\": %.0f}",
+               bench_ms(res->walk_ns[0]),
+               bench_ms(res->walk_ns[walks / 2]),
+               bench_ms(res->walk_ns[(walks * 99) / 100]),
+               bench_ms(res->walk_ns[walks - 1]),
+               bench_ms(res->walk_total_ns / walks),
+               bench_per_sec(res->walk.n_rows * walks, res->walk_total_ns),
+               bench_per_sec(res->walk.n_varbinds * walks,
+                             res->walk_total_ns));
+    }
+    printf("}}\n");
+
+} /* bench_report_json */
+
+static void
+usage(const char *program_name)
+{
+    printf("%s: IF-MIB and IP-MIB table benchmark\n"
+           "usage: %s [OPTIONS] DATABASE PLUGIN...\n"
+           "where DATABASE is an OVSDB remote, e.g. unix:/tmp/db.sock,\n"
+           "and PLUGIN the file of an SNMP plugin of ops-intfd.\n"
+           "\nOptions:\n"
+           "  -w, --walks=N           timed loads and walks of every table "
+           "(default: %d)\n"
+           "  -r, --max-repetitions=N walk with GETBULK instead of GETNEXT\n"
+           "  -c, --config=LINE       pass a line of snmpd.conf to the "
+           "plugins\n"
+           "  -j, --json              print the results as one JSON object\n"
+           "  -h, --help              display this help message\n",
+           program_name, program_name, BENCH_DEFAULT_WALKS);
+
+} /* usage */
+
+int
+main(int argc, char *argv[])
+{
+    static const struct option long_options[] = {
+        {"walks",           required_argument, NULL, 'w'},
+        {"max-repetitions", required_argument, NULL, 'r'},
+        {"config",          required_argument, NULL, 'c'},
+        {"json",            no_argument,       NULL, 'j'},
+        {"help",            no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    struct bench_result results[N_BENCH_TABLES];
+    char *configs[BENCH_MAX_CONFIGS];
+    size_t n_configs = 0;
+    long walks = BENCH_DEFAULT_WALKS;
+    long max_repetitions = 0;
+    bool json = false;
+    netsnmp_session *ss;
+    size_t i;
+    int c, arg;
+
+    while ((c = getopt_long(argc, argv, "w:r:c:jh", long_options, NULL))
+           != -1) {
+        switch (c) {
+        case 'w':
+            walks = strtol(optarg, NULL, 10);
+            break;
+
+        case 'r':
+            max_repetitions = strtol(optarg, NULL, 10);
+            break;
+
+        case 'c':
+            if (n_configs >= BENCH_MAX_CONFIGS) {
+                bench_fail("too many -c options");
+            }
+            configs[n_configs++] = optarg;
+            break;
+
+        case 'j':
+            json = true;
+            break;
+
+        case 'h':
+            usage(argv[0]);
+            exit(EXIT_SUCCESS);
+
+        default:
+            usage(argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (walks <= 0 || max_repetitions < 0 || argc - optind < 2) {
+        usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    ovsrec_init();
+    idl = ovsdb_idl_create(argv[optind], &ovsrec_idl_class, false, true);
+
+    /* A master agent without transports, nor configuration files. */
+    netsnmp_ds_set_boolean(NETSNMP_DS_APPLICATION_ID, NETSNMP_DS_AGENT_ROLE,
+                           MASTER_AGENT);
+    netsnmp_ds_set_boolean(NETSNMP_DS_LIBRARY_ID,
+                           NETSNMP_DS_LIB_DONT_READ_CONFIGS, 1);
+    netsnmp_ds_set_boolean(NETSNMP_DS_LIBRARY_ID,
+                           NETSNMP_DS_LIB_DISABLE_PERSISTENT_LOAD, 1);
+    netsnmp_ds_set_boolean(NETSNMP_DS_LIBRARY_ID,
+                           NETSNMP_DS_LIB_DISABLE_PERSISTENT_SAVE, 1);
+    snmp_enable_stderrlog();
+    init_agent(BENCH_NAME);
+
+    /* The plugins add their columns to the IDL before its first run. */
+    for (arg = optind + 1; arg < argc; arg++) {
+        bench_plugin_load(argv[arg]);
+    }
+    init_snmp(BENCH_NAME);
+    for (i = 0; i < n_configs; i++) {
+        netsnmp_config(configs[i]);
+    }
+    bench_idl_sync();
+
+    ss = bench_session_open();
+    for (i = 0; i < N_BENCH_TABLES; i++) {
+        bench_run_table(ss, &bench_tables[i], walks, max_repetitions,
+                        &results[i]);
+    }
+
+    if (json) {
+        bench_report_json(results, walks, max_repetitions);
+    } else {
+        bench_report_text(results, walks);
+    }
+
+    for (i = 0; i < N_BENCH_TABLES; i++) {
+        free(results[i].walk_ns);
+    }
+    snmp_close(ss);
+    for (i = 0; i < n_bench_plugins; i++) {
+        bench_plugins[i].destroy();
+    }
+    snmp_shutdown(BENCH_NAME);
+    ovsdb_idl_destroy(idl);
+
+    return 0;
+
+} /* main */
+
+/** @} end of group ops-intfd */
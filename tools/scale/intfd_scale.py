@@ -0,0 +1,780 @@
+#!/usr/bin/env python
+# (C) Copyright 2016 Hewlett Packard Enterprise Development LP
+# All Rights Reserved.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License"); you may
+#    not use this file except in compliance with the License. You may obtain
+#    a copy of the License at
+#
+#         http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+#    WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+#    License for the specific language governing permissions and limitations
+#    under the License.
+#
+##########################################################################
+
+"""
+Scale harness for ops-intfd.
+
+Starts a private ovsdb-server with the OpenSwitch schema, populates it with
+a synthetic switch of 64 to 8192 Interface rows (fixed RJ45 ports, SFP+
+cages, split QSFP+/QSFP28 groups, LAGs and VLAN subinterfaces) and runs
+ops-intfd against it.  It measures:
+
+  * time_to_first_commit: from starting ops-intfd until every Interface
+    row has hw_intf_config:enable written.
+  * steady_state: ops-intfd CPU use while nothing changes.
+  * per-update latency under scripted churn, from the transaction that
+    changes a row until ops-intfd writes the expected hw_intf_config:enable
+    for every affected interface:
+      optic_storm   pluggable modules removed and re-inserted
+      lag_flap      LAG Port admin toggled down and up
+      admin_toggle  user_config:admin toggled on many interfaces in a
+                    single transaction
+
+The results are written as one JSON object, to stdout or --output, so runs
+can be collected for trend tracking.
+
+Example:
+
+    intfd_scale.py --interfaces=4096 --output=intfd-4096.json
+
+ovsdb-tool, ovsdb-server and ops-intfd are taken from $PATH unless given
+explicitly.  Nothing outside --workdir is touched.
+"""
+
+from __future__ import print_function
+
+import argparse
+import errno
+import json
+import os
+import platform
+import random
+import shutil
+import signal
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+
+DB_NAME = "OpenSwitch"
+MIN_INTERFACES = 64
+MAX_INTERFACES = 8192
+SPLIT_COUNT = 4
+SUBINTF_VLAN_BASE = 100
+
+CLK_TCK = os.sysconf("SC_CLK_TCK")
+
+
+class HarnessError(Exception):
+    pass
+
+
+# ---------------------------------------------------------------------------
+# Minimal OVSDB JSON-RPC client (RFC 7047), so the harness only needs the
+# OVS binaries and not the OVS Python library.
+# ---------------------------------------------------------------------------
+
+class OvsdbClient(object):
+
+    def __init__(self, path, timeout):
+        self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self.sock.connect(path)
+        self.timeout = timeout
+        self.buf = ""
+        self.decoder = json.JSONDecoder()
+        self.next_id = 0
+        # Notifications received while waiting for a reply, each one
+        # stamped with its arrival time.
+        self.notifications = []
+
+    def close(self):
+        self.sock.close()
+
+    def _send(self, msg):
+        self.sock.sendall(json.dumps(msg).encode("utf-8"))
+
+    def _recv(self, deadline):
+        while True:
+            self.buf = self.buf.lstrip()
+            if self.buf:
+                try:
+                    msg, end = self.decoder.raw_decode(self.buf)
+                except ValueError:
+                    msg = None
+                if msg is not None:
+                    self.buf = self.buf[end:]
+                    if msg.get("method") == "echo":
+                        self._send({"id": msg["id"], "error": None,
+                                    "result": msg["params"]})
+                        continue
+                    return time.time(), msg
+
+            remaining = deadline - time.time()
+            if remaining <= 0:
+                return None, None
+            self.sock.settimeout(remaining)
+            try:
+                data = self.sock.recv(1 << 20)
+            except socket.timeout:
+                return None, None
+            if not data:
+                raise HarnessError("ovsdb-server closed the connection")
+            self.buf += data.decode("utf-8")
+
+    def call(self, method, params):
+        self.next_id += 1
+        msg_id = self.next_id
+        self._send({"method": method, "params": params, "id": msg_id})
+        deadline = time.time() + self.timeout
+        while True:
+            stamp, msg = self._recv(deadline)
+            if msg is None:
+                raise HarnessError("no reply to %s" % method)
+            if msg.get("id") == msg_id:
+                if msg.get("error"):
+                    raise HarnessError("%s failed: %s" % (method, msg["error"]))
+                return msg["result"]
+            if msg.get("method"):
+                self.notifications.append((stamp, msg))
+
+    def transact(self, ops):
+        result = self.call("transact", [DB_NAME] + ops)
+        for i, res in enumerate(result):
+            if res and "error" in res:
+                raise HarnessError("transaction failed at op %d: %s: %s"
+                                   % (i, res["error"], res.get("details")))
+        return result
+
+    def next_notification(self, deadline):
+        if self.notifications:
+            return self.notifications.pop(0)
+        return self._recv(deadline)
+
+
+def ovs_map(d):
+    return ["map", [[k, v] for k, v in sorted(d.items())]]
+
+
+def ovs_set(items):
+    return ["set", list(items)]
+
+
+def named(name):
+    return ["named-uuid", name]
+
+
+def by_uuid(uuid):
+    return [["_uuid", "==", ["uuid", uuid]]]
+
+
+# ---------------------------------------------------------------------------
+# Synthetic switch.
+# ---------------------------------------------------------------------------
+
+class Intf(object):
+
+    def __init__(self, name, kind, hw_intf_info, pm_info,
+                 parent=None, vlan=None):
+        self.name = name
+        self.kind = kind  # rj45, sfp, qsfp, split_child, subintf
+        self.hw_intf_info = hw_intf_info
+        self.pm_info = pm_info
+        self.user_config = {"admin": "up"}
+        self.split_parent = parent if kind == "split_child" else None
+        self.split_children = []
+        self.subintf_parent = parent if kind == "subintf" else None
+        self.vlan = vlan
+        self.uuid = None
+        self.port = None
+        # Last hw_intf_config:enable written by ops-intfd.
+        self.enable = None
+
+
+class Port(object):
+
+    def __init__(self, name, members):
+        self.name = name
+        self.members = members
+        self.admin = "up"
+        self.uuid = None
+        for intf in members:
+            intf.port = self
+
+
+def hw_info(idx, connector, speeds, pluggable, **extra):
+    info = {
+        "connector": connector,
+        "speeds": speeds,
+        "max_speed": speeds.split(",")[-1],
+        "pluggable": "true" if pluggable else "false",
+        "switch_unit": "0",
+        "switch_intf_id": str(idx),
+        "mac_intf_id": str(idx),
+    }
+    info.update(extra)
+    return info
+
+
+def build_switch(args, rng):
+    """Lay out 'args.interfaces' Interface rows and their ports."""
+    n = args.interfaces
+    n_subintf = int(n * args.subintf_ratio)
+    n_split_groups = int((n - n_subintf) * args.split_ratio) // \
+        (SPLIT_COUNT + 1)
+    n_physical = n - n_subintf - n_split_groups * (SPLIT_COUNT + 1)
+    n_rj45 = min(48, n_physical // 4)
+
+    intfs = []
+    idx = 0
+    for i in range(n_physical):
+        idx += 1
+        if i < n_rj45:
+            intfs.append(Intf(str(idx), "rj45",
+                              hw_info(idx, "RJ45", "1000", False), {}))
+        else:
+            pm = {"connector": rng.choice(["SFP_SR", "SFP_LR", "SFP_DAC"]),
+                  "connector_status": "supported"}
+            intfs.append(Intf(str(idx), "sfp",
+                              hw_info(idx, "SFP_PLUS", "1000,10000", True),
+                              pm))
+
+    for g in range(n_split_groups):
+        idx += 1
+        qsfp28 = (g % 2 == 1)
+        connector = "QSFP28" if qsfp28 else "QSFP_PLUS"
+        speeds = "25000,40000,100000" if qsfp28 else "10000,40000"
+        module = "QSFP28_SR4" if qsfp28 else "QSFP_SR4"
+        parent = Intf(str(idx), "qsfp",
+                      hw_info(idx, connector, speeds, True,
+                              splittable="true", split_4="true"),
+                      {"connector": module, "connector_status": "supported"})
+        parent.user_config["lane_split"] = "split"
+        intfs.append(parent)
+        child_speeds = "25000" if qsfp28 else "10000"
+        for lane in range(1, SPLIT_COUNT + 1):
+            child = Intf("%d-%d" % (idx, lane), "split_child",
+                         hw_info(idx, connector, child_speeds, True),
+                         {}, parent=parent)
+            parent.split_children.append(child)
+            intfs.append(child)
+
+    # Subinterfaces hang off the physical ports that are not LAG members.
+    n_lag_members = min(args.lags * args.lag_members,
+                        (n_physical - n_rj45) // 2)
+    sfps = [intf for intf in intfs if intf.kind == "sfp"]
+    lag_pool = sfps[:n_lag_members]
+    l3_parents = sfps[n_lag_members:] or \
+        [intf for intf in intfs if intf.kind == "rj45"]
+    for s in range(n_subintf):
+        parent = l3_parents[s % len(l3_parents)]
+        vlan = SUBINTF_VLAN_BASE + s // len(l3_parents)
+        intfs.append(Intf("%s.%d" % (parent.name, vlan), "subintf",
+                          {}, {}, parent=parent, vlan=vlan))
+
+    ports = []
+    lags = []
+    for lag in range(n_lag_members // args.lag_members):
+        members = lag_pool[lag * args.lag_members:
+                           (lag + 1) * args.lag_members]
+        lags.append(Port("lag%d" % (lag + 1), members))
+    ports.extend(lags)
+    for intf in intfs:
+        if intf.port is None and intf.kind != "subintf":
+            ports.append(Port(intf.name, [intf]))
+    subintf_ports = [Port(intf.name, [intf])
+                     for intf in intfs if intf.kind == "subintf"]
+
+    return intfs, ports, lags, subintf_ports
+
+
+def populate(client, intfs, ports, subintf_ports, max_mtu):
+    """Insert the whole switch in one transaction."""
+    ops = []
+    for i, intf in enumerate(intfs):
+        intf.tag = "if%d" % i
+    for i, port in enumerate(ports + subintf_ports):
+        port.tag = "port%d" % i
+
+    for intf in intfs:
+        row = {
+            "name": intf.name,
+            "type": "vlansubint" if intf.kind == "subintf" else "system",
+            "user_config": ovs_map(intf.user_config),
+            "hw_intf_info": ovs_map(intf.hw_intf_info),
+            "pm_info": ovs_map(intf.pm_info),
+        }
+        if intf.split_parent:
+            row["split_parent"] = named(intf.split_parent.tag)
+        if intf.split_children:
+            row["split_children"] = ovs_set(named(c.tag)
+                                            for c in intf.split_children)
+        if intf.subintf_parent:
+            row["subintf_parent"] = ["map", [[intf.vlan,
+                                              named(intf.subintf_parent.tag)]]]
+        ops.append({"op": "insert", "table": "Interface", "row": row,
+                    "uuid-name": intf.tag})
+
+    for port in ports + subintf_ports:
+        ops.append({"op": "insert", "table": "Port", "uuid-name": port.tag,
+                    "row": {"name": port.name, "admin": port.admin,
+                            "interfaces": ovs_set(named(m.tag)
+                                                  for m in port.members)}})
+
+    ops.append({"op": "insert", "table": "Bridge", "uuid-name": "br",
+                "row": {"name": "bridge_normal",
+                        "ports": ovs_set(named(p.tag) for p in ports)}})
+    ops.append({"op": "insert", "table": "VRF", "uuid-name": "vrf",
+                "row": {"name": "vrf_default",
+                        "ports": ovs_set(named(p.tag)
+                                         for p in subintf_ports)}})
+    ops.append({"op": "insert", "table": "Subsystem",
+                "row": {"name": "base",
+                        "other_info": ovs_map({"max_transmission_unit":
+                                               str(max_mtu)})}})
+    ops.append({"op": "insert", "table": "System",
+                "row": {"cur_cfg": 1,
+                        "bridges": ovs_set([named("br")]),
+                        "vrfs": ovs_set([named("vrf")])}})
+
+    result = client.transact(ops)
+    for i, intf in enumerate(intfs):
+        intf.uuid = result[i]["uuid"][1]
+    for i, port in enumerate(ports + subintf_ports):
+        port.uuid = result[len(intfs) + i]["uuid"][1]
+
+
+# ---------------------------------------------------------------------------
+# Measurement helpers.
+# ---------------------------------------------------------------------------
+
+def proc_cpu_ticks(pid):
+    with open("/proc/%d/stat" % pid) as f:
+        fields = f.read().rsplit(")", 1)[1].split()
+    # utime and stime are fields 14 and 15 of the full line.
+    return int(fields[11]) + int(fields[12])
+
+
+def proc_rss_kb(pid):
+    with open("/proc/%d/status" % pid) as f:
+        for line in f:
+            if line.startswith("VmRSS:"):
+                return int(line.split()[1])
+    return 0
+
+
+def percentile(sorted_values, pct):
+    if not sorted_values:
+        return 0.0
+    k = int(round((len(sorted_values) - 1) * pct / 100.0))
+    return sorted_values[k]
+
+
+def latency_summary(latencies):
+    values = sorted(latencies)
+    ms = [v * 1000.0 for v in values]
+    return {
+        "count": len(ms),
+        "min_ms": round(ms[0], 3) if ms else 0.0,
+        "p50_ms": round(percentile(ms, 50), 3),
+        "p90_ms": round(percentile(ms, 90), 3),
+        "p99_ms": round(percentile(ms, 99), 3),
+        "max_ms": round(ms[-1], 3) if ms else 0.0,
+        "mean_ms": round(sum(ms) / len(ms), 3) if ms else 0.0,
+    }
+
+
+class Monitor(object):
+    """Tracks hw_intf_config:enable of every Interface row."""
+
+    def __init__(self, client, intfs):
+        self.client = client
+        self.by_uuid = dict((intf.uuid, intf) for intf in intfs)
+        initial = client.call("monitor", [DB_NAME, "intfd-scale", {
+            "Interface": {"columns": ["name", "hw_intf_config"]}}])
+        self.apply(initial, time.time())
+
+    @staticmethod
+    def _enable(row):
+        cfg = row.get("hw_intf_config")
+        if not cfg:
+            return None
+        return dict(cfg[1]).get("enable")
+
+    def apply(self, update, stamp):
+        changed = []
+        for uuid, change in update.get("Interface", {}).items():
+            intf = self.by_uuid.get(uuid)
+            if intf is None or "new" not in change:
+                continue
+            enable = self._enable(change["new"])
+            if enable != intf.enable:
+                intf.enable = enable
+                changed.append(intf)
+        return changed
+
+    def wait(self, pending, deadline):
+        """Wait until every interface in 'pending' (name -> (expected
+        enable, start time)) reached its expected state.  Returns the
+        latencies, raises HarnessError on timeout."""
+        latencies = []
+        while pending:
+            stamp, msg = self.client.next_notification(deadline)
+            if msg is None:
+                raise HarnessError("timed out waiting for %d interfaces, "
+                                   "e.g. %s" % (len(pending),
+                                                sorted(pending)[0]))
+            if msg.get("method") != "update":
+                continue
+            for intf in self.apply(msg["params"][1], stamp):
+                want = pending.get(intf.name)
+                if want and intf.enable == want[0]:
+                    latencies.append(stamp - want[1])
+                    del pending[intf.name]
+        return latencies
+
+
+# ---------------------------------------------------------------------------
+# Processes.
+# ---------------------------------------------------------------------------
+
+def wait_for_path(path, proc, timeout):
+    deadline = time.time() + timeout
+    while not os.path.exists(path):
+        if proc.poll() is not None:
+            raise HarnessError("%s exited with status %d"
+                               % (proc.args_name, proc.returncode))
+        if time.time() > deadline:
+            raise HarnessError("%s did not appear" % path)
+        time.sleep(0.05)
+
+
+def start(cmd, log_path):
+    log = open(log_path, "w")
+    proc = subprocess.Popen(cmd, stdout=log, stderr=subprocess.STDOUT)
+    proc.args_name = os.path.basename(cmd[0])
+    return proc
+
+
+def stop(proc):
+    if proc is None or proc.poll() is not None:
+        return
+    proc.send_signal(signal.SIGTERM)
+    for _ in range(50):
+        if proc.poll() is not None:
+            return
+        time.sleep(0.1)
+    proc.kill()
+    proc.wait()
+
+
+# ---------------------------------------------------------------------------
+# Scenarios.
+# ---------------------------------------------------------------------------
+
+class Scenario(object):
+
+    def __init__(self, name, client, monitor, timeout):
+        self.name = name
+        self.client = client
+        self.monitor = monitor
+        self.timeout = timeout
+        self.latencies = []
+        self.batch_latencies = []
+        self.updates = 0
+
+    def run_batch(self, ops, expected):
+        """Commit 'ops' and wait until every (intf, enable) pair in
+        'expected' is reflected in hw_intf_config."""
+        start_time = time.time()
+        self.client.transact(ops)
+        pending = dict((intf.name, (enable, start_time))
+                       for intf, enable in expected)
+        self.latencies.extend(self.monitor.wait(
+            pending, time.time() + self.timeout))
+        self.batch_latencies.append(time.time() - start_time)
+        self.updates += len(ops)
+
+    def result(self, elapsed, cpu_ticks):
+        return {
+            "transactions": len(self.batch_latencies),
+            "row_updates": self.updates,
+            "interface_updates": len(self.latencies),
+            "elapsed_s": round(elapsed, 3),
+            "updates_per_s": round(len(self.latencies) / elapsed, 1)
+            if elapsed else 0.0,
+            "cpu_pct": round(100.0 * cpu_ticks / CLK_TCK / elapsed, 1)
+            if elapsed else 0.0,
+            "interface_latency": latency_summary(self.latencies),
+            "transaction_latency": latency_summary(self.batch_latencies),
+        }
+
+
+def optic_storm(sc, intfs, rng, events, burst):
+    """Pull and re-insert modules, 'burst' transactions at a time."""
+    cages = [i for i in intfs if i.kind == "sfp" and i.port
+             and len(i.port.members) == 1 and i.enable == "true"]
+    if not cages:
+        return
+    for _ in range(max(1, events // burst)):
+        chosen = rng.sample(cages, min(burst, len(cages)))
+        for removed in (True, False):
+            start_time = time.time()
+            pending = {}
+            for intf in chosen:
+                pm = dict(intf.pm_info)
+                if removed:
+                    pm = {"connector": "absent",
+                          "connector_status": "unsupported"}
+                sc.client.transact([{"op": "update", "table": "Interface",
+                                     "where": by_uuid(intf.uuid),
+                                     "row": {"pm_info": ovs_map(pm)}}])
+                pending[intf.name] = ("false" if removed else "true",
+                                      time.time())
+                sc.updates += 1
+            sc.latencies.extend(sc.monitor.wait(
+                pending, time.time() + sc.timeout))
+            sc.batch_latencies.append(time.time() - start_time)
+
+
+def lag_flap(sc, lags, rng, events):
+    lags = [lag for lag in lags
+            if all(m.enable == "true" for m in lag.members)]
+    if not lags:
+        return
+    for _ in range(events):
+        lag = rng.choice(lags)
+        for admin, enable in (("down", "false"), ("up", "true")):
+            sc.run_batch([{"op": "update", "table": "Port",
+                           "where": by_uuid(lag.uuid),
+                           "row": {"admin": admin}}],
+                         [(m, enable) for m in lag.members])
+
+
+def admin_toggle(sc, intfs, rng, rounds, fraction):
+    candidates = [i for i in intfs
+                  if i.kind in ("rj45", "sfp") and i.enable == "true"]
+    if not candidates:
+        return
+    for _ in range(rounds):
+        chosen = rng.sample(candidates,
+                            max(1, int(len(candidates) * fraction)))
+        for admin, enable in (("down", "false"), ("up", "true")):
+            ops = []
+            for intf in chosen:
+                cfg = dict(intf.user_config, admin=admin)
+                ops.append({"op": "update", "table": "Interface",
+                            "where": by_uuid(intf.uuid),
+                            "row": {"user_config": ovs_map(cfg)}})
+            sc.run_batch(ops, [(i, enable) for i in chosen])
+
+
+def run_scenario(name, client, monitor, pid, timeout, fn, *fn_args):
+    sc = Scenario(name, client, monitor, timeout)
+    cpu0 = proc_cpu_ticks(pid)
+    t0 = time.time()
+    fn(sc, *fn_args)
+    return sc.result(time.time() - t0, proc_cpu_ticks(pid) - cpu0)
+
+
+# ---------------------------------------------------------------------------
+# Main.
+# ---------------------------------------------------------------------------
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description="ops-intfd scale harness",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+    parser.add_argument("--interfaces", type=int, default=1024,
+                        help="Interface rows to create (%d-%d)"
+                        % (MIN_INTERFACES, MAX_INTERFACES))
+    parser.add_argument("--split-ratio", type=float, default=0.125,
+                        help="share of non-subinterface rows in split "
+                        "QSFP groups")
+    parser.add_argument("--subintf-ratio", type=float, default=0.125,
+                        help="share of rows that are VLAN subinterfaces")
+    parser.add_argument("--lags", type=int, default=16,
+                        help="LAG ports to create")
+    parser.add_argument("--lag-members", type=int, default=4,
+                        help="member interfaces per LAG")
+    parser.add_argument("--max-mtu", type=int, default=9192,
+                        help="base subsystem max_transmission_unit")
+    parser.add_argument("--idle", type=float, default=5.0,
+                        help="seconds of steady state to sample CPU")
+    parser.add_argument("--optic-events", type=int, default=256,
+                        help="module pull/insert events in the optic storm")
+    parser.add_argument("--optic-burst", type=int, default=16,
+                        help="modules changed before waiting for ops-intfd")
+    parser.add_argument("--lag-flaps", type=int, default=32,
+                        help="LAG admin down/up cycles")
+    parser.add_argument("--admin-rounds", type=int, default=4,
+                        help="bulk admin down/up cycles")
+    parser.add_argument("--admin-fraction", type=float, default=0.5,
+                        help="share of physical interfaces per bulk toggle")
+    parser.add_argument("--seed", type=int, default=1,
+                        help="random seed for the layout and churn")
+    parser.add_argument("--timeout", type=float, default=120.0,
+                        help="seconds to wait for ops-intfd at any step")
+    parser.add_argument("--schema",
+                        default="/usr/share/openvswitch/vswitch.ovsschema",
+                        help="OpenSwitch OVSDB schema")
+    parser.add_argument("--ovsdb-tool", default="ovsdb-tool")
+    parser.add_argument("--ovsdb-server", default="ovsdb-server")
+    parser.add_argument("--ops-intfd", default="ops-intfd")
+    parser.add_argument("--intfd-arg", action="append", default=[],
+                        help="extra ops-intfd argument (repeatable)")
+    parser.add_argument("--workdir",
+                        help="directory for the database, sockets and logs "
+                        "(default: a temporary directory, removed "
+                        "afterwards)")
+    parser.add_argument("--output", help="write the JSON result here")
+    args = parser.parse_args()
+
+    if not MIN_INTERFACES <= args.interfaces <= MAX_INTERFACES:
+        parser.error("--interfaces must be between %d and %d"
+                     % (MIN_INTERFACES, MAX_INTERFACES))
+    if args.lag_members < 1 or args.optic_burst < 1:
+        parser.error("--lag-members and --optic-burst must be positive")
+    return args
+
+
+def run(args, workdir):
+    rng = random.Random(args.seed)
+    intfs, ports, lags, subintf_ports = build_switch(args, rng)
+
+    db = os.path.join(workdir, "ovsdb.db")
+    db_sock = os.path.join(workdir, "db.sock")
+    subprocess.check_call([args.ovsdb_tool, "create", db, args.schema])
+
+    server = intfd = client = None
+    try:
+        server = start([args.ovsdb_server, db,
+                        "--remote=punix:" + db_sock,
+                        "--unixctl=" + os.path.join(workdir, "ovsdb.ctl"),
+                        "--no-chdir"],
+                       os.path.join(workdir, "ovsdb-server.log"))
+        wait_for_path(db_sock, server, args.timeout)
+
+        client = OvsdbClient(db_sock, args.timeout)
+        t0 = time.time()
+        populate(client, intfs, ports, subintf_ports, args.max_mtu)
+        populate_s = time.time() - t0
+        monitor = Monitor(client, intfs)
+
+        # Time to first commit.
+        t0 = time.time()
+        intfd = start([args.ops_intfd, "unix:" + db_sock,
+                       "--unixctl=" + os.path.join(workdir, "intfd.ctl"),
+                       "--no-chdir"] + args.intfd_arg,
+                      os.path.join(workdir, "ops-intfd.log"))
+        pending = dict((intf.name, (None, t0)) for intf in intfs)
+        deadline = t0 + args.timeout
+        first_update = None
+        while pending:
+            stamp, msg = client.next_notification(deadline)
+            if msg is None:
+                raise HarnessError("ops-intfd did not configure %d "
+                                   "interfaces" % len(pending))
+            if msg.get("method") != "update":
+                continue
+            for intf in monitor.apply(msg["params"][1], stamp):
+                if first_update is None:
+                    first_update = stamp - t0
+                pending.pop(intf.name, None)
+        first_commit_s = time.time() - t0
+
+        # Steady state.
+        cpu0 = proc_cpu_ticks(intfd.pid)
+        time.sleep(args.idle)
+        idle_ticks = proc_cpu_ticks(intfd.pid) - cpu0
+
+        results = {
+            "time_to_first_update_s": round(first_update or 0.0, 3),
+            "time_to_first_commit_s": round(first_commit_s, 3),
+            "steady_state": {
+                "seconds": args.idle,
+                "cpu_pct": round(100.0 * idle_ticks / CLK_TCK / args.idle, 2),
+                "rss_kb": proc_rss_kb(intfd.pid),
+            },
+            "enabled_interfaces": sum(1 for i in intfs if i.enable == "true"),
+        }
+
+        scenarios = {}
+        scenarios["optic_storm"] = run_scenario(
+            "optic_storm", client, monitor, intfd.pid, args.timeout,
+            optic_storm, intfs, rng, args.optic_events, args.optic_burst)
+        scenarios["lag_flap"] = run_scenario(
+            "lag_flap", client, monitor, intfd.pid, args.timeout,
+            lag_flap, lags, rng, args.lag_flaps)
+        scenarios["admin_toggle"] = run_scenario(
+            "admin_toggle", client, monitor, intfd.pid, args.timeout,
+            admin_toggle, intfs, rng, args.admin_rounds,
+            args.admin_fraction)
+        results["scenarios"] = scenarios
+        results["rss_kb_after_churn"] = proc_rss_kb(intfd.pid)
+        results["populate_s"] = round(populate_s, 3)
+
+        if intfd.poll() is not None:
+            raise HarnessError("ops-intfd exited with status %d"
+                               % intfd.returncode)
+        return results, intfs, ports, lags, subintf_ports
+    finally:
+        if client:
+            client.close()
+        stop(intfd)
+        stop(server)
+
+
+def main():
+    args = parse_args()
+    workdir = args.workdir or tempfile.mkdtemp(prefix="intfd-scale-")
+    try:
+        os.makedirs(workdir)
+    except OSError as e:
+        if e.errno != errno.EEXIST:
+            raise
+
+    try:
+        results, intfs, ports, lags, subintf_ports = run(args, workdir)
+    except (HarnessError, subprocess.CalledProcessError, socket.error) as e:
+        print("intfd_scale: %s (logs in %s)" % (e, workdir), file=sys.stderr)
+        return 1
+
+    counts = {}
+    for intf in intfs:
+        counts[intf.kind] = counts.get(intf.kind, 0) + 1
+    report = {
+        "harness": "intfd_scale",
+        "timestamp": time.strftime("%Y-%m-%dT%H:%M:%SZ", time.gmtime()),
+        "host": platform.node(),
+        "kernel": platform.release(),
+        "config": {
+            "interfaces": len(intfs),
+            "interface_kinds": counts,
+            "ports": len(ports) + len(subintf_ports),
+            "lags": len(lags),
+            "lag_members": args.lag_members,
+            "seed": args.seed,
+        },
+        "results": results,
+    }
+
+    text = json.dumps(report, indent=2, sort_keys=True)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text + "\n")
+    else:
+        print(text)
+
+    if not args.workdir:
+        shutil.rmtree(workdir, ignore_errors=True)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,276 @@
+#!/usr/bin/env python
+# (C) Copyright 2016 Hewlett Packard Enterprise Development LP
+# All Rights Reserved.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License"); you may
+#    not use this file except in compliance with the License. You may obtain
+#    a copy of the License at
+#
+#         http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+#    WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+#    License for the specific language governing permissions and limitations
+#    under the License.
+#
+##########################################################################
+
+"""
+SNMP table benchmark for the IF-MIB and IP-MIB plugins of ops-intfd.
+
+For each switch size, starts a private ovsdb-server with the OpenSwitch
+schema and fills it with the synthetic switch of intfd_scale.py.  Every
+Interface row gets link and admin states and a full statistics column, and
+the LAGs, the VLAN subinterfaces and some of the other ports get IPv4 and
+IPv6 addresses, so they have ipIfStatsTable rows.  It then runs
+mib_walk_bench against the database, once walking with GETNEXT, once with
+GETBULK and once with GETBULK and the counters of ifTable and ifXTable in
+columnar snapshots (ifMibColumnarCounters), and reports for ifTable,
+ifXTable, ipIfStatsTable and ipSystemStatsTable:
+
+  * the time to build the snapshot of the table into empty containers,
+    and to refresh it with every row in place
+  * the latency of a walk of the whole table, and the rows and varbinds
+    per second it serves
+
+The results are written as one JSON object, to stdout or --output.
+
+Example:
+
+    snmp_walk_scale.py --bench=_build/mib_walk_bench \\
+        --plugin=_build/src/snmp/ifmib/libintfd_snmp.so \\
+        --plugin=_build/src/snmp/ipmib/libintfd_ip_snmp.so
+
+"make bench-snmp-walk" runs it with the plugins of the build tree.
+"""
+
+from __future__ import print_function
+
+import argparse
+import errno
+import json
+import os
+import platform
+import random
+import shutil
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+from intfd_scale import (MAX_INTERFACES, MIN_INTERFACES, HarnessError,
+                         OvsdbClient, build_switch, by_uuid, ovs_map,
+                         populate, start, stop, wait_for_path)
+
+DEFAULT_SIZES = "64,256,1024,4096,8192"
+
+# The keys of the Interface "statistics" column the tables read.
+STATISTICS = [
+    "collisions", "rx_bytes", "rx_crc_err", "rx_dropped", "rx_errors",
+    "rx_frame_err", "rx_over_err", "rx_packets", "tx_bytes", "tx_dropped",
+    "tx_errors", "tx_packets",
+] + ["ipv%d_%s_%s_%s" % (v, cast, d, unit)
+     for v in (4, 6) for cast in ("uc", "mc")
+     for d in ("rx", "tx") for unit in ("packets", "bytes")]
+
+
+def add_state(client, rng, intfs, ports, lags, subintf_ports, l3_ratio):
+    """Give every Interface states and counters, and some ports
+    addresses, in one transaction."""
+    ops = []
+    for intf in intfs:
+        stats = dict((key, rng.randint(0, 1 << 40)) for key in STATISTICS)
+        ops.append({"op": "update", "table": "Interface",
+                    "where": by_uuid(intf.uuid),
+                    "row": {"admin_state": "up",
+                            "link_state": rng.choice(["up", "up", "down"]),
+                            "statistics": ovs_map(stats)}})
+
+    singles = [p for p in ports if p not in lags]
+    routed = lags + subintf_ports + \
+        singles[:int(len(singles) * l3_ratio)]
+    for i, port in enumerate(routed):
+        row = {"ip4_address": "10.%d.%d.1/24" % (i // 256, i % 256)}
+        if i % 2 == 0:
+            row["ip6_address"] = "2001:db8:%x::1/64" % i
+        ops.append({"op": "update", "table": "Port",
+                    "where": by_uuid(port.uuid), "row": row})
+
+    client.transact(ops)
+    return len(routed)
+
+
+def run_bench(args, workdir, db_sock, max_repetitions, configs=()):
+    env = dict(os.environ, OVS_DBDIR=workdir)
+    cmd = [args.bench, "--json", "--walks=%d" % args.walks,
+           "--max-repetitions=%d" % max_repetitions]
+    cmd += ["--config=" + line for line in configs]
+    cmd += ["unix:" + db_sock] + args.plugin
+    log = open(os.path.join(workdir, "mib_walk_bench.log"), "a")
+    try:
+        out = subprocess.check_output(cmd, env=env, stderr=log)
+    finally:
+        log.close()
+    return json.loads(out.decode("utf-8"))
+
+
+def run_size(args, n_interfaces, workdir):
+    rng = random.Random(args.seed)
+    args.interfaces = n_interfaces
+    intfs, ports, lags, subintf_ports = build_switch(args, rng)
+
+    db = os.path.join(workdir, "ovsdb.db")
+    db_sock = os.path.join(workdir, "db.sock")
+    subprocess.check_call([args.ovsdb_tool, "create", db, args.schema])
+
+    server = client = None
+    try:
+        server = start([args.ovsdb_server, db,
+                        "--remote=punix:" + db_sock,
+                        "--unixctl=" + os.path.join(workdir, "ovsdb.ctl"),
+                        "--no-chdir"],
+                       os.path.join(workdir, "ovsdb-server.log"))
+        wait_for_path(db_sock, server, args.timeout)
+
+        client = OvsdbClient(db_sock, args.timeout)
+        populate(client, intfs, ports, subintf_ports, args.max_mtu)
+        n_routed = add_state(client, rng, intfs, ports, lags,
+                             subintf_ports, args.l3_ratio)
+        client.close()
+        client = None
+
+        result = {
+            "interfaces": len(intfs),
+            "ports": len(ports) + len(subintf_ports),
+            "routed_ports": n_routed,
+            "getnext": run_bench(args, workdir, db_sock, 0),
+        }
+        if args.max_repetitions:
+            result["getbulk"] = run_bench(args, workdir, db_sock,
+                                          args.max_repetitions)
+            result["getbulk_columnar"] = run_bench(
+                args, workdir, db_sock, args.max_repetitions,
+                ["ifMibColumnarCounters yes"])
+        return result
+    finally:
+        if client:
+            client.close()
+        stop(server)
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description="IF-MIB and IP-MIB table benchmark",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+    parser.add_argument("--bench", default="mib_walk_bench",
+                        help="mib_walk_bench executable")
+    parser.add_argument("--plugin", action="append", default=[],
+                        help="SNMP plugin to load (repeatable, required)")
+    parser.add_argument("--sizes", default=DEFAULT_SIZES,
+                        help="comma-separated Interface row counts (%d-%d)"
+                        % (MIN_INTERFACES, MAX_INTERFACES))
+    parser.add_argument("--walks", type=int, default=20,
+                        help="timed loads and walks of every table")
+    parser.add_argument("--max-repetitions", type=int, default=25,
+                        help="max-repetitions of the GETBULK walk, 0 for "
+                        "GETNEXT only")
+    parser.add_argument("--split-ratio", type=float, default=0.125,
+                        help="share of non-subinterface rows in split "
+                        "QSFP groups")
+    parser.add_argument("--subintf-ratio", type=float, default=0.125,
+                        help="share of rows that are VLAN subinterfaces")
+    parser.add_argument("--lags", type=int, default=16,
+                        help="LAG ports to create")
+    parser.add_argument("--lag-members", type=int, default=4,
+                        help="member interfaces per LAG")
+    parser.add_argument("--l3-ratio", type=float, default=0.25,
+                        help="share of the other ports with addresses")
+    parser.add_argument("--max-mtu", type=int, default=9192,
+                        help="base subsystem max_transmission_unit")
+    parser.add_argument("--seed", type=int, default=1,
+                        help="random seed for the layout and counters")
+    parser.add_argument("--timeout", type=float, default=120.0,
+                        help="seconds to wait for ovsdb-server")
+    parser.add_argument("--schema",
+                        default="/usr/share/openvswitch/vswitch.ovsschema",
+                        help="OpenSwitch OVSDB schema")
+    parser.add_argument("--ovsdb-tool", default="ovsdb-tool")
+    parser.add_argument("--ovsdb-server", default="ovsdb-server")
+    parser.add_argument("--workdir",
+                        help="directory for the databases, sockets and "
+                        "logs (default: a temporary directory, removed "
+                        "afterwards)")
+    parser.add_argument("--output", help="write the JSON result here")
+    args = parser.parse_args()
+
+    if not args.plugin:
+        parser.error("at least one --plugin is required")
+    try:
+        args.sizes = [int(n) for n in args.sizes.split(",")]
+    except ValueError:
+        parser.error("--sizes must be a comma-separated list of numbers")
+    for n in args.sizes:
+        if not MIN_INTERFACES <= n <= MAX_INTERFACES:
+            parser.error("every size must be between %d and %d"
+                         % (MIN_INTERFACES, MAX_INTERFACES))
+    if args.walks < 1 or args.lag_members < 1 or args.max_repetitions < 0:
+        parser.error("--walks and --lag-members must be positive, "
+                     "--max-repetitions not negative")
+    return args
+
+
+def main():
+    args = parse_args()
+    workdir = args.workdir or tempfile.mkdtemp(prefix="snmp-walk-scale-")
+
+    results = {}
+    for n in args.sizes:
+        size_dir = os.path.join(workdir, str(n))
+        try:
+            os.makedirs(size_dir)
+        except OSError as e:
+            if e.errno != errno.EEXIST:
+                raise
+        try:
+            results[str(n)] = run_size(args, n, size_dir)
+        except (HarnessError, subprocess.CalledProcessError, socket.error,
+                ValueError) as e:
+            print("snmp_walk_scale: %d interfaces: %s (logs in %s)"
+                  % (n, e, size_dir), file=sys.stderr)
+            return 1
+
+    report = {
+        "harness": "snmp_walk_scale",
+        "timestamp": time.strftime("%Y-%m-%dT%H:%M:%SZ", time.gmtime()),
+        "host": platform.node(),
+        "kernel": platform.release(),
+        "config": {
+            "sizes": args.sizes,
+            "walks": args.walks,
+            "max_repetitions": args.max_repetitions,
+            "lags": args.lags,
+            "lag_members": args.lag_members,
+            "l3_ratio": args.l3_ratio,
+            "seed": args.seed,
+        },
+        "results": results,
+    }
+
+    text = json.dumps(report, indent=2, sort_keys=True)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text + "\n")
+    else:
+        print(text)
+
+    if not args.workdir:
+        shutil.rmtree(workdir, ignore_errors=True)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())